@@ -0,0 +1,264 @@
+// Benchmark and stress test for the allocators of allocators.hpp: the arena, the block pool and the thread cache are
+// checked for overlapping or misaligned blocks and leaked upstream memory (also from threads and from thread_local
+// destructors running after the thread cache), then simulated requests building 500 small vectors each are timed
+// with the default allocator, an arena reset after every request and the thread cache
+// Build from the repository root, for example: g++ -std=c++20 -O2 -pthread -I. benchmarks/allocators.cpp
+// Sanitizer runs: g++ -std=c++20 -O1 -g -pthread -fsanitize=address,undefined -I. benchmarks/allocators.cpp
+// and the same with -fsanitize=thread
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "include/woj/allocators.hpp"
+#include "include/woj/small_vector.hpp"
+#include "include/woj/vector.hpp"
+
+namespace
+{
+	constexpr int request_count = 2000;
+	constexpr int objects_per_request = 500;
+	constexpr unsigned thread_count = 4;
+
+	void check(const bool condition, const char* const what)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "check failed: %s\n", what);
+			std::exit(1);
+		}
+	}
+
+	/**
+	 * Upstream counting the blocks it hands out
+	 */
+	class counting_allocator
+	{
+	public:
+		static inline int live = 0;
+
+		WOJ_NODISCARD static void* allocate(const size_t size, const size_t alignment)
+		{
+			++live;
+			return woj::default_allocator::allocate(size, alignment);
+		}
+
+		static void deallocate(void* const ptr, const size_t size, const size_t alignment) noexcept
+		{
+			--live;
+			woj::default_allocator::deallocate(ptr, size, alignment);
+		}
+	};
+
+	using counting_arena = woj::basic_monotonic_arena<counting_allocator>;
+
+	void stress_arena()
+	{
+		woj::stack::vector<std::byte, 1024> storage{ woj::noinit };
+		counting_arena arena{ storage };
+		for (int round = 0; round < 5; ++round)
+		{
+			woj::vector<int, woj::resource_allocator<counting_arena>> values{ arena };
+			for (int i = 0; i < 100; ++i)
+			{
+				values.push_back(i);
+			}
+			const std::byte* const first = reinterpret_cast<const std::byte*>(values.data());
+			check(first >= storage.data() && first < storage.data() + storage.size(), "small vector starts on the caller buffer");
+			for (int i = 100; i < 100000; ++i)
+			{
+				values.push_back(i);
+			}
+			for (int i = 0; i < 100000; ++i)
+			{
+				check(values[static_cast<size_t>(i)] == i, "arena vector keeps its elements");
+			}
+
+			woj::small_vector<double, 4, woj::resource_allocator<counting_arena>> doubles{ arena };
+			for (int i = 0; i < 1000; ++i)
+			{
+				doubles.push_back(i);
+			}
+			check(doubles[999] == 999, "arena small_vector keeps its elements");
+			values.clear();
+			arena.reset();
+		}
+		arena.release();
+		check(counting_allocator::live == 0, "arena returns every upstream block");
+
+		woj::monotonic_arena aligned{ 1 << 20 };
+		check(reinterpret_cast<uintptr_t>(aligned.allocate(10, 256)) % 256 == 0, "arena honours alignment");
+		void* const big = aligned.allocate(1 << 22, 4096);
+		check(reinterpret_cast<uintptr_t>(big) % 4096 == 0, "arena honours alignment of big blocks");
+		std::memset(big, 1, 1 << 22);
+	}
+
+	void stress_pool()
+	{
+		{
+			woj::block_pool<24, 8, counting_allocator> pool;
+			std::vector<void*> blocks;
+			std::mt19937 rng{ 1 };
+			for (int i = 0; i < 100000; ++i)
+			{
+				if (blocks.empty() || rng() % 3 != 0)
+				{
+					void* const block = pool.allocate(24, 8);
+					std::memset(block, 0xAB, 24);
+					blocks.push_back(block);
+				}
+				else
+				{
+					const size_t index = rng() % blocks.size();
+					pool.deallocate(blocks[index], 24, 8);
+					blocks[index] = blocks.back();
+					blocks.pop_back();
+				}
+			}
+			std::sort(blocks.begin(), blocks.end());
+			check(std::adjacent_find(blocks.begin(), blocks.end()) == blocks.end(), "pool blocks do not overlap");
+			pool.deallocate(pool.allocate(100, 8), 100, 8);
+		}
+		check(counting_allocator::live == 0, "pool returns every upstream chunk");
+	}
+
+	/**
+	 * Frees and allocates from a thread_local destructor that runs after the thread cache is destroyed
+	 */
+	class late_user
+	{
+	public:
+		std::vector<void*> m_blocks;
+
+		~late_user()
+		{
+			for (void* const block : m_blocks)
+			{
+				woj::thread_cached_allocator::deallocate(block, 64, 8);
+			}
+			for (int i = 0; i < 100; ++i)
+			{
+				woj::thread_cached_allocator::deallocate(woj::thread_cached_allocator::allocate(32, 8), 32, 8);
+			}
+		}
+	};
+
+	thread_local late_user t_late_user;
+
+	void stress_thread_cache()
+	{
+		std::vector<std::thread> threads;
+		std::vector<std::vector<void*>> handoff(thread_count);
+		for (unsigned t = 0; t < thread_count; ++t)
+		{
+			threads.emplace_back([t, &handoff]
+			{
+				// Constructed before the thread cache, so destroyed after it
+				t_late_user.m_blocks.reserve(100);
+
+				std::mt19937 rng{ t };
+				std::vector<std::pair<void*, size_t>> mine;
+				for (int i = 0; i < 200000; ++i)
+				{
+					if (mine.empty() || rng() % 2 != 0)
+					{
+						const size_t size = 1 + rng() % 2000;
+						void* const block = woj::thread_cached_allocator::allocate(size, 8);
+						std::memset(block, static_cast<int>(t), size);
+						mine.emplace_back(block, size);
+					}
+					else
+					{
+						const size_t index = rng() % mine.size();
+						woj::thread_cached_allocator::deallocate(mine[index].first, mine[index].second, 8);
+						mine[index] = mine.back();
+						mine.pop_back();
+					}
+				}
+
+				for (int i = 0; i < 100; ++i)
+				{
+					handoff[t].push_back(woj::thread_cached_allocator::allocate(64, 64));
+					t_late_user.m_blocks.push_back(woj::thread_cached_allocator::allocate(64, 8));
+				}
+				for (const auto& [block, size] : mine)
+				{
+					woj::thread_cached_allocator::deallocate(block, size, 8);
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		// Blocks freed by another thread than the one that allocated them
+		for (const std::vector<void*>& blocks : handoff)
+		{
+			for (void* const block : blocks)
+			{
+				check(reinterpret_cast<uintptr_t>(block) % 64 == 0, "thread cache honours alignment");
+				woj::thread_cached_allocator::deallocate(block, 64, 64);
+			}
+		}
+	}
+
+	template <typename Vector, typename... Args>
+	long build_request(const int request, Args&... args)
+	{
+		std::vector<Vector> objects;
+		objects.reserve(objects_per_request);
+		long sum = 0;
+		for (int i = 0; i < objects_per_request; ++i)
+		{
+			Vector& object = objects.emplace_back(args...);
+			for (int k = 0; k < 8 + (i & 7); ++k)
+			{
+				object.push_back(k + request);
+			}
+			sum += object.back();
+		}
+		return sum;
+	}
+
+	template <typename Request>
+	void time_requests(const char* const name, const Request& request)
+	{
+		const auto begin = std::chrono::steady_clock::now();
+		long sum = 0;
+		for (int i = 0; i < request_count; ++i)
+		{
+			sum += request(i);
+		}
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+		std::printf("%-18s %12.1f %14ld\n", name, elapsed.count(), sum);
+	}
+}
+
+int main()
+{
+	stress_arena();
+	stress_pool();
+	stress_thread_cache();
+
+	woj::stack::vector<std::byte, 65536> storage{ woj::noinit };
+	woj::monotonic_arena arena{ storage };
+
+	std::printf("%-18s %12s %14s\n", "allocator", "total [ms]", "checksum");
+	time_requests("default_allocator", [](const int request) { return build_request<woj::vector<int>>(request); });
+	time_requests("monotonic_arena", [&arena](const int request)
+	{
+		const long sum = build_request<woj::vector<int, woj::arena_allocator>>(request, arena);
+		arena.reset();
+		return sum;
+	});
+	time_requests("thread_cache", [](const int request) { return build_request<woj::vector<int, woj::thread_cached_allocator>>(request); });
+	return 0;
+}
@@ -0,0 +1,193 @@
+// Benchmark and stress test for woj::dary_heap: random operations on the plain and addressable heaps are checked
+// against std::priority_queue and a std::map of the live handles, then 4M random uint32 keys are pushed and popped
+// with std::priority_queue and with d-ary heaps of arity 2, 4 and 8
+// Build from the repository root, for example: g++ -std=c++20 -O2 -I. benchmarks/dary_heap.cpp
+// Sanitizer run: g++ -std=c++20 -O1 -g -fsanitize=address,undefined -I. benchmarks/dary_heap.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <queue>
+#include <random>
+#include <vector>
+#include "include/woj/dary_heap.hpp"
+
+namespace
+{
+	constexpr size_t operation_count = 100000;
+	constexpr size_t key_count = 1 << 22;
+
+	void check(const bool condition, const char* const what)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "check failed: %s\n", what);
+			std::exit(1);
+		}
+	}
+
+	template <size_t Arity>
+	void stress_plain(const unsigned seed)
+	{
+		std::mt19937 rng{ seed };
+		woj::dary_heap<int, Arity> heap;
+		std::priority_queue<int> reference;
+		for (size_t i = 0; i < operation_count; ++i)
+		{
+			const unsigned operation = rng() % 5;
+			if (operation < 3 || reference.empty())
+			{
+				const int value = static_cast<int>(rng() % 1000);
+				heap.push(value);
+				reference.push(value);
+			}
+			else if (operation == 3)
+			{
+				heap.pop();
+				reference.pop();
+			}
+			else
+			{
+				const int value = static_cast<int>(rng() % 1000);
+				heap.replace_top(value);
+				reference.pop();
+				reference.push(value);
+			}
+			check(heap.size() == reference.size() && (reference.empty() || heap.top() == reference.top()), "heap matches std::priority_queue");
+
+			if (i % 10000 == 0)
+			{
+				std::vector<int> batch(50);
+				for (int& value : batch)
+				{
+					value = static_cast<int>(rng() % 1000);
+					reference.push(value);
+				}
+				heap.push(batch.begin(), batch.end());
+			}
+		}
+
+		check(woj::is_dary_heap<Arity>(heap.elements().begin(), heap.elements().end()), "heap property holds");
+		const auto sorted = heap.extract_sorted();
+		check(heap.empty(), "extract_sorted empties the heap");
+		for (size_t i = 0; i < sorted.size(); ++i)
+		{
+			check(sorted[i] == reference.top(), "extract_sorted order");
+			reference.pop();
+		}
+	}
+
+	template <typename Heap>
+	void stress_addressable(const unsigned seed, const size_t capacity)
+	{
+		std::mt19937 rng{ seed };
+		Heap heap;
+		std::map<size_t, int> live;
+		for (size_t i = 0; i < operation_count; ++i)
+		{
+			const unsigned operation = rng() % 6;
+			if ((operation < 2 || live.empty()) && live.size() < capacity)
+			{
+				const int value = static_cast<int>(rng() % 10000);
+				const woj::heap_handle handle = heap.push(value);
+				check(live.count(handle.m_index) == 0, "push returns a fresh handle");
+				live[handle.m_index] = value;
+			}
+			else if (live.empty())
+			{
+				continue;
+			}
+			else if (operation == 2)
+			{
+				const woj::heap_handle handle = heap.top_handle();
+				int best = live.begin()->second;
+				for (const auto& [index, value] : live)
+				{
+					best = (std::max)(best, value);
+				}
+				check(heap.top() == best && live[handle.m_index] == best, "top is the greatest live element");
+				heap.pop();
+				live.erase(handle.m_index);
+				check(!heap.contains(handle), "popped handle is stale");
+			}
+			else
+			{
+				auto entry = live.begin();
+				std::advance(entry, rng() % live.size());
+				const woj::heap_handle handle{ entry->first };
+				check(heap.contains(handle) && heap[handle] == entry->second, "handle refers to its element");
+				if (operation == 3)
+				{
+					heap.erase(handle);
+					live.erase(entry);
+				}
+				else if (operation == 4)
+				{
+					const int value = entry->second + static_cast<int>(rng() % 100);
+					heap.decrease_key(handle, value);
+					entry->second = value;
+				}
+				else
+				{
+					const int value = static_cast<int>(rng() % 10000);
+					heap.update(handle, value);
+					entry->second = value;
+				}
+			}
+			check(heap.size() == live.size(), "addressable heap size");
+		}
+	}
+
+	double milliseconds(const std::chrono::steady_clock::time_point begin, const std::chrono::steady_clock::time_point end)
+	{
+		return std::chrono::duration<double, std::milli>(end - begin).count();
+	}
+
+	template <typename Heap>
+	void time_heap(const char* const name, Heap heap, const std::vector<uint32_t>& keys)
+	{
+		const auto begin = std::chrono::steady_clock::now();
+		for (const uint32_t key : keys)
+		{
+			heap.push(key);
+		}
+		const auto pushed = std::chrono::steady_clock::now();
+		uint64_t checksum = 0;
+		while (!heap.empty())
+		{
+			checksum += heap.top();
+			heap.pop();
+		}
+		const auto popped = std::chrono::steady_clock::now();
+		std::printf("%-22s %10.1f %10.1f %22llu\n", name, milliseconds(begin, pushed), milliseconds(pushed, popped), static_cast<unsigned long long>(checksum));
+	}
+}
+
+int main()
+{
+	stress_plain<2>(1);
+	stress_plain<3>(2);
+	stress_plain<4>(3);
+	stress_plain<8>(4);
+	stress_addressable<woj::addressable_dary_heap<int>>(5, ~size_t{ 0 });
+	stress_addressable<woj::addressable_dary_heap<int, 3>>(6, ~size_t{ 0 });
+	stress_addressable<woj::stack::addressable_dary_heap<int, 64>>(7, 64);
+
+	std::mt19937 rng{ 9 };
+	std::vector<uint32_t> keys(key_count);
+	for (uint32_t& key : keys)
+	{
+		key = static_cast<uint32_t>(rng());
+	}
+
+	std::printf("%-22s %10s %10s %22s\n", "heap", "push [ms]", "pop [ms]", "checksum");
+	time_heap("std::priority_queue", std::priority_queue<uint32_t>{}, keys);
+	time_heap("woj::dary_heap<2>", woj::dary_heap<uint32_t, 2>{}, keys);
+	time_heap("woj::dary_heap<4>", woj::dary_heap<uint32_t, 4>{}, keys);
+	time_heap("woj::dary_heap<8>", woj::dary_heap<uint32_t, 8>{}, keys);
+	return 0;
+}
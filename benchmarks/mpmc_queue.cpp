@@ -0,0 +1,119 @@
+// Contention benchmark for woj::stack::mpmc_queue: every combination of producer and consumer thread counts
+// (powers of two up to the hardware concurrency) moves the same number of items through the queue,
+// once with the spinning try_push/try_pop and once with the blocking push/pop
+// Build from the repository root, for example: g++ -std=c++20 -O2 -pthread -I. benchmarks/mpmc_queue.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "include/woj/mpmc_queue.hpp"
+
+namespace
+{
+	constexpr uint64_t item_count = 1 << 22;
+
+	using queue_type = woj::stack::mpmc_queue<uint64_t, 1024>;
+
+	template <bool Blocking>
+	double run(const unsigned producers, const unsigned consumers)
+	{
+		const std::unique_ptr<queue_type> queue = std::make_unique<queue_type>();
+		std::atomic<bool> start{ false };
+		std::atomic<uint64_t> checksum{ 0 };
+		std::vector<std::thread> threads;
+
+		for (unsigned p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&, p]
+			{
+				while (!start.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+
+				for (uint64_t i = p; i < item_count; i += producers)
+				{
+					if constexpr (Blocking)
+					{
+						queue->push(i);
+					}
+					else
+					{
+						while (!queue->try_push(i))
+						{
+							std::this_thread::yield();
+						}
+					}
+				}
+			});
+		}
+
+		for (unsigned c = 0; c < consumers; ++c)
+		{
+			threads.emplace_back([&, c]
+			{
+				while (!start.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+
+				uint64_t sum = 0;
+				for (uint64_t i = c; i < item_count; i += consumers)
+				{
+					uint64_t value;
+					if constexpr (Blocking)
+					{
+						queue->pop(value);
+					}
+					else
+					{
+						while (!queue->try_pop(value))
+						{
+							std::this_thread::yield();
+						}
+					}
+					sum += value;
+				}
+				checksum.fetch_add(sum, std::memory_order_relaxed);
+			});
+		}
+
+		const auto begin = std::chrono::steady_clock::now();
+		start.store(true, std::memory_order_release);
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+		if (checksum.load() != item_count * (item_count - 1) / 2)
+		{
+			std::fprintf(stderr, "checksum mismatch with %u producers and %u consumers\n", producers, consumers);
+			std::exit(1);
+		}
+		return static_cast<double>(item_count) / elapsed.count() / 1e6;
+	}
+}
+
+int main()
+{
+	const unsigned threads = (std::max)(2u, std::thread::hardware_concurrency());
+
+	std::printf("%9s %9s %14s %14s\n", "producers", "consumers", "try [Mops/s]", "block [Mops/s]");
+	for (unsigned producers = 1; producers < threads; producers *= 2)
+	{
+		for (unsigned consumers = 1; producers + consumers <= threads; consumers *= 2)
+		{
+			const double spinning = run<false>(producers, consumers);
+			const double blocking = run<true>(producers, consumers);
+			std::printf("%9u %9u %14.2f %14.2f\n", producers, consumers, spinning, blocking);
+		}
+	}
+	return 0;
+}
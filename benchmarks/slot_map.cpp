@@ -0,0 +1,156 @@
+// Benchmark and stress test for woj::slot_map: random inserts, erases and updates are checked against a std::map of
+// the live handles (stale handles must stay rejected, erasing while iterating must visit every element once), then
+// summing 4M floats through a slot map is timed against the same loop over a std::vector (twice, the first round
+// warms the caches)
+// Build from the repository root, for example: g++ -std=c++20 -O2 -I. benchmarks/slot_map.cpp
+// Sanitizer run: g++ -std=c++20 -O1 -g -fsanitize=address,undefined -I. benchmarks/slot_map.cpp
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "include/woj/slot_map.hpp"
+
+namespace
+{
+	constexpr size_t operation_count = 200000;
+	constexpr size_t element_count = 1 << 22;
+	constexpr int pass_count = 20;
+
+	void check(const bool condition, const char* const what)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "check failed: %s\n", what);
+			std::exit(1);
+		}
+	}
+
+	template <typename Map>
+	void stress(const unsigned seed, const size_t capacity)
+	{
+		std::mt19937 rng{ seed };
+		Map map;
+		std::map<std::pair<uint32_t, uint32_t>, int> live;
+		std::vector<woj::slot_handle> stale;
+		for (size_t i = 0; i < operation_count; ++i)
+		{
+			const unsigned operation = rng() % 4;
+			if ((operation < 2 || live.empty()) && live.size() < capacity)
+			{
+				const int value = static_cast<int>(rng());
+				const woj::slot_handle handle = map.insert(value);
+				check(live.count({ handle.m_index, handle.m_generation }) == 0, "insert returns a fresh handle");
+				live[{ handle.m_index, handle.m_generation }] = value;
+			}
+			else if (!live.empty())
+			{
+				auto entry = live.begin();
+				std::advance(entry, rng() % live.size());
+				const woj::slot_handle handle{ entry->first.first, entry->first.second };
+				check(map.contains(handle) && map[handle] == entry->second && *map.get(handle) == entry->second, "handle refers to its element");
+				if (operation == 2)
+				{
+					check(map.erase(handle), "erase of a live handle");
+					check(!map.erase(handle), "erase of a stale handle");
+					stale.push_back(handle);
+					live.erase(entry);
+				}
+				else
+				{
+					map[handle] = ++entry->second;
+				}
+			}
+			check(map.size() == live.size(), "slot map size");
+
+			if (i % 1000 == 0)
+			{
+				for (const woj::slot_handle handle : stale)
+				{
+					check(!map.contains(handle) && map.get(handle) == nullptr, "stale handle is rejected");
+				}
+				for (auto element = map.begin(); element != map.end(); ++element)
+				{
+					const woj::slot_handle handle = map.handle_of(element);
+					check(live.at({ handle.m_index, handle.m_generation }) == *element, "handle_of matches the element");
+				}
+			}
+		}
+
+		for (auto element = map.begin(); element != map.end();)
+		{
+			if ((*element & 1) != 0)
+			{
+				const woj::slot_handle handle = map.handle_of(element);
+				live.erase({ handle.m_index, handle.m_generation });
+				element = map.erase(element);
+			}
+			else
+			{
+				++element;
+			}
+		}
+		check(map.size() == live.size(), "erasing while iterating visits every element");
+		for (const auto& [handle, value] : live)
+		{
+			check(map[woj::slot_handle{ handle.first, handle.second }] == value, "survivors keep their values");
+		}
+
+		map.clear();
+		for (const auto& [handle, value] : live)
+		{
+			check(!map.contains(woj::slot_handle{ handle.first, handle.second }), "clear invalidates every handle");
+		}
+		check(!map.contains(woj::slot_handle{}), "default handle is rejected");
+	}
+
+	double milliseconds(const std::chrono::steady_clock::time_point begin, const std::chrono::steady_clock::time_point end)
+	{
+		return std::chrono::duration<double, std::milli>(end - begin).count();
+	}
+
+	template <typename Container>
+	void time_sum(const char* const name, const Container& container)
+	{
+		const auto begin = std::chrono::steady_clock::now();
+		float sum = 0.0f;
+		for (int pass = 0; pass < pass_count; ++pass)
+		{
+			for (const float value : container)
+			{
+				sum += value;
+			}
+		}
+		const auto end = std::chrono::steady_clock::now();
+		std::printf("%-14s %10.1f %14g\n", name, milliseconds(begin, end), static_cast<double>(sum));
+	}
+}
+
+int main()
+{
+	stress<woj::slot_map<int>>(1, ~size_t{ 0 });
+	stress<woj::stack::slot_map<int, 64>>(2, 64);
+
+	std::mt19937 rng{ 3 };
+	woj::slot_map<float> map;
+	std::vector<float> vector;
+	for (size_t i = 0; i < element_count; ++i)
+	{
+		const float value = static_cast<float>(rng() % 100);
+		map.insert(value);
+		vector.push_back(value);
+	}
+
+	std::printf("%-14s %10s %14s\n", "container", "sum [ms]", "sum");
+	for (int round = 0; round < 2; ++round)
+	{
+		time_sum("std::vector", vector);
+		time_sum("woj::slot_map", map);
+	}
+	return 0;
+}
@@ -0,0 +1,137 @@
+// Benchmark and stress test for woj::thread_pool: nested task groups, outside threads sharing a pool without workers
+// and exceptions thrown by tasks are checked, then the CPU time used while a thread waits in sync for a task
+// sleeping 500 ms is measured (the process CPU time, so it includes the idle workers) for several pool sizes
+// Build from the repository root, for example: g++ -std=c++20 -O2 -pthread -I. benchmarks/thread_pool.cpp
+// Sanitizer runs: g++ -std=c++20 -O1 -g -pthread -fsanitize=address,undefined -I. benchmarks/thread_pool.cpp
+// and the same with -fsanitize=thread
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "include/woj/thread_pool.hpp"
+
+namespace
+{
+	constexpr int round_count = 2000;
+	constexpr int sleep_milliseconds = 500;
+
+	void check(const bool condition, const char* const what)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "check failed: %s\n", what);
+			std::exit(1);
+		}
+	}
+
+	void stress_nested(woj::thread_pool& pool)
+	{
+		for (int round = 0; round < round_count; ++round)
+		{
+			std::atomic<int> count{ 0 };
+			woj::task_group group;
+			for (int i = 0; i < 8; ++i)
+			{
+				pool.spawn(group, [&pool, &count]
+				{
+					woj::task_group inner;
+					for (int k = 0; k < 4; ++k)
+					{
+						pool.spawn(inner, [&count, k]
+						{
+							count.fetch_add(1, std::memory_order_relaxed);
+							if (k == 0)
+							{
+								std::this_thread::yield();
+							}
+						});
+					}
+					pool.sync(inner);
+				});
+			}
+			pool.sync(group);
+			check(count.load() == 32, "sync waits for nested groups");
+		}
+	}
+
+	void stress_outside_threads()
+	{
+		// No workers: the tasks only run on the threads waiting in sync
+		woj::thread_pool pool{ 1 };
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([&pool]
+			{
+				for (int round = 0; round < round_count / 4; ++round)
+				{
+					std::atomic<int> count{ 0 };
+					woj::task_group group;
+					for (int i = 0; i < 16; ++i)
+					{
+						pool.spawn(group, [&count] { count.fetch_add(1, std::memory_order_relaxed); });
+					}
+					pool.sync(group);
+					check(count.load() == 16, "outside threads run their groups");
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	void check_exception(woj::thread_pool& pool)
+	{
+		woj::task_group group;
+		pool.spawn(group, [] { std::this_thread::sleep_for(std::chrono::milliseconds(50)); throw 5; });
+		bool caught = false;
+		try
+		{
+			pool.sync(group);
+		}
+		catch (const int value)
+		{
+			caught = value == 5;
+		}
+		check(caught, "sync rethrows the exception of a task");
+	}
+
+	void time_sync(const size_t thread_count)
+	{
+		woj::thread_pool pool{ thread_count };
+		woj::task_group group;
+		pool.spawn(group, [] { std::this_thread::sleep_for(std::chrono::milliseconds(sleep_milliseconds)); });
+		const std::clock_t cpu_begin = std::clock();
+		const auto begin = std::chrono::steady_clock::now();
+		pool.sync(group);
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+		const double cpu = static_cast<double>(std::clock() - cpu_begin) * 1000.0 / CLOCKS_PER_SEC;
+		check(elapsed.count() >= sleep_milliseconds - 1, "sync waits for the sleeping task");
+		std::printf("%8zu %10.1f %10.1f\n", thread_count, elapsed.count(), cpu);
+	}
+}
+
+int main()
+{
+	const size_t hardware = (std::max)(2u, std::thread::hardware_concurrency());
+	{
+		woj::thread_pool pool{ (std::min)(hardware, size_t{ 8 }) };
+		stress_nested(pool);
+		check_exception(pool);
+	}
+	stress_outside_threads();
+
+	std::printf("%8s %10s %10s\n", "threads", "wall [ms]", "cpu [ms]");
+	for (const size_t thread_count : { size_t{ 2 }, size_t{ 4 }, hardware })
+	{
+		time_sync(thread_count);
+	}
+	return 0;
+}
@@ -0,0 +1,599 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+#ifndef WOJ_ALLOCATORS_HPP
+#define WOJ_ALLOCATORS_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Allocator referring to a memory resource owned elsewhere (an arena, a pool...), it is what growable containers
+	 * store, so they can share a resource that is neither copyable nor movable; the resource must outlive them
+	 * @tparam Resource Type providing allocate(size, alignment) and deallocate(ptr, size, alignment), and optionally reallocate
+	 */
+	template <allocator_type Resource>
+	class resource_allocator
+	{
+	public:
+		Resource* m_resource;
+
+		constexpr resource_allocator(Resource& resource) noexcept : m_resource{ &resource } {}
+
+		WOJ_NODISCARD void* allocate(const size_t size, const size_t alignment) const
+		{
+			return m_resource->allocate(size, alignment);
+		}
+
+		void deallocate(void* const ptr, const size_t size, const size_t alignment) const noexcept
+		{
+			m_resource->deallocate(ptr, size, alignment);
+		}
+
+		WOJ_NODISCARD void* reallocate(void* const ptr, const size_t old_size, const size_t new_size, const size_t alignment) const requires reallocating_allocator_type<Resource>
+		{
+			return m_resource->reallocate(ptr, old_size, new_size, alignment);
+		}
+
+		WOJ_NODISCARD Resource& resource() const noexcept
+		{
+			return *m_resource;
+		}
+
+		constexpr bool operator==(const resource_allocator&) const noexcept = default;
+	};
+
+	namespace detail
+	{
+		/**
+		 * Header of a block taken from the upstream allocator, the usable bytes follow it
+		 */
+		class alignas(std::max_align_t) arena_block
+		{
+		public:
+			arena_block* m_previous;
+			size_t m_size;
+		};
+
+		WOJ_NODISCARD inline uintptr_t align_up(const uintptr_t address, const size_t alignment) noexcept
+		{
+			return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+		}
+	}
+
+	/**
+	 * Class representing a monotonic (bump pointer) arena: allocations only move a pointer forward and individual
+	 * deallocations are ignored (except for the most recent allocation, which is rolled back), everything is freed at
+	 * once by reset(). The arena can start on a caller buffer (for example the storage of a stack::vector) and falls
+	 * back to blocks from the upstream allocator, each twice as big as the previous one. It is not thread-safe and
+	 * neither copyable nor movable, containers use it through resource_allocator (see arena_allocator)
+	 * @tparam Upstream Allocator providing the blocks once the initial buffer is exhausted
+	 */
+	template <allocator_type Upstream = default_allocator>
+	class basic_monotonic_arena
+	{
+	public:
+		static constexpr size_t default_block_size = 4096;
+		static constexpr size_t max_block_size = size_t{ 1 } << 26;
+
+		std::byte* m_current;
+		std::byte* m_end;
+		std::byte* m_buffer;
+		size_t m_buffer_size;
+		detail::arena_block* m_blocks;
+		detail::arena_block* m_spare;
+		size_t m_next_block_size;
+		WOJ_NO_UNIQUE_ADDRESS Upstream m_upstream;
+
+		/**
+		 * Constructs an arena taking all its memory from the upstream allocator
+		 * @param block_size Size of the first upstream block
+		 */
+		explicit basic_monotonic_arena(const size_t block_size = default_block_size, const Upstream& upstream = Upstream{}) noexcept(std::is_nothrow_copy_constructible_v<Upstream>)
+			: m_current{ nullptr }, m_end{ nullptr }, m_buffer{ nullptr }, m_buffer_size{ 0 }, m_blocks{ nullptr }, m_spare{ nullptr }, m_next_block_size{ block_size }, m_upstream{ upstream } {}
+
+		/**
+		 * Constructs an arena starting on a caller buffer, which must outlive the arena
+		 * @param buffer Initial memory
+		 * @param size Size of the buffer in bytes
+		 */
+		basic_monotonic_arena(void* const buffer, const size_t size, const Upstream& upstream = Upstream{}) noexcept(std::is_nothrow_copy_constructible_v<Upstream>)
+			: m_current{ static_cast<std::byte*>(buffer) }, m_end{ static_cast<std::byte*>(buffer) + size }, m_buffer{ static_cast<std::byte*>(buffer) }, m_buffer_size{ size }, m_blocks{ nullptr }, m_spare{ nullptr },
+			  m_next_block_size{ (std::max)(default_block_size, size) }, m_upstream{ upstream } {}
+
+		/**
+		 * Constructs an arena starting on the storage of a stack vector (its elements are overwritten)
+		 * @param storage Vector whose storage becomes the initial buffer, for example stack::vector<std::byte, 4096>{ noinit }
+		 */
+		template <typename ElementType, size_t Size> requires std::is_trivially_copyable_v<ElementType>
+		explicit basic_monotonic_arena(stack::vector<ElementType, Size>& storage, const Upstream& upstream = Upstream{}) noexcept(std::is_nothrow_copy_constructible_v<Upstream>)
+			: basic_monotonic_arena{ static_cast<void*>(storage.data()), sizeof(ElementType) * Size, upstream } {}
+
+		basic_monotonic_arena(const basic_monotonic_arena&) = delete;
+		basic_monotonic_arena(basic_monotonic_arena&&) = delete;
+
+		~basic_monotonic_arena() noexcept
+		{
+			release();
+		}
+
+		basic_monotonic_arena& operator=(const basic_monotonic_arena&) = delete;
+		basic_monotonic_arena& operator=(basic_monotonic_arena&&) = delete;
+
+		/**
+		 * @param size Count of bytes
+		 * @param alignment Alignment, a power of 2
+		 * @return Storage for size bytes
+		 * @throws bad_allocation (or what the upstream allocator throws) if a new block cannot be allocated
+		 */
+		WOJ_NODISCARD void* allocate(const size_t size, const size_t alignment)
+		{
+			const uintptr_t aligned = detail::align_up(reinterpret_cast<uintptr_t>(m_current), alignment);
+			if (aligned + size <= reinterpret_cast<uintptr_t>(m_end)) WOJ_LIKELY
+			{
+				m_current = reinterpret_cast<std::byte*>(aligned + size);
+				return reinterpret_cast<void*>(aligned);
+			}
+			return allocate_block(size, alignment);
+		}
+
+		/**
+		 * Rolls back the most recent allocation, any other deallocation is a no-op
+		 */
+		void deallocate(void* const ptr, const size_t size, size_t) noexcept
+		{
+			if (static_cast<std::byte*>(ptr) + size == m_current)
+			{
+				m_current = static_cast<std::byte*>(ptr);
+			}
+		}
+
+		/**
+		 * Resizes the most recent allocation in place when it fits and shrinks any other one in place, otherwise copies
+		 * the bytes to a new allocation
+		 */
+		WOJ_NODISCARD void* reallocate(void* const ptr, const size_t old_size, const size_t new_size, const size_t alignment)
+		{
+			std::byte* const bytes = static_cast<std::byte*>(ptr);
+			if (bytes + old_size == m_current && new_size <= static_cast<size_t>(m_end - bytes))
+			{
+				m_current = bytes + new_size;
+				return ptr;
+			}
+			if (new_size <= old_size)
+			{
+				return ptr;
+			}
+
+			void* const new_ptr = allocate(new_size, alignment);
+			std::memcpy(new_ptr, ptr, (std::min)(old_size, new_size));
+			return new_ptr;
+		}
+
+		/**
+		 * Frees everything allocated from the arena at once, the initial buffer is reused and the biggest upstream block
+		 * is kept for the next allocations
+		 */
+		void reset() noexcept
+		{
+			detail::arena_block* biggest = m_spare;
+			for (detail::arena_block* block = m_blocks; block != nullptr;)
+			{
+				detail::arena_block* const previous = block->m_previous;
+				if (biggest == nullptr || block->m_size > biggest->m_size)
+				{
+					if (biggest != nullptr)
+					{
+						m_upstream.deallocate(biggest, biggest->m_size, alignof(detail::arena_block));
+					}
+					biggest = block;
+				}
+				else
+				{
+					m_upstream.deallocate(block, block->m_size, alignof(detail::arena_block));
+				}
+				block = previous;
+			}
+
+			m_blocks = nullptr;
+			m_spare = nullptr;
+			if (m_buffer != nullptr || biggest == nullptr)
+			{
+				m_spare = biggest;
+				m_current = m_buffer;
+				m_end = m_buffer + m_buffer_size;
+			}
+			else
+			{
+				use_block(biggest);
+			}
+		}
+
+		/**
+		 * Frees everything allocated from the arena and returns all upstream blocks
+		 */
+		void release() noexcept
+		{
+			reset();
+			if (m_spare != nullptr)
+			{
+				m_upstream.deallocate(m_spare, m_spare->m_size, alignof(detail::arena_block));
+				m_spare = nullptr;
+			}
+			else if (m_blocks != nullptr)
+			{
+				m_upstream.deallocate(m_blocks, m_blocks->m_size, alignof(detail::arena_block));
+				m_blocks = nullptr;
+			}
+			m_current = m_buffer;
+			m_end = m_buffer + m_buffer_size;
+		}
+
+		/**
+		 * @return Count of bytes left in the current buffer or block
+		 */
+		WOJ_NODISCARD size_t remaining() const noexcept
+		{
+			return static_cast<size_t>(m_end - m_current);
+		}
+
+	private:
+		void use_block(detail::arena_block* const block) noexcept
+		{
+			block->m_previous = m_blocks;
+			m_blocks = block;
+			m_current = reinterpret_cast<std::byte*>(block + 1);
+			m_end = reinterpret_cast<std::byte*>(block) + block->m_size;
+		}
+
+		WOJ_NODISCARD void* allocate_block(const size_t size, const size_t alignment)
+		{
+			const size_t required = sizeof(detail::arena_block) + size + (alignment > alignof(detail::arena_block) ? alignment : 0);
+			if (m_spare != nullptr && m_spare->m_size >= required)
+			{
+				use_block(std::exchange(m_spare, nullptr));
+			}
+			else
+			{
+				const size_t block_size = (std::max)(m_next_block_size, std::bit_ceil(required));
+				detail::arena_block* const block = static_cast<detail::arena_block*>(m_upstream.allocate(block_size, alignof(detail::arena_block)));
+				block->m_size = block_size;
+				use_block(block);
+				m_next_block_size = (std::min)(block_size * 2, (std::max)(max_block_size, block_size));
+			}
+
+			const uintptr_t aligned = detail::align_up(reinterpret_cast<uintptr_t>(m_current), alignment);
+			m_current = reinterpret_cast<std::byte*>(aligned + size);
+			return reinterpret_cast<void*>(aligned);
+		}
+	};
+
+	using monotonic_arena = basic_monotonic_arena<>;
+
+	/**
+	 * Allocator for growable containers drawing from a monotonic_arena, e.g. woj::vector<int, arena_allocator> values{ arena }
+	 */
+	using arena_allocator = resource_allocator<monotonic_arena>;
+
+	namespace detail
+	{
+		class pool_free_block
+		{
+		public:
+			pool_free_block* m_next;
+		};
+	}
+
+	/**
+	 * Class representing a pool of fixed-size blocks: freed blocks go to a free list and are handed out again in
+	 * constant time, new blocks are carved from chunks of the upstream allocator (each twice as big as the previous
+	 * one). Requests bigger than BlockSize or more aligned than Alignment are forwarded upstream, so the pool can back
+	 * any container whose allocations are mostly small (node-based structures, small vectors). It is not thread-safe
+	 * and neither copyable nor movable, containers use it through resource_allocator
+	 * @tparam BlockSize Size of the blocks in bytes
+	 * @tparam Alignment Alignment of the blocks
+	 * @tparam Upstream Allocator providing the chunks and the oversized allocations
+	 */
+	template <size_t BlockSize, size_t Alignment = alignof(std::max_align_t), allocator_type Upstream = default_allocator>
+	class block_pool
+	{
+	public:
+		static_assert(std::has_single_bit(Alignment), "Alignment must be a power of 2");
+
+		static constexpr size_t block_size = ((std::max)(BlockSize, sizeof(detail::pool_free_block)) + Alignment - 1) / Alignment * Alignment;
+		static constexpr size_t first_chunk_blocks = 32;
+		static constexpr size_t max_chunk_blocks = 4096;
+
+		detail::pool_free_block* m_free;
+		detail::arena_block* m_chunks;
+		size_t m_next_chunk_blocks;
+		WOJ_NO_UNIQUE_ADDRESS Upstream m_upstream;
+
+		explicit block_pool(const Upstream& upstream = Upstream{}) noexcept(std::is_nothrow_copy_constructible_v<Upstream>) : m_free{ nullptr }, m_chunks{ nullptr }, m_next_chunk_blocks{ first_chunk_blocks }, m_upstream{ upstream } {}
+
+		block_pool(const block_pool&) = delete;
+		block_pool(block_pool&&) = delete;
+
+		~block_pool() noexcept
+		{
+			release();
+		}
+
+		block_pool& operator=(const block_pool&) = delete;
+		block_pool& operator=(block_pool&&) = delete;
+
+		WOJ_NODISCARD void* allocate(const size_t size, const size_t alignment)
+		{
+			if (size > block_size || alignment > Alignment) WOJ_UNLIKELY
+			{
+				return m_upstream.allocate(size, alignment);
+			}
+
+			if (m_free == nullptr) WOJ_UNLIKELY
+			{
+				add_chunk();
+			}
+			detail::pool_free_block* const block = m_free;
+			m_free = block->m_next;
+			return block;
+		}
+
+		void deallocate(void* const ptr, const size_t size, const size_t alignment) noexcept
+		{
+			if (size > block_size || alignment > Alignment) WOJ_UNLIKELY
+			{
+				m_upstream.deallocate(ptr, size, alignment);
+				return;
+			}
+
+			m_free = ::new (ptr) detail::pool_free_block{ m_free };
+		}
+
+		/**
+		 * Returns all chunks to the upstream allocator, every block handed out becomes invalid
+		 */
+		void release() noexcept
+		{
+			while (m_chunks != nullptr)
+			{
+				detail::arena_block* const previous = m_chunks->m_previous;
+				m_upstream.deallocate(m_chunks, m_chunks->m_size, chunk_alignment);
+				m_chunks = previous;
+			}
+			m_free = nullptr;
+			m_next_chunk_blocks = first_chunk_blocks;
+		}
+
+	private:
+		static constexpr size_t chunk_alignment = (std::max)(Alignment, alignof(detail::arena_block));
+		static constexpr size_t chunk_header_size = (sizeof(detail::arena_block) + Alignment - 1) / Alignment * Alignment;
+
+		void add_chunk()
+		{
+			const size_t count = m_next_chunk_blocks;
+			const size_t size = chunk_header_size + count * block_size;
+			detail::arena_block* const chunk = static_cast<detail::arena_block*>(m_upstream.allocate(size, chunk_alignment));
+			chunk->m_previous = m_chunks;
+			chunk->m_size = size;
+			m_chunks = chunk;
+			m_next_chunk_blocks = (std::min)(count * 2, max_chunk_blocks);
+
+			// Threaded back to front, so blocks are handed out in address order
+			std::byte* const blocks = reinterpret_cast<std::byte*>(chunk) + chunk_header_size;
+			for (size_t i = count; i-- > 0;)
+			{
+				m_free = ::new (blocks + i * block_size) detail::pool_free_block{ m_free };
+			}
+		}
+	};
+
+	/**
+	 * Allocator for growable containers drawing from a block_pool
+	 */
+	template <size_t BlockSize, size_t Alignment = alignof(std::max_align_t)>
+	using pool_allocator = resource_allocator<block_pool<BlockSize, Alignment>>;
+
+	namespace detail
+	{
+		inline constexpr size_t thread_cache_min_size = 16;
+		inline constexpr size_t thread_cache_max_size = 1024;
+		inline constexpr size_t thread_cache_class_count = std::countr_zero(thread_cache_max_size / thread_cache_min_size) + 1;
+		inline constexpr size_t thread_cache_batch = 32;
+		inline constexpr size_t thread_cache_chunk_size = size_t{ 1 } << 16;
+
+		WOJ_NODISCARD constexpr size_t thread_cache_class(const size_t size) noexcept
+		{
+			return static_cast<size_t>(std::countr_zero(std::bit_ceil((std::max)(size, thread_cache_min_size)) / thread_cache_min_size));
+		}
+
+		/**
+		 * Free blocks of one size class shared by all threads, refilled from chunks that are never given back
+		 */
+		class thread_cache_central
+		{
+		public:
+			std::mutex m_mutex;
+			pool_free_block* m_free = nullptr;
+
+			/**
+			 * Takes up to max_count blocks
+			 * @return Chain of blocks, the count is stored to count
+			 */
+			WOJ_NODISCARD pool_free_block* take(const size_t block_size, size_t& count, const size_t max_count = thread_cache_batch)
+			{
+				std::lock_guard lock{ m_mutex };
+				if (m_free == nullptr)
+				{
+					std::byte* const chunk = static_cast<std::byte*>(default_allocator::allocate(thread_cache_chunk_size, cache_line_size));
+					for (size_t offset = thread_cache_chunk_size; offset >= block_size; offset -= block_size)
+					{
+						m_free = ::new (chunk + offset - block_size) pool_free_block{ m_free };
+					}
+				}
+
+				pool_free_block* const first = m_free;
+				pool_free_block* last = first;
+				count = 1;
+				for (; count < max_count && last->m_next != nullptr; ++count)
+				{
+					last = last->m_next;
+				}
+				m_free = last->m_next;
+				last->m_next = nullptr;
+				return first;
+			}
+
+			void give(pool_free_block* const first, pool_free_block* const last) noexcept
+			{
+				std::lock_guard lock{ m_mutex };
+				last->m_next = m_free;
+				m_free = first;
+			}
+		};
+
+		/**
+		 * Central lists of every size class, intentionally leaked so that threads exiting during static destruction can
+		 * still return their blocks
+		 */
+		WOJ_NODISCARD inline thread_cache_central* thread_cache_centrals()
+		{
+			static thread_cache_central* const centrals = new thread_cache_central[thread_cache_class_count];
+			return centrals;
+		}
+
+		/**
+		 * Set once the thread's cache is destroyed, allocations made later by other thread_local destructors of the
+		 * thread go straight to the central lists (trivially destructible, so it stays readable until the thread ends)
+		 */
+		inline thread_local bool thread_cache_destroyed = false;
+
+		/**
+		 * Per-thread free lists, a thread allocates and frees without locking until a list runs empty or grows past two
+		 * batches; a block freed by another thread than the one that allocated it simply joins the freeing thread's list
+		 */
+		class thread_cache
+		{
+		public:
+			pool_free_block* m_free[thread_cache_class_count] = {};
+			size_t m_count[thread_cache_class_count] = {};
+
+			thread_cache() = default;
+			thread_cache(const thread_cache&) = delete;
+			thread_cache& operator=(const thread_cache&) = delete;
+
+			~thread_cache() noexcept
+			{
+				for (size_t size_class = 0; size_class < thread_cache_class_count; ++size_class)
+				{
+					if (m_free[size_class] != nullptr)
+					{
+						pool_free_block* last = m_free[size_class];
+						for (; last->m_next != nullptr; last = last->m_next);
+						thread_cache_centrals()[size_class].give(m_free[size_class], last);
+						m_free[size_class] = nullptr;
+						m_count[size_class] = 0;
+					}
+				}
+				thread_cache_destroyed = true;
+			}
+
+			WOJ_NODISCARD void* allocate(const size_t size_class)
+			{
+				if (m_free[size_class] == nullptr) WOJ_UNLIKELY
+				{
+					m_free[size_class] = thread_cache_centrals()[size_class].take(thread_cache_min_size << size_class, m_count[size_class]);
+				}
+
+				pool_free_block* const block = m_free[size_class];
+				m_free[size_class] = block->m_next;
+				--m_count[size_class];
+				return block;
+			}
+
+			void deallocate(void* const ptr, const size_t size_class) noexcept
+			{
+				m_free[size_class] = ::new (ptr) pool_free_block{ m_free[size_class] };
+				if (++m_count[size_class] > 2 * thread_cache_batch) WOJ_UNLIKELY
+				{
+					// The first batch goes back, the most recently freed (cache-hot) blocks stay
+					pool_free_block* first = m_free[size_class];
+					for (size_t i = 1; i < thread_cache_batch; ++i)
+					{
+						first = first->m_next;
+					}
+					pool_free_block* const last_kept = first;
+					first = first->m_next;
+					last_kept->m_next = nullptr;
+
+					pool_free_block* last = first;
+					for (; last->m_next != nullptr; last = last->m_next);
+					thread_cache_centrals()[size_class].give(first, last);
+					m_count[size_class] = thread_cache_batch;
+				}
+			}
+		};
+
+		WOJ_NODISCARD inline thread_cache& local_thread_cache()
+		{
+			thread_local thread_cache cache;
+			return cache;
+		}
+	}
+
+	/**
+	 * Stateless allocator with per-thread caches of small blocks (power of 2 size classes from 16 to 1024 bytes, aligned
+	 * to their size up to a cache line), most allocations and deallocations are a few instructions on a thread-local
+	 * list; bigger or more aligned requests go to default_allocator. Blocks may be freed by any thread, the memory of
+	 * the size classes is kept for the lifetime of the process; once a thread's cache is destroyed, the thread's
+	 * remaining requests lock the central lists
+	 */
+	class thread_cached_allocator
+	{
+	public:
+		WOJ_NODISCARD static void* allocate(const size_t size, const size_t alignment)
+		{
+			const size_t rounded = (std::max)(size, alignment);
+			if (rounded > detail::thread_cache_max_size || alignment > cache_line_size) WOJ_UNLIKELY
+			{
+				return default_allocator::allocate(size, alignment);
+			}
+			const size_t size_class = detail::thread_cache_class(rounded);
+			if (detail::thread_cache_destroyed) WOJ_UNLIKELY
+			{
+				size_t count;
+				return detail::thread_cache_centrals()[size_class].take(detail::thread_cache_min_size << size_class, count, 1);
+			}
+			return detail::local_thread_cache().allocate(size_class);
+		}
+
+		static void deallocate(void* const ptr, const size_t size, const size_t alignment) noexcept
+		{
+			const size_t rounded = (std::max)(size, alignment);
+			if (rounded > detail::thread_cache_max_size || alignment > cache_line_size) WOJ_UNLIKELY
+			{
+				default_allocator::deallocate(ptr, size, alignment);
+				return;
+			}
+			const size_t size_class = detail::thread_cache_class(rounded);
+			if (detail::thread_cache_destroyed) WOJ_UNLIKELY
+			{
+				detail::pool_free_block* const block = ::new (ptr) detail::pool_free_block{ nullptr };
+				detail::thread_cache_centrals()[size_class].give(block, block);
+				return;
+			}
+			detail::local_thread_cache().deallocate(ptr, size_class);
+		}
+
+		constexpr bool operator==(const thread_cached_allocator&) const noexcept = default;
+	};
+}
@@ -24,6 +24,14 @@
 #define WOJ_HAS_CXX23 1
 #endif
 
+#if WOJ_CPP_VERSION >= 202002L
+#define WOJ_HAS_CXX20 1
+#endif
+
+#if WOJ_CPP_VERSION >= 201703L
+#define WOJ_HAS_CXX17 1
+#endif
+
 
 #if 1 || WOJ_HAS_CXX23
 #define WOJ_CONSTEXPR23 constexpr
@@ -31,6 +39,20 @@
 #define WOJ_CONSTEXPR23 inline
 #endif
 
+#if WOJ_HAS_CXX20
+#define WOJ_CONSTEXPR20 constexpr
+#else
+#define WOJ_CONSTEXPR20 inline
+#endif
+
+#if defined(__cpp_consteval) && __cpp_consteval >= 201811L
+#define WOJ_CONSTEVAL consteval
+#define WOJ_CONSTEVAL20 consteval
+#else
+#define WOJ_CONSTEVAL constexpr
+#define WOJ_CONSTEVAL20 constexpr
+#endif
+
 
 #if __has_cpp_attribute(likely) >= 201803L
 #define WOJ_LIKELY [[likely]]
@@ -118,6 +140,21 @@
 #define WOJ_ALWAYS_INLINE inline
 #endif
 
+#ifdef _MSC_VER
+#define WOJ_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define WOJ_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+#if defined(__clang__) || defined(__GNUC__)
+#define WOJ_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define WOJ_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define WOJ_PREFETCH(address) void(0)
+#endif
+
 #define WOJ_ASSERT_ASSUME(...) assert(__VA_ARGS__); WOJ_ASSUME(__VA_ARGS__);
 
 #include <cstring>
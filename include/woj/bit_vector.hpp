@@ -0,0 +1,926 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#ifndef WOJ_BIT_VECTOR_HPP
+#define WOJ_BIT_VECTOR_HPP
+#endif
+
+namespace woj
+{
+	namespace detail
+	{
+		using bit_word = uint64_t;
+
+		inline constexpr size_t bits_per_word = 64;
+
+		WOJ_NODISCARD constexpr size_t bit_word_count(const size_t bits) noexcept
+		{
+			return (bits + bits_per_word - 1) / bits_per_word;
+		}
+
+		/**
+		 * Mask of the bits of the last word that belong to a vector of the given size
+		 */
+		WOJ_NODISCARD constexpr bit_word bit_tail_mask(const size_t bits) noexcept
+		{
+			const size_t used = bits % bits_per_word;
+			return used == 0 ? ~bit_word{ 0 } : (bit_word{ 1 } << used) - 1;
+		}
+
+		enum class bit_operation : uint8_t
+		{
+			bitwise_and,
+			bitwise_or,
+			bitwise_xor,
+			bitwise_and_not
+		};
+
+		template <bit_operation Operation>
+		WOJ_NODISCARD constexpr bit_word apply_bit_operation(const bit_word left, const bit_word right) noexcept
+		{
+			if constexpr (Operation == bit_operation::bitwise_and)
+			{
+				return left & right;
+			}
+			else if constexpr (Operation == bit_operation::bitwise_or)
+			{
+				return left | right;
+			}
+			else if constexpr (Operation == bit_operation::bitwise_xor)
+			{
+				return left ^ right;
+			}
+			else
+			{
+				return left & ~right;
+			}
+		}
+
+		/**
+		 * Combines count words of source into destination with the widest enabled registers
+		 */
+		template <bit_operation Operation>
+		constexpr void apply_bit_operation(bit_word* const destination, const bit_word* const source, const size_t count) noexcept
+		{
+			size_t i = 0;
+			if (!is_constant_evaluated())
+			{
+#if defined(WOJ_HAS_AVX512)
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512i left = _mm512_loadu_si512(destination + i);
+					const __m512i right = _mm512_loadu_si512(source + i);
+					__m512i result;
+					if constexpr (Operation == bit_operation::bitwise_and) result = _mm512_and_si512(left, right);
+					else if constexpr (Operation == bit_operation::bitwise_or) result = _mm512_or_si512(left, right);
+					else if constexpr (Operation == bit_operation::bitwise_xor) result = _mm512_xor_si512(left, right);
+					else result = _mm512_andnot_si512(right, left);
+					_mm512_storeu_si512(destination + i, result);
+				}
+#elif defined(WOJ_HAS_AVX2)
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+					const __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+					__m256i result;
+					if constexpr (Operation == bit_operation::bitwise_and) result = _mm256_and_si256(left, right);
+					else if constexpr (Operation == bit_operation::bitwise_or) result = _mm256_or_si256(left, right);
+					else if constexpr (Operation == bit_operation::bitwise_xor) result = _mm256_xor_si256(left, right);
+					else result = _mm256_andnot_si256(right, left);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), result);
+				}
+#elif defined(WOJ_HAS_SSE2)
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+					const __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+					__m128i result;
+					if constexpr (Operation == bit_operation::bitwise_and) result = _mm_and_si128(left, right);
+					else if constexpr (Operation == bit_operation::bitwise_or) result = _mm_or_si128(left, right);
+					else if constexpr (Operation == bit_operation::bitwise_xor) result = _mm_xor_si128(left, right);
+					else result = _mm_andnot_si128(right, left);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), result);
+				}
+#endif
+			}
+
+			for (; i < count; ++i)
+			{
+				destination[i] = apply_bit_operation<Operation>(destination[i], source[i]);
+			}
+		}
+
+		/**
+		 * Counts the set bits of count words (four independent accumulators keep the POPCNT units busy)
+		 */
+		WOJ_NODISCARD constexpr size_t popcount_words(const bit_word* const words, const size_t count) noexcept
+		{
+			size_t counts[4]{};
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				counts[0] += static_cast<size_t>(std::popcount(words[i]));
+				counts[1] += static_cast<size_t>(std::popcount(words[i + 1]));
+				counts[2] += static_cast<size_t>(std::popcount(words[i + 2]));
+				counts[3] += static_cast<size_t>(std::popcount(words[i + 3]));
+			}
+			for (; i < count; ++i)
+			{
+				counts[0] += static_cast<size_t>(std::popcount(words[i]));
+			}
+			return counts[0] + counts[1] + counts[2] + counts[3];
+		}
+
+		/**
+		 * Proxy to a single bit of a bit vector
+		 */
+		class bit_reference
+		{
+		public:
+			bit_word* m_word;
+			bit_word m_mask;
+
+			constexpr bit_reference(bit_word* const word, const bit_word mask) noexcept : m_word{ word }, m_mask{ mask } {}
+
+			constexpr bit_reference(const bit_reference&) noexcept = default;
+
+			constexpr operator bool() const noexcept
+			{
+				return (*m_word & m_mask) != 0;
+			}
+
+			constexpr bool operator~() const noexcept
+			{
+				return (*m_word & m_mask) == 0;
+			}
+
+			constexpr bit_reference& operator=(const bool value) noexcept
+			{
+				*m_word = value ? *m_word | m_mask : *m_word & ~m_mask;
+				return *this;
+			}
+
+			constexpr bit_reference& operator=(const bit_reference& other) noexcept
+			{
+				return *this = static_cast<bool>(other);
+			}
+
+			constexpr bit_reference& flip() noexcept
+			{
+				*m_word ^= m_mask;
+				return *this;
+			}
+		};
+
+		/**
+		 * Forward iterator over the positions of the set bits, skips whole zero words
+		 */
+		class set_bit_iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = size_t;
+			using difference_type = ptrdiff_t;
+			using pointer = const size_t*;
+			using reference = size_t;
+
+			const bit_word* m_words;
+			size_t m_word_count;
+			size_t m_index;
+			bit_word m_word;
+
+			constexpr set_bit_iterator() noexcept : m_words{ nullptr }, m_word_count{ 0 }, m_index{ 0 }, m_word{ 0 } {}
+
+			constexpr set_bit_iterator(const bit_word* const words, const size_t word_count, const size_t index) noexcept : m_words{ words }, m_word_count{ word_count }, m_index{ index }, m_word{ index < word_count ? words[index] : 0 }
+			{
+				skip_zero_words();
+			}
+
+			constexpr size_t operator*() const noexcept
+			{
+				return m_index * bits_per_word + static_cast<size_t>(std::countr_zero(m_word));
+			}
+
+			constexpr set_bit_iterator& operator++() noexcept
+			{
+				m_word &= m_word - 1;
+				skip_zero_words();
+				return *this;
+			}
+
+			constexpr set_bit_iterator operator++(int) noexcept
+			{
+				set_bit_iterator copy{ *this };
+				++*this;
+				return copy;
+			}
+
+			constexpr bool operator==(const set_bit_iterator& other) const noexcept
+			{
+				return m_index == other.m_index && m_word == other.m_word;
+			}
+
+		private:
+			constexpr void skip_zero_words() noexcept
+			{
+				while (m_word == 0 && m_index < m_word_count)
+				{
+					++m_index;
+					m_word = m_index < m_word_count ? m_words[m_index] : 0;
+				}
+			}
+		};
+
+		/**
+		 * Range of the positions of the set bits of a bit vector
+		 */
+		class set_bit_range
+		{
+		public:
+			const bit_word* m_words;
+			size_t m_word_count;
+
+			WOJ_NODISCARD constexpr set_bit_iterator begin() const noexcept
+			{
+				return { m_words, m_word_count, 0 };
+			}
+
+			WOJ_NODISCARD constexpr set_bit_iterator end() const noexcept
+			{
+				return { m_words, m_word_count, m_word_count };
+			}
+		};
+
+		/**
+		 * Bit operations shared by the fixed-size and the dynamic bit vectors, bits past size() in the last word are kept at 0
+		 * @tparam Derived Bit vector type, must provide words(), word_count() and size()
+		 */
+		template <typename Derived>
+		class bit_vector_base
+		{
+		public:
+			using size_type = size_t;
+			using word_type = bit_word;
+			using reference = bit_reference;
+
+			static constexpr size_type npos = static_cast<size_type>(-1);
+
+			// ----- Element access -----
+
+			WOJ_NODISCARD constexpr bool operator[](const size_type index) const noexcept
+			{
+				return test(index);
+			}
+
+			WOJ_NODISCARD constexpr reference operator[](const size_type index) noexcept
+			{
+				return { self().words() + index / bits_per_word, word_type{ 1 } << (index % bits_per_word) };
+			}
+
+			WOJ_NODISCARD constexpr bool test(const size_type index) const noexcept
+			{
+				return (self().words()[index / bits_per_word] >> (index % bits_per_word)) & 1;
+			}
+
+			/**
+			 * Accesses a bit with bounds checking in every build
+			 */
+			WOJ_NODISCARD constexpr bool at(const size_type index) const
+			{
+				if (index >= self().size())
+				{
+					throw out_of_vector_range{ 301ull, "bit_vector.hpp", "woj::detail::bit_vector_base<Derived>::at" };
+				}
+				return test(index);
+			}
+
+			// ----- Single bit modifiers -----
+
+			constexpr Derived& set(const size_type index) noexcept
+			{
+				self().words()[index / bits_per_word] |= word_type{ 1 } << (index % bits_per_word);
+				return self();
+			}
+
+			constexpr Derived& set(const size_type index, const bool value) noexcept
+			{
+				(*this)[index] = value;
+				return self();
+			}
+
+			constexpr Derived& reset(const size_type index) noexcept
+			{
+				self().words()[index / bits_per_word] &= ~(word_type{ 1 } << (index % bits_per_word));
+				return self();
+			}
+
+			constexpr Derived& flip(const size_type index) noexcept
+			{
+				self().words()[index / bits_per_word] ^= word_type{ 1 } << (index % bits_per_word);
+				return self();
+			}
+
+			// ----- Whole vector modifiers -----
+
+			constexpr Derived& set() noexcept
+			{
+				fill_words(~word_type{ 0 });
+				clear_tail();
+				return self();
+			}
+
+			constexpr Derived& reset() noexcept
+			{
+				fill_words(0);
+				return self();
+			}
+
+			constexpr Derived& flip() noexcept
+			{
+				word_type* const words = self().words();
+				for (size_type i = 0; i < self().word_count(); ++i)
+				{
+					words[i] = ~words[i];
+				}
+				clear_tail();
+				return self();
+			}
+
+			/**
+			 * Bulk operations work on whole words, on the bits both vectors have
+			 */
+			template <typename Other>
+			constexpr Derived& operator&=(const bit_vector_base<Other>& other) noexcept
+			{
+				combine<bit_operation::bitwise_and>(other);
+				word_type* const words = self().words();
+				for (size_type i = common_word_count(other); i < self().word_count(); ++i)
+				{
+					words[i] = 0;
+				}
+				return self();
+			}
+
+			template <typename Other>
+			constexpr Derived& operator|=(const bit_vector_base<Other>& other) noexcept
+			{
+				combine<bit_operation::bitwise_or>(other);
+				clear_tail();
+				return self();
+			}
+
+			template <typename Other>
+			constexpr Derived& operator^=(const bit_vector_base<Other>& other) noexcept
+			{
+				combine<bit_operation::bitwise_xor>(other);
+				clear_tail();
+				return self();
+			}
+
+			/**
+			 * Clears the bits set in other (this &= ~other)
+			 */
+			template <typename Other>
+			constexpr Derived& and_not(const bit_vector_base<Other>& other) noexcept
+			{
+				combine<bit_operation::bitwise_and_not>(other);
+				return self();
+			}
+
+			// ----- Queries -----
+
+			/**
+			 * @return Count of set bits
+			 */
+			WOJ_NODISCARD constexpr size_type count() const noexcept
+			{
+				return popcount_words(self().words(), self().word_count());
+			}
+
+			WOJ_NODISCARD constexpr bool any() const noexcept
+			{
+				const word_type* const words = self().words();
+				for (size_type i = 0; i < self().word_count(); ++i)
+				{
+					if (words[i] != 0)
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			WOJ_NODISCARD constexpr bool none() const noexcept
+			{
+				return !any();
+			}
+
+			WOJ_NODISCARD constexpr bool all() const noexcept
+			{
+				return count() == self().size();
+			}
+
+			/**
+			 * @return Count of set bits before index (index may be size())
+			 */
+			WOJ_NODISCARD constexpr size_type rank(const size_type index) const noexcept
+			{
+				const word_type* const words = self().words();
+				const size_type full = index / bits_per_word;
+				size_type result = popcount_words(words, full);
+				if (index % bits_per_word != 0)
+				{
+					result += static_cast<size_type>(std::popcount(words[full] & ((word_type{ 1 } << (index % bits_per_word)) - 1)));
+				}
+				return result;
+			}
+
+			/**
+			 * @return Position of the n-th (0-based) set bit or npos if there are not that many
+			 */
+			WOJ_NODISCARD constexpr size_type select(size_type n) const noexcept
+			{
+				const word_type* const words = self().words();
+				for (size_type i = 0; i < self().word_count(); ++i)
+				{
+					const size_type bits = static_cast<size_type>(std::popcount(words[i]));
+					if (n < bits)
+					{
+						return i * bits_per_word + simd::select_bit(words[i], n);
+					}
+					n -= bits;
+				}
+				return npos;
+			}
+
+			/**
+			 * @return Position of the first set bit or npos
+			 */
+			WOJ_NODISCARD constexpr size_type find_first() const noexcept
+			{
+				return find_from_word(0);
+			}
+
+			/**
+			 * @return Position of the first set bit after index or npos
+			 */
+			WOJ_NODISCARD constexpr size_type find_next(const size_type index) const noexcept
+			{
+				const size_type next = index + 1;
+				if (next >= self().size())
+				{
+					return npos;
+				}
+
+				const size_type word_index = next / bits_per_word;
+				const word_type word = self().words()[word_index] >> (next % bits_per_word);
+				if (word != 0)
+				{
+					return next + static_cast<size_type>(std::countr_zero(word));
+				}
+				return find_from_word(word_index + 1);
+			}
+
+			/**
+			 * @return Range over the positions of the set bits in increasing order
+			 */
+			WOJ_NODISCARD constexpr set_bit_range set_bits() const noexcept
+			{
+				return { self().words(), self().word_count() };
+			}
+
+			/**
+			 * Calls function with the position of every set bit in increasing order (the fastest way to visit them)
+			 */
+			template <typename Function>
+			constexpr void for_each_set(Function&& function) const
+			{
+				const word_type* const words = self().words();
+				for (size_type i = 0; i < self().word_count(); ++i)
+				{
+					for (word_type word = words[i]; word != 0; word &= word - 1)
+					{
+						function(i * bits_per_word + static_cast<size_type>(std::countr_zero(word)));
+					}
+				}
+			}
+
+			template <typename Other>
+			WOJ_NODISCARD constexpr bool operator==(const bit_vector_base<Other>& other) const noexcept
+			{
+				if (self().size() != other.self().size())
+				{
+					return false;
+				}
+
+				const word_type* const words = self().words();
+				const word_type* const other_words = other.self().words();
+				for (size_type i = 0; i < self().word_count(); ++i)
+				{
+					if (words[i] != other_words[i])
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			WOJ_NODISCARD constexpr const Derived& self() const noexcept
+			{
+				return static_cast<const Derived&>(*this);
+			}
+
+		protected:
+			WOJ_NODISCARD constexpr Derived& self() noexcept
+			{
+				return static_cast<Derived&>(*this);
+			}
+
+			constexpr void fill_words(const word_type value) noexcept
+			{
+				word_type* const words = self().words();
+				for (size_type i = 0; i < self().word_count(); ++i)
+				{
+					words[i] = value;
+				}
+			}
+
+			constexpr void clear_tail() noexcept
+			{
+				if (self().word_count() != 0)
+				{
+					self().words()[self().word_count() - 1] &= bit_tail_mask(self().size());
+				}
+			}
+
+			template <typename Other>
+			WOJ_NODISCARD constexpr size_type common_word_count(const bit_vector_base<Other>& other) const noexcept
+			{
+				return self().word_count() < other.self().word_count() ? self().word_count() : other.self().word_count();
+			}
+
+			template <bit_operation Operation, typename Other>
+			constexpr void combine(const bit_vector_base<Other>& other) noexcept
+			{
+				apply_bit_operation<Operation>(self().words(), other.self().words(), common_word_count(other));
+			}
+
+			WOJ_NODISCARD constexpr size_type find_from_word(size_type word_index) const noexcept
+			{
+				const word_type* const words = self().words();
+				for (; word_index < self().word_count(); ++word_index)
+				{
+					if (words[word_index] != 0)
+					{
+						return word_index * bits_per_word + static_cast<size_type>(std::countr_zero(words[word_index]));
+					}
+				}
+				return npos;
+			}
+		};
+	}
+
+	namespace stack
+	{
+		/**
+		 * Class representing a fixed-size packed vector of bits (one bit per flag instead of one byte for stack::vector<bool, N>)
+		 * @tparam Size Count of bits
+		 */
+		template <size_t Size>
+		class bit_vector : public detail::bit_vector_base<bit_vector<Size>>
+		{
+		public:
+			using size_type = size_t;
+			using word_type = detail::bit_word;
+
+			static constexpr size_type word_count_v = detail::bit_word_count(Size);
+
+			word_type m_words[word_count_v == 0 ? 1 : word_count_v];
+
+			constexpr bit_vector() noexcept : m_words{} {}
+
+			/**
+			 * Constructs the vector with all bits set to value
+			 */
+			explicit constexpr bit_vector(const bool value) noexcept : m_words{}
+			{
+				if (value)
+				{
+					this->set();
+				}
+			}
+
+			/**
+			 * Packs a vector of flags
+			 */
+			explicit constexpr bit_vector(const vector<bool, Size>& flags) noexcept : m_words{}
+			{
+				for (size_type i = 0; i < Size; ++i)
+				{
+					m_words[i / detail::bits_per_word] |= static_cast<word_type>(flags[i]) << (i % detail::bits_per_word);
+				}
+			}
+
+			WOJ_NODISCARD constexpr word_type* words() noexcept
+			{
+				return m_words;
+			}
+
+			WOJ_NODISCARD constexpr const word_type* words() const noexcept
+			{
+				return m_words;
+			}
+
+			static WOJ_CONSTEVAL size_type word_count() noexcept
+			{
+				return word_count_v;
+			}
+
+			static WOJ_CONSTEVAL size_type size() noexcept
+			{
+				return Size;
+			}
+
+			WOJ_NODISCARD friend constexpr bit_vector operator&(bit_vector left, const bit_vector& right) noexcept
+			{
+				return left &= right;
+			}
+
+			WOJ_NODISCARD friend constexpr bit_vector operator|(bit_vector left, const bit_vector& right) noexcept
+			{
+				return left |= right;
+			}
+
+			WOJ_NODISCARD friend constexpr bit_vector operator^(bit_vector left, const bit_vector& right) noexcept
+			{
+				return left ^= right;
+			}
+
+			WOJ_NODISCARD friend constexpr bit_vector operator~(bit_vector value) noexcept
+			{
+				return value.flip();
+			}
+		};
+	}
+
+	/**
+	 * Class representing a growable packed vector of bits
+	 * @tparam Allocator Allocator providing the word storage (see allocator_type)
+	 */
+	template <typename Allocator = default_allocator>
+	class bit_vector : public detail::bit_vector_base<bit_vector<Allocator>>
+	{
+	public:
+		using size_type = size_t;
+		using word_type = detail::bit_word;
+
+		vector<word_type, Allocator> m_words;
+		size_type m_size;
+
+		constexpr bit_vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) : m_words{}, m_size{ 0 } {}
+
+		explicit constexpr bit_vector(const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>) : m_words{ allocator }, m_size{ 0 } {}
+
+		/**
+		 * Constructs count bits set to value
+		 */
+		explicit constexpr bit_vector(const size_type count, const bool value = false, const Allocator& allocator = Allocator{}) : m_words{ allocator }, m_size{ 0 }
+		{
+			resize(count, value);
+		}
+
+		template <size_t Size>
+		explicit constexpr bit_vector(const stack::bit_vector<Size>& other, const Allocator& allocator = Allocator{}) : m_words{ allocator }, m_size{ Size }
+		{
+			m_words.append(other.words(), other.words() + other.word_count());
+		}
+
+		WOJ_NODISCARD constexpr const Allocator& get_allocator() const noexcept
+		{
+			return m_words.get_allocator();
+		}
+
+		WOJ_NODISCARD constexpr word_type* words() noexcept
+		{
+			return m_words.data();
+		}
+
+		WOJ_NODISCARD constexpr const word_type* words() const noexcept
+		{
+			return m_words.data();
+		}
+
+		WOJ_NODISCARD constexpr size_type word_count() const noexcept
+		{
+			return m_words.size();
+		}
+
+		WOJ_NODISCARD constexpr size_type size() const noexcept
+		{
+			return m_size;
+		}
+
+		WOJ_NODISCARD constexpr bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		WOJ_NODISCARD constexpr size_type capacity() const noexcept
+		{
+			return m_words.capacity() * detail::bits_per_word;
+		}
+
+		constexpr void reserve(const size_type count)
+		{
+			m_words.reserve(detail::bit_word_count(count));
+		}
+
+		/**
+		 * Resizes the vector, new bits are set to value
+		 */
+		constexpr void resize(const size_type count, const bool value = false)
+		{
+			if (count > m_size && value)
+			{
+				// Fill the rest of the current last word before adding whole words
+				if (m_size % detail::bits_per_word != 0)
+				{
+					m_words.back() |= ~detail::bit_tail_mask(m_size);
+				}
+				m_words.resize(detail::bit_word_count(count), ~word_type{ 0 });
+			}
+			else
+			{
+				m_words.resize(detail::bit_word_count(count), 0);
+			}
+			m_size = count;
+			this->clear_tail();
+		}
+
+		constexpr void push_back(const bool value)
+		{
+			if (m_size % detail::bits_per_word == 0)
+			{
+				m_words.push_back(static_cast<word_type>(value));
+			}
+			else if (value)
+			{
+				m_words.back() |= word_type{ 1 } << (m_size % detail::bits_per_word);
+			}
+			++m_size;
+		}
+
+		/**
+		 * Removes the last bit, the vector must not be empty
+		 */
+		constexpr void pop_back() noexcept
+		{
+			--m_size;
+			if (m_size % detail::bits_per_word == 0)
+			{
+				m_words.pop_back();
+			}
+			else
+			{
+				this->clear_tail();
+			}
+		}
+
+		constexpr void clear() noexcept
+		{
+			m_words.clear();
+			m_size = 0;
+		}
+
+		WOJ_NODISCARD friend constexpr bit_vector operator&(bit_vector left, const bit_vector& right)
+		{
+			return std::move(left &= right);
+		}
+
+		WOJ_NODISCARD friend constexpr bit_vector operator|(bit_vector left, const bit_vector& right)
+		{
+			return std::move(left |= right);
+		}
+
+		WOJ_NODISCARD friend constexpr bit_vector operator^(bit_vector left, const bit_vector& right)
+		{
+			return std::move(left ^= right);
+		}
+
+		WOJ_NODISCARD friend constexpr bit_vector operator~(bit_vector value)
+		{
+			return std::move(value.flip());
+		}
+	};
+
+	/**
+	 * Rank/select directory over a bit vector: cumulative set bit counts per block of 8 words make rank O(1)
+	 * and select a binary search over the blocks followed by PDEP, rebuild it after modifying the bits
+	 */
+	template <typename Allocator = default_allocator>
+	class bit_rank_index
+	{
+	public:
+		using size_type = size_t;
+
+		static constexpr size_type block_words = 8;
+
+		/**
+		 * m_blocks[b] is the count of set bits before block b, the last entry is the total
+		 */
+		vector<size_type, Allocator> m_blocks;
+
+		constexpr bit_rank_index() = default;
+
+		explicit constexpr bit_rank_index(const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>) : m_blocks{ allocator } {}
+
+		template <typename Bits>
+		explicit constexpr bit_rank_index(const detail::bit_vector_base<Bits>& bits, const Allocator& allocator = Allocator{}) : m_blocks{ allocator }
+		{
+			rebuild(bits);
+		}
+
+		template <typename Bits>
+		constexpr void rebuild(const detail::bit_vector_base<Bits>& bits)
+		{
+			const detail::bit_word* const words = bits.self().words();
+			const size_type word_count = bits.self().word_count();
+			m_blocks.clear();
+			m_blocks.reserve(word_count / block_words + 2);
+
+			size_type total = 0;
+			m_blocks.push_back(0);
+			for (size_type i = 0; i < word_count; i += block_words)
+			{
+				total += detail::popcount_words(words + i, word_count - i < block_words ? word_count - i : block_words);
+				m_blocks.push_back(total);
+			}
+		}
+
+		/**
+		 * @return Count of set bits before index (index may be size())
+		 */
+		template <typename Bits>
+		WOJ_NODISCARD constexpr size_type rank(const detail::bit_vector_base<Bits>& bits, const size_type index) const noexcept
+		{
+			const detail::bit_word* const words = bits.self().words();
+			const size_type word_index = index / detail::bits_per_word;
+			const size_type block_start = word_index / block_words * block_words;
+			size_type result = m_blocks[word_index / block_words] + detail::popcount_words(words + block_start, word_index - block_start);
+			if (index % detail::bits_per_word != 0)
+			{
+				result += static_cast<size_type>(std::popcount(words[word_index] & ((detail::bit_word{ 1 } << (index % detail::bits_per_word)) - 1)));
+			}
+			return result;
+		}
+
+		/**
+		 * @return Position of the n-th (0-based) set bit or npos if there are not that many
+		 */
+		template <typename Bits>
+		WOJ_NODISCARD constexpr size_type select(const detail::bit_vector_base<Bits>& bits, size_type n) const noexcept
+		{
+			if (n >= m_blocks.back())
+			{
+				return detail::bit_vector_base<Bits>::npos;
+			}
+
+			// Last block starting with fewer than n + 1 set bits before it
+			size_type low = 0;
+			size_type high = m_blocks.size() - 1;
+			while (high - low > 1)
+			{
+				const size_type middle = low + (high - low) / 2;
+				if (m_blocks[middle] <= n)
+				{
+					low = middle;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			const detail::bit_word* const words = bits.self().words();
+			n -= m_blocks[low];
+			for (size_type i = low * block_words;; ++i)
+			{
+				const size_type count = static_cast<size_type>(std::popcount(words[i]));
+				if (n < count)
+				{
+					return i * detail::bits_per_word + simd::select_bit(words[i], n);
+				}
+				n -= count;
+			}
+		}
+	};
+}
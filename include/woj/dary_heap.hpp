@@ -0,0 +1,958 @@
+#pragma once
+
+#include "base.hpp"
+#include "inplace_vector.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_DARY_HEAP_HPP
+#define WOJ_DARY_HEAP_HPP
+#endif
+
+namespace woj
+{
+	namespace detail
+	{
+		/**
+		 * Position callback of the heaps that do not track their elements
+		 */
+		class heap_untracked
+		{
+		public:
+			template <typename Element>
+			constexpr void operator()(const Element&, size_t) const noexcept {}
+		};
+
+		/**
+		 * Compare with swapped arguments, turns the top of a heap into its bottom
+		 */
+		template <typename Compare>
+		class heap_reverse
+		{
+		public:
+			WOJ_NO_UNIQUE_ADDRESS Compare m_compare;
+
+			template <typename Left, typename Right>
+			WOJ_NODISCARD constexpr bool operator()(const Left& left, const Right& right) const
+			{
+				return m_compare(right, left);
+			}
+		};
+
+		/**
+		 * Moves the element at index towards the root while it compares greater than its parent
+		 * @param track Called with every element that lands at a new index
+		 */
+		template <size_t Arity, typename Element, typename Compare, typename Track>
+		constexpr void heap_sift_up(Element* const data, size_t index, Compare& compare, Track& track)
+		{
+			Element value = std::move(data[index]);
+			while (index > 0)
+			{
+				const size_t parent = (index - 1) / Arity;
+				if (!compare(data[parent], value))
+				{
+					break;
+				}
+				data[index] = std::move(data[parent]);
+				track(data[index], index);
+				index = parent;
+			}
+			data[index] = std::move(value);
+			track(data[index], index);
+		}
+
+		/**
+		 * Greatest of Count consecutive children, as a tournament for power of two counts (independent comparisons
+		 * instead of a chain of Count - 1 dependent ones)
+		 */
+		template <size_t Count, typename Element, typename Compare>
+		WOJ_NODISCARD WOJ_ALWAYS_INLINE constexpr size_t heap_best_child(const Element* const data, const size_t first, Compare& compare)
+		{
+			if constexpr (Count == 1)
+			{
+				return first;
+			}
+			else if constexpr (std::has_single_bit(Count))
+			{
+				const size_t left = heap_best_child<Count / 2>(data, first, compare);
+				const size_t right = heap_best_child<Count / 2>(data, first + Count / 2, compare);
+				// Arithmetic select, compilers tend to turn a ternary here into an unpredictable branch
+				return left + static_cast<size_t>(compare(data[left], data[right])) * (right - left);
+			}
+			else
+			{
+				size_t best = first;
+				for (size_t child = first + 1; child < first + Count; ++child)
+				{
+					best += static_cast<size_t>(compare(data[best], data[child])) * (child - best);
+				}
+				return best;
+			}
+		}
+
+		/**
+		 * Moves the element at index towards the leaves while one of its children compares greater, nodes with all
+		 * Arity children scan a fixed count of siblings (stored next to each other, so mostly in one cache line)
+		 * @param track Called with every element that lands at a new index
+		 */
+		template <size_t Arity, typename Element, typename Compare, typename Track>
+		constexpr void heap_sift_down(Element* const data, const size_t size, size_t index, Compare& compare, Track& track)
+		{
+			Element value = std::move(data[index]);
+			for (;;)
+			{
+				const size_t first = index * Arity + 1;
+				size_t best = first;
+				if (first + Arity <= size) WOJ_LIKELY
+				{
+					best = heap_best_child<Arity>(data, first, compare);
+				}
+				else if (first < size)
+				{
+					for (size_t child = first + 1; child < size; ++child)
+					{
+						best = compare(data[best], data[child]) ? child : best;
+					}
+				}
+				else
+				{
+					break;
+				}
+
+				if (!compare(value, data[best]))
+				{
+					break;
+				}
+				data[index] = std::move(data[best]);
+				track(data[index], index);
+				index = best;
+			}
+			data[index] = std::move(value);
+			track(data[index], index);
+		}
+
+		/**
+		 * Removes the root by moving the greatest child up level by level until the hole is a leaf, then sifts the
+		 * element from the end of the heap up from there; the last element usually belongs near the leaves, so this
+		 * needs about half the comparisons of a sift down from the root
+		 * @param size Size of the heap without the last element, which is at data[size]
+		 */
+		template <size_t Arity, typename Element, typename Compare, typename Track>
+		constexpr void heap_pop_root(Element* const data, const size_t size, Compare& compare, Track& track)
+		{
+			size_t index = 0;
+			for (;;)
+			{
+				const size_t first = index * Arity + 1;
+				size_t best = first;
+				if (first + Arity <= size) WOJ_LIKELY
+				{
+					best = heap_best_child<Arity>(data, first, compare);
+				}
+				else if (first < size)
+				{
+					for (size_t child = first + 1; child < size; ++child)
+					{
+						best = compare(data[best], data[child]) ? child : best;
+					}
+				}
+				else
+				{
+					break;
+				}
+
+				data[index] = std::move(data[best]);
+				track(data[index], index);
+				index = best;
+			}
+
+			data[index] = std::move(data[size]);
+			heap_sift_up<Arity>(data, index, compare, track);
+		}
+
+		/**
+		 * Floyd's bottom-up construction, linear in size
+		 */
+		template <size_t Arity, typename Element, typename Compare, typename Track>
+		constexpr void heap_make(Element* const data, const size_t size, Compare& compare, Track& track)
+		{
+			if (size < 2)
+			{
+				for (size_t i = 0; i < size; ++i)
+				{
+					track(data[i], i);
+				}
+				return;
+			}
+
+			// Leaves are not sifted but still land at their index
+			const size_t last_parent = (size - 2) / Arity;
+			for (size_t i = last_parent + 1; i < size; ++i)
+			{
+				track(data[i], i);
+			}
+			for (size_t i = last_parent + 1; i-- > 0;)
+			{
+				heap_sift_down<Arity>(data, size, i, compare, track);
+			}
+		}
+
+		/**
+		 * Restores the heap property of the element at index after it was changed in either direction
+		 */
+		template <size_t Arity, typename Element, typename Compare, typename Track>
+		constexpr void heap_update(Element* const data, const size_t size, const size_t index, Compare& compare, Track& track)
+		{
+			if (index > 0 && compare(data[(index - 1) / Arity], data[index]))
+			{
+				heap_sift_up<Arity>(data, index, compare, track);
+			}
+			else
+			{
+				heap_sift_down<Arity>(data, size, index, compare, track);
+			}
+		}
+
+		template <typename RandomIterator>
+		WOJ_NODISCARD constexpr auto heap_data(const RandomIterator first) noexcept
+		{
+			return std::to_address(first);
+		}
+	}
+
+	/**
+	 * Arranges a range as a d-ary max-heap (the first element compares greater or equal than all others), in linear time
+	 * @tparam Arity Count of children of each node
+	 * @param first Iterator to the first element
+	 * @param last Iterator past the last element
+	 * @param compare Strict weak ordering
+	 */
+	template <size_t Arity = 4, std::contiguous_iterator RandomIterator, typename Compare = std::less<>>
+	constexpr void make_dary_heap(const RandomIterator first, const RandomIterator last, Compare compare = Compare{})
+	{
+		static_assert(Arity >= 2, "Arity must be at least 2");
+
+		detail::heap_untracked track;
+		detail::heap_make<Arity>(detail::heap_data(first), static_cast<size_t>(last - first), compare, track);
+	}
+
+	/**
+	 * Adds the last element of a range to the d-ary heap formed by the previous ones
+	 */
+	template <size_t Arity = 4, std::contiguous_iterator RandomIterator, typename Compare = std::less<>>
+	constexpr void push_dary_heap(const RandomIterator first, const RandomIterator last, Compare compare = Compare{})
+	{
+		static_assert(Arity >= 2, "Arity must be at least 2");
+
+		if (last - first > 1)
+		{
+			detail::heap_untracked track;
+			detail::heap_sift_up<Arity>(detail::heap_data(first), static_cast<size_t>(last - first - 1), compare, track);
+		}
+	}
+
+	/**
+	 * Moves the top of a d-ary heap to the last position, the previous elements form a heap again
+	 */
+	template <size_t Arity = 4, std::contiguous_iterator RandomIterator, typename Compare = std::less<>>
+	constexpr void pop_dary_heap(const RandomIterator first, const RandomIterator last, Compare compare = Compare{})
+	{
+		static_assert(Arity >= 2, "Arity must be at least 2");
+
+		const size_t size = static_cast<size_t>(last - first);
+		if (size > 1)
+		{
+			auto* const data = detail::heap_data(first);
+			std::iter_swap(data, data + size - 1);
+
+			detail::heap_untracked track;
+			detail::heap_sift_down<Arity>(data, size - 1, 0, compare, track);
+		}
+	}
+
+	/**
+	 * @return True if the range is a d-ary heap
+	 */
+	template <size_t Arity = 4, std::contiguous_iterator RandomIterator, typename Compare = std::less<>>
+	WOJ_NODISCARD constexpr bool is_dary_heap(const RandomIterator first, const RandomIterator last, Compare compare = Compare{})
+	{
+		static_assert(Arity >= 2, "Arity must be at least 2");
+
+		const size_t size = static_cast<size_t>(last - first);
+		for (size_t i = 1; i < size; ++i)
+		{
+			if (compare(first[(i - 1) / Arity], first[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Class representing a priority queue stored as a d-ary heap in a contiguous container, a wider node makes the heap
+	 * shallower and its children share cache lines, so pops touch less memory than with a binary heap
+	 * @tparam ElementType Type of the elements
+	 * @tparam Arity Count of children of each node
+	 * @tparam Compare Strict weak ordering, top() is the greatest element (std::greater<> makes a min-heap)
+	 * @tparam Container Contiguous container holding the elements (woj::vector or stack::inplace_vector)
+	 */
+	template <typename ElementType, size_t Arity, typename Compare, typename Container>
+	class basic_dary_heap
+	{
+	public:
+		using value_type = ElementType;
+		using value_compare = Compare;
+		using container_type = Container;
+		using size_type = size_t;
+		using reference = ElementType&;
+		using const_reference = const ElementType&;
+
+		static constexpr size_t arity = Arity;
+
+		static_assert(Arity >= 2, "Arity must be at least 2");
+
+		Container m_elements;
+		WOJ_NO_UNIQUE_ADDRESS Compare m_compare;
+
+		constexpr basic_dary_heap() = default;
+
+		explicit constexpr basic_dary_heap(const Compare& compare) : m_elements{}, m_compare{ compare } {}
+
+		/**
+		 * Constructs the heap from unordered elements with a bulk heapify
+		 */
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr basic_dary_heap(const InputIterator first, const InputIterator last, const Compare& compare = Compare{}) : m_elements(first, last), m_compare{ compare }
+		{
+			heapify();
+		}
+
+		constexpr basic_dary_heap(const std::initializer_list<ElementType> values, const Compare& compare = Compare{}) : basic_dary_heap{ values.begin(), values.end(), compare } {}
+
+		/**
+		 * Adopts a container of unordered elements with a bulk heapify
+		 */
+		explicit constexpr basic_dary_heap(Container elements, const Compare& compare = Compare{}) : m_elements{ std::move(elements) }, m_compare{ compare }
+		{
+			heapify();
+		}
+
+		// ----- Element access -----
+
+		/**
+		 * @return The greatest element, the heap must not be empty
+		 */
+		WOJ_NODISCARD constexpr const ElementType& top() const noexcept
+		{
+			return m_elements.data()[0];
+		}
+
+		/**
+		 * @return The elements in heap order
+		 */
+		WOJ_NODISCARD constexpr const Container& elements() const noexcept
+		{
+			return m_elements;
+		}
+
+		// ----- Capacity -----
+
+		WOJ_NODISCARD constexpr size_type size() const noexcept
+		{
+			return m_elements.size();
+		}
+
+		WOJ_NODISCARD constexpr bool empty() const noexcept
+		{
+			return m_elements.size() == 0;
+		}
+
+		/**
+		 * Reserves storage for count elements (no-op for fixed-capacity containers)
+		 */
+		constexpr void reserve(const size_type count)
+		{
+			if constexpr (requires { m_elements.reserve(count); })
+			{
+				m_elements.reserve(count);
+			}
+		}
+
+		// ----- Modifiers -----
+
+		template <typename... Args>
+		constexpr void emplace(Args&&... args)
+		{
+			m_elements.emplace_back(std::forward<Args>(args)...);
+			detail::heap_untracked track;
+			detail::heap_sift_up<Arity>(m_elements.data(), m_elements.size() - 1, m_compare, track);
+		}
+
+		constexpr void push(const ElementType& value)
+		{
+			emplace(value);
+		}
+
+		constexpr void push(ElementType&& value)
+		{
+			emplace(std::move(value));
+		}
+
+		/**
+		 * Inserts several elements, a large batch is appended and the whole heap rebuilt in linear time instead of
+		 * sifting every element up. If appending an element throws (e.g. a full fixed-capacity heap), the elements
+		 * appended so far are removed and the heap is left unchanged
+		 */
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr void push(InputIterator first, const InputIterator last)
+		{
+			const size_type old_size = m_elements.size();
+			try
+			{
+				for (; first != last; ++first)
+				{
+					m_elements.emplace_back(*first);
+				}
+			}
+			catch (...)
+			{
+				while (m_elements.size() != old_size)
+				{
+					m_elements.pop_back();
+				}
+				throw;
+			}
+
+			const size_type added = m_elements.size() - old_size;
+			if (added > old_size / 2)
+			{
+				heapify();
+				return;
+			}
+
+			detail::heap_untracked track;
+			for (size_type i = old_size; i < m_elements.size(); ++i)
+			{
+				detail::heap_sift_up<Arity>(m_elements.data(), i, m_compare, track);
+			}
+		}
+
+		/**
+		 * Removes the greatest element, the heap must not be empty
+		 */
+		constexpr void pop()
+		{
+			const size_type last = m_elements.size() - 1;
+			if (last != 0)
+			{
+				detail::heap_untracked track;
+				detail::heap_pop_root<Arity>(m_elements.data(), last, m_compare, track);
+			}
+			m_elements.pop_back();
+		}
+
+		/**
+		 * Removes and returns the greatest element, the heap must not be empty
+		 */
+		WOJ_NODISCARD constexpr ElementType extract()
+		{
+			ElementType value = std::move(m_elements.data()[0]);
+			pop();
+			return value;
+		}
+
+		/**
+		 * Replaces the greatest element with value in a single sift (cheaper than pop() followed by push())
+		 */
+		constexpr void replace_top(ElementType value)
+		{
+			m_elements.data()[0] = std::move(value);
+			detail::heap_untracked track;
+			detail::heap_sift_down<Arity>(m_elements.data(), m_elements.size(), 0, m_compare, track);
+		}
+
+		/**
+		 * Rebuilds the heap in linear time
+		 */
+		constexpr void heapify()
+		{
+			detail::heap_untracked track;
+			detail::heap_make<Arity>(m_elements.data(), m_elements.size(), m_compare, track);
+		}
+
+		constexpr void clear() noexcept
+		{
+			m_elements.clear();
+		}
+
+		/**
+		 * Sorts the elements in place from the greatest to the smallest and hands them out, the heap is left empty
+		 */
+		WOJ_NODISCARD constexpr Container extract_sorted()
+		{
+			ElementType* const data = m_elements.data();
+			for (size_type size = m_elements.size(); size > 1; --size)
+			{
+				pop_dary_heap<Arity>(data, data + size, m_compare);
+			}
+			std::reverse(data, data + m_elements.size());
+
+			Container sorted{ std::move(m_elements) };
+			m_elements.clear();
+			return sorted;
+		}
+	};
+
+	/**
+	 * Handle of an element of an addressable heap, stays valid until the element is removed
+	 */
+	class heap_handle
+	{
+	public:
+		size_t m_index;
+
+		WOJ_NODISCARD constexpr bool operator==(const heap_handle& other) const noexcept = default;
+	};
+
+	namespace detail
+	{
+		template <typename ElementType>
+		class heap_entry
+		{
+		public:
+			ElementType m_value;
+			size_t m_handle;
+		};
+
+		template <typename Compare>
+		class heap_entry_compare
+		{
+		public:
+			WOJ_NO_UNIQUE_ADDRESS Compare m_compare;
+
+			template <typename ElementType>
+			WOJ_NODISCARD constexpr bool operator()(const heap_entry<ElementType>& left, const heap_entry<ElementType>& right) const
+			{
+				return m_compare(left.m_value, right.m_value);
+			}
+		};
+
+		template <typename Positions>
+		class heap_position_tracker
+		{
+		public:
+			Positions* m_positions;
+
+			template <typename Entry>
+			constexpr void operator()(const Entry& entry, const size_t index) const noexcept
+			{
+				m_positions->data()[entry.m_handle] = index;
+			}
+		};
+	}
+
+	/**
+	 * Class representing a d-ary heap whose elements can be changed or removed through the handle returned by push(),
+	 * the handle to heap index table is updated whenever an element moves (timers, Dijkstra's open set...)
+	 * @tparam ElementType Type of the elements
+	 * @tparam Arity Count of children of each node
+	 * @tparam Compare Strict weak ordering, top() is the greatest element (std::greater<> makes a min-heap)
+	 * @tparam EntryContainer Contiguous container of detail::heap_entry<ElementType>
+	 * @tparam IndexContainer Contiguous container of size_t with the same capacity
+	 */
+	template <typename ElementType, size_t Arity, typename Compare, typename EntryContainer, typename IndexContainer>
+	class basic_addressable_dary_heap
+	{
+	public:
+		using value_type = ElementType;
+		using value_compare = Compare;
+		using size_type = size_t;
+		using handle_type = heap_handle;
+
+		static constexpr size_t arity = Arity;
+
+		/**
+		 * Position of a handle that is not in the heap
+		 */
+		static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+		static_assert(Arity >= 2, "Arity must be at least 2");
+
+		EntryContainer m_entries;
+		IndexContainer m_positions;
+		IndexContainer m_free_handles;
+		WOJ_NO_UNIQUE_ADDRESS detail::heap_entry_compare<Compare> m_compare;
+
+		constexpr basic_addressable_dary_heap() = default;
+
+		explicit constexpr basic_addressable_dary_heap(const Compare& compare) : m_entries{}, m_positions{}, m_free_handles{}, m_compare{ compare } {}
+
+		// ----- Element access -----
+
+		/**
+		 * @return The greatest element, the heap must not be empty
+		 */
+		WOJ_NODISCARD constexpr const ElementType& top() const noexcept
+		{
+			return m_entries.data()[0].m_value;
+		}
+
+		/**
+		 * @return Handle of the greatest element, the heap must not be empty
+		 */
+		WOJ_NODISCARD constexpr heap_handle top_handle() const noexcept
+		{
+			return { m_entries.data()[0].m_handle };
+		}
+
+		/**
+		 * @return Element of a handle that is in the heap (modify it through update())
+		 */
+		WOJ_NODISCARD constexpr const ElementType& operator[](const heap_handle handle) const noexcept
+		{
+			return m_entries.data()[m_positions.data()[handle.m_index]].m_value;
+		}
+
+		/**
+		 * @return True if the handle refers to an element still in the heap
+		 */
+		WOJ_NODISCARD constexpr bool contains(const heap_handle handle) const noexcept
+		{
+			return handle.m_index < m_positions.size() && m_positions.data()[handle.m_index] != npos;
+		}
+
+		// ----- Capacity -----
+
+		WOJ_NODISCARD constexpr size_type size() const noexcept
+		{
+			return m_entries.size();
+		}
+
+		WOJ_NODISCARD constexpr bool empty() const noexcept
+		{
+			return m_entries.size() == 0;
+		}
+
+		/**
+		 * Reserves storage for count elements (no-op for fixed-capacity containers)
+		 */
+		constexpr void reserve(const size_type count)
+		{
+			if constexpr (requires { m_entries.reserve(count); })
+			{
+				m_entries.reserve(count);
+				m_positions.reserve(count);
+			}
+		}
+
+		// ----- Modifiers -----
+
+		/**
+		 * Inserts an element
+		 * @return Handle of the element
+		 */
+		template <typename... Args>
+		constexpr heap_handle emplace(Args&&... args)
+		{
+			size_t handle;
+			if (m_free_handles.size() != 0)
+			{
+				handle = m_free_handles.data()[m_free_handles.size() - 1];
+				m_entries.emplace_back(ElementType(std::forward<Args>(args)...), handle);
+				m_free_handles.pop_back();
+			}
+			else
+			{
+				handle = m_positions.size();
+				m_positions.emplace_back(npos);
+				m_entries.emplace_back(ElementType(std::forward<Args>(args)...), handle);
+			}
+
+			sift_up(m_entries.size() - 1);
+			return { handle };
+		}
+
+		constexpr heap_handle push(const ElementType& value)
+		{
+			return emplace(value);
+		}
+
+		constexpr heap_handle push(ElementType&& value)
+		{
+			return emplace(std::move(value));
+		}
+
+		/**
+		 * Removes the greatest element, the heap must not be empty
+		 */
+		constexpr void pop()
+		{
+			// The handle is recorded first, the heap is unchanged if the free list cannot grow
+			const size_t handle = m_entries.data()[0].m_handle;
+			m_free_handles.emplace_back(handle);
+			m_positions.data()[handle] = npos;
+
+			const size_type last = m_entries.size() - 1;
+			if (last != 0)
+			{
+				detail::heap_position_tracker<IndexContainer> track{ &m_positions };
+				detail::heap_pop_root<Arity>(m_entries.data(), last, m_compare, track);
+			}
+			m_entries.pop_back();
+		}
+
+		/**
+		 * Removes an element
+		 * @param handle Handle of an element in the heap
+		 */
+		constexpr void erase(const heap_handle handle)
+		{
+			detail::heap_entry<ElementType>* const data = m_entries.data();
+			const size_t index = m_positions.data()[handle.m_index];
+			const size_t last = m_entries.size() - 1;
+
+			m_free_handles.emplace_back(handle.m_index);
+			m_positions.data()[handle.m_index] = npos;
+			if (index != last)
+			{
+				data[index] = std::move(data[last]);
+			}
+			m_entries.pop_back();
+
+			if (index != last)
+			{
+				detail::heap_position_tracker<IndexContainer> track{ &m_positions };
+				detail::heap_update<Arity>(data, last, index, m_compare, track);
+			}
+		}
+
+		/**
+		 * Moves an element towards the top after it got greater (for a min-heap, after its key decreased)
+		 * @param handle Handle of an element in the heap
+		 * @param value New value, must not compare less than the old one
+		 */
+		constexpr void decrease_key(const heap_handle handle, ElementType value)
+		{
+			const size_t index = m_positions.data()[handle.m_index];
+			m_entries.data()[index].m_value = std::move(value);
+			sift_up(index);
+		}
+
+		/**
+		 * Moves an element towards the leaves after it got smaller (for a min-heap, after its key increased)
+		 * @param handle Handle of an element in the heap
+		 * @param value New value, must not compare greater than the old one
+		 */
+		constexpr void increase_key(const heap_handle handle, ElementType value)
+		{
+			const size_t index = m_positions.data()[handle.m_index];
+			m_entries.data()[index].m_value = std::move(value);
+
+			detail::heap_position_tracker<IndexContainer> track{ &m_positions };
+			detail::heap_sift_down<Arity>(m_entries.data(), m_entries.size(), index, m_compare, track);
+		}
+
+		/**
+		 * Replaces an element, it moves in whichever direction the new value requires
+		 * @param handle Handle of an element in the heap
+		 * @param value New value
+		 */
+		constexpr void update(const heap_handle handle, ElementType value)
+		{
+			const size_t index = m_positions.data()[handle.m_index];
+			m_entries.data()[index].m_value = std::move(value);
+
+			detail::heap_position_tracker<IndexContainer> track{ &m_positions };
+			detail::heap_update<Arity>(m_entries.data(), m_entries.size(), index, m_compare, track);
+		}
+
+		/**
+		 * Removes all elements, every handle becomes invalid
+		 */
+		constexpr void clear() noexcept
+		{
+			m_entries.clear();
+			m_positions.clear();
+			m_free_handles.clear();
+		}
+
+	private:
+		constexpr void sift_up(const size_t index)
+		{
+			detail::heap_position_tracker<IndexContainer> track{ &m_positions };
+			detail::heap_sift_up<Arity>(m_entries.data(), index, m_compare, track);
+		}
+	};
+
+	/**
+	 * Class keeping the k greatest of the pushed elements: a d-ary heap ordered the other way around holds them, so
+	 * its top is the smallest kept element and a new one either replaces it with a single sift or is dropped
+	 * @tparam ElementType Type of the elements
+	 * @tparam Arity Count of children of each node
+	 * @tparam Compare Strict weak ordering, the greatest elements are kept (std::greater<> keeps the k smallest)
+	 * @tparam Container Contiguous container holding the elements (woj::vector or stack::inplace_vector)
+	 */
+	template <typename ElementType, size_t Arity, typename Compare, typename Container>
+	class basic_top_k
+	{
+	public:
+		using value_type = ElementType;
+		using value_compare = Compare;
+		using container_type = Container;
+		using size_type = size_t;
+
+		basic_dary_heap<ElementType, Arity, detail::heap_reverse<Compare>, Container> m_heap;
+		size_type m_k;
+
+		/**
+		 * @param k Count of elements to keep (at most the capacity of a fixed-capacity container)
+		 * @param compare Strict weak ordering
+		 */
+		explicit constexpr basic_top_k(const size_type k, const Compare& compare = Compare{}) : m_heap{ detail::heap_reverse<Compare>{ compare } }, m_k{ k }
+		{
+			m_heap.reserve(k);
+		}
+
+		/**
+		 * Offers an element
+		 * @return True if the element is kept (it may be evicted by later ones)
+		 */
+		constexpr bool push(const ElementType& value)
+		{
+			if (m_heap.size() < m_k)
+			{
+				m_heap.push(value);
+				return true;
+			}
+			if (m_k == 0 || !m_heap.m_compare.m_compare(m_heap.top(), value))
+			{
+				return false;
+			}
+			m_heap.replace_top(value);
+			return true;
+		}
+
+		constexpr bool push(ElementType&& value)
+		{
+			if (m_heap.size() < m_k)
+			{
+				m_heap.push(std::move(value));
+				return true;
+			}
+			if (m_k == 0 || !m_heap.m_compare.m_compare(m_heap.top(), value))
+			{
+				return false;
+			}
+			m_heap.replace_top(std::move(value));
+			return true;
+		}
+
+		/**
+		 * Offers every element of a range
+		 */
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr void push(InputIterator first, const InputIterator last)
+		{
+			for (; first != last; ++first)
+			{
+				push(*first);
+			}
+		}
+
+		/**
+		 * @return The smallest kept element (the threshold a new element has to beat once k are kept)
+		 */
+		WOJ_NODISCARD constexpr const ElementType& threshold() const noexcept
+		{
+			return m_heap.top();
+		}
+
+		WOJ_NODISCARD constexpr size_type size() const noexcept
+		{
+			return m_heap.size();
+		}
+
+		WOJ_NODISCARD constexpr bool empty() const noexcept
+		{
+			return m_heap.empty();
+		}
+
+		WOJ_NODISCARD constexpr size_type k() const noexcept
+		{
+			return m_k;
+		}
+
+		/**
+		 * @return The kept elements in heap order
+		 */
+		WOJ_NODISCARD constexpr const Container& elements() const noexcept
+		{
+			return m_heap.elements();
+		}
+
+		/**
+		 * Sorts the kept elements from the greatest to the smallest and hands them out, nothing is kept afterwards
+		 */
+		WOJ_NODISCARD constexpr Container extract_sorted()
+		{
+			Container sorted = m_heap.extract_sorted();
+			std::reverse(sorted.begin(), sorted.end());
+			return sorted;
+		}
+
+		constexpr void clear() noexcept
+		{
+			m_heap.clear();
+		}
+	};
+
+	/**
+	 * Growable d-ary heap
+	 */
+	template <typename ElementType, size_t Arity = 4, typename Compare = std::less<>>
+	using dary_heap = basic_dary_heap<ElementType, Arity, Compare, vector<ElementType>>;
+
+	/**
+	 * Growable addressable d-ary heap
+	 */
+	template <typename ElementType, size_t Arity = 4, typename Compare = std::less<>>
+	using addressable_dary_heap = basic_addressable_dary_heap<ElementType, Arity, Compare, vector<detail::heap_entry<ElementType>>, vector<size_t>>;
+
+	/**
+	 * Growable top-k selection
+	 */
+	template <typename ElementType, size_t Arity = 4, typename Compare = std::less<>>
+	using top_k = basic_top_k<ElementType, Arity, Compare, vector<ElementType>>;
+
+	namespace stack
+	{
+		/**
+		 * Fixed-capacity, allocation-free d-ary heap
+		 */
+		template <typename ElementType, size_t Capacity, size_t Arity = 4, typename Compare = std::less<>>
+		using dary_heap = basic_dary_heap<ElementType, Arity, Compare, inplace_vector<ElementType, Capacity>>;
+
+		/**
+		 * Fixed-capacity, allocation-free addressable d-ary heap
+		 */
+		template <typename ElementType, size_t Capacity, size_t Arity = 4, typename Compare = std::less<>>
+		using addressable_dary_heap = basic_addressable_dary_heap<ElementType, Arity, Compare, inplace_vector<detail::heap_entry<ElementType>, Capacity>, inplace_vector<size_t, Capacity>>;
+
+		/**
+		 * Fixed-capacity, allocation-free top-k selection (k is at most Capacity)
+		 */
+		template <typename ElementType, size_t Capacity, size_t Arity = 4, typename Compare = std::less<>>
+		using top_k = basic_top_k<ElementType, Arity, Compare, inplace_vector<ElementType, Capacity>>;
+	}
+}
@@ -0,0 +1,474 @@
+#pragma once
+
+#include "base.hpp"
+#include "simd.hpp"
+#include "string.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#ifndef WOJ_EDIT_DISTANCE_HPP
+#define WOJ_EDIT_DISTANCE_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Passed as max_distance to compute the exact distance without a bound
+	 */
+	inline constexpr size_t unbounded_distance = static_cast<size_t>(-1) / 2;
+
+	namespace detail
+	{
+		/**
+		 * Match masks of a pattern (bit i of word w is set if pattern[w * 64 + i] == c), the table is direct-mapped for
+		 * 1-byte characters and open-addressed for wider ones
+		 * @tparam Elem Type of the pattern's elements
+		 * @tparam Words Count of 64-bit words per mask (pattern length <= Words * 64)
+		 */
+		template <typename Elem, size_t Words>
+		class pattern_masks
+		{
+		public:
+			static constexpr bool direct = sizeof(Elem) == 1;
+			static constexpr size_t table_size = direct ? 256 : 256 * Words;
+
+			uint64_t m_masks[table_size][Words];
+			Elem m_keys[direct ? 1 : table_size];
+			bool m_used[direct ? 1 : table_size];
+
+			constexpr pattern_masks(const Elem* const pattern, const size_t length) noexcept : m_masks{}, m_keys{}, m_used{}
+			{
+				for (size_t i = 0; i < length; ++i)
+				{
+					m_masks[slot_for_insert(pattern[i])][i / 64] |= 1ull << (i % 64);
+				}
+			}
+
+			WOJ_NODISCARD constexpr const uint64_t* get(const Elem c) const noexcept
+			{
+				if constexpr (direct)
+				{
+					return m_masks[static_cast<unsigned char>(c)];
+				}
+				else
+				{
+					for (size_t slot = hash_slot(c);; slot = (slot + 1) % table_size)
+					{
+						if (!m_used[slot] || m_keys[slot] == c)
+						{
+							// Unused slots hold zero masks
+							return m_masks[slot];
+						}
+					}
+				}
+			}
+
+		private:
+			WOJ_NODISCARD static constexpr size_t hash_slot(const Elem c) noexcept
+			{
+				return static_cast<size_t>((static_cast<uint64_t>(c) * 0x9E3779B97F4A7C15ull) >> 40) % table_size;
+			}
+
+			constexpr size_t slot_for_insert(const Elem c) noexcept
+			{
+				if constexpr (direct)
+				{
+					return static_cast<unsigned char>(c);
+				}
+				else
+				{
+					size_t slot = hash_slot(c);
+					for (; m_used[slot] && m_keys[slot] != c; slot = (slot + 1) % table_size);
+					m_used[slot] = true;
+					m_keys[slot] = c;
+					return slot;
+				}
+			}
+		};
+
+		/**
+		 * Strips the common prefix and suffix (they never contribute to the distance)
+		 */
+		template <typename Elem>
+		constexpr void strip_common_affix(const Elem*& a, size_t& a_length, const Elem*& b, size_t& b_length) noexcept
+		{
+			while (a_length && b_length && *a == *b)
+			{
+				++a, ++b, --a_length, --b_length;
+			}
+			while (a_length && b_length && a[a_length - 1] == b[b_length - 1])
+			{
+				--a_length, --b_length;
+			}
+		}
+
+		/**
+		 * Bit-parallel edit distance (Myers 1999, Hyyro 2003 for transpositions and multiple words)
+		 * @tparam Words Count of 64-bit words per column (pattern length <= Words * 64)
+		 * @tparam Transpositions Whether adjacent transpositions cost 1 (optimal string alignment distance)
+		 * @param masks Match masks of the pattern
+		 * @param pattern_length Length of the pattern (> 0)
+		 * @param text Text to compare with
+		 * @param text_length Length of the text
+		 * @param max_distance Bound of the distance
+		 * @return Distance or max_distance + 1 if the distance exceeds the bound
+		 */
+		template <size_t Words, bool Transpositions, typename Elem>
+		constexpr size_t myers_distance(const pattern_masks<Elem, Words>& masks, const size_t pattern_length, const Elem* const text, const size_t text_length, const size_t max_distance) noexcept
+		{
+			constexpr uint64_t zero_masks[Words]{};
+
+			uint64_t vp[Words];
+			uint64_t vn[Words]{};
+			uint64_t d0[Words]{};
+			const uint64_t* previous_eq = zero_masks;
+
+			for (size_t w = 0; w < Words; ++w)
+			{
+				vp[w] = ~0ull;
+			}
+
+			const uint64_t last = 1ull << ((pattern_length - 1) % 64);
+			size_t score = pattern_length;
+
+			for (size_t j = 0; j < text_length; ++j)
+			{
+				const uint64_t* const eq = masks.get(text[j]);
+				uint64_t hp_carry = 1;
+				uint64_t hn_carry = 0;
+				uint64_t add_carry = 0;
+				uint64_t tr_carry = 0;
+
+				for (size_t w = 0; w < Words; ++w)
+				{
+					const uint64_t x = eq[w] | hn_carry;
+
+					// (x & vp) + vp with the carry of the lower word
+					const uint64_t sum_low = (x & vp[w]) + vp[w];
+					const uint64_t sum = sum_low + add_carry;
+					add_carry = (sum_low < vp[w]) | (sum < sum_low);
+
+					uint64_t d = ((sum ^ vp[w]) | x | vn[w]);
+
+					if constexpr (Transpositions)
+					{
+						const uint64_t tr_source = ~d0[w] & eq[w];
+						d |= ((tr_source << 1) | tr_carry) & previous_eq[w];
+						tr_carry = tr_source >> 63;
+						d0[w] = d;
+					}
+
+					uint64_t hp = vn[w] | ~(d | vp[w]);
+					uint64_t hn = d & vp[w];
+
+					if (w == Words - 1)
+					{
+						score += (hp & last) != 0;
+						score -= (hn & last) != 0;
+					}
+
+					const uint64_t hp_out = hp >> 63;
+					const uint64_t hn_out = hn >> 63;
+					hp = (hp << 1) | hp_carry;
+					hn = (hn << 1) | hn_carry;
+					hp_carry = hp_out;
+					hn_carry = hn_out;
+
+					vp[w] = hn | ~(d | hp);
+					vn[w] = hp & d;
+				}
+
+				previous_eq = eq;
+
+				// The score drops by at most 1 per remaining text character
+				if (score > max_distance + (text_length - j - 1)) WOJ_UNLIKELY
+				{
+					return max_distance + 1;
+				}
+			}
+
+			return score <= max_distance ? score : max_distance + 1;
+		}
+
+		/**
+		 * Dynamic-programming fallback for patterns longer than 128 characters (allocates two or three rows)
+		 */
+		template <bool Transpositions, typename Elem>
+		constexpr size_t dp_distance(const Elem* const a, const size_t a_length, const Elem* const b, const size_t b_length, const size_t max_distance)
+		{
+			std::vector<size_t> before(Transpositions ? a_length + 1 : 0);
+			std::vector<size_t> previous(a_length + 1);
+			std::vector<size_t> current(a_length + 1);
+
+			for (size_t i = 0; i <= a_length; ++i)
+			{
+				previous[i] = i;
+			}
+
+			for (size_t j = 1; j <= b_length; ++j)
+			{
+				current[0] = j;
+				size_t row_min = j;
+
+				for (size_t i = 1; i <= a_length; ++i)
+				{
+					const size_t cost = a[i - 1] != b[j - 1];
+					current[i] = (std::min)({ previous[i] + 1, current[i - 1] + 1, previous[i - 1] + cost });
+
+					if constexpr (Transpositions)
+					{
+						if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+						{
+							current[i] = (std::min)(current[i], before[i - 2] + 1);
+						}
+					}
+
+					row_min = (std::min)(row_min, current[i]);
+				}
+
+				if (row_min > max_distance) WOJ_UNLIKELY
+				{
+					return max_distance + 1;
+				}
+
+				if constexpr (Transpositions)
+				{
+					before.swap(previous);
+				}
+				previous.swap(current);
+			}
+
+			return previous[a_length] <= max_distance ? previous[a_length] : max_distance + 1;
+		}
+
+		template <bool Transpositions, typename Elem>
+		constexpr size_t edit_distance(const Elem* a, size_t a_length, const Elem* b, size_t b_length, const size_t max_distance)
+		{
+			// The shorter string is the bit-parallel pattern
+			if (a_length > b_length)
+			{
+				std::swap(a, b);
+				std::swap(a_length, b_length);
+			}
+
+			if (b_length - a_length > max_distance)
+			{
+				return max_distance + 1;
+			}
+
+			strip_common_affix(a, a_length, b, b_length);
+
+			if (!a_length)
+			{
+				return b_length <= max_distance ? b_length : max_distance + 1;
+			}
+
+			if (a_length <= 64)
+			{
+				return myers_distance<1, Transpositions>(pattern_masks<Elem, 1>{ a, a_length }, a_length, b, b_length, max_distance);
+			}
+
+			if (a_length <= 128)
+			{
+				return myers_distance<2, Transpositions>(pattern_masks<Elem, 2>{ a, a_length }, a_length, b, b_length, max_distance);
+			}
+
+			return dp_distance<Transpositions>(a, a_length, b, b_length, max_distance);
+		}
+
+#if defined(WOJ_HAS_AVX2)
+		/**
+		 * Scores one pattern (1..64 characters) against four texts at once, one text per 64-bit lane
+		 */
+		inline void myers_distance_x4(const pattern_masks<char, 1>& masks, const size_t pattern_length, const char* const (&texts)[4], const size_t (&text_lengths)[4], size_t (&distances)[4]) noexcept
+		{
+			const __m256i ones = _mm256_set1_epi64x(-1);
+			const __m256i last = _mm256_set1_epi64x(static_cast<int64_t>(1ull << ((pattern_length - 1) % 64)));
+			const __m256i lengths = _mm256_setr_epi64x(static_cast<int64_t>(text_lengths[0]), static_cast<int64_t>(text_lengths[1]), static_cast<int64_t>(text_lengths[2]), static_cast<int64_t>(text_lengths[3]));
+
+			__m256i vp = ones;
+			__m256i vn = _mm256_setzero_si256();
+			__m256i score = _mm256_set1_epi64x(static_cast<int64_t>(pattern_length));
+
+			const size_t longest = (std::max)({ text_lengths[0], text_lengths[1], text_lengths[2], text_lengths[3] });
+
+			for (size_t j = 0; j < longest; ++j)
+			{
+				const auto mask_at = [&](const size_t lane) noexcept
+				{
+					return j < text_lengths[lane] ? static_cast<int64_t>(masks.get(texts[lane][j])[0]) : 0ll;
+				};
+
+				const __m256i eq = _mm256_setr_epi64x(mask_at(0), mask_at(1), mask_at(2), mask_at(3));
+				const __m256i active = _mm256_cmpgt_epi64(lengths, _mm256_set1_epi64x(static_cast<int64_t>(j)));
+
+				const __m256i x = eq;
+				const __m256i sum = _mm256_add_epi64(_mm256_and_si256(x, vp), vp);
+				const __m256i d = _mm256_or_si256(_mm256_or_si256(_mm256_xor_si256(sum, vp), x), vn);
+
+				__m256i hp = _mm256_or_si256(vn, _mm256_xor_si256(_mm256_or_si256(d, vp), ones));
+				__m256i hn = _mm256_and_si256(d, vp);
+
+				// cmpeq yields -1 for set bits: subtracting it increments, adding it decrements
+				const __m256i hp_last = _mm256_and_si256(_mm256_cmpeq_epi64(_mm256_and_si256(hp, last), last), active);
+				const __m256i hn_last = _mm256_and_si256(_mm256_cmpeq_epi64(_mm256_and_si256(hn, last), last), active);
+				score = _mm256_add_epi64(_mm256_sub_epi64(score, hp_last), hn_last);
+
+				hp = _mm256_or_si256(_mm256_slli_epi64(hp, 1), _mm256_set1_epi64x(1));
+				hn = _mm256_slli_epi64(hn, 1);
+
+				const __m256i next_vp = _mm256_or_si256(hn, _mm256_xor_si256(_mm256_or_si256(d, hp), ones));
+				const __m256i next_vn = _mm256_and_si256(hp, d);
+
+				vp = _mm256_blendv_epi8(vp, next_vp, active);
+				vn = _mm256_blendv_epi8(vn, next_vn, active);
+			}
+
+			alignas(32) int64_t scores[4];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(scores), score);
+			for (size_t lane = 0; lane < 4; ++lane)
+			{
+				distances[lane] = static_cast<size_t>(scores[lane]);
+			}
+		}
+#endif
+	}
+
+	/**
+	 * Computes the Levenshtein distance (insertions, deletions and substitutions cost 1)
+	 * @tparam Elem Type of the strings' elements
+	 * @param a First string
+	 * @param a_length Length of the first string
+	 * @param b Second string
+	 * @param b_length Length of the second string
+	 * @param max_distance Bound of the distance, computation stops early once it is certainly exceeded
+	 * @return Distance or max_distance + 1 if the distance exceeds the bound
+	 */
+	template <typename Elem>
+	WOJ_NODISCARD constexpr size_t levenshtein(const Elem* const a, const size_t a_length, const Elem* const b, const size_t b_length, const size_t max_distance = unbounded_distance)
+	{
+		return detail::edit_distance<false>(a, a_length, b, b_length, max_distance);
+	}
+
+	template <typename Elem, size_t AMemSize, size_t BMemSize>
+	WOJ_NODISCARD constexpr size_t levenshtein(const stack::string<Elem, AMemSize>& a, const stack::string<Elem, BMemSize>& b, const size_t max_distance = unbounded_distance)
+	{
+		return levenshtein(a.data(), a.str_size(), b.data(), b.str_size(), max_distance);
+	}
+
+	/**
+	 * Computes the Damerau-Levenshtein distance in its optimal string alignment variant (adjacent transpositions cost 1,
+	 * a substring is edited at most once)
+	 * @tparam Elem Type of the strings' elements
+	 * @param a First string
+	 * @param a_length Length of the first string
+	 * @param b Second string
+	 * @param b_length Length of the second string
+	 * @param max_distance Bound of the distance, computation stops early once it is certainly exceeded
+	 * @return Distance or max_distance + 1 if the distance exceeds the bound
+	 */
+	template <typename Elem>
+	WOJ_NODISCARD constexpr size_t damerau_levenshtein(const Elem* const a, const size_t a_length, const Elem* const b, const size_t b_length, const size_t max_distance = unbounded_distance)
+	{
+		return detail::edit_distance<true>(a, a_length, b, b_length, max_distance);
+	}
+
+	template <typename Elem, size_t AMemSize, size_t BMemSize>
+	WOJ_NODISCARD constexpr size_t damerau_levenshtein(const stack::string<Elem, AMemSize>& a, const stack::string<Elem, BMemSize>& b, const size_t max_distance = unbounded_distance)
+	{
+		return damerau_levenshtein(a.data(), a.str_size(), b.data(), b.str_size(), max_distance);
+	}
+
+	/**
+	 * Scores one query against many candidates with the Levenshtein distance, the query's match masks are built once
+	 * and (with AVX2, char strings, queries up to 64 characters) four candidates are scored per pass
+	 * @tparam Elem Type of the strings' elements
+	 * @tparam QueryMemSize MemSize of the query
+	 * @tparam CandidateMemSize MemSize of the candidates
+	 * @param query Query to score against
+	 * @param candidates Candidates to score
+	 * @param count Count of candidates
+	 * @param distances Output distances (count elements), max_distance + 1 where the bound is exceeded
+	 * @param max_distance Bound of the distance
+	 */
+	template <typename Elem, size_t QueryMemSize, size_t CandidateMemSize>
+	void levenshtein_batch(const stack::string<Elem, QueryMemSize>& query, const stack::string<Elem, CandidateMemSize>* const candidates, const size_t count, size_t* const distances, const size_t max_distance = unbounded_distance)
+	{
+		const size_t query_length = query.str_size();
+
+		if (!query_length || query_length > 64)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				distances[i] = levenshtein(query, candidates[i], max_distance);
+			}
+			return;
+		}
+
+		const detail::pattern_masks<Elem, 1> masks{ query.data(), query_length };
+		size_t i = 0;
+
+#if defined(WOJ_HAS_AVX2)
+		if constexpr (std::is_same_v<Elem, char>)
+		{
+			for (; i + 4 <= count; i += 4)
+			{
+				const char* const texts[4]{ candidates[i].data(), candidates[i + 1].data(), candidates[i + 2].data(), candidates[i + 3].data() };
+				const size_t lengths[4]{ candidates[i].str_size(), candidates[i + 1].str_size(), candidates[i + 2].str_size(), candidates[i + 3].str_size() };
+				size_t lane_distances[4];
+
+				detail::myers_distance_x4(masks, query_length, texts, lengths, lane_distances);
+
+				for (size_t lane = 0; lane < 4; ++lane)
+				{
+					distances[i + lane] = lane_distances[lane] <= max_distance ? lane_distances[lane] : max_distance + 1;
+				}
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			const size_t length = candidates[i].str_size();
+			const size_t length_difference = length > query_length ? length - query_length : query_length - length;
+
+			distances[i] = length_difference > max_distance ? max_distance + 1 : detail::myers_distance<1, false>(masks, query_length, candidates[i].data(), length, max_distance);
+		}
+	}
+
+	/**
+	 * Finds the candidate closest to the query by Levenshtein distance
+	 * @param query Query to match
+	 * @param candidates Candidates to match against
+	 * @param count Count of candidates
+	 * @param max_distance Bound of the distance, candidates further away are ignored
+	 * @return Index of the first closest candidate or count if no candidate is within the bound
+	 */
+	template <typename Elem, size_t QueryMemSize, size_t CandidateMemSize>
+	WOJ_NODISCARD size_t best_match(const stack::string<Elem, QueryMemSize>& query, const stack::string<Elem, CandidateMemSize>* const candidates, const size_t count, size_t max_distance = unbounded_distance)
+	{
+		constexpr size_t chunk_size = 64;
+		size_t distances[chunk_size];
+		size_t best = count;
+
+		for (size_t first = 0; first < count; first += chunk_size)
+		{
+			const size_t chunk = (std::min)(chunk_size, count - first);
+			levenshtein_batch(query, candidates + first, chunk, distances, max_distance);
+
+			for (size_t i = 0; i < chunk; ++i)
+			{
+				if (distances[i] <= max_distance && (best == count || distances[i] < max_distance))
+				{
+					best = first + i;
+					// Tightening the bound lets later candidates exit early
+					max_distance = distances[i];
+				}
+			}
+		}
+
+		return best;
+	}
+}
@@ -0,0 +1,686 @@
+#pragma once
+
+#include "base.hpp"
+#include "simd.hpp"
+#include "string.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef WOJ_ENCODING_HPP
+#define WOJ_ENCODING_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Returned by decoders when the input is not strictly valid
+	 */
+	inline constexpr size_t invalid_encoding = static_cast<size_t>(-1);
+
+	namespace hex
+	{
+		namespace detail
+		{
+			inline constexpr char lower_digits[17] = "0123456789abcdef";
+			inline constexpr char upper_digits[17] = "0123456789ABCDEF";
+
+			WOJ_NODISCARD constexpr uint8_t nibble(const char c) noexcept
+			{
+				if (c >= '0' && c <= '9')
+				{
+					return static_cast<uint8_t>(c - '0');
+				}
+				if (c >= 'a' && c <= 'f')
+				{
+					return static_cast<uint8_t>(c - 'a' + 10);
+				}
+				if (c >= 'A' && c <= 'F')
+				{
+					return static_cast<uint8_t>(c - 'A' + 10);
+				}
+				return 0xFF;
+			}
+
+#if defined(WOJ_HAS_SSSE3)
+			/**
+			 * Converts 16 hex characters to nibble values
+			 * @param valid Cleared if any character is not a hex digit
+			 */
+			inline __m128i nibbles16(const __m128i chars, bool& valid) noexcept
+			{
+				const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+				const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+				const __m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+				const __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+				valid &= _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) == 0xFFFF;
+
+				return _mm_or_si128(_mm_and_si128(digit, is_digit), _mm_and_si128(_mm_add_epi8(alpha, _mm_set1_epi8(10)), is_alpha));
+			}
+#endif
+
+#if defined(WOJ_HAS_AVX2)
+			inline __m256i nibbles32(const __m256i chars, bool& valid) noexcept
+			{
+				const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+				const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+				const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+				const __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+				valid &= _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) == -1;
+
+				return _mm256_or_si256(_mm256_and_si256(digit, is_digit), _mm256_and_si256(_mm256_add_epi8(alpha, _mm256_set1_epi8(10)), is_alpha));
+			}
+#endif
+		}
+
+		/**
+		 * @param size Count of bytes to encode
+		 * @return Count of characters produced by encode
+		 */
+		WOJ_NODISCARD constexpr size_t encoded_size(const size_t size) noexcept
+		{
+			return size * 2;
+		}
+
+		/**
+		 * @param size Count of characters to decode
+		 * @return Maximum count of bytes produced by decode
+		 */
+		WOJ_NODISCARD constexpr size_t decoded_size(const size_t size) noexcept
+		{
+			return size / 2;
+		}
+
+		/**
+		 * Type of a string holding the hex encoding of Size bytes (compile-time output capacity)
+		 */
+		template <size_t Size>
+		using encoded_string = stack::string<char, encoded_size(Size)>;
+
+		/**
+		 * Encodes bytes to hex
+		 * @tparam Uppercase Whether to use uppercase digits
+		 * @param src Bytes to encode
+		 * @param size Count of bytes to encode
+		 * @param dst Output buffer (at least encoded_size(size) characters, not null-terminated)
+		 * @return Count of characters written
+		 */
+		template <bool Uppercase = false>
+		constexpr size_t encode(const uint8_t* const src, const size_t size, char* const dst) noexcept
+		{
+			constexpr const char* digits = Uppercase ? detail::upper_digits : detail::lower_digits;
+			size_t i = 0;
+
+			if (!is_constant_evaluated())
+			{
+#if defined(WOJ_HAS_SSSE3)
+				const __m128i lookup = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+				const __m128i low_mask = _mm_set1_epi8(0x0F);
+#endif
+#if defined(WOJ_HAS_AVX2)
+				const __m256i lookup256 = _mm256_broadcastsi128_si256(lookup);
+				const __m256i low_mask256 = _mm256_set1_epi8(0x0F);
+
+				for (; i + 32 <= size; i += 32)
+				{
+					const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+					const __m256i high = _mm256_shuffle_epi8(lookup256, _mm256_and_si256(_mm256_srli_epi16(in, 4), low_mask256));
+					const __m256i low = _mm256_shuffle_epi8(lookup256, _mm256_and_si256(in, low_mask256));
+
+					// Unpacking works per 128-bit lane, the permutes restore byte order
+					const __m256i first = _mm256_unpacklo_epi8(high, low);
+					const __m256i second = _mm256_unpackhi_epi8(high, low);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_permute2x128_si256(first, second, 0x20));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 32), _mm256_permute2x128_si256(first, second, 0x31));
+				}
+#endif
+#if defined(WOJ_HAS_SSSE3)
+				for (; i + 16 <= size; i += 16)
+				{
+					const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+					const __m128i high = _mm_shuffle_epi8(lookup, _mm_and_si128(_mm_srli_epi16(in, 4), low_mask));
+					const __m128i low = _mm_shuffle_epi8(lookup, _mm_and_si128(in, low_mask));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_unpacklo_epi8(high, low));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 16), _mm_unpackhi_epi8(high, low));
+				}
+#endif
+			}
+
+			for (; i < size; ++i)
+			{
+				dst[i * 2] = digits[src[i] >> 4];
+				dst[i * 2 + 1] = digits[src[i] & 0x0F];
+			}
+
+			return size * 2;
+		}
+
+		/**
+		 * Encodes a fixed-size byte array to hex (capacity checked at compile-time)
+		 * @tparam Uppercase Whether to use uppercase digits
+		 * @param src Bytes to encode
+		 * @param dst Output string
+		 */
+		template <bool Uppercase = false, size_t Size, size_t MemSize>
+		constexpr void encode(const uint8_t (&src)[Size], stack::string<char, MemSize>& dst) noexcept
+		{
+			static_assert(MemSize >= encoded_size(Size), "Output string is too small");
+
+			encode<Uppercase>(src, Size, dst.data());
+			if constexpr (MemSize > encoded_size(Size))
+			{
+				dst[encoded_size(Size)] = '\0';
+			}
+		}
+
+		/**
+		 * Encodes bytes to hex into a string
+		 * @tparam Uppercase Whether to use uppercase digits
+		 * @param src Bytes to encode
+		 * @param size Count of bytes to encode
+		 * @param dst Output string
+		 * @return False (and dst untouched) if the string is too small
+		 */
+		template <bool Uppercase = false, size_t MemSize>
+		constexpr bool encode(const uint8_t* const src, const size_t size, stack::string<char, MemSize>& dst) noexcept
+		{
+			if (encoded_size(size) > MemSize)
+			{
+				return false;
+			}
+
+			encode<Uppercase>(src, size, dst.data());
+			if (encoded_size(size) < MemSize)
+			{
+				dst[encoded_size(size)] = '\0';
+			}
+			return true;
+		}
+
+		/**
+		 * Encodes bytes to hex into a heap string (replaces its contents)
+		 * @tparam Uppercase Whether to use uppercase digits
+		 * @param src Bytes to encode
+		 * @param size Count of bytes to encode
+		 * @param dst Output string
+		 */
+		template <bool Uppercase = false>
+		void encode(const uint8_t* const src, const size_t size, std::string& dst)
+		{
+			dst.resize(encoded_size(size));
+			encode<Uppercase>(src, size, dst.data());
+		}
+
+		/**
+		 * Decodes hex (both cases accepted, every character must be a hex digit and the length must be even)
+		 * @param src Characters to decode
+		 * @param size Count of characters to decode
+		 * @param dst Output buffer (at least decoded_size(size) bytes)
+		 * @return Count of bytes written or invalid_encoding
+		 */
+		constexpr size_t decode(const char* const src, const size_t size, uint8_t* const dst) noexcept
+		{
+			if (size % 2)
+			{
+				return invalid_encoding;
+			}
+
+			size_t i = 0;
+
+			if (!is_constant_evaluated())
+			{
+				bool valid = true;
+#if defined(WOJ_HAS_AVX2)
+				for (; i + 64 <= size && valid; i += 64)
+				{
+					const __m256i first = detail::nibbles32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), valid);
+					const __m256i second = detail::nibbles32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)), valid);
+					const __m256i weights = _mm256_set1_epi16(0x0110);
+
+					// high * 16 + low for every pair, then narrowed back to bytes
+					const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+				}
+#endif
+#if defined(WOJ_HAS_SSSE3)
+				for (; i + 32 <= size && valid; i += 32)
+				{
+					const __m128i first = detail::nibbles16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), valid);
+					const __m128i second = detail::nibbles16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)), valid);
+					const __m128i weights = _mm_set1_epi16(0x0110);
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i / 2), _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights)));
+				}
+#endif
+				if (!valid)
+				{
+					return invalid_encoding;
+				}
+			}
+
+			for (; i < size; i += 2)
+			{
+				const uint8_t high = detail::nibble(src[i]);
+				const uint8_t low = detail::nibble(src[i + 1]);
+
+				if ((high | low) & 0xF0) WOJ_UNLIKELY
+				{
+					return invalid_encoding;
+				}
+
+				dst[i / 2] = static_cast<uint8_t>(high << 4 | low);
+			}
+
+			return size / 2;
+		}
+
+		template <size_t MemSize>
+		constexpr size_t decode(const stack::string<char, MemSize>& src, uint8_t* const dst) noexcept
+		{
+			return decode(src.data(), src.str_size(), dst);
+		}
+
+		/**
+		 * Decodes hex into a heap buffer (replaces its contents, left empty if the input is invalid)
+		 * @param src Characters to decode
+		 * @param size Count of characters to decode
+		 * @param dst Output buffer
+		 * @return False if the input is invalid
+		 */
+		inline bool decode(const char* const src, const size_t size, std::vector<uint8_t>& dst)
+		{
+			dst.resize(decoded_size(size));
+			if (decode(src, size, dst.data()) == invalid_encoding)
+			{
+				dst.clear();
+				return false;
+			}
+			return true;
+		}
+	}
+
+	namespace base64
+	{
+		namespace detail
+		{
+			inline constexpr char alphabet[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+			WOJ_NODISCARD constexpr uint8_t sextet(const char c) noexcept
+			{
+				if (c >= 'A' && c <= 'Z')
+				{
+					return static_cast<uint8_t>(c - 'A');
+				}
+				if (c >= 'a' && c <= 'z')
+				{
+					return static_cast<uint8_t>(c - 'a' + 26);
+				}
+				if (c >= '0' && c <= '9')
+				{
+					return static_cast<uint8_t>(c - '0' + 52);
+				}
+				if (c == '+')
+				{
+					return 62;
+				}
+				if (c == '/')
+				{
+					return 63;
+				}
+				return 0xFF;
+			}
+
+#if defined(WOJ_HAS_SSSE3)
+			/**
+			 * Splits 12 bytes (reshuffled into 4-byte groups) to 16 sextets and maps them to ASCII (W. Mula, D. Lemire)
+			 */
+			inline __m128i encode12(__m128i in) noexcept
+			{
+				in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+				const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+				const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+				const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+				const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+				const __m128i indices = _mm_or_si128(t1, t3);
+
+				// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12, then an offset is looked up
+				const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+				__m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+				reduced = _mm_or_si128(reduced, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+
+				return _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+			}
+
+			/**
+			 * Maps 16 characters to sextets and packs them to 12 bytes (in the low 12 bytes)
+			 * @param valid Cleared if any character is outside of the alphabet
+			 */
+			inline __m128i decode16(const __m128i in, bool& valid) noexcept
+			{
+				const __m128i low_nibble_mask = _mm_set1_epi8(0x0F);
+				const __m128i high_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), low_nibble_mask);
+				const __m128i low_nibbles = _mm_and_si128(in, low_nibble_mask);
+
+				const __m128i low_lookup = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+				const __m128i high_lookup = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+				const __m128i roll_lookup = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+
+				const __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(low_lookup, low_nibbles), _mm_shuffle_epi8(high_lookup, high_nibbles));
+				valid &= _mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) == 0xFFFF;
+
+				const __m128i roll = _mm_shuffle_epi8(roll_lookup, _mm_add_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')), high_nibbles));
+				const __m128i sextets = _mm_add_epi8(in, roll);
+
+				const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+				const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+				return _mm_shuffle_epi8(quads, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+			}
+#endif
+
+#if defined(WOJ_HAS_AVX2)
+			inline __m256i encode24(__m256i in) noexcept
+			{
+				in = _mm256_shuffle_epi8(in, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1, 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+				const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+				const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+				const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+				const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+				const __m256i indices = _mm256_or_si256(t1, t3);
+
+				const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+					'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+				__m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+				reduced = _mm256_or_si256(reduced, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+
+				return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, reduced), indices);
+			}
+
+			inline __m256i decode32(const __m256i in, bool& valid) noexcept
+			{
+				const __m256i low_nibble_mask = _mm256_set1_epi8(0x0F);
+				const __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), low_nibble_mask);
+				const __m256i low_nibbles = _mm256_and_si256(in, low_nibble_mask);
+
+				const __m256i low_lookup = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+					0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+				const __m256i high_lookup = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+					0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+				const __m256i roll_lookup = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+					0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+
+				const __m256i invalid = _mm256_and_si256(_mm256_shuffle_epi8(low_lookup, low_nibbles), _mm256_shuffle_epi8(high_lookup, high_nibbles));
+				valid &= _mm256_movemask_epi8(_mm256_cmpeq_epi8(invalid, _mm256_setzero_si256())) == -1;
+
+				const __m256i roll = _mm256_shuffle_epi8(roll_lookup, _mm256_add_epi8(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')), high_nibbles));
+				const __m256i sextets = _mm256_add_epi8(in, roll);
+
+				const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+				const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+				const __m256i packed = _mm256_shuffle_epi8(quads, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+					2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+				// Moves the 12 bytes of the upper lane next to the 12 bytes of the lower lane
+				return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+			}
+#endif
+		}
+
+		/**
+		 * @param size Count of bytes to encode
+		 * @return Count of characters produced by encode (padded)
+		 */
+		WOJ_NODISCARD constexpr size_t encoded_size(const size_t size) noexcept
+		{
+			return (size + 2) / 3 * 4;
+		}
+
+		/**
+		 * @param size Count of characters to decode
+		 * @return Maximum count of bytes produced by decode
+		 */
+		WOJ_NODISCARD constexpr size_t decoded_size(const size_t size) noexcept
+		{
+			return size / 4 * 3;
+		}
+
+		/**
+		 * Type of a string holding the Base64 encoding of Size bytes (compile-time output capacity)
+		 */
+		template <size_t Size>
+		using encoded_string = stack::string<char, encoded_size(Size)>;
+
+		/**
+		 * Encodes bytes to Base64 (standard alphabet, padded)
+		 * @param src Bytes to encode
+		 * @param size Count of bytes to encode
+		 * @param dst Output buffer (at least encoded_size(size) characters, not null-terminated)
+		 * @return Count of characters written
+		 */
+		constexpr size_t encode(const uint8_t* const src, const size_t size, char* const dst) noexcept
+		{
+			size_t i = 0;
+			size_t o = 0;
+
+			if (!is_constant_evaluated())
+			{
+#if defined(WOJ_HAS_AVX2)
+				// Each lane loads 16 bytes and consumes 12
+				for (; i + 28 <= size; i += 24, o += 32)
+				{
+					const __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12)), 1);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + o), detail::encode24(in));
+				}
+#endif
+#if defined(WOJ_HAS_SSSE3)
+				for (; i + 16 <= size; i += 12, o += 16)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + o), detail::encode12(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+				}
+#endif
+			}
+
+			for (; i + 3 <= size; i += 3, o += 4)
+			{
+				const uint32_t triple = static_cast<uint32_t>(src[i]) << 16 | static_cast<uint32_t>(src[i + 1]) << 8 | src[i + 2];
+				dst[o] = detail::alphabet[triple >> 18];
+				dst[o + 1] = detail::alphabet[(triple >> 12) & 0x3F];
+				dst[o + 2] = detail::alphabet[(triple >> 6) & 0x3F];
+				dst[o + 3] = detail::alphabet[triple & 0x3F];
+			}
+
+			if (i < size)
+			{
+				const bool two = i + 2 == size;
+				const uint32_t triple = static_cast<uint32_t>(src[i]) << 16 | (two ? static_cast<uint32_t>(src[i + 1]) << 8 : 0);
+				dst[o] = detail::alphabet[triple >> 18];
+				dst[o + 1] = detail::alphabet[(triple >> 12) & 0x3F];
+				dst[o + 2] = two ? detail::alphabet[(triple >> 6) & 0x3F] : '=';
+				dst[o + 3] = '=';
+				o += 4;
+			}
+
+			return o;
+		}
+
+		/**
+		 * Encodes a fixed-size byte array to Base64 (capacity checked at compile-time)
+		 * @param src Bytes to encode
+		 * @param dst Output string
+		 */
+		template <size_t Size, size_t MemSize>
+		constexpr void encode(const uint8_t (&src)[Size], stack::string<char, MemSize>& dst) noexcept
+		{
+			static_assert(MemSize >= encoded_size(Size), "Output string is too small");
+
+			encode(src, Size, dst.data());
+			if constexpr (MemSize > encoded_size(Size))
+			{
+				dst[encoded_size(Size)] = '\0';
+			}
+		}
+
+		/**
+		 * Encodes bytes to Base64 into a string
+		 * @param src Bytes to encode
+		 * @param size Count of bytes to encode
+		 * @param dst Output string
+		 * @return False (and dst untouched) if the string is too small
+		 */
+		template <size_t MemSize>
+		constexpr bool encode(const uint8_t* const src, const size_t size, stack::string<char, MemSize>& dst) noexcept
+		{
+			if (encoded_size(size) > MemSize)
+			{
+				return false;
+			}
+
+			encode(src, size, dst.data());
+			if (encoded_size(size) < MemSize)
+			{
+				dst[encoded_size(size)] = '\0';
+			}
+			return true;
+		}
+
+		/**
+		 * Encodes bytes to Base64 into a heap string (replaces its contents)
+		 * @param src Bytes to encode
+		 * @param size Count of bytes to encode
+		 * @param dst Output string
+		 */
+		inline void encode(const uint8_t* const src, const size_t size, std::string& dst)
+		{
+			dst.resize(encoded_size(size));
+			encode(src, size, dst.data());
+		}
+
+		/**
+		 * Decodes Base64 strictly: standard alphabet, length divisible by 4, padding only at the end and unused
+		 * bits of the last character set to zero
+		 * @param src Characters to decode
+		 * @param size Count of characters to decode
+		 * @param dst Output buffer (at least decoded_size(size) bytes)
+		 * @return Count of bytes written or invalid_encoding
+		 */
+		constexpr size_t decode(const char* const src, const size_t size, uint8_t* const dst) noexcept
+		{
+			if (size % 4)
+			{
+				return invalid_encoding;
+			}
+
+			if (!size)
+			{
+				return 0;
+			}
+
+			// The last quantum may be padded and is decoded separately
+			const size_t body = size - 4;
+			size_t i = 0;
+			size_t o = 0;
+
+			if (!is_constant_evaluated())
+			{
+				bool valid = true;
+#if defined(WOJ_HAS_AVX2)
+				// Stores 32 bytes of which 24 are valid, the slack is overwritten by the following output
+				for (; i + 48 <= body && valid; i += 32, o += 24)
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + o), detail::decode32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), valid));
+				}
+#endif
+#if defined(WOJ_HAS_SSSE3)
+				for (; i + 24 <= body && valid; i += 16, o += 12)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + o), detail::decode16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), valid));
+				}
+#endif
+				if (!valid)
+				{
+					return invalid_encoding;
+				}
+			}
+
+			for (; i < body; i += 4, o += 3)
+			{
+				const uint8_t a = detail::sextet(src[i]);
+				const uint8_t b = detail::sextet(src[i + 1]);
+				const uint8_t c = detail::sextet(src[i + 2]);
+				const uint8_t d = detail::sextet(src[i + 3]);
+
+				if ((a | b | c | d) & 0xC0) WOJ_UNLIKELY
+				{
+					return invalid_encoding;
+				}
+
+				const uint32_t triple = static_cast<uint32_t>(a) << 18 | static_cast<uint32_t>(b) << 12 | static_cast<uint32_t>(c) << 6 | d;
+				dst[o] = static_cast<uint8_t>(triple >> 16);
+				dst[o + 1] = static_cast<uint8_t>(triple >> 8);
+				dst[o + 2] = static_cast<uint8_t>(triple);
+			}
+
+			const bool pad_last = src[body + 3] == '=';
+			const bool pad_both = pad_last && src[body + 2] == '=';
+
+			const uint8_t a = detail::sextet(src[body]);
+			const uint8_t b = detail::sextet(src[body + 1]);
+			const uint8_t c = pad_both ? 0 : detail::sextet(src[body + 2]);
+			const uint8_t d = pad_last ? 0 : detail::sextet(src[body + 3]);
+
+			if ((a | b | c | d) & 0xC0) WOJ_UNLIKELY
+			{
+				return invalid_encoding;
+			}
+
+			// Bits that do not make it into the output must be zero (canonical encoding)
+			if ((pad_both && (b & 0x0F)) || (pad_last && !pad_both && (c & 0x03))) WOJ_UNLIKELY
+			{
+				return invalid_encoding;
+			}
+
+			const uint32_t triple = static_cast<uint32_t>(a) << 18 | static_cast<uint32_t>(b) << 12 | static_cast<uint32_t>(c) << 6 | d;
+			dst[o++] = static_cast<uint8_t>(triple >> 16);
+			if (!pad_both)
+			{
+				dst[o++] = static_cast<uint8_t>(triple >> 8);
+			}
+			if (!pad_last)
+			{
+				dst[o++] = static_cast<uint8_t>(triple);
+			}
+
+			return o;
+		}
+
+		template <size_t MemSize>
+		constexpr size_t decode(const stack::string<char, MemSize>& src, uint8_t* const dst) noexcept
+		{
+			return decode(src.data(), src.str_size(), dst);
+		}
+
+		/**
+		 * Decodes Base64 into a heap buffer (replaces its contents, left empty if the input is invalid)
+		 * @param src Characters to decode
+		 * @param size Count of characters to decode
+		 * @param dst Output buffer
+		 * @return False if the input is invalid
+		 */
+		inline bool decode(const char* const src, const size_t size, std::vector<uint8_t>& dst)
+		{
+			dst.resize(decoded_size(size));
+			const size_t written = decode(src, size, dst.data());
+			if (written == invalid_encoding)
+			{
+				dst.clear();
+				return false;
+			}
+			dst.resize(written);
+			return true;
+		}
+	}
+}
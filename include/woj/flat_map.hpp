@@ -0,0 +1,1368 @@
+#pragma once
+
+#include "base.hpp"
+#include "inplace_vector.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_FLAT_MAP_HPP
+#define WOJ_FLAT_MAP_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Search layout of the flat containers: sorted keys searched with a branchless binary search, or an additional
+	 * copy of the keys in Eytzinger (breadth-first) order whose search touches one cache line per 4 levels once
+	 * the next levels are prefetched, better suited to large read-mostly tables (every modification rebuilds it)
+	 */
+	enum class flat_layout : uint8_t
+	{
+		sorted,
+		eytzinger
+	};
+
+	/**
+	 * Tag telling a flat container that the given range is already sorted and free of duplicates
+	 */
+	struct sorted_unique_t
+	{
+		explicit sorted_unique_t() = default;
+	};
+
+	inline constexpr sorted_unique_t sorted_unique{};
+
+	namespace detail
+	{
+		/**
+		 * Tables bigger than this (in bytes) do not fit in L1, their binary search prefetches both possible next probes
+		 */
+		inline constexpr size_t flat_prefetch_bytes = 32768;
+
+		/**
+		 * Same kind of container as Container (same allocator or same capacity plus Extra) holding Type
+		 */
+		template <typename Container, typename Type, size_t Extra = 0>
+		struct flat_rebind;
+
+		template <typename ElementType, typename Allocator, typename GrowthFactor, typename Type, size_t Extra>
+		struct flat_rebind<vector<ElementType, Allocator, GrowthFactor>, Type, Extra>
+		{
+			using type = vector<Type, Allocator, GrowthFactor>;
+		};
+
+		template <typename ElementType, size_t Capacity, typename Type, size_t Extra>
+		struct flat_rebind<stack::inplace_vector<ElementType, Capacity>, Type, Extra>
+		{
+			using type = stack::inplace_vector<Type, Capacity + Extra>;
+		};
+
+		template <typename Container, typename Type, size_t Extra = 0>
+		using flat_rebind_t = typename flat_rebind<Container, Type, Extra>::type;
+
+		/**
+		 * Allocator type of fixed-capacity containers, which have none
+		 */
+		class flat_no_allocator
+		{
+		};
+
+		template <typename Container>
+		struct flat_allocator
+		{
+			using type = flat_no_allocator;
+		};
+
+		template <typename Container> requires requires { typename Container::allocator_type; }
+		struct flat_allocator<Container>
+		{
+			using type = typename Container::allocator_type;
+		};
+
+		template <typename Container>
+		using flat_allocator_t = typename flat_allocator<Container>::type;
+
+		/**
+		 * @return Empty container of type Result using the allocator of container (fixed-capacity containers have none)
+		 */
+		template <typename Result, typename Container>
+		WOJ_NODISCARD constexpr Result flat_empty_like(const Container& container)
+		{
+			if constexpr (requires { container.get_allocator(); })
+			{
+				return Result(container.get_allocator());
+			}
+			else
+			{
+				return Result{};
+			}
+		}
+
+		/**
+		 * Branchless binary search (the comparison result selects the next base, compiled to a conditional move)
+		 * @param data Partitioned elements
+		 * @param count Count of elements
+		 * @param before Predicate true for the elements before the searched position
+		 * @return Index of the first element for which before is false
+		 */
+		template <typename Element, typename Predicate>
+		WOJ_NODISCARD constexpr size_t branchless_partition_point(const Element* const data, const size_t count, const Predicate& before) noexcept(std::is_nothrow_invocable_v<const Predicate&, const Element&>)
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			const Element* base = data;
+			size_t length = count;
+			if (!is_constant_evaluated() && count * sizeof(Element) > flat_prefetch_bytes)
+			{
+				while (length > 1)
+				{
+					const size_t half = length / 2;
+					WOJ_PREFETCH(base + half / 2);
+					WOJ_PREFETCH(base + half + half / 2);
+					base = before(base[half]) ? base + half : base;
+					length -= half;
+				}
+			}
+			else
+			{
+				while (length > 1)
+				{
+					const size_t half = length / 2;
+					base = before(base[half]) ? base + half : base;
+					length -= half;
+				}
+			}
+			return static_cast<size_t>(base - data) + static_cast<size_t>(before(*base));
+		}
+
+		/**
+		 * Search index of the sorted layout, the keys themselves are searched
+		 */
+		template <flat_layout Layout, typename Key, typename Container>
+		class flat_index
+		{
+		public:
+			constexpr flat_index() = default;
+
+			explicit constexpr flat_index(const Container&) noexcept {}
+
+			constexpr void rebuild(const Key*, size_t) noexcept {}
+
+			constexpr void clear() noexcept {}
+
+			template <typename Predicate>
+			WOJ_NODISCARD constexpr size_t partition_point(const Key* const keys, const size_t count, const Predicate& before) const
+			{
+				return branchless_partition_point(keys, count, before);
+			}
+		};
+
+		/**
+		 * Search index of the Eytzinger layout: a copy of the keys in breadth-first order of the implicit search tree
+		 * (node k has children 2k and 2k + 1) with the sorted index of every node, node k is stored at index k (index
+		 * 0 is unused) so the descendants of a node in a given generation are contiguous from the start of a block
+		 */
+		template <typename Key, typename Container>
+		class flat_index<flat_layout::eytzinger, Key, Container>
+		{
+		public:
+			flat_rebind_t<Container, Key, 1> m_keys;
+			flat_rebind_t<Container, size_t, 1> m_ranks;
+
+			/**
+			 * Count of nodes covering one cache line, nodes k * block_size to k * block_size + block_size - 1 are the
+			 * 4th generation below k (for 4-byte keys)
+			 */
+			static constexpr size_t block_size = sizeof(Key) < cache_line_size ? cache_line_size / sizeof(Key) : 1;
+
+			constexpr flat_index() = default;
+
+			/**
+			 * Constructs an empty index using the allocator of the keys container
+			 */
+			explicit constexpr flat_index(const Container& keys) : m_keys{ flat_empty_like<flat_rebind_t<Container, Key, 1>>(keys) }, m_ranks{ flat_empty_like<flat_rebind_t<Container, size_t, 1>>(keys) } {}
+
+			constexpr void rebuild(const Key* const keys, const size_t count)
+			{
+				m_keys.clear();
+				m_ranks.clear();
+				if (count == 0)
+				{
+					return;
+				}
+
+				m_keys.resize(count + 1, keys[0]);
+				m_ranks.resize(count + 1);
+				size_t rank = 0;
+				fill(keys, count, 1, rank);
+			}
+
+			constexpr void clear() noexcept
+			{
+				m_keys.clear();
+				m_ranks.clear();
+			}
+
+			template <typename Predicate>
+			WOJ_NODISCARD constexpr size_t partition_point(const Key*, const size_t count, const Predicate& before) const
+			{
+				const Key* const keys = m_keys.data();
+				size_t node = 1;
+				if (!is_constant_evaluated() && count * sizeof(Key) > flat_prefetch_bytes)
+				{
+					while (node <= count)
+					{
+						// The storage is only aligned for Key, the block may straddle two cache lines
+						WOJ_PREFETCH(keys + node * block_size);
+						WOJ_PREFETCH(keys + (node * block_size + block_size - 1));
+						node = 2 * node + static_cast<size_t>(before(keys[node]));
+					}
+				}
+				else
+				{
+					while (node <= count)
+					{
+						node = 2 * node + static_cast<size_t>(before(keys[node]));
+					}
+				}
+
+				// The path turned right after every node before the result, dropping those turns and the final left turn leaves the result
+				node >>= std::countr_one(node) + 1;
+				return node == 0 ? count : m_ranks[node];
+			}
+
+		private:
+			constexpr void fill(const Key* const keys, const size_t count, const size_t node, size_t& rank)
+			{
+				if (node > count)
+				{
+					return;
+				}
+
+				fill(keys, count, 2 * node, rank);
+				m_keys[node] = keys[rank];
+				m_ranks[node] = rank++;
+				fill(keys, count, 2 * node + 1, rank);
+			}
+		};
+
+		/**
+		 * Sorts the elements after the already sorted prefix, merges both parts and removes duplicates, the first
+		 * of equivalent elements is kept (among the unsorted ones it is unspecified which one)
+		 */
+		template <typename Container, typename Less>
+		constexpr void flat_sort_unique(Container& container, const size_t sorted, const Less& less)
+		{
+			const auto first = container.begin();
+			const auto middle = first + sorted;
+			std::sort(middle, container.end(), less);
+			if (sorted != 0 && middle != container.end())
+			{
+				std::inplace_merge(first, middle, container.end(), less);
+			}
+			const auto last = std::unique(first, container.end(), [&less](const auto& left, const auto& right) { return !less(left, right); });
+			container.erase(last, container.end());
+		}
+
+		/**
+		 * @return Count of elements a flat container can still take
+		 */
+		template <typename Container>
+		WOJ_NODISCARD constexpr size_t flat_free_capacity(const Container& container) noexcept
+		{
+			if constexpr (requires { Container::capacity(); })
+			{
+				return Container::capacity() - container.size();
+			}
+			else
+			{
+				return Container::max_size() - container.size();
+			}
+		}
+
+		/**
+		 * Collects the elements of a range that are not present in a flat container into a buffer, sorted and without
+		 * duplicates; a fixed-capacity buffer is compacted whenever it fills up, so duplicates in the range do not
+		 * count against its capacity
+		 * @param free Count of elements the flat container can still take
+		 * @param present Whether an element is already in the flat container
+		 * @throws vector_capacity_exceeded if the range holds more than free new elements
+		 */
+		template <typename Buffer, typename InputIterator, typename Less, typename Present>
+		constexpr void flat_collect_new(Buffer& buffer, InputIterator first, const InputIterator last, const size_t free, const Less& less, const Present& present)
+		{
+			size_t sorted = 0;
+			for (; first != last; ++first)
+			{
+				if constexpr (requires { Buffer::capacity(); })
+				{
+					if (buffer.size() == Buffer::capacity()) WOJ_UNLIKELY
+					{
+						if (sorted != buffer.size())
+						{
+							flat_sort_unique(buffer, sorted, less);
+							sorted = buffer.size();
+						}
+						if (sorted == Buffer::capacity())
+						{
+							// Only an element already collected or present can still be taken
+							const typename Buffer::value_type element(*first);
+							if (!present(element) && !std::binary_search(buffer.begin(), buffer.end(), element, less))
+							{
+								throw vector_capacity_exceeded{ 324ull, "flat_map.hpp", "woj::detail::flat_collect_new" };
+							}
+							continue;
+						}
+					}
+				}
+
+				buffer.emplace_back(*first);
+				if (present(buffer.back()))
+				{
+					buffer.pop_back();
+				}
+			}
+
+			flat_sort_unique(buffer, sorted, less);
+			if (buffer.size() > free)
+			{
+				throw vector_capacity_exceeded{ 341ull, "flat_map.hpp", "woj::detail::flat_collect_new" };
+			}
+		}
+
+		/**
+		 * Merges count sorted new elements, none equivalent to one of the size sorted elements of a flat container,
+		 * into it from the back: the last count elements of the merged order are appended, the rest is merged
+		 * backwards by move assignment, so neither a buffer nor placeholder elements are needed. The container must
+		 * have room for the appended elements
+		 * @param new_before Called with (new index, index) whether the new element is ordered first
+		 * @param append Called with (is new, index) to append an element
+		 * @param assign Called with (destination, is new, index) to move an element to a position
+		 */
+		template <typename NewBefore, typename Append, typename Assign>
+		constexpr void flat_merge_back(const size_t size, const size_t count, const NewBefore& new_before, const Append& append, const Assign& assign)
+		{
+			// The appended tail is made of the elements [old, size) and the new elements [added, count)
+			size_t old = size;
+			size_t added = count;
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (added == 0 || (old != 0 && new_before(added - 1, old - 1)))
+				{
+					--old;
+				}
+				else
+				{
+					--added;
+				}
+			}
+
+			for (size_t i = old, j = added; i != size || j != count;)
+			{
+				if (j == count || (i != size && !new_before(j, i)))
+				{
+					append(false, i++);
+				}
+				else
+				{
+					append(true, j++);
+				}
+			}
+
+			// The elements before old stay in place once the new ones are exhausted
+			for (size_t destination = size; added != 0;)
+			{
+				--destination;
+				if (old != 0 && new_before(added - 1, old - 1))
+				{
+					assign(destination, false, --old);
+				}
+				else
+				{
+					assign(destination, true, --added);
+				}
+			}
+		}
+
+		/**
+		 * Whether flat_merge_back can merge elements of a type in place: a move that throws halfway through the merge
+		 * would leave elements moved out or duplicated
+		 */
+		template <typename Type>
+		constexpr bool flat_merge_in_place = std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>;
+
+		/**
+		 * Merges count sorted new elements, none equivalent to one of the size sorted elements of a flat container,
+		 * front to back into new containers, for elements whose moves may throw: the elements of the flat container
+		 * are moved only if that cannot throw (copied otherwise), so it is unchanged until the merged containers are
+		 * swapped in
+		 * @param new_before Called with (new index, index) whether the new element is ordered first
+		 * @param append Called with (is new, index) to append an element to the merged containers
+		 */
+		template <typename NewBefore, typename Append>
+		constexpr void flat_merge_front(const size_t size, const size_t count, const NewBefore& new_before, const Append& append)
+		{
+			for (size_t i = 0, j = 0; i != size || j != count;)
+			{
+				if (j == count || (i != size && !new_before(j, i)))
+				{
+					append(false, i++);
+				}
+				else
+				{
+					append(true, j++);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Class representing an ordered set stored as a sorted array, lookups are branchless binary searches
+	 * @tparam Key Type of the keys
+	 * @tparam Compare Key ordering function object
+	 * @tparam Container Contiguous container holding the keys (woj::vector or stack::inplace_vector)
+	 * @tparam Layout Search layout
+	 */
+	template <typename Key, typename Compare, typename Container, flat_layout Layout>
+	class basic_flat_set
+	{
+	public:
+		using key_type = Key;
+		using value_type = Key;
+		using key_compare = Compare;
+		using value_compare = Compare;
+		using container_type = Container;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using reference = const Key&;
+		using const_reference = const Key&;
+		using iterator = const Key*;
+		using const_iterator = const Key*;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		Container m_keys;
+		WOJ_NO_UNIQUE_ADDRESS Compare m_compare;
+		WOJ_NO_UNIQUE_ADDRESS detail::flat_index<Layout, Key, Container> m_index;
+
+		constexpr basic_flat_set() = default;
+
+		explicit constexpr basic_flat_set(const Compare& compare) : m_keys{}, m_compare{ compare }, m_index{} {}
+
+		/**
+		 * Constructs an empty set whose keys and search index use allocator
+		 */
+		explicit constexpr basic_flat_set(const detail::flat_allocator_t<Container>& allocator, const Compare& compare = Compare{}) requires (!std::is_same_v<detail::flat_allocator_t<Container>, detail::flat_no_allocator>) : m_keys(allocator), m_compare{ compare }, m_index{ m_keys } {}
+
+		/**
+		 * Constructs the set from unsorted keys, they are sorted and deduplicated in place
+		 */
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr basic_flat_set(const InputIterator first, const InputIterator last, const Compare& compare = Compare{}) : m_keys(first, last), m_compare{ compare }, m_index{ m_keys }
+		{
+			detail::flat_sort_unique(m_keys, 0, m_compare);
+			m_index.rebuild(m_keys.data(), m_keys.size());
+		}
+
+		constexpr basic_flat_set(const std::initializer_list<Key> keys, const Compare& compare = Compare{}) : basic_flat_set{ keys.begin(), keys.end(), compare } {}
+
+		/**
+		 * Adopts keys that are already sorted and free of duplicates
+		 */
+		constexpr basic_flat_set(sorted_unique_t, Container keys, const Compare& compare = Compare{}) : m_keys{ std::move(keys) }, m_compare{ compare }, m_index{ m_keys }
+		{
+			m_index.rebuild(m_keys.data(), m_keys.size());
+		}
+
+		// ----- Iterators -----
+
+		WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+		{
+			return m_keys.data();
+		}
+
+		WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+		{
+			return m_keys.data();
+		}
+
+		WOJ_NODISCARD constexpr const_iterator end() const noexcept
+		{
+			return m_keys.data() + m_keys.size();
+		}
+
+		WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		WOJ_NODISCARD constexpr const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator{ end() };
+		}
+
+		WOJ_NODISCARD constexpr const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator{ begin() };
+		}
+
+		// ----- Capacity -----
+
+		WOJ_NODISCARD constexpr size_type size() const noexcept
+		{
+			return m_keys.size();
+		}
+
+		WOJ_NODISCARD constexpr bool empty() const noexcept
+		{
+			return m_keys.size() == 0;
+		}
+
+		/**
+		 * Reserves storage for count keys (no-op for fixed-capacity containers)
+		 */
+		constexpr void reserve(const size_type count)
+		{
+			if constexpr (requires { m_keys.reserve(count); })
+			{
+				m_keys.reserve(count);
+			}
+		}
+
+		/**
+		 * @return The sorted keys
+		 */
+		WOJ_NODISCARD constexpr const Container& keys() const noexcept
+		{
+			return m_keys;
+		}
+
+		// ----- Lookup -----
+
+		/**
+		 * @return Iterator to the first key not ordered before key
+		 */
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr const_iterator lower_bound(const LookupKey& key) const
+		{
+			return begin() + lower_index(key);
+		}
+
+		/**
+		 * @return Iterator to the first key ordered after key
+		 */
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr const_iterator upper_bound(const LookupKey& key) const
+		{
+			return begin() + m_index.partition_point(m_keys.data(), m_keys.size(), [this, &key](const Key& element) { return !m_compare(key, element); });
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr std::pair<const_iterator, const_iterator> equal_range(const LookupKey& key) const
+		{
+			const const_iterator first = lower_bound(key);
+			return { first, first != end() && !m_compare(key, *first) ? first + 1 : first };
+		}
+
+		/**
+		 * Finds a key
+		 * @tparam LookupKey Type of the key (any type accepted by Compare)
+		 * @param key Key to find
+		 * @return Iterator to the key or end()
+		 */
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr const_iterator find(const LookupKey& key) const
+		{
+			return begin() + find_index(key);
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr bool contains(const LookupKey& key) const
+		{
+			return find_index(key) != m_keys.size();
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr size_type count(const LookupKey& key) const
+		{
+			return contains(key);
+		}
+
+		// ----- Modifiers -----
+
+		/**
+		 * Inserts a key
+		 * @param key Key to insert
+		 * @return Pair of iterator to the key and whether it was inserted
+		 */
+		constexpr std::pair<const_iterator, bool> insert(const Key& key)
+		{
+			return emplace_key(key);
+		}
+
+		constexpr std::pair<const_iterator, bool> insert(Key&& key)
+		{
+			return emplace_key(std::move(key));
+		}
+
+		template <typename... Args>
+		constexpr std::pair<const_iterator, bool> emplace(Args&&... args)
+		{
+			return emplace_key(Key(std::forward<Args>(args)...));
+		}
+
+		/**
+		 * Inserts unsorted keys with one sort and merge pass, keys already present are kept. Only the new keys are
+		 * sorted, in their own buffer, and the set is not changed if they do not fit or if a key throws while being
+		 * merged (keys whose moves may throw are merged into a new container that is swapped in)
+		 * @throws vector_capacity_exceeded if a fixed-capacity set cannot take the new keys
+		 */
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr void insert(InputIterator first, const InputIterator last)
+		{
+			Container keys = detail::flat_empty_like<Container>(m_keys);
+			detail::flat_collect_new(keys, first, last, detail::flat_free_capacity(m_keys), m_compare, [this](const Key& key) { return find_index(key) != m_keys.size(); });
+			if (keys.size() == 0)
+			{
+				return;
+			}
+
+			const auto new_before = [this, &keys](const size_type added, const size_type index) { return m_compare(keys.data()[added], m_keys.data()[index]); };
+			if constexpr (detail::flat_merge_in_place<Key>)
+			{
+				reserve(m_keys.size() + keys.size());
+				detail::flat_merge_back(m_keys.size(), keys.size(), new_before,
+					[this, &keys](const bool is_new, const size_type index) { m_keys.emplace_back(std::move(is_new ? keys.data()[index] : m_keys.data()[index])); },
+					[this, &keys](const size_type destination, const bool is_new, const size_type index) { m_keys.data()[destination] = std::move(is_new ? keys.data()[index] : m_keys.data()[index]); });
+			}
+			else
+			{
+				static_assert(std::is_nothrow_swappable_v<Container>, "woj::basic_flat_set::insert: a fixed-capacity set needs keys that are nothrow movable");
+				Container merged = detail::flat_empty_like<Container>(m_keys);
+				if constexpr (requires { merged.reserve(size_type{}); })
+				{
+					merged.reserve(m_keys.size() + keys.size());
+				}
+				detail::flat_merge_front(m_keys.size(), keys.size(), new_before, [this, &keys, &merged](const bool is_new, const size_type index)
+				{
+					if (is_new)
+					{
+						merged.emplace_back(std::move(keys.data()[index]));
+					}
+					else
+					{
+						merged.emplace_back(std::move_if_noexcept(m_keys.data()[index]));
+					}
+				});
+				using std::swap;
+				swap(m_keys, merged);
+			}
+			m_index.rebuild(m_keys.data(), m_keys.size());
+		}
+
+		constexpr void insert(const std::initializer_list<Key> keys)
+		{
+			insert(keys.begin(), keys.end());
+		}
+
+		/**
+		 * Erases a key
+		 * @param key Key to erase
+		 * @return Count of erased keys (0 or 1)
+		 */
+		template <typename LookupKey>
+		constexpr size_type erase(const LookupKey& key)
+		{
+			const size_type index = find_index(key);
+			if (index == m_keys.size())
+			{
+				return 0;
+			}
+			m_keys.erase(m_keys.begin() + index);
+			m_index.rebuild(m_keys.data(), m_keys.size());
+			return 1;
+		}
+
+		/**
+		 * Erases the key pointed by an iterator
+		 * @return Iterator to the next key
+		 */
+		constexpr const_iterator erase(const const_iterator pos)
+		{
+			const size_type index = static_cast<size_type>(pos - begin());
+			m_keys.erase(m_keys.begin() + index);
+			m_index.rebuild(m_keys.data(), m_keys.size());
+			return begin() + index;
+		}
+
+		constexpr void clear() noexcept
+		{
+			m_keys.clear();
+			m_index.clear();
+		}
+
+		WOJ_NODISCARD constexpr bool operator==(const basic_flat_set& other) const
+		{
+			return std::equal(begin(), end(), other.begin(), other.end());
+		}
+
+	private:
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr size_type lower_index(const LookupKey& key) const
+		{
+			return m_index.partition_point(m_keys.data(), m_keys.size(), [this, &key](const Key& element) { return m_compare(element, key); });
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr size_type find_index(const LookupKey& key) const
+		{
+			const size_type index = lower_index(key);
+			return index != m_keys.size() && !m_compare(key, m_keys.data()[index]) ? index : m_keys.size();
+		}
+
+		template <typename OtherKey>
+		constexpr std::pair<const_iterator, bool> emplace_key(OtherKey&& key)
+		{
+			const size_type index = lower_index(key);
+			if (index != m_keys.size() && !m_compare(key, m_keys.data()[index]))
+			{
+				return { begin() + index, false };
+			}
+
+			m_keys.emplace(m_keys.begin() + index, std::forward<OtherKey>(key));
+			m_index.rebuild(m_keys.data(), m_keys.size());
+			return { begin() + index, true };
+		}
+	};
+
+	namespace detail
+	{
+		/**
+		 * Random access iterator over a flat map, dereferencing yields a pair of references to the key and the value
+		 */
+		template <typename Map, bool Const>
+		class flat_map_iterator
+		{
+		public:
+			using key_type = typename Map::key_type;
+			using mapped_type = std::conditional_t<Const, const typename Map::mapped_type, typename Map::mapped_type>;
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = std::pair<typename Map::key_type, typename Map::mapped_type>;
+			using difference_type = ptrdiff_t;
+			using reference = std::pair<const key_type&, mapped_type&>;
+
+			/**
+			 * Keeps the pair of references alive for operator->
+			 */
+			class pointer
+			{
+			public:
+				reference m_reference;
+
+				constexpr const reference* operator->() const noexcept
+				{
+					return &m_reference;
+				}
+			};
+
+			const key_type* m_key;
+			mapped_type* m_value;
+
+			constexpr flat_map_iterator() noexcept : m_key{ nullptr }, m_value{ nullptr } {}
+
+			constexpr flat_map_iterator(const key_type* const key, mapped_type* const value) noexcept : m_key{ key }, m_value{ value } {}
+
+			constexpr operator flat_map_iterator<Map, true>() const noexcept requires (!Const)
+			{
+				return { m_key, m_value };
+			}
+
+			/**
+			 * @return The key (cheaper than going through the pair)
+			 */
+			WOJ_NODISCARD constexpr const key_type& key() const noexcept
+			{
+				return *m_key;
+			}
+
+			WOJ_NODISCARD constexpr mapped_type& value() const noexcept
+			{
+				return *m_value;
+			}
+
+			constexpr reference operator*() const noexcept
+			{
+				return { *m_key, *m_value };
+			}
+
+			constexpr pointer operator->() const noexcept
+			{
+				return { { *m_key, *m_value } };
+			}
+
+			constexpr reference operator[](const difference_type offset) const noexcept
+			{
+				return { m_key[offset], m_value[offset] };
+			}
+
+			constexpr flat_map_iterator& operator++() noexcept
+			{
+				++m_key;
+				++m_value;
+				return *this;
+			}
+
+			constexpr flat_map_iterator operator++(int) noexcept
+			{
+				flat_map_iterator copy{ *this };
+				++*this;
+				return copy;
+			}
+
+			constexpr flat_map_iterator& operator--() noexcept
+			{
+				--m_key;
+				--m_value;
+				return *this;
+			}
+
+			constexpr flat_map_iterator operator--(int) noexcept
+			{
+				flat_map_iterator copy{ *this };
+				--*this;
+				return copy;
+			}
+
+			constexpr flat_map_iterator& operator+=(const difference_type offset) noexcept
+			{
+				m_key += offset;
+				m_value += offset;
+				return *this;
+			}
+
+			constexpr flat_map_iterator& operator-=(const difference_type offset) noexcept
+			{
+				m_key -= offset;
+				m_value -= offset;
+				return *this;
+			}
+
+			constexpr flat_map_iterator operator+(const difference_type offset) const noexcept
+			{
+				return { m_key + offset, m_value + offset };
+			}
+
+			friend constexpr flat_map_iterator operator+(const difference_type offset, const flat_map_iterator& iterator) noexcept
+			{
+				return iterator + offset;
+			}
+
+			constexpr flat_map_iterator operator-(const difference_type offset) const noexcept
+			{
+				return { m_key - offset, m_value - offset };
+			}
+
+			constexpr difference_type operator-(const flat_map_iterator& other) const noexcept
+			{
+				return m_key - other.m_key;
+			}
+
+			constexpr bool operator==(const flat_map_iterator& other) const noexcept
+			{
+				return m_key == other.m_key;
+			}
+
+			constexpr auto operator<=>(const flat_map_iterator& other) const noexcept
+			{
+				return m_key <=> other.m_key;
+			}
+		};
+	}
+
+	/**
+	 * Class representing an ordered map stored as a sorted array of keys and a parallel array of values (the keys are
+	 * searched without touching the values), lookups are branchless binary searches
+	 * @tparam Key Type of the keys
+	 * @tparam Value Type of the values
+	 * @tparam Compare Key ordering function object
+	 * @tparam KeyContainer Contiguous container holding the keys (woj::vector or stack::inplace_vector)
+	 * @tparam Layout Search layout
+	 */
+	template <typename Key, typename Value, typename Compare, typename KeyContainer, flat_layout Layout>
+	class basic_flat_map
+	{
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key, Value>;
+		using key_compare = Compare;
+		using key_container_type = KeyContainer;
+		using mapped_container_type = detail::flat_rebind_t<KeyContainer, Value>;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using iterator = detail::flat_map_iterator<basic_flat_map, false>;
+		using const_iterator = detail::flat_map_iterator<basic_flat_map, true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		KeyContainer m_keys;
+		mapped_container_type m_values;
+		WOJ_NO_UNIQUE_ADDRESS Compare m_compare;
+		WOJ_NO_UNIQUE_ADDRESS detail::flat_index<Layout, Key, KeyContainer> m_index;
+
+		constexpr basic_flat_map() = default;
+
+		explicit constexpr basic_flat_map(const Compare& compare) : m_keys{}, m_values{}, m_compare{ compare }, m_index{} {}
+
+		/**
+		 * Constructs an empty map whose keys, values and search index use allocator
+		 */
+		explicit constexpr basic_flat_map(const detail::flat_allocator_t<KeyContainer>& allocator, const Compare& compare = Compare{}) requires (!std::is_same_v<detail::flat_allocator_t<KeyContainer>, detail::flat_no_allocator>) : m_keys(allocator), m_values(allocator), m_compare{ compare }, m_index{ m_keys } {}
+
+		/**
+		 * Constructs the map from unsorted key/value pairs, they are sorted and deduplicated in one pass over a pair buffer
+		 */
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr basic_flat_map(const InputIterator first, const InputIterator last, const Compare& compare = Compare{}) : m_keys{}, m_values{}, m_compare{ compare }, m_index{}
+		{
+			insert(first, last);
+		}
+
+		constexpr basic_flat_map(const std::initializer_list<value_type> entries, const Compare& compare = Compare{}) : basic_flat_map{ entries.begin(), entries.end(), compare } {}
+
+		/**
+		 * Adopts keys that are already sorted and free of duplicates along with their values
+		 */
+		constexpr basic_flat_map(sorted_unique_t, KeyContainer keys, mapped_container_type values, const Compare& compare = Compare{}) : m_keys{ std::move(keys) }, m_values{ std::move(values) }, m_compare{ compare }, m_index{ m_keys }
+		{
+			m_index.rebuild(m_keys.data(), m_keys.size());
+		}
+
+		// ----- Iterators -----
+
+		WOJ_NODISCARD constexpr iterator begin() noexcept
+		{
+			return { m_keys.data(), m_values.data() };
+		}
+
+		WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+		{
+			return { m_keys.data(), m_values.data() };
+		}
+
+		WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		WOJ_NODISCARD constexpr iterator end() noexcept
+		{
+			return begin() + static_cast<difference_type>(m_keys.size());
+		}
+
+		WOJ_NODISCARD constexpr const_iterator end() const noexcept
+		{
+			return begin() + static_cast<difference_type>(m_keys.size());
+		}
+
+		WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		WOJ_NODISCARD constexpr reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator{ end() };
+		}
+
+		WOJ_NODISCARD constexpr const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator{ end() };
+		}
+
+		WOJ_NODISCARD constexpr reverse_iterator rend() noexcept
+		{
+			return reverse_iterator{ begin() };
+		}
+
+		WOJ_NODISCARD constexpr const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator{ begin() };
+		}
+
+		// ----- Capacity -----
+
+		WOJ_NODISCARD constexpr size_type size() const noexcept
+		{
+			return m_keys.size();
+		}
+
+		WOJ_NODISCARD constexpr bool empty() const noexcept
+		{
+			return m_keys.size() == 0;
+		}
+
+		/**
+		 * Reserves storage for count entries (no-op for fixed-capacity containers)
+		 */
+		constexpr void reserve(const size_type count)
+		{
+			if constexpr (requires { m_keys.reserve(count); })
+			{
+				m_keys.reserve(count);
+				m_values.reserve(count);
+			}
+		}
+
+		/**
+		 * @return The sorted keys
+		 */
+		WOJ_NODISCARD constexpr const KeyContainer& keys() const noexcept
+		{
+			return m_keys;
+		}
+
+		/**
+		 * @return The values in the order of their keys
+		 */
+		WOJ_NODISCARD constexpr const mapped_container_type& values() const noexcept
+		{
+			return m_values;
+		}
+
+		// ----- Lookup -----
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr iterator lower_bound(const LookupKey& key)
+		{
+			return begin() + static_cast<difference_type>(lower_index(key));
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr const_iterator lower_bound(const LookupKey& key) const
+		{
+			return begin() + static_cast<difference_type>(lower_index(key));
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr iterator upper_bound(const LookupKey& key)
+		{
+			return begin() + static_cast<difference_type>(upper_index(key));
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr const_iterator upper_bound(const LookupKey& key) const
+		{
+			return begin() + static_cast<difference_type>(upper_index(key));
+		}
+
+		/**
+		 * Finds an entry by key
+		 * @tparam LookupKey Type of the key (any type accepted by Compare)
+		 * @param key Key to find
+		 * @return Iterator to the entry or end()
+		 */
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr iterator find(const LookupKey& key)
+		{
+			return begin() + static_cast<difference_type>(find_index(key));
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr const_iterator find(const LookupKey& key) const
+		{
+			return begin() + static_cast<difference_type>(find_index(key));
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr bool contains(const LookupKey& key) const
+		{
+			return find_index(key) != m_keys.size();
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr size_type count(const LookupKey& key) const
+		{
+			return contains(key);
+		}
+
+		/**
+		 * Accesses the value of a key
+		 * @param key Key of the entry
+		 * @return Pointer to the value or nullptr if the key is not present
+		 */
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr Value* get(const LookupKey& key)
+		{
+			const size_type index = find_index(key);
+			return index == m_keys.size() ? nullptr : m_values.data() + index;
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr const Value* get(const LookupKey& key) const
+		{
+			const size_type index = find_index(key);
+			return index == m_keys.size() ? nullptr : m_values.data() + index;
+		}
+
+		/**
+		 * Accesses the value of a key, default-constructing it if not present
+		 */
+		constexpr Value& operator[](const Key& key)
+		{
+			return try_emplace(key).first.value();
+		}
+
+		// ----- Modifiers -----
+
+		/**
+		 * Inserts an entry constructed from arguments if the key is not present
+		 * @param key Key of the entry
+		 * @param value_args Arguments to construct the value with
+		 * @return Pair of iterator to the entry and whether it was inserted
+		 */
+		template <typename... ValueArgs>
+		constexpr std::pair<iterator, bool> try_emplace(const Key& key, ValueArgs&&... value_args)
+		{
+			const size_type index = lower_index(key);
+			if (index != m_keys.size() && !m_compare(key, m_keys.data()[index]))
+			{
+				return { begin() + static_cast<difference_type>(index), false };
+			}
+
+			m_values.emplace(m_values.begin() + index, std::forward<ValueArgs>(value_args)...);
+			try
+			{
+				m_keys.emplace(m_keys.begin() + index, key);
+			}
+			catch (...)
+			{
+				m_values.erase(m_values.begin() + index);
+				throw;
+			}
+			m_index.rebuild(m_keys.data(), m_keys.size());
+			return { begin() + static_cast<difference_type>(index), true };
+		}
+
+		constexpr std::pair<iterator, bool> insert(const value_type& entry)
+		{
+			return try_emplace(entry.first, entry.second);
+		}
+
+		constexpr std::pair<iterator, bool> insert(value_type&& entry)
+		{
+			return try_emplace(entry.first, std::move(entry.second));
+		}
+
+		/**
+		 * Inserts an entry or assigns to the value if the key is present
+		 * @return Pair of iterator to the entry and whether it was inserted
+		 */
+		template <typename OtherValue>
+		constexpr std::pair<iterator, bool> insert_or_assign(const Key& key, OtherValue&& value)
+		{
+			const std::pair<iterator, bool> result = try_emplace(key, std::forward<OtherValue>(value));
+			if (!result.second)
+			{
+				result.first.value() = std::forward<OtherValue>(value);
+			}
+			return result;
+		}
+
+		/**
+		 * Inserts unsorted key/value pairs with one sort and merge pass, keys already present keep their values. Only
+		 * the new entries are sorted, in their own buffer, and the map is not changed if they do not fit or if an
+		 * entry throws while being merged (keys and values whose moves may throw are merged into new containers that
+		 * are swapped in)
+		 * @throws vector_capacity_exceeded if a fixed-capacity map cannot take the new entries
+		 */
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr void insert(InputIterator first, const InputIterator last)
+		{
+			auto entries = detail::flat_empty_like<detail::flat_rebind_t<KeyContainer, value_type>>(m_keys);
+			detail::flat_collect_new(entries, first, last, detail::flat_free_capacity(m_keys),
+				[this](const value_type& left, const value_type& right) { return m_compare(left.first, right.first); },
+				[this](const value_type& entry) { return find_index(entry.first) != m_keys.size(); });
+			if (entries.size() == 0)
+			{
+				return;
+			}
+
+			const auto new_before = [this, &entries](const size_type added, const size_type index) { return m_compare(entries.data()[added].first, m_keys.data()[index]); };
+			if constexpr (detail::flat_merge_in_place<Key> && detail::flat_merge_in_place<Value>)
+			{
+				reserve(m_keys.size() + entries.size());
+				detail::flat_merge_back(m_keys.size(), entries.size(), new_before,
+					[this, &entries](const bool is_new, const size_type index)
+					{
+						if (is_new)
+						{
+							m_keys.emplace_back(std::move(entries.data()[index].first));
+							m_values.emplace_back(std::move(entries.data()[index].second));
+						}
+						else
+						{
+							m_keys.emplace_back(std::move(m_keys.data()[index]));
+							m_values.emplace_back(std::move(m_values.data()[index]));
+						}
+					},
+					[this, &entries](const size_type destination, const bool is_new, const size_type index)
+					{
+						if (is_new)
+						{
+							m_keys.data()[destination] = std::move(entries.data()[index].first);
+							m_values.data()[destination] = std::move(entries.data()[index].second);
+						}
+						else
+						{
+							m_keys.data()[destination] = std::move(m_keys.data()[index]);
+							m_values.data()[destination] = std::move(m_values.data()[index]);
+						}
+					});
+			}
+			else
+			{
+				static_assert(std::is_nothrow_swappable_v<KeyContainer> && std::is_nothrow_swappable_v<mapped_container_type>, "woj::basic_flat_map::insert: a fixed-capacity map needs keys and values that are nothrow movable");
+				KeyContainer keys = detail::flat_empty_like<KeyContainer>(m_keys);
+				mapped_container_type values = detail::flat_empty_like<mapped_container_type>(m_values);
+				if constexpr (requires { keys.reserve(size_type{}); })
+				{
+					keys.reserve(m_keys.size() + entries.size());
+					values.reserve(m_keys.size() + entries.size());
+				}
+				detail::flat_merge_front(m_keys.size(), entries.size(), new_before, [this, &entries, &keys, &values](const bool is_new, const size_type index)
+				{
+					if (is_new)
+					{
+						keys.emplace_back(std::move(entries.data()[index].first));
+						values.emplace_back(std::move(entries.data()[index].second));
+					}
+					else
+					{
+						keys.emplace_back(std::move_if_noexcept(m_keys.data()[index]));
+						values.emplace_back(std::move_if_noexcept(m_values.data()[index]));
+					}
+				});
+				using std::swap;
+				swap(m_keys, keys);
+				swap(m_values, values);
+			}
+			m_index.rebuild(m_keys.data(), m_keys.size());
+		}
+
+		constexpr void insert(const std::initializer_list<value_type> entries)
+		{
+			insert(entries.begin(), entries.end());
+		}
+
+		/**
+		 * Erases an entry by key
+		 * @return Count of erased entries (0 or 1)
+		 */
+		template <typename LookupKey>
+		constexpr size_type erase(const LookupKey& key)
+		{
+			const size_type index = find_index(key);
+			if (index == m_keys.size())
+			{
+				return 0;
+			}
+			erase_index(index);
+			return 1;
+		}
+
+		/**
+		 * Erases the entry pointed by an iterator
+		 * @return Iterator to the next entry
+		 */
+		constexpr iterator erase(const const_iterator pos)
+		{
+			const size_type index = static_cast<size_type>(pos.m_key - m_keys.data());
+			erase_index(index);
+			return begin() + static_cast<difference_type>(index);
+		}
+
+		constexpr iterator erase(const iterator pos)
+		{
+			return erase(const_iterator{ pos });
+		}
+
+		constexpr void clear() noexcept
+		{
+			m_keys.clear();
+			m_values.clear();
+			m_index.clear();
+		}
+
+		WOJ_NODISCARD constexpr bool operator==(const basic_flat_map& other) const
+		{
+			return std::equal(m_keys.begin(), m_keys.end(), other.m_keys.begin(), other.m_keys.end()) && std::equal(m_values.begin(), m_values.end(), other.m_values.begin(), other.m_values.end());
+		}
+
+	private:
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr size_type lower_index(const LookupKey& key) const
+		{
+			return m_index.partition_point(m_keys.data(), m_keys.size(), [this, &key](const Key& element) { return m_compare(element, key); });
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr size_type upper_index(const LookupKey& key) const
+		{
+			return m_index.partition_point(m_keys.data(), m_keys.size(), [this, &key](const Key& element) { return !m_compare(key, element); });
+		}
+
+		template <typename LookupKey>
+		WOJ_NODISCARD constexpr size_type find_index(const LookupKey& key) const
+		{
+			const size_type index = lower_index(key);
+			return index != m_keys.size() && !m_compare(key, m_keys.data()[index]) ? index : m_keys.size();
+		}
+
+		constexpr void erase_index(const size_type index)
+		{
+			m_keys.erase(m_keys.begin() + index);
+			m_values.erase(m_values.begin() + index);
+			m_index.rebuild(m_keys.data(), m_keys.size());
+		}
+	};
+
+	/**
+	 * Growable flat set
+	 */
+	template <typename Key, typename Compare = std::less<>, flat_layout Layout = flat_layout::sorted>
+	using flat_set = basic_flat_set<Key, Compare, vector<Key>, Layout>;
+
+	/**
+	 * Growable flat map
+	 */
+	template <typename Key, typename Value, typename Compare = std::less<>, flat_layout Layout = flat_layout::sorted>
+	using flat_map = basic_flat_map<Key, Value, Compare, vector<Key>, Layout>;
+
+	namespace stack
+	{
+		/**
+		 * Fixed-capacity, allocation-free flat set
+		 */
+		template <typename Key, size_t Capacity, typename Compare = std::less<>, flat_layout Layout = flat_layout::sorted>
+		using flat_set = basic_flat_set<Key, Compare, inplace_vector<Key, Capacity>, Layout>;
+
+		/**
+		 * Fixed-capacity, allocation-free flat map
+		 */
+		template <typename Key, typename Value, size_t Capacity, typename Compare = std::less<>, flat_layout Layout = flat_layout::sorted>
+		using flat_map = basic_flat_map<Key, Value, Compare, inplace_vector<Key, Capacity>, Layout>;
+	}
+}
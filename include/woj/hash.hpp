@@ -0,0 +1,148 @@
+#pragma once
+
+#include "base.hpp"
+#include "string.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifndef WOJ_HASH_HPP
+#define WOJ_HASH_HPP
+#endif
+
+namespace woj
+{
+	namespace detail
+	{
+		constexpr uint64_t hash_k0 = 0x9E3779B97F4A7C15ull;
+		constexpr uint64_t hash_k1 = 0x87C37B91114253D5ull;
+		constexpr uint64_t hash_k2 = 0x4CF5AD432745937Full;
+
+		/**
+		 * Final avalanche step of MurmurHash3 (every input bit affects every output bit)
+		 */
+		constexpr uint64_t hash_finalize(uint64_t value) noexcept
+		{
+			value ^= value >> 33;
+			value *= 0xFF51AFD7ED558CCDull;
+			value ^= value >> 33;
+			value *= 0xC4CEB9FE1A85EC53ull;
+			value ^= value >> 33;
+			return value;
+		}
+
+		constexpr uint64_t hash_round(const uint64_t state, uint64_t word) noexcept
+		{
+			word *= hash_k1;
+			word = std::rotl(word, 31);
+			word *= hash_k2;
+			return std::rotl(state ^ word, 27) * 5 + 0x52DCE729;
+		}
+
+		/**
+		 * Packs up to (8 / sizeof(Elem)) elements into a little-endian word by value
+		 */
+		template <typename Elem>
+		constexpr uint64_t hash_pack(const Elem* const elems, const size_t count) noexcept
+		{
+			uint64_t word{ 0 };
+			for (size_t i = 0; i < count; ++i)
+			{
+				word |= static_cast<uint64_t>(static_cast<std::make_unsigned_t<Elem>>(elems[i])) << (i * 8 * sizeof(Elem));
+			}
+			return word;
+		}
+	}
+
+	/**
+	 * Hashes a character buffer, the result is identical at compile-time and at run-time
+	 * @tparam Elem Type of the buffer's elements
+	 * @param elems Buffer to hash
+	 * @param count Count of elements in the buffer
+	 * @param seed Seed to hash with
+	 * @return 64-bit hash
+	 */
+	template <typename Elem>
+	WOJ_NODISCARD constexpr uint64_t hash_chars(const Elem* const elems, const size_t count, const uint64_t seed = 0) noexcept
+	{
+		static_assert(sizeof(Elem) <= 8 && std::has_single_bit(sizeof(Elem)), "Element type must be 1, 2, 4 or 8 bytes wide");
+
+		constexpr size_t per_word = 8 / sizeof(Elem);
+
+		uint64_t state = seed ^ (count * detail::hash_k0);
+		size_t i = 0;
+
+		if (is_constant_evaluated() || std::endian::native != std::endian::little)
+		{
+			for (; i + per_word <= count; i += per_word)
+			{
+				state = detail::hash_round(state, detail::hash_pack(elems + i, per_word));
+			}
+		}
+		else
+		{
+			for (; i + per_word <= count; i += per_word)
+			{
+				uint64_t word;
+				std::memcpy(&word, elems + i, sizeof(word));
+				state = detail::hash_round(state, word);
+			}
+		}
+
+		if (i != count)
+		{
+			state = detail::hash_round(state, detail::hash_pack(elems + i, count - i));
+		}
+
+		return detail::hash_finalize(state);
+	}
+
+	/**
+	 * Hashes an integer (bijective, so integers never collide before reduction)
+	 * @param value Value to hash
+	 * @param seed Seed to hash with
+	 * @return 64-bit hash
+	 */
+	WOJ_NODISCARD constexpr uint64_t hash_integer(const uint64_t value, const uint64_t seed = 0) noexcept
+	{
+		return detail::hash_finalize(value ^ seed ^ detail::hash_k0);
+	}
+
+	/**
+	 * Hash function object used by woj hash containers
+	 * @tparam Type Type to hash
+	 */
+	template <typename Type, typename = void>
+	class hash;
+
+	template <typename Type>
+	class hash<Type, std::enable_if_t<std::is_integral_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>>>
+	{
+	public:
+		WOJ_NODISCARD constexpr uint64_t operator()(const Type value) const noexcept
+		{
+			if constexpr (std::is_pointer_v<Type>)
+			{
+				return hash_integer(reinterpret_cast<uintptr_t>(value));
+			}
+			else
+			{
+				return hash_integer(static_cast<uint64_t>(value));
+			}
+		}
+	};
+
+	template <typename Elem, size_t MemSize>
+	class hash<stack::string<Elem, MemSize>>
+	{
+	public:
+		using is_transparent = void;
+
+		template <size_t OtherMemSize>
+		WOJ_NODISCARD constexpr uint64_t operator()(const stack::string<Elem, OtherMemSize>& value) const noexcept
+		{
+			return hash_chars(value.data(), value.str_size());
+		}
+	};
+}
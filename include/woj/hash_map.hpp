@@ -0,0 +1,777 @@
+#pragma once
+
+#include "base.hpp"
+#include "hash.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#ifndef WOJ_HASH_MAP_HPP
+#define WOJ_HASH_MAP_HPP
+#endif
+
+namespace woj
+{
+	class hash_capacity_exceeded final : public exception
+	{
+	public:
+		constexpr hash_capacity_exceeded() noexcept : exception{ static_cast<uint64_t>(-1), "Hash container capacity exceeded", nullptr, nullptr } {}
+
+		constexpr hash_capacity_exceeded(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Hash container capacity exceeded", file, function } {}
+	};
+
+	/**
+	 * Snapshot of how far elements of a hash container sit from their home group, a probe length of 1 means the element
+	 * is found in the first group a lookup inspects
+	 */
+	class hash_probe_statistics
+	{
+	public:
+		size_t m_size;
+		size_t m_slot_count;
+		float m_load_factor;
+		float m_mean_probe_length;
+		size_t m_max_probe_length;
+	};
+
+	namespace detail
+	{
+		/**
+		 * Copies a key into raw slot memory, keys without copy constructor (e.g. stack::string) are default-constructed and then assigned
+		 */
+		template <typename Key>
+		constexpr void construct_key(Key* const where, const Key& key)
+		{
+			if constexpr (std::is_copy_constructible_v<Key>)
+			{
+				std::construct_at(where, key);
+			}
+			else
+			{
+				std::construct_at(where);
+				*where = key;
+			}
+		}
+
+		/**
+		 * Swiss-table core with inline storage: 16-byte control groups matched with SIMD, a cached hash per slot and
+		 * linear probing over groups. Lookups stop at the first group with an empty slot; erasing shifts later elements
+		 * back instead of leaving tombstones, so tables with a lot of churn keep short probe sequences.
+		 * @tparam Key Type of the keys
+		 * @tparam Slot Type stored per slot (Key for sets, key/value entry for maps)
+		 * @tparam Capacity Maximum count of elements
+		 * @tparam Hash Hash function object
+		 * @tparam KeyEqual Key comparison function object
+		 */
+		template <typename Key, typename Slot, size_t Capacity, typename Hash, typename KeyEqual>
+		class swiss_table
+		{
+		public:
+			using size_type = size_t;
+			using difference_type = ptrdiff_t;
+
+			static constexpr int8_t ctrl_empty = -128;
+			static constexpr size_type group_width = 16;
+			// Keeps the load factor at or below 7/8 when the table is filled to Capacity
+			static constexpr size_type slot_count = std::bit_ceil((std::max)(group_width, Capacity + Capacity / 7 + 1));
+			static constexpr size_type group_count = slot_count / group_width;
+
+			static_assert(Capacity > 0, "Capacity must be greater than 0");
+
+			template <bool Const>
+			class basic_iterator final
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = Slot;
+				using difference_type = ptrdiff_t;
+				using pointer = std::conditional_t<Const, const Slot*, Slot*>;
+				using reference = std::conditional_t<Const, const Slot&, Slot&>;
+				using table_pointer = std::conditional_t<Const, const swiss_table*, swiss_table*>;
+
+				table_pointer m_table;
+				size_type m_index;
+
+				constexpr basic_iterator() noexcept : m_table{ nullptr }, m_index{ 0 } {}
+
+				constexpr basic_iterator(const table_pointer table, const size_type index) noexcept : m_table{ table }, m_index{ index } {}
+
+				template <bool OtherConst> requires (Const && !OtherConst)
+				constexpr basic_iterator(const basic_iterator<OtherConst>& other) noexcept : m_table{ other.m_table }, m_index{ other.m_index } {}
+
+				constexpr reference operator*() const noexcept
+				{
+					return m_table->m_slots[m_index];
+				}
+
+				constexpr pointer operator->() const noexcept
+				{
+					return m_table->m_slots + m_index;
+				}
+
+				constexpr basic_iterator& operator++() noexcept
+				{
+					m_index = m_table->next_full(m_index + 1);
+					return *this;
+				}
+
+				constexpr basic_iterator operator++(int) noexcept
+				{
+					basic_iterator temp{ *this };
+					++*this;
+					return temp;
+				}
+
+				constexpr bool operator==(const basic_iterator& other) const noexcept
+				{
+					return m_index == other.m_index;
+				}
+
+				constexpr bool operator!=(const basic_iterator& other) const noexcept
+				{
+					return m_index != other.m_index;
+				}
+			};
+
+			using iterator = basic_iterator<false>;
+			using const_iterator = basic_iterator<true>;
+
+			alignas(16) int8_t m_ctrl[slot_count];
+			uint32_t m_hashes[slot_count];
+			size_type m_size;
+
+			union
+			{
+				Slot m_slots[slot_count];
+			};
+
+			constexpr swiss_table() noexcept : m_ctrl{}, m_hashes{}, m_size{ 0 }
+			{
+				std::fill_n(m_ctrl, slot_count, ctrl_empty);
+			}
+
+			constexpr swiss_table(const swiss_table& other) : m_ctrl{}, m_hashes{}, m_size{ 0 }
+			{
+				copy_from(other);
+			}
+
+			constexpr swiss_table(swiss_table&& other) noexcept(std::is_nothrow_move_constructible_v<Slot> || !std::is_move_constructible_v<Slot>) : m_ctrl{}, m_hashes{}, m_size{ 0 }
+			{
+				copy_from(std::move(other));
+			}
+
+			constexpr ~swiss_table() noexcept
+			{
+				destroy_all();
+			}
+
+			constexpr swiss_table& operator=(const swiss_table& other)
+			{
+				if (this != &other)
+				{
+					clear();
+					copy_from(other);
+				}
+				return *this;
+			}
+
+			constexpr swiss_table& operator=(swiss_table&& other) noexcept(std::is_nothrow_move_constructible_v<Slot>)
+			{
+				if (this != &other)
+				{
+					clear();
+					copy_from(std::move(other));
+				}
+				return *this;
+			}
+
+			WOJ_NODISCARD constexpr iterator begin() noexcept
+			{
+				return { this, next_full(0) };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+			{
+				return { this, next_full(0) };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+			{
+				return begin();
+			}
+
+			WOJ_NODISCARD constexpr iterator end() noexcept
+			{
+				return { this, slot_count };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator end() const noexcept
+			{
+				return { this, slot_count };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+			{
+				return end();
+			}
+
+			/**
+			 * @return Count of stored elements
+			 */
+			WOJ_NODISCARD constexpr size_type size() const noexcept
+			{
+				return m_size;
+			}
+
+			/**
+			 * @return True if no elements are stored
+			 */
+			WOJ_NODISCARD constexpr bool empty() const noexcept
+			{
+				return !m_size;
+			}
+
+			/**
+			 * @return True if no more elements can be inserted
+			 */
+			WOJ_NODISCARD constexpr bool full() const noexcept
+			{
+				return m_size == Capacity;
+			}
+
+			/**
+			 * @return Maximum count of elements
+			 */
+			static WOJ_CONSTEVAL size_type capacity() noexcept
+			{
+				return Capacity;
+			}
+
+			/**
+			 * @return Maximum count of elements
+			 */
+			static WOJ_CONSTEVAL size_type max_size() noexcept
+			{
+				return Capacity;
+			}
+
+			/**
+			 * @return Ratio of stored elements to slots
+			 */
+			WOJ_NODISCARD constexpr float load_factor() const noexcept
+			{
+				return static_cast<float>(m_size) / static_cast<float>(slot_count);
+			}
+
+			/**
+			 * Measures the probe lengths (in groups) of all stored elements, linear in the count of slots
+			 * @return Size, slot count, load factor, mean and maximum probe length
+			 */
+			WOJ_NODISCARD constexpr hash_probe_statistics probe_statistics() const noexcept
+			{
+				hash_probe_statistics statistics{ m_size, slot_count, load_factor(), 0.0f, 0 };
+
+				size_type total = 0;
+				for (size_type i = 0; i < slot_count; ++i)
+				{
+					if (m_ctrl[i] >= 0)
+					{
+						const size_type length = probe_distance(i / group_width, home_group(i)) + 1;
+						total += length;
+						statistics.m_max_probe_length = (std::max)(statistics.m_max_probe_length, length);
+					}
+				}
+
+				if (m_size)
+				{
+					statistics.m_mean_probe_length = static_cast<float>(total) / static_cast<float>(m_size);
+				}
+				return statistics;
+			}
+
+			/**
+			 * Finds an element by key
+			 * @tparam LookupKey Type of the key (any type accepted by Hash and KeyEqual)
+			 * @param key Key to find
+			 * @return Iterator to the element or end()
+			 */
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr iterator find(const LookupKey& key) noexcept
+			{
+				return { this, find_index(key, Hash{}(key)) };
+			}
+
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr const_iterator find(const LookupKey& key) const noexcept
+			{
+				return { this, find_index(key, Hash{}(key)) };
+			}
+
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr bool contains(const LookupKey& key) const noexcept
+			{
+				return find_index(key, Hash{}(key)) != slot_count;
+			}
+
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr size_type count(const LookupKey& key) const noexcept
+			{
+				return contains(key);
+			}
+
+			/**
+			 * Erases an element by key
+			 * @param key Key of the element to erase
+			 * @return Count of erased elements (0 or 1)
+			 */
+			template <typename LookupKey>
+			constexpr size_type erase(const LookupKey& key) noexcept
+			{
+				const size_type index = find_index(key, Hash{}(key));
+				if (index == slot_count)
+				{
+					return 0;
+				}
+				erase_index(index);
+				return 1;
+			}
+
+			/**
+			 * Erases the element pointed by an iterator, an element shifted back into the freed slot is the next one
+			 * (when the shift wraps around the end of the table, an element already iterated over can be visited again)
+			 * @param pos Iterator to the element to erase
+			 * @return Iterator to the next element
+			 */
+			constexpr iterator erase(const const_iterator pos) noexcept
+			{
+				erase_index(pos.m_index);
+				return { this, next_full(pos.m_index) };
+			}
+
+			constexpr iterator erase(const iterator pos) noexcept
+			{
+				return erase(const_iterator{ pos });
+			}
+
+			/**
+			 * Erases all elements
+			 */
+			constexpr void clear() noexcept
+			{
+				destroy_all();
+				std::fill_n(m_ctrl, slot_count, ctrl_empty);
+				m_size = 0;
+			}
+
+		protected:
+			WOJ_NODISCARD static constexpr const Key& key_of(const Slot& slot) noexcept
+			{
+				if constexpr (std::is_same_v<Slot, Key>)
+				{
+					return slot;
+				}
+				else
+				{
+					return slot.first;
+				}
+			}
+
+			WOJ_NODISCARD static constexpr int8_t hash_h2(const uint64_t hash) noexcept
+			{
+				return static_cast<int8_t>(hash >> 57);
+			}
+
+			WOJ_NODISCARD constexpr size_type next_full(size_type index) const noexcept
+			{
+				for (; index < slot_count && m_ctrl[index] < 0; ++index);
+				return index;
+			}
+
+			WOJ_NODISCARD constexpr size_type home_group(const size_type index) const noexcept
+			{
+				return static_cast<size_type>(m_hashes[index]) & (group_count - 1);
+			}
+
+			/**
+			 * @return Count of groups a probe sequence advances from group from to reach group to
+			 */
+			WOJ_NODISCARD static constexpr size_type probe_distance(const size_type to, const size_type from) noexcept
+			{
+				return (to - from) & (group_count - 1);
+			}
+
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr size_type find_index(const LookupKey& key, const uint64_t hash) const noexcept
+			{
+				const int8_t h2 = hash_h2(hash);
+				const uint32_t cached = static_cast<uint32_t>(hash);
+				size_type group = static_cast<size_type>(hash) & (group_count - 1);
+
+				for (size_type probe = 0; probe < group_count; ++probe)
+				{
+					const int8_t* const ctrl = m_ctrl + group * group_width;
+
+					for (simd::bitmask match = simd::match_bytes16(ctrl, h2); match; match.remove_lowest())
+					{
+						const size_type index = group * group_width + match.lowest();
+						if (m_hashes[index] == cached && KeyEqual{}(key_of(m_slots[index]), key)) WOJ_LIKELY
+						{
+							return index;
+						}
+					}
+
+					if (simd::match_bytes16(ctrl, ctrl_empty)) WOJ_LIKELY
+					{
+						return slot_count;
+					}
+
+					group = (group + 1) & (group_count - 1);
+				}
+
+				return slot_count;
+			}
+
+			/**
+			 * Finds the key or the first slot it can be inserted into
+			 * @return Pair of slot index and whether the key was found, index is slot_count if the key was not found and the table is full
+			 */
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr std::pair<size_type, bool> find_or_prepare(const LookupKey& key, const uint64_t hash) const noexcept
+			{
+				const int8_t h2 = hash_h2(hash);
+				const uint32_t cached = static_cast<uint32_t>(hash);
+				size_type group = static_cast<size_type>(hash) & (group_count - 1);
+
+				// There are more slots than Capacity, so the probe always reaches a group with an empty slot
+				for (size_type probe = 0; probe < group_count; ++probe)
+				{
+					const int8_t* const ctrl = m_ctrl + group * group_width;
+
+					for (simd::bitmask match = simd::match_bytes16(ctrl, h2); match; match.remove_lowest())
+					{
+						const size_type index = group * group_width + match.lowest();
+						if (m_hashes[index] == cached && KeyEqual{}(key_of(m_slots[index]), key)) WOJ_LIKELY
+						{
+							return { index, true };
+						}
+					}
+
+					if (const simd::bitmask empty = simd::match_bytes16(ctrl, ctrl_empty)) WOJ_LIKELY
+					{
+						return { m_size == Capacity ? slot_count : group * group_width + empty.lowest(), false };
+					}
+
+					group = (group + 1) & (group_count - 1);
+				}
+
+				return { slot_count, false };
+			}
+
+			constexpr void mark_full(const size_type index, const uint64_t hash) noexcept
+			{
+				m_ctrl[index] = hash_h2(hash);
+				m_hashes[index] = static_cast<uint32_t>(hash);
+				++m_size;
+			}
+
+			/**
+			 * Erases a slot and repairs the probe sequences crossing it (backward shift): the following groups are
+			 * scanned and an element whose probe sequence passes through the group of the hole is moved into it, leaving
+			 * a new hole behind; the scan ends at a group that had an empty slot, as no probe sequence goes past it
+			 */
+			constexpr void erase_index(const size_type index) noexcept
+			{
+				std::destroy_at(m_slots + index);
+				--m_size;
+
+				size_type group = index / group_width;
+				// A group that still has an empty slot never extended a probe sequence, there is nothing to repair
+				const bool had_empty = static_cast<bool>(simd::match_bytes16(m_ctrl + group * group_width, ctrl_empty));
+				m_ctrl[index] = ctrl_empty;
+				if (had_empty)
+				{
+					return;
+				}
+
+				size_type hole = index;
+				for (size_type step = 1; step < group_count; ++step)
+				{
+					group = (group + 1) & (group_count - 1);
+					const int8_t* const ctrl = m_ctrl + group * group_width;
+					const bool had_empty = static_cast<bool>(simd::match_bytes16(ctrl, ctrl_empty));
+					const size_type hole_distance = probe_distance(group, hole / group_width);
+
+					for (simd::bitmask full{ ~simd::sign_bytes16(ctrl).m_mask & 0xFFFFu }; full; full.remove_lowest())
+					{
+						const size_type from = group * group_width + full.lowest();
+						if (probe_distance(group, home_group(from)) >= hole_distance)
+						{
+							relocate_slot(from, hole);
+							hole = from;
+							break;
+						}
+					}
+
+					if (had_empty)
+					{
+						return;
+					}
+				}
+			}
+
+		private:
+			constexpr void relocate_slot(const size_type from, const size_type to) noexcept
+			{
+				if constexpr (std::is_same_v<Slot, Key> && !std::is_move_constructible_v<Key>)
+				{
+					construct_key(m_slots + to, m_slots[from]);
+				}
+				else
+				{
+					std::construct_at(m_slots + to, std::move(m_slots[from]));
+				}
+				std::destroy_at(m_slots + from);
+
+				m_ctrl[to] = m_ctrl[from];
+				m_hashes[to] = m_hashes[from];
+				m_ctrl[from] = ctrl_empty;
+			}
+
+			template <typename Other>
+			constexpr void copy_from(Other&& other)
+			{
+				std::copy_n(other.m_ctrl, slot_count, m_ctrl);
+				std::copy_n(other.m_hashes, slot_count, m_hashes);
+				m_size = other.m_size;
+
+				for (size_type i = 0; i < slot_count; ++i)
+				{
+					if (m_ctrl[i] < 0)
+					{
+						continue;
+					}
+
+					if constexpr (std::is_same_v<Slot, Key>)
+					{
+						construct_key(m_slots + i, other.m_slots[i]);
+					}
+					else if constexpr (std::is_rvalue_reference_v<Other&&>)
+					{
+						std::construct_at(m_slots + i, std::move(other.m_slots[i]));
+					}
+					else
+					{
+						std::construct_at(m_slots + i, other.m_slots[i]);
+					}
+				}
+			}
+
+			constexpr void destroy_all() noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<Slot>)
+				{
+					for (size_type i = 0; i < slot_count; ++i)
+					{
+						if (m_ctrl[i] >= 0)
+						{
+							std::destroy_at(m_slots + i);
+						}
+					}
+				}
+			}
+		};
+	}
+
+	namespace stack
+	{
+		/**
+		 * Class representing a key/value pair stored in a hash_map (the key must not be modified through iterators)
+		 * @tparam Key Type of the key
+		 * @tparam Value Type of the value
+		 */
+		template <typename Key, typename Value>
+		class hash_map_entry
+		{
+		public:
+			Key first;
+			Value second;
+
+			template <typename... ValueArgs> requires std::is_copy_constructible_v<Key>
+			constexpr hash_map_entry(const Key& key, ValueArgs&&... value_args) : first(key), second(std::forward<ValueArgs>(value_args)...) {}
+
+			template <typename... ValueArgs> requires (!std::is_copy_constructible_v<Key>)
+			constexpr hash_map_entry(const Key& key, ValueArgs&&... value_args) : first{}, second(std::forward<ValueArgs>(value_args)...)
+			{
+				first = key;
+			}
+
+			constexpr hash_map_entry(const hash_map_entry& other) : hash_map_entry{ other.first, other.second } {}
+
+			constexpr hash_map_entry(hash_map_entry&& other) noexcept(std::is_nothrow_move_constructible_v<Value>) : hash_map_entry{ other.first, std::move(other.second) } {}
+		};
+
+		/**
+		 * Class representing a fixed-capacity, allocation-free hash set stored inline (Swiss-table layout)
+		 * @tparam Key Type of the keys (typically stack::string)
+		 * @tparam Capacity Maximum count of keys
+		 * @tparam Hash Hash function object (Default: woj::hash<Key>)
+		 * @tparam KeyEqual Key comparison function object (Default: std::equal_to<>, vectorised for stack::string)
+		 */
+		template <typename Key, size_t Capacity, typename Hash = woj::hash<Key>, typename KeyEqual = std::equal_to<>>
+		class hash_set : public detail::swiss_table<Key, Key, Capacity, Hash, KeyEqual>
+		{
+			using base = detail::swiss_table<Key, Key, Capacity, Hash, KeyEqual>;
+
+		public:
+			using key_type = Key;
+			using value_type = Key;
+			using typename base::size_type;
+			using typename base::iterator;
+			using typename base::const_iterator;
+
+			constexpr hash_set() noexcept = default;
+
+			constexpr hash_set(const std::initializer_list<Key>& keys) : base{}
+			{
+				for (const Key& key : keys)
+				{
+					insert(key);
+				}
+			}
+
+			/**
+			 * Inserts a key
+			 * @param key Key to insert
+			 * @return Pair of iterator to the key and whether it was inserted, the iterator is end() if the set is full
+			 */
+			constexpr std::pair<iterator, bool> insert(const Key& key)
+			{
+				const uint64_t hash = Hash{}(key);
+				const auto [index, found] = this->find_or_prepare(key, hash);
+
+				if (found || index == base::slot_count)
+				{
+					return { iterator{ this, index }, false };
+				}
+
+				detail::construct_key(this->m_slots + index, key);
+				this->mark_full(index, hash);
+				return { iterator{ this, index }, true };
+			}
+		};
+
+		/**
+		 * Class representing a fixed-capacity, allocation-free hash map stored inline (Swiss-table layout)
+		 * @tparam Key Type of the keys (typically stack::string)
+		 * @tparam Value Type of the values
+		 * @tparam Capacity Maximum count of entries
+		 * @tparam Hash Hash function object (Default: woj::hash<Key>)
+		 * @tparam KeyEqual Key comparison function object (Default: std::equal_to<>, vectorised for stack::string)
+		 */
+		template <typename Key, typename Value, size_t Capacity, typename Hash = woj::hash<Key>, typename KeyEqual = std::equal_to<>>
+		class hash_map : public detail::swiss_table<Key, hash_map_entry<Key, Value>, Capacity, Hash, KeyEqual>
+		{
+			using base = detail::swiss_table<Key, hash_map_entry<Key, Value>, Capacity, Hash, KeyEqual>;
+
+		public:
+			using key_type = Key;
+			using mapped_type = Value;
+			using value_type = hash_map_entry<Key, Value>;
+			using typename base::size_type;
+			using typename base::iterator;
+			using typename base::const_iterator;
+
+			constexpr hash_map() noexcept = default;
+
+			/**
+			 * Inserts an entry constructed from arguments if the key is not present
+			 * @param key Key of the entry
+			 * @param value_args Arguments to construct the value with
+			 * @return Pair of iterator to the entry and whether it was inserted, the iterator is end() if the map is full
+			 */
+			template <typename... ValueArgs>
+			constexpr std::pair<iterator, bool> try_emplace(const Key& key, ValueArgs&&... value_args)
+			{
+				const uint64_t hash = Hash{}(key);
+				const auto [index, found] = this->find_or_prepare(key, hash);
+
+				if (found || index == base::slot_count)
+				{
+					return { iterator{ this, index }, false };
+				}
+
+				std::construct_at(this->m_slots + index, key, std::forward<ValueArgs>(value_args)...);
+				this->mark_full(index, hash);
+				return { iterator{ this, index }, true };
+			}
+
+			/**
+			 * Inserts an entry or assigns to the value if the key is present
+			 * @param key Key of the entry
+			 * @param value Value to insert or assign
+			 * @return Pair of iterator to the entry and whether it was inserted, the iterator is end() if the map is full
+			 */
+			template <typename OtherValue>
+			constexpr std::pair<iterator, bool> insert_or_assign(const Key& key, OtherValue&& value)
+			{
+				const std::pair<iterator, bool> result = try_emplace(key, std::forward<OtherValue>(value));
+				if (!result.second && result.first != this->end())
+				{
+					result.first->second = std::forward<OtherValue>(value);
+				}
+				return result;
+			}
+
+			/**
+			 * Accesses the value of a key, default-constructing it if not present
+			 * @param key Key of the entry
+			 * @return Reference to the value
+			 * @throws hash_capacity_exceeded if the key is not present and the map is full
+			 */
+			constexpr Value& operator[](const Key& key)
+			{
+				const std::pair<iterator, bool> result = try_emplace(key);
+				if (result.first == this->end()) WOJ_UNLIKELY
+				{
+					throw hash_capacity_exceeded{ 740ull, "hash_map.hpp", "woj::stack::hash_map<Key, Value, Capacity, Hash, KeyEqual>::operator[]" };
+				}
+				return result.first->second;
+			}
+
+			/**
+			 * Accesses the value of a key
+			 * @param key Key of the entry
+			 * @return Pointer to the value or nullptr if the key is not present
+			 */
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr Value* get(const LookupKey& key) noexcept
+			{
+				const size_type index = this->find_index(key, Hash{}(key));
+				return index == base::slot_count ? nullptr : &this->m_slots[index].second;
+			}
+
+			template <typename LookupKey>
+			WOJ_NODISCARD constexpr const Value* get(const LookupKey& key) const noexcept
+			{
+				const size_type index = this->find_index(key, Hash{}(key));
+				return index == base::slot_count ? nullptr : &this->m_slots[index].second;
+			}
+		};
+
+		/**
+		 * hash_set under the name of its standard library counterpart
+		 */
+		template <typename Key, size_t Capacity, typename Hash = woj::hash<Key>, typename KeyEqual = std::equal_to<>>
+		using unordered_set = hash_set<Key, Capacity, Hash, KeyEqual>;
+
+		/**
+		 * hash_map under the name of its standard library counterpart
+		 */
+		template <typename Key, typename Value, size_t Capacity, typename Hash = woj::hash<Key>, typename KeyEqual = std::equal_to<>>
+		using unordered_map = hash_map<Key, Value, Capacity, Hash, KeyEqual>;
+	}
+}
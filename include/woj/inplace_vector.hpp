@@ -0,0 +1,730 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_INPLACE_VECTOR_HPP
+#define WOJ_INPLACE_VECTOR_HPP
+#endif
+
+namespace woj
+{
+	namespace stack
+	{
+		/**
+		 * Class representing a vector with a fixed capacity and a variable size, elements are stored in-place
+		 * and constructed lazily, it never allocates
+		 * @tparam ElementType Type of the elements
+		 * @tparam Capacity Maximum count of elements
+		 */
+		template <typename ElementType, size_t Capacity>
+		class inplace_vector
+		{
+		public:
+			using value_type = ElementType;
+			using size_type = size_t;
+			using difference_type = ptrdiff_t;
+			using reference = ElementType&;
+			using const_reference = const ElementType&;
+			using pointer = ElementType*;
+			using const_pointer = const ElementType*;
+			using iterator = ElementType*;
+			using const_iterator = const ElementType*;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			/**
+			 * Smallest unsigned integer type able to hold Capacity
+			 */
+			using count_type = utils::auto_integer_t<0, Capacity>;
+
+			static_assert(Capacity > 0, "Capacity must be greater than 0");
+
+			union
+			{
+				alignas(ElementType) ElementType m_data[Capacity];
+			};
+			count_type m_size;
+
+			constexpr inplace_vector() noexcept : m_size{ 0 } {}
+
+			explicit constexpr inplace_vector(const none_t) noexcept : m_size{ 0 } {}
+
+			/**
+			 * Constructs count value-initialized elements
+			 */
+			explicit constexpr inplace_vector(const size_type count) : m_size{ 0 }
+			{
+				resize(count);
+			}
+
+			constexpr inplace_vector(const size_type count, const ElementType& value) : m_size{ 0 }
+			{
+				resize(count, value);
+			}
+
+			template <size_t OtherSize>
+			explicit constexpr inplace_vector(const ElementType (&other)[OtherSize]) noexcept(std::is_nothrow_copy_constructible_v<ElementType>) : m_size{ 0 }
+			{
+				static_assert(OtherSize <= Capacity, "Array does not fit in the vector");
+
+				copy_construct(other, OtherSize);
+			}
+
+			constexpr inplace_vector(const std::initializer_list<ElementType> values) : m_size{ 0 }
+			{
+				check_capacity(values.size(), 84ull, "woj::stack::inplace_vector<ElementType, Capacity>::inplace_vector");
+				copy_construct(values.begin(), values.size());
+			}
+
+			template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+			constexpr inplace_vector(InputIterator first, const InputIterator last) : m_size{ 0 }
+			{
+				for (; first != last; ++first)
+				{
+					emplace_back(*first);
+				}
+			}
+
+			template <typename... OthersValueTypes>
+			explicit constexpr inplace_vector(in_place_t, OthersValueTypes&&... other_values) : m_size{ 0 }
+			{
+				static_assert(sizeof...(OthersValueTypes) <= Capacity, "Too many values for the vector");
+
+				(unchecked_emplace_back(std::forward<OthersValueTypes>(other_values)), ...);
+			}
+
+			constexpr inplace_vector(const inplace_vector& other) requires std::is_trivially_copy_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr inplace_vector(const inplace_vector& other) noexcept(std::is_nothrow_copy_constructible_v<ElementType>) : m_size{ 0 }
+			{
+				copy_construct(other.m_data, other.m_size);
+			}
+
+			constexpr inplace_vector(inplace_vector&& other) requires std::is_trivially_move_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr inplace_vector(inplace_vector&& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>) : m_size{ 0 }
+			{
+				for (; m_size < other.m_size; ++m_size)
+				{
+					std::construct_at(m_data + m_size, std::move(other.m_data[m_size]));
+				}
+			}
+
+			constexpr ~inplace_vector() requires std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr ~inplace_vector() noexcept
+			{
+				clear();
+			}
+
+			constexpr inplace_vector& operator=(const inplace_vector& other) requires std::is_trivially_copy_assignable_v<ElementType> && std::is_trivially_copy_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr inplace_vector& operator=(const inplace_vector& other)
+			{
+				if (this == &other)
+				{
+					return *this;
+				}
+
+				assign(other.begin(), other.end());
+				return *this;
+			}
+
+			constexpr inplace_vector& operator=(inplace_vector&& other) requires std::is_trivially_move_assignable_v<ElementType> && std::is_trivially_move_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr inplace_vector& operator=(inplace_vector&& other) noexcept(std::is_nothrow_move_assignable_v<ElementType> && std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				if (this == &other)
+				{
+					return *this;
+				}
+
+				const size_type common = m_size < other.m_size ? m_size : other.m_size;
+				for (size_type i = 0; i < common; ++i)
+				{
+					m_data[i] = std::move(other.m_data[i]);
+				}
+				for (size_type i = common; i < other.m_size; ++i)
+				{
+					std::construct_at(m_data + i, std::move(other.m_data[i]));
+				}
+				destroy_from(other.m_size);
+				m_size = other.m_size;
+				return *this;
+			}
+
+			constexpr inplace_vector& operator=(const std::initializer_list<ElementType> values)
+			{
+				assign(values.begin(), values.end());
+				return *this;
+			}
+
+			explicit constexpr operator bool() const noexcept
+			{
+				return m_size != 0;
+			}
+
+			// ----- Element access -----
+
+			constexpr const ElementType& operator[](const size_type index) const noexcept
+#ifndef NDEBUG
+			(false)
+#endif
+			{
+#ifndef NDEBUG
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 186ull, "inplace_vector.hpp", "woj::stack::inplace_vector<ElementType, Capacity>::operator[]" };
+				}
+#endif
+
+				return m_data[index];
+			}
+
+			constexpr ElementType& operator[](const size_type index) noexcept
+#ifndef NDEBUG
+			(false)
+#endif
+			{
+#ifndef NDEBUG
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 201ull, "inplace_vector.hpp", "woj::stack::inplace_vector<ElementType, Capacity>::operator[]" };
+				}
+#endif
+
+				return m_data[index];
+			}
+
+			/**
+			 * Accesses an element with bounds checking in every build
+			 */
+			constexpr const ElementType& at(const size_type index) const
+			{
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 215ull, "inplace_vector.hpp", "woj::stack::inplace_vector<ElementType, Capacity>::at" };
+				}
+				return m_data[index];
+			}
+
+			constexpr ElementType& at(const size_type index)
+			{
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 224ull, "inplace_vector.hpp", "woj::stack::inplace_vector<ElementType, Capacity>::at" };
+				}
+				return m_data[index];
+			}
+
+			WOJ_NODISCARD constexpr const ElementType& front() const noexcept
+			{
+				return m_data[0];
+			}
+
+			WOJ_NODISCARD constexpr ElementType& front() noexcept
+			{
+				return m_data[0];
+			}
+
+			WOJ_NODISCARD constexpr const ElementType& back() const noexcept
+			{
+				return m_data[m_size - 1];
+			}
+
+			WOJ_NODISCARD constexpr ElementType& back() noexcept
+			{
+				return m_data[m_size - 1];
+			}
+
+			WOJ_NODISCARD constexpr const ElementType* data() const noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr ElementType* data() noexcept
+			{
+				return m_data;
+			}
+
+			// ----- Iterators -----
+
+			WOJ_NODISCARD constexpr iterator begin() noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr iterator end() noexcept
+			{
+				return m_data + m_size;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator end() const noexcept
+			{
+				return m_data + m_size;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+			{
+				return m_data + m_size;
+			}
+
+			WOJ_NODISCARD constexpr reverse_iterator rbegin() noexcept
+			{
+				return reverse_iterator{ end() };
+			}
+
+			WOJ_NODISCARD constexpr const_reverse_iterator rbegin() const noexcept
+			{
+				return const_reverse_iterator{ end() };
+			}
+
+			WOJ_NODISCARD constexpr reverse_iterator rend() noexcept
+			{
+				return reverse_iterator{ begin() };
+			}
+
+			WOJ_NODISCARD constexpr const_reverse_iterator rend() const noexcept
+			{
+				return const_reverse_iterator{ begin() };
+			}
+
+			// ----- Capacity -----
+
+			WOJ_NODISCARD constexpr size_type size() const noexcept
+			{
+				return m_size;
+			}
+
+			WOJ_NODISCARD constexpr bool empty() const noexcept
+			{
+				return m_size == 0;
+			}
+
+			WOJ_NODISCARD constexpr bool full() const noexcept
+			{
+				return m_size == Capacity;
+			}
+
+			static WOJ_CONSTEVAL size_type capacity() noexcept
+			{
+				return Capacity;
+			}
+
+			static WOJ_CONSTEVAL size_type max_size() noexcept
+			{
+				return Capacity;
+			}
+
+			/**
+			 * Resizes the vector, new elements are value-initialized
+			 * @param count New size (must not exceed Capacity)
+			 */
+			constexpr void resize(const size_type count)
+			{
+				check_capacity(count, 344ull, "woj::stack::inplace_vector<ElementType, Capacity>::resize");
+
+				destroy_from(count);
+				for (; m_size < count; ++m_size)
+				{
+					std::construct_at(m_data + m_size);
+				}
+			}
+
+			constexpr void resize(const size_type count, const ElementType& value)
+			{
+				check_capacity(count, 355ull, "woj::stack::inplace_vector<ElementType, Capacity>::resize");
+
+				destroy_from(count);
+				for (; m_size < count; ++m_size)
+				{
+					std::construct_at(m_data + m_size, value);
+				}
+			}
+
+			// ----- Modifiers -----
+
+			/**
+			 * Constructs an element at the end
+			 * @param args Arguments to construct the element with
+			 * @return Reference to the new element
+			 * @throws vector_capacity_exceeded if the vector is full
+			 */
+			template <typename... Args>
+			constexpr ElementType& emplace_back(Args&&... args)
+			{
+				if (full()) WOJ_UNLIKELY
+				{
+					throw vector_capacity_exceeded{ 377ull, "inplace_vector.hpp", "woj::stack::inplace_vector<ElementType, Capacity>::emplace_back" };
+				}
+				return unchecked_emplace_back(std::forward<Args>(args)...);
+			}
+
+			constexpr ElementType& push_back(const ElementType& value)
+			{
+				return emplace_back(value);
+			}
+
+			constexpr ElementType& push_back(ElementType&& value)
+			{
+				return emplace_back(std::move(value));
+			}
+
+			/**
+			 * Constructs an element at the end if there is room
+			 * @param args Arguments to construct the element with
+			 * @return Pointer to the new element or nullptr if the vector is full
+			 */
+			template <typename... Args>
+			constexpr ElementType* try_emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<ElementType, Args...>)
+			{
+				if (full())
+				{
+					return nullptr;
+				}
+				return &unchecked_emplace_back(std::forward<Args>(args)...);
+			}
+
+			constexpr ElementType* try_push_back(const ElementType& value) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				return try_emplace_back(value);
+			}
+
+			constexpr ElementType* try_push_back(ElementType&& value) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				return try_emplace_back(std::move(value));
+			}
+
+			/**
+			 * Constructs an element at the end, the vector must not be full
+			 */
+			template <typename... Args>
+			constexpr ElementType& unchecked_emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<ElementType, Args...>)
+			{
+				WOJ_ASSUME(m_size < Capacity);
+
+				ElementType* const element = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+				++m_size;
+				return *element;
+			}
+
+			constexpr ElementType& unchecked_push_back(const ElementType& value) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				return unchecked_emplace_back(value);
+			}
+
+			constexpr ElementType& unchecked_push_back(ElementType&& value) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				return unchecked_emplace_back(std::move(value));
+			}
+
+			/**
+			 * Destroys the last element, the vector must not be empty
+			 */
+			constexpr void pop_back() noexcept
+			{
+				WOJ_ASSUME(m_size > 0);
+
+				--m_size;
+				std::destroy_at(m_data + m_size);
+			}
+
+			/**
+			 * Constructs an element before pos, later elements are shifted right
+			 * @param pos Position to insert at
+			 * @param args Arguments to construct the element with
+			 * @return Iterator to the new element
+			 * @throws vector_capacity_exceeded if the vector is full
+			 */
+			template <typename... Args>
+			constexpr iterator emplace(const const_iterator pos, Args&&... args)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				if (full()) WOJ_UNLIKELY
+				{
+					throw vector_capacity_exceeded{ 464ull, "inplace_vector.hpp", "woj::stack::inplace_vector<ElementType, Capacity>::emplace" };
+				}
+
+				if (index == m_size)
+				{
+					return &unchecked_emplace_back(std::forward<Args>(args)...);
+				}
+
+				// Constructed first so arguments referring to elements of this vector stay valid
+				ElementType value(std::forward<Args>(args)...);
+				if (open_gap(index, 1))
+				{
+					m_data[index] = std::move(value);
+				}
+				else
+				{
+					std::construct_at(m_data + index, std::move(value));
+				}
+				return m_data + index;
+			}
+
+			constexpr iterator insert(const const_iterator pos, const ElementType& value)
+			{
+				return emplace(pos, value);
+			}
+
+			constexpr iterator insert(const const_iterator pos, ElementType&& value)
+			{
+				return emplace(pos, std::move(value));
+			}
+
+			/**
+			 * Inserts count copies of value before pos
+			 * @return Iterator to the first inserted element
+			 */
+			constexpr iterator insert(const const_iterator pos, const size_type count, const ElementType& value)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				check_capacity(m_size + count, 502ull, "woj::stack::inplace_vector<ElementType, Capacity>::insert");
+				if (count == 0)
+				{
+					return m_data + index;
+				}
+
+				const ElementType copy(value);
+				const size_type moved = open_gap(index, count);
+				for (size_type i = 0; i < count; ++i)
+				{
+					if (i < moved)
+					{
+						m_data[index + i] = copy;
+					}
+					else
+					{
+						std::construct_at(m_data + index + i, copy);
+					}
+				}
+				return m_data + index;
+			}
+
+			/**
+			 * Inserts the elements of [first, last) before pos
+			 * @return Iterator to the first inserted element
+			 */
+			template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+			constexpr iterator insert(const const_iterator pos, InputIterator first, const InputIterator last)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				const size_type old_size = m_size;
+
+				for (; first != last; ++first)
+				{
+					emplace_back(*first);
+				}
+
+				std::rotate(m_data + index, m_data + old_size, m_data + m_size);
+				return m_data + index;
+			}
+
+			constexpr iterator insert(const const_iterator pos, const std::initializer_list<ElementType> values)
+			{
+				return insert(pos, values.begin(), values.end());
+			}
+
+			/**
+			 * Removes the element at pos, later elements are shifted left
+			 * @return Iterator to the element following the removed one
+			 */
+			constexpr iterator erase(const const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				return erase(pos, pos + 1);
+			}
+
+			/**
+			 * Removes the elements of [first, last)
+			 * @return Iterator to the element following the removed ones
+			 */
+			constexpr iterator erase(const const_iterator first, const const_iterator last) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				const size_type index = static_cast<size_type>(first - m_data);
+				const size_type count = static_cast<size_type>(last - first);
+
+				if (count)
+				{
+					if constexpr (is_trivially_relocatable_v<ElementType>)
+					{
+						if (!is_constant_evaluated())
+						{
+							std::destroy_n(m_data + index, count);
+							woj::uninitialized_relocate_n(m_data + index + count, m_size - index - count, m_data + index);
+							m_size = static_cast<count_type>(m_size - count);
+							return m_data + index;
+						}
+					}
+
+					std::move(m_data + index + count, m_data + m_size, m_data + index);
+					destroy_from(m_size - count);
+				}
+				return m_data + index;
+			}
+
+			/**
+			 * Removes the element at pos by moving the last element into its place (does not keep the order)
+			 * @return Iterator to the element now at pos
+			 */
+			constexpr iterator swap_erase(const const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				if (index != m_size - 1u)
+				{
+					m_data[index] = std::move(m_data[m_size - 1]);
+				}
+				pop_back();
+				return m_data + index;
+			}
+
+			template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+			constexpr void assign(InputIterator first, const InputIterator last)
+			{
+				size_type i = 0;
+				for (; first != last && i < m_size; ++first, ++i)
+				{
+					m_data[i] = *first;
+				}
+				destroy_from(i);
+				for (; first != last; ++first)
+				{
+					emplace_back(*first);
+				}
+			}
+
+			constexpr void assign(const size_type count, const ElementType& value)
+			{
+				check_capacity(count, 617ull, "woj::stack::inplace_vector<ElementType, Capacity>::assign");
+
+				const size_type common = m_size < count ? m_size : count;
+				for (size_type i = 0; i < common; ++i)
+				{
+					m_data[i] = value;
+				}
+				resize(count, value);
+			}
+
+			constexpr void clear() noexcept
+			{
+				destroy_from(0);
+			}
+
+			constexpr void swap(inplace_vector& other) noexcept(std::is_nothrow_swappable_v<ElementType> && std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				inplace_vector& shorter = m_size < other.m_size ? *this : other;
+				inplace_vector& longer = m_size < other.m_size ? other : *this;
+
+				for (size_type i = 0; i < shorter.m_size; ++i)
+				{
+					using std::swap;
+					swap(shorter.m_data[i], longer.m_data[i]);
+				}
+				for (size_type i = shorter.m_size; i < longer.m_size; ++i)
+				{
+					std::construct_at(shorter.m_data + i, std::move(longer.m_data[i]));
+				}
+				const size_type common = shorter.m_size;
+				shorter.m_size = longer.m_size;
+				longer.destroy_from(common);
+			}
+
+			// ----- Comparison -----
+
+			template <size_t OtherCapacity>
+			WOJ_NODISCARD constexpr bool operator==(const inplace_vector<ElementType, OtherCapacity>& other) const noexcept
+			{
+				return m_size == other.m_size && std::equal(m_data, m_data + m_size, other.m_data);
+			}
+
+		private:
+			constexpr void check_capacity(const size_type count, const size_t line, const char* const function) const
+			{
+				if (count > Capacity) WOJ_UNLIKELY
+				{
+					throw vector_capacity_exceeded{ line, "inplace_vector.hpp", function };
+				}
+			}
+
+			constexpr void copy_construct(const ElementType* const source, const size_type count) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				woj::uninitialized_copy_n(source, count, m_data);
+				m_size = static_cast<count_type>(count);
+			}
+
+			/**
+			 * Destroys the elements from index on and shrinks the size to index (no-op if index >= size)
+			 */
+			constexpr void destroy_from(const size_type index) noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<ElementType>)
+				{
+					for (size_type i = index; i < m_size; ++i)
+					{
+						std::destroy_at(m_data + i);
+					}
+				}
+				if (index < m_size)
+				{
+					m_size = static_cast<count_type>(index);
+				}
+			}
+
+			/**
+			 * Shifts [index, size) right by count, the first min(count, size - index) slots of the gap stay constructed
+			 * (moved-from) and the rest is raw storage, trivially relocatable elements are relocated and leave the whole gap raw
+			 * @return Count of gap slots holding moved-from elements
+			 */
+			constexpr size_type open_gap(const size_type index, const size_type count)
+			{
+				const size_type tail = m_size - index;
+
+				if constexpr (is_trivially_relocatable_v<ElementType>)
+				{
+					if (!is_constant_evaluated())
+					{
+						woj::uninitialized_relocate_n(m_data + index, tail, m_data + index + count);
+						m_size = static_cast<count_type>(m_size + count);
+						return 0;
+					}
+				}
+
+				// Elements moved past the old end are constructed, the rest is move-assigned backwards
+				const size_type old_size = m_size;
+				const size_type constructed_from = tail > count ? old_size - count : index;
+				for (size_type i = constructed_from; i < old_size; ++i)
+				{
+					std::construct_at(m_data + i + count, std::move(m_data[i]));
+				}
+				std::move_backward(m_data + index, m_data + constructed_from, m_data + constructed_from + count);
+				m_size = static_cast<count_type>(old_size + count);
+				return tail < count ? tail : count;
+			}
+		};
+
+		template <typename ElementType, typename... OthersValueTypes>
+		inplace_vector(in_place_t, ElementType&&, OthersValueTypes&&...) -> inplace_vector<std::common_type_t<std::remove_cvref_t<ElementType>, std::remove_cvref_t<OthersValueTypes>...>, sizeof...(OthersValueTypes) + 1>;
+	}
+
+	template <typename ElementType, size_t Capacity>
+	struct is_trivially_relocatable<stack::inplace_vector<ElementType, Capacity>> : is_trivially_relocatable<ElementType> {};
+}
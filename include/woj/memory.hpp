@@ -0,0 +1,312 @@
+#pragma once
+
+#include "base.hpp"
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_MEMORY_HPP
+#define WOJ_MEMORY_HPP
+#endif
+
+namespace woj
+{
+	class bad_allocation final : public exception
+	{
+	public:
+		constexpr bad_allocation() noexcept : exception{ static_cast<uint64_t>(-1), "Memory allocation failed", nullptr, nullptr } {}
+
+		constexpr bad_allocation(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Memory allocation failed", file, function } {}
+	};
+
+	/**
+	 * Assumed size of a cache line (and of the false sharing granularity), used to keep data written by different threads apart
+	 */
+	inline constexpr size_t cache_line_size = 64;
+
+	/**
+	 * Allocators hand out untyped memory: allocate(size, alignment) returns storage for size bytes (throwing on failure)
+	 * and deallocate(ptr, size, alignment) gets back the same size and alignment it was allocated with
+	 */
+	template <typename Allocator>
+	concept allocator_type = requires(Allocator& allocator, void* const ptr, const size_t size, const size_t alignment)
+	{
+		{ allocator.allocate(size, alignment) } -> std::same_as<void*>;
+		{ allocator.deallocate(ptr, size, alignment) } noexcept;
+	};
+
+	/**
+	 * Allocators that can also resize an allocation in place or move it (copying the bytes) with reallocate(ptr, old_size, new_size, alignment),
+	 * containers use it only for trivially relocatable elements
+	 */
+	template <typename Allocator>
+	concept reallocating_allocator_type = allocator_type<Allocator> && requires(Allocator& allocator, void* const ptr, const size_t size, const size_t alignment)
+	{
+		{ allocator.reallocate(ptr, size, size, alignment) } -> std::same_as<void*>;
+	};
+
+	/**
+	 * Stateless allocator using malloc/realloc/free, over-aligned requests go through aligned operator new
+	 */
+	class default_allocator
+	{
+	public:
+		static void* allocate(const size_t size, const size_t alignment)
+		{
+			void* const ptr = alignment <= alignof(std::max_align_t) ? std::malloc(size) : ::operator new(size, std::align_val_t{ alignment }, std::nothrow);
+			if (!ptr && size) WOJ_UNLIKELY
+			{
+				throw bad_allocation{ 64ull, "memory.hpp", "woj::default_allocator::allocate" };
+			}
+			return ptr;
+		}
+
+		static void deallocate(void* const ptr, WOJ_MAYBE_UNUSED const size_t size, const size_t alignment) noexcept
+		{
+			if (alignment <= alignof(std::max_align_t))
+			{
+				std::free(ptr);
+			}
+			else
+			{
+				::operator delete(ptr, std::align_val_t{ alignment });
+			}
+		}
+
+		static void* reallocate(void* const ptr, const size_t old_size, const size_t new_size, const size_t alignment)
+		{
+			if (alignment <= alignof(std::max_align_t))
+			{
+				void* const new_ptr = std::realloc(ptr, new_size);
+				if (!new_ptr && new_size) WOJ_UNLIKELY
+				{
+					throw bad_allocation{ 88ull, "memory.hpp", "woj::default_allocator::reallocate" };
+				}
+				return new_ptr;
+			}
+
+			void* const new_ptr = allocate(new_size, alignment);
+			std::memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+			deallocate(ptr, old_size, alignment);
+			return new_ptr;
+		}
+
+		constexpr bool operator==(const default_allocator&) const noexcept = default;
+	};
+
+	/**
+	 * Trait telling whether moving an object to a new address and ending the lifetime of the source can be done
+	 * with a plain memcpy (no move constructor and no destructor call), specialize it for types owning resources
+	 * through pointers that do not point back into the object itself
+	 * @tparam Type Type to query
+	 */
+	template <typename Type>
+	struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<Type>> {};
+
+	template <typename Type, typename Deleter>
+	struct is_trivially_relocatable<std::unique_ptr<Type, Deleter>> : is_trivially_relocatable<Deleter> {};
+
+	template <typename Type>
+	struct is_trivially_relocatable<std::shared_ptr<Type>> : std::true_type {};
+
+	template <typename Type>
+	struct is_trivially_relocatable<std::weak_ptr<Type>> : std::true_type {};
+
+	template <typename Type>
+	struct is_trivially_relocatable<const Type> : is_trivially_relocatable<Type> {};
+
+	template <typename Type, size_t Size>
+	struct is_trivially_relocatable<Type[Size]> : is_trivially_relocatable<Type> {};
+
+	template <typename Type>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Type>::value;
+
+	/**
+	 * Value-initializes count elements in uninitialized storage
+	 * @param destination Uninitialized storage for count elements
+	 * @param count Count of elements
+	 */
+	template <typename Type>
+	constexpr void uninitialized_value_construct_n(Type* const destination, const size_t count) noexcept(std::is_nothrow_default_constructible_v<Type>)
+	{
+		size_t i = 0;
+		if constexpr (std::is_nothrow_default_constructible_v<Type>)
+		{
+			for (; i < count; ++i)
+			{
+				std::construct_at(destination + i);
+			}
+		}
+		else
+		{
+			try
+			{
+				for (; i < count; ++i)
+				{
+					std::construct_at(destination + i);
+				}
+			}
+			catch (...)
+			{
+				std::destroy_n(destination, i);
+				throw;
+			}
+		}
+	}
+
+	/**
+	 * Copy-constructs count elements from value in uninitialized storage
+	 * @param destination Uninitialized storage for count elements
+	 * @param count Count of elements
+	 * @param value Value to copy
+	 */
+	template <typename Type>
+	constexpr void uninitialized_fill_n(Type* const destination, const size_t count, const Type& value) noexcept(std::is_nothrow_copy_constructible_v<Type>)
+	{
+		size_t i = 0;
+		if constexpr (std::is_nothrow_copy_constructible_v<Type>)
+		{
+			for (; i < count; ++i)
+			{
+				std::construct_at(destination + i, value);
+			}
+		}
+		else
+		{
+			try
+			{
+				for (; i < count; ++i)
+				{
+					std::construct_at(destination + i, value);
+				}
+			}
+			catch (...)
+			{
+				std::destroy_n(destination, i);
+				throw;
+			}
+		}
+	}
+
+	/**
+	 * Copies count elements into uninitialized storage
+	 * @param source First element to copy
+	 * @param count Count of elements
+	 * @param destination Uninitialized storage for count elements (must not overlap the source)
+	 */
+	template <typename Type>
+	constexpr void uninitialized_copy_n(const Type* const source, const size_t count, Type* const destination) noexcept(std::is_nothrow_copy_constructible_v<Type>)
+	{
+		if constexpr (std::is_trivially_copyable_v<Type>)
+		{
+			if (!is_constant_evaluated())
+			{
+				if (count)
+				{
+					std::memcpy(destination, source, count * sizeof(Type));
+				}
+				return;
+			}
+		}
+
+		size_t i = 0;
+		if constexpr (std::is_nothrow_copy_constructible_v<Type>)
+		{
+			for (; i < count; ++i)
+			{
+				std::construct_at(destination + i, source[i]);
+			}
+		}
+		else
+		{
+			try
+			{
+				for (; i < count; ++i)
+				{
+					std::construct_at(destination + i, source[i]);
+				}
+			}
+			catch (...)
+			{
+				std::destroy_n(destination, i);
+				throw;
+			}
+		}
+	}
+
+	/**
+	 * Move-constructs count elements into uninitialized storage, the sources stay alive (moved-from)
+	 * @param source First element to move
+	 * @param count Count of elements
+	 * @param destination Uninitialized storage for count elements (must not overlap the source)
+	 */
+	template <typename Type>
+	constexpr void uninitialized_move_n(Type* const source, const size_t count, Type* const destination) noexcept(std::is_nothrow_move_constructible_v<Type>)
+	{
+		if constexpr (std::is_trivially_copyable_v<Type>)
+		{
+			if (!is_constant_evaluated())
+			{
+				if (count)
+				{
+					std::memcpy(destination, source, count * sizeof(Type));
+				}
+				return;
+			}
+		}
+
+		size_t i = 0;
+		if constexpr (std::is_nothrow_move_constructible_v<Type>)
+		{
+			for (; i < count; ++i)
+			{
+				std::construct_at(destination + i, std::move(source[i]));
+			}
+		}
+		else
+		{
+			try
+			{
+				for (; i < count; ++i)
+				{
+					std::construct_at(destination + i, std::move(source[i]));
+				}
+			}
+			catch (...)
+			{
+				std::destroy_n(destination, i);
+				throw;
+			}
+		}
+	}
+
+	/**
+	 * Relocates count elements into uninitialized storage, the lifetime of the sources ends
+	 * @param source First element to relocate
+	 * @param count Count of elements
+	 * @param destination Uninitialized storage for count elements, may overlap the source when the type is trivially relocatable
+	 */
+	template <typename Type>
+	constexpr void uninitialized_relocate_n(Type* const source, const size_t count, Type* const destination) noexcept(is_trivially_relocatable_v<Type> || std::is_nothrow_move_constructible_v<Type>)
+	{
+		if constexpr (is_trivially_relocatable_v<Type>)
+		{
+			if (!is_constant_evaluated())
+			{
+				if (count)
+				{
+					std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(Type));
+				}
+				return;
+			}
+		}
+
+		uninitialized_move_n(source, count, destination);
+		std::destroy_n(source, count);
+	}
+}
@@ -0,0 +1,327 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_MPMC_QUEUE_HPP
+#define WOJ_MPMC_QUEUE_HPP
+#endif
+
+namespace woj
+{
+	namespace stack
+	{
+		/**
+		 * Class representing a bounded lock-free multi-producer/multi-consumer FIFO queue (Vyukov's algorithm), elements are
+		 * stored in-place, every slot carries a sequence number telling whose turn it is: pos when it is free for the producer
+		 * of position pos, pos + 1 when it holds the element of position pos
+		 * The blocking push/pop take a ticket and sleep on the slot's sequence (futex on Linux, WaitOnAddress on Windows),
+		 * they can be mixed freely with the non-blocking try_push/try_pop
+		 * @tparam ElementType Type of the elements
+		 * @tparam Capacity Maximum count of elements (a power of two turns the index wrapping into a mask)
+		 */
+		template <typename ElementType, size_t Capacity>
+		class mpmc_queue
+		{
+		public:
+			using value_type = ElementType;
+			using size_type = size_t;
+
+			/**
+			 * 32-bit so that waiting on it maps directly to a futex, positions are compared modulo 2^32
+			 */
+			using sequence_type = uint32_t;
+
+			static_assert(Capacity > 0, "Capacity must be greater than 0");
+			static_assert(Capacity <= (static_cast<size_t>(1) << 30), "Capacity must fit in the sequence numbers");
+
+			class slot
+			{
+			public:
+				std::atomic<sequence_type> m_sequence;
+
+				union
+				{
+					ElementType m_value;
+				};
+
+				slot() noexcept {}
+
+				~slot() noexcept {}
+			};
+
+			alignas(cache_line_size) std::atomic<size_type> m_enqueue;
+			alignas(cache_line_size) std::atomic<size_type> m_dequeue;
+			alignas(cache_line_size) std::atomic<uint32_t> m_waiting;
+			alignas(cache_line_size) slot m_slots[Capacity];
+
+			mpmc_queue() noexcept : m_enqueue{ 0 }, m_dequeue{ 0 }, m_waiting{ 0 }
+			{
+				for (size_type i = 0; i < Capacity; ++i)
+				{
+					m_slots[i].m_sequence.store(static_cast<sequence_type>(i), std::memory_order_relaxed);
+				}
+			}
+
+			mpmc_queue(const mpmc_queue&) = delete;
+
+			mpmc_queue(mpmc_queue&&) = delete;
+
+			/**
+			 * Destroys the elements left in the queue, destroying it while a blocking push or pop still waits is undefined
+			 * behavior (a waiting pop leaves the dequeue ticket ahead of the enqueue ticket, there is nothing to destroy then)
+			 */
+			~mpmc_queue() noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<ElementType>)
+				{
+					const size_type enqueue = m_enqueue.load(std::memory_order_relaxed);
+					const size_type dequeue = m_dequeue.load(std::memory_order_relaxed);
+					for (size_type position = dequeue; position < enqueue; ++position)
+					{
+						std::destroy_at(&m_slots[position % Capacity].m_value);
+					}
+				}
+			}
+
+			mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+			mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+			// ----- Non-blocking -----
+
+			/**
+			 * Constructs an element at the back of the queue in-place
+			 * @return Whether there was room for it
+			 */
+			template <typename... Args>
+			bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<ElementType, Args&&...>)
+			{
+				size_type position = m_enqueue.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					slot& current = m_slots[position % Capacity];
+					const int32_t difference = distance(current.m_sequence.load(std::memory_order_acquire), position);
+					if (difference == 0)
+					{
+						if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							construct(current, position, std::forward<Args>(args)...);
+							return true;
+						}
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = m_enqueue.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			bool try_push(const ElementType& value) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				return try_emplace(value);
+			}
+
+			bool try_push(ElementType&& value) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				return try_emplace(std::move(value));
+			}
+
+			/**
+			 * Moves the oldest element out of the queue
+			 * @return Whether there was an element
+			 */
+			bool try_pop(ElementType& value) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				size_type position = m_dequeue.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					slot& current = m_slots[position % Capacity];
+					const int32_t difference = distance(current.m_sequence.load(std::memory_order_acquire), position + 1);
+					if (difference == 0)
+					{
+						if (m_dequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							take(current, position, value);
+							return true;
+						}
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = m_dequeue.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			// ----- Blocking -----
+
+			/**
+			 * Constructs an element at the back of the queue in-place, sleeping while the queue is full
+			 */
+			template <typename... Args>
+			void emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<ElementType, Args&&...>)
+			{
+				const size_type position = m_enqueue.fetch_add(1, std::memory_order_relaxed);
+				slot& current = m_slots[position % Capacity];
+				wait_for(current, static_cast<sequence_type>(position));
+				construct(current, position, std::forward<Args>(args)...);
+			}
+
+			void push(const ElementType& value) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				emplace(value);
+			}
+
+			void push(ElementType&& value) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				emplace(std::move(value));
+			}
+
+			/**
+			 * Moves the oldest element out of the queue, sleeping while the queue is empty
+			 */
+			void pop(ElementType& value) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				const size_type position = m_dequeue.fetch_add(1, std::memory_order_relaxed);
+				slot& current = m_slots[position % Capacity];
+				wait_for(current, static_cast<sequence_type>(position + 1));
+				take(current, position, value);
+			}
+
+			// ----- Observers -----
+
+			/**
+			 * @return Approximate count of elements (negative counts of pending blocking pops are reported as 0)
+			 */
+			WOJ_NODISCARD size_type size() const noexcept
+			{
+				const size_type dequeue = m_dequeue.load(std::memory_order_acquire);
+				const size_type enqueue = m_enqueue.load(std::memory_order_acquire);
+				return enqueue > dequeue ? enqueue - dequeue : 0;
+			}
+
+			WOJ_NODISCARD bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			static WOJ_CONSTEVAL size_type capacity() noexcept
+			{
+				return Capacity;
+			}
+
+		private:
+			WOJ_NODISCARD static int32_t distance(const sequence_type sequence, const size_type position) noexcept
+			{
+				return static_cast<int32_t>(sequence - static_cast<sequence_type>(position));
+			}
+
+			/**
+			 * Sleeps until the slot's sequence reaches expected, registered in m_waiting so that publish only notifies
+			 * while someone sleeps
+			 */
+			void wait_for(slot& current, const sequence_type expected) noexcept
+			{
+				sequence_type sequence = current.m_sequence.load(std::memory_order_acquire);
+				if (sequence == expected)
+				{
+					return;
+				}
+
+				m_waiting.fetch_add(1, std::memory_order_relaxed);
+				// Pairs with the fence in publish: either the publisher sees this waiter or the reload sees the new sequence
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				for (sequence = current.m_sequence.load(std::memory_order_acquire); sequence != expected; sequence = current.m_sequence.load(std::memory_order_acquire))
+				{
+					current.m_sequence.wait(sequence, std::memory_order_acquire);
+				}
+				m_waiting.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			template <typename... Args>
+			void construct(slot& current, const size_type position, Args&&... args) noexcept(std::is_nothrow_constructible_v<ElementType, Args&&...>)
+			{
+				if constexpr (std::is_nothrow_constructible_v<ElementType, Args&&...>)
+				{
+					std::construct_at(&current.m_value, std::forward<Args>(args)...);
+				}
+				else
+				{
+					// The position is already claimed and a consumer may be waiting for it, so the slot is published anyway
+					// holding a value-initialized element (elements that cannot be value-initialized have to be constructed without throwing)
+					try
+					{
+						std::construct_at(&current.m_value, std::forward<Args>(args)...);
+					}
+					catch (...)
+					{
+						if constexpr (std::is_nothrow_default_constructible_v<ElementType>)
+						{
+							std::construct_at(&current.m_value);
+							publish(current, static_cast<sequence_type>(position + 1));
+							throw;
+						}
+						else
+						{
+							std::terminate();
+						}
+					}
+				}
+				publish(current, static_cast<sequence_type>(position + 1));
+			}
+
+			void take(slot& current, const size_type position, ElementType& value) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				if constexpr (std::is_nothrow_move_assignable_v<ElementType>)
+				{
+					value = std::move(current.m_value);
+				}
+				else
+				{
+					// The position is already claimed and the next producer of the slot may be waiting for it, so the
+					// element is dropped and the slot released anyway
+					try
+					{
+						value = std::move(current.m_value);
+					}
+					catch (...)
+					{
+						std::destroy_at(&current.m_value);
+						publish(current, static_cast<sequence_type>(position + Capacity));
+						throw;
+					}
+				}
+				std::destroy_at(&current.m_value);
+				publish(current, static_cast<sequence_type>(position + Capacity));
+			}
+
+			/**
+			 * Stores the slot's new sequence and wakes its sleepers, the notify (a syscall) is skipped while nobody waits
+			 */
+			void publish(slot& current, const sequence_type sequence) noexcept
+			{
+				current.m_sequence.store(sequence, std::memory_order_release);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (m_waiting.load(std::memory_order_relaxed) != 0)
+				{
+					current.m_sequence.notify_all();
+				}
+			}
+		};
+	}
+}
@@ -0,0 +1,667 @@
+#pragma once
+
+#include "base.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_NUMERIC_HPP
+#define WOJ_NUMERIC_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Type sums of Type are accumulated in: Type itself for floating point, 64-bit integers otherwise
+	 */
+	template <typename Type>
+	using sum_type_t = std::conditional_t<std::is_floating_point_v<Type>, Type, std::conditional_t<std::is_signed_v<Type>, int64_t, uint64_t>>;
+
+	/**
+	 * Type norms of Type are computed in
+	 */
+	template <typename Type>
+	using norm_type_t = std::conditional_t<std::is_floating_point_v<Type>, Type, double>;
+
+	namespace detail
+	{
+		/**
+		 * stack::vector sizes up to this are reduced with a fully unrolled fold instead of a loop
+		 */
+		inline constexpr size_t numeric_unroll_limit = 16;
+
+		template <typename Type>
+		concept numeric_type = std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>;
+
+		template <typename Range>
+		concept numeric_range = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range> && numeric_type<std::remove_cv_t<std::ranges::range_value_t<Range>>>;
+
+		template <typename Type>
+		WOJ_NODISCARD constexpr Type numeric_sqrt(const Type value) noexcept
+		{
+			if (!is_constant_evaluated())
+			{
+				return std::sqrt(value);
+			}
+
+			if (!(value > Type{ 0 }) || value != value || value == std::numeric_limits<Type>::infinity())
+			{
+				return value;
+			}
+			Type current = value >= Type{ 1 } ? value : Type{ 1 };
+			for (;;)
+			{
+				const Type next = (current + value / current) / Type{ 2 };
+				if (!(next < current))
+				{
+					return current;
+				}
+				current = next;
+			}
+		}
+
+		template <typename Type>
+		WOJ_NODISCARD constexpr Type scalar_minimum(const Type* const data, const size_t count) noexcept
+		{
+			Type result = data[0];
+			for (size_t i = 1; i < count; ++i)
+			{
+				result = data[i] < result ? data[i] : result;
+			}
+			return result;
+		}
+
+		template <typename Type>
+		WOJ_NODISCARD constexpr Type scalar_maximum(const Type* const data, const size_t count) noexcept
+		{
+			Type result = data[0];
+			for (size_t i = 1; i < count; ++i)
+			{
+				result = data[i] > result ? data[i] : result;
+			}
+			return result;
+		}
+
+#if defined(WOJ_HAS_SSE2)
+		/**
+		 * Prefix sums of one 128-bit register (log-step shifts) plus the carry of previous blocks
+		 * @return Inclusive sums of the lanes
+		 */
+		inline __m128 scan_block(const __m128 block) noexcept
+		{
+			__m128 result = _mm_add_ps(block, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(block), 4)));
+			return _mm_add_ps(result, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(result), 8)));
+		}
+
+		inline __m128d scan_block(const __m128d block) noexcept
+		{
+			return _mm_add_pd(block, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(block), 8)));
+		}
+
+		inline __m128i scan_block(const __m128i block) noexcept
+		{
+			const __m128i result = _mm_add_epi32(block, _mm_slli_si128(block, 4));
+			return _mm_add_epi32(result, _mm_slli_si128(result, 8));
+		}
+
+		/**
+		 * SSE2 prefix sum kernel for float, double and 32-bit integers
+		 * @return Count of elements processed (a multiple of the block width)
+		 */
+		template <bool Inclusive, typename Type>
+		size_t scan_sse2(const Type* const source, const size_t count, Type* const destination, Type& carry) noexcept
+		{
+			size_t i = 0;
+			if constexpr (std::is_same_v<Type, float>)
+			{
+				__m128 running = _mm_set1_ps(carry);
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128 sums = scan_block(_mm_loadu_ps(source + i));
+					const __m128 shifted = Inclusive ? sums : _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(sums), 4));
+					_mm_storeu_ps(destination + i, _mm_add_ps(shifted, running));
+					running = _mm_add_ps(running, _mm_shuffle_ps(sums, sums, 0xFF));
+				}
+				carry = _mm_cvtss_f32(running);
+			}
+			else if constexpr (std::is_same_v<Type, double>)
+			{
+				__m128d running = _mm_set1_pd(carry);
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128d sums = scan_block(_mm_loadu_pd(source + i));
+					const __m128d shifted = Inclusive ? sums : _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(sums), 8));
+					_mm_storeu_pd(destination + i, _mm_add_pd(shifted, running));
+					running = _mm_add_pd(running, _mm_unpackhi_pd(sums, sums));
+				}
+				carry = _mm_cvtsd_f64(running);
+			}
+			else
+			{
+				__m128i running = _mm_set1_epi32(static_cast<int32_t>(carry));
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i sums = scan_block(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+					const __m128i shifted = Inclusive ? sums : _mm_slli_si128(sums, 4);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_add_epi32(shifted, running));
+					running = _mm_add_epi32(running, _mm_shuffle_epi32(sums, 0xFF));
+				}
+				carry = static_cast<Type>(_mm_cvtsi128_si32(running));
+			}
+			return i;
+		}
+#endif
+
+		template <bool Inclusive, typename Type>
+		constexpr void scan(const Type* const source, const size_t count, Type* const destination, Type carry) noexcept
+		{
+			size_t i = 0;
+#if defined(WOJ_HAS_SSE2)
+			if constexpr (std::is_same_v<Type, float> || std::is_same_v<Type, double> || (std::is_integral_v<Type> && sizeof(Type) == 4))
+			{
+				if (!is_constant_evaluated())
+				{
+					i = scan_sse2<Inclusive>(source, count, destination, carry);
+				}
+			}
+#endif
+
+			for (; i < count; ++i)
+			{
+				// Read before writing so the scan can run in place
+				const Type value = source[i];
+				if constexpr (Inclusive)
+				{
+					carry = static_cast<Type>(carry + value);
+					destination[i] = carry;
+				}
+				else
+				{
+					destination[i] = carry;
+					carry = static_cast<Type>(carry + value);
+				}
+			}
+		}
+	}
+
+	// ----- Sum -----
+
+	/**
+	 * Sums count values, floating point values are summed with 4 independent SIMD accumulators (so the result may
+	 * differ from a sequential sum in the last bits, use kahan_sum when that matters)
+	 * @param data Pointer to the values
+	 * @param count Count of values
+	 * @return Sum of the values (0 if count is 0)
+	 */
+	template <detail::numeric_type Type>
+	WOJ_NODISCARD constexpr sum_type_t<Type> sum(const Type* const data, const size_t count) noexcept
+	{
+		size_t i = 0;
+		sum_type_t<Type> result{};
+
+		if constexpr (simd::has_pack_v<Type>)
+		{
+			if (!is_constant_evaluated())
+			{
+				using pack = simd::pack<Type>;
+				constexpr size_t width = pack::width;
+				pack first = pack::zero(), second = pack::zero(), third = pack::zero(), fourth = pack::zero();
+				for (; i + 4 * width <= count; i += 4 * width)
+				{
+					first = first + pack::load(data + i);
+					second = second + pack::load(data + i + width);
+					third = third + pack::load(data + i + 2 * width);
+					fourth = fourth + pack::load(data + i + 3 * width);
+				}
+				for (; i + width <= count; i += width)
+				{
+					first = first + pack::load(data + i);
+				}
+				result = reduce_add((first + second) + (third + fourth));
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			result += data[i];
+		}
+		return result;
+	}
+
+	template <detail::numeric_type Type, size_t Size>
+	WOJ_NODISCARD constexpr sum_type_t<Type> sum(const stack::vector<Type, Size>& values) noexcept
+	{
+		if constexpr (Size <= detail::numeric_unroll_limit)
+		{
+			return [&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				return (sum_type_t<Type>{} + ... + values.m_data[Indices]);
+			}(std::make_index_sequence<Size>{});
+		}
+		else
+		{
+			return sum(values.m_data, Size);
+		}
+	}
+
+	template <detail::numeric_range Range>
+	WOJ_NODISCARD constexpr auto sum(const Range& values) noexcept
+	{
+		return sum(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)));
+	}
+
+	/**
+	 * Sums count floating point values with Kahan compensation, each SIMD lane keeps its own compensation term
+	 * (do not compile with -ffast-math or /fp:fast, it removes the compensation)
+	 * @param data Pointer to the values
+	 * @param count Count of values
+	 * @return Compensated sum of the values
+	 */
+	template <typename Type> requires std::is_floating_point_v<Type>
+	WOJ_NODISCARD constexpr Type kahan_sum(const Type* const data, const size_t count) noexcept
+	{
+		size_t i = 0;
+		Type result{};
+		Type compensation{};
+
+		const auto add = [&](const Type value)
+		{
+			const Type corrected = value - compensation;
+			const Type next = result + corrected;
+			compensation = (next - result) - corrected;
+			result = next;
+		};
+
+		if constexpr (simd::has_pack_v<Type>)
+		{
+			if (!is_constant_evaluated())
+			{
+				using pack = simd::pack<Type>;
+				constexpr size_t width = pack::width;
+				if (count >= width)
+				{
+					pack sums = pack::zero(), compensations = pack::zero();
+					for (; i + width <= count; i += width)
+					{
+						const pack corrected = pack::load(data + i) - compensations;
+						const pack next = sums + corrected;
+						compensations = (next - sums) - corrected;
+						sums = next;
+					}
+
+					Type lane_sums[width];
+					Type lane_compensations[width];
+					sums.store(lane_sums);
+					compensations.store(lane_compensations);
+					for (size_t lane = 0; lane < width; ++lane)
+					{
+						add(lane_sums[lane]);
+						add(-lane_compensations[lane]);
+					}
+				}
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			add(data[i]);
+		}
+		return result;
+	}
+
+	template <typename Type, size_t Size> requires std::is_floating_point_v<Type>
+	WOJ_NODISCARD constexpr Type kahan_sum(const stack::vector<Type, Size>& values) noexcept
+	{
+		return kahan_sum(values.m_data, Size);
+	}
+
+	template <detail::numeric_range Range> requires std::is_floating_point_v<std::ranges::range_value_t<Range>>
+	WOJ_NODISCARD constexpr auto kahan_sum(const Range& values) noexcept
+	{
+		return kahan_sum(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)));
+	}
+
+	// ----- Minimum and maximum -----
+
+	/**
+	 * Finds the smallest of count values, NaNs after the first value are skipped
+	 * @param data Pointer to the values
+	 * @param count Count of values (must be greater than 0)
+	 * @return Smallest value
+	 */
+	template <detail::numeric_type Type>
+	WOJ_NODISCARD constexpr Type minimum(const Type* const data, const size_t count) noexcept
+	{
+		if constexpr (simd::has_pack_v<Type>)
+		{
+			using pack = simd::pack<Type>;
+			constexpr size_t width = pack::width;
+			if (!is_constant_evaluated() && count >= 2 * width)
+			{
+				// The accumulator is the second operand so a NaN element never replaces it
+				pack first = pack::broadcast(data[0]), second = first;
+				size_t i = 0;
+				for (; i + 2 * width <= count; i += 2 * width)
+				{
+					first = min(pack::load(data + i), first);
+					second = min(pack::load(data + i + width), second);
+				}
+				for (; i + width <= count; i += width)
+				{
+					first = min(pack::load(data + i), first);
+				}
+				// Overlapping last block covers the tail
+				first = min(pack::load(data + count - width), first);
+				const Type lanes = reduce_min(min(second, first));
+				return lanes < data[0] ? lanes : data[0];
+			}
+		}
+
+		return detail::scalar_minimum(data, count);
+	}
+
+	/**
+	 * Finds the largest of count values, NaNs after the first value are skipped
+	 * @param data Pointer to the values
+	 * @param count Count of values (must be greater than 0)
+	 * @return Largest value
+	 */
+	template <detail::numeric_type Type>
+	WOJ_NODISCARD constexpr Type maximum(const Type* const data, const size_t count) noexcept
+	{
+		if constexpr (simd::has_pack_v<Type>)
+		{
+			using pack = simd::pack<Type>;
+			constexpr size_t width = pack::width;
+			if (!is_constant_evaluated() && count >= 2 * width)
+			{
+				pack first = pack::broadcast(data[0]), second = first;
+				size_t i = 0;
+				for (; i + 2 * width <= count; i += 2 * width)
+				{
+					first = max(pack::load(data + i), first);
+					second = max(pack::load(data + i + width), second);
+				}
+				for (; i + width <= count; i += width)
+				{
+					first = max(pack::load(data + i), first);
+				}
+				// Overlapping last block covers the tail
+				first = max(pack::load(data + count - width), first);
+				const Type lanes = reduce_max(max(second, first));
+				return lanes > data[0] ? lanes : data[0];
+			}
+		}
+
+		return detail::scalar_maximum(data, count);
+	}
+
+	template <detail::numeric_type Type, size_t Size> requires (Size > 0)
+	WOJ_NODISCARD constexpr Type minimum(const stack::vector<Type, Size>& values) noexcept
+	{
+		if constexpr (Size <= detail::numeric_unroll_limit)
+		{
+			Type result = values.m_data[0];
+			[&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				((result = values.m_data[Indices + 1] < result ? values.m_data[Indices + 1] : result), ...);
+			}(std::make_index_sequence<Size - 1>{});
+			return result;
+		}
+		else
+		{
+			return minimum(values.m_data, Size);
+		}
+	}
+
+	template <detail::numeric_type Type, size_t Size> requires (Size > 0)
+	WOJ_NODISCARD constexpr Type maximum(const stack::vector<Type, Size>& values) noexcept
+	{
+		if constexpr (Size <= detail::numeric_unroll_limit)
+		{
+			Type result = values.m_data[0];
+			[&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				((result = values.m_data[Indices + 1] > result ? values.m_data[Indices + 1] : result), ...);
+			}(std::make_index_sequence<Size - 1>{});
+			return result;
+		}
+		else
+		{
+			return maximum(values.m_data, Size);
+		}
+	}
+
+	template <detail::numeric_range Range>
+	WOJ_NODISCARD constexpr auto minimum(const Range& values) noexcept
+	{
+		return minimum(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)));
+	}
+
+	template <detail::numeric_range Range>
+	WOJ_NODISCARD constexpr auto maximum(const Range& values) noexcept
+	{
+		return maximum(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)));
+	}
+
+	/**
+	 * Finds the index of the first smallest value (SIMD minimum followed by a search for it)
+	 * @param data Pointer to the values
+	 * @param count Count of values (must be greater than 0)
+	 * @return Index of the first smallest value
+	 */
+	template <detail::numeric_type Type>
+	WOJ_NODISCARD constexpr size_t argmin(const Type* const data, const size_t count) noexcept
+	{
+		const Type value = minimum(data, count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (data[i] == value)
+			{
+				return i;
+			}
+		}
+		return 0;
+	}
+
+	/**
+	 * Finds the index of the first largest value (SIMD maximum followed by a search for it)
+	 * @param data Pointer to the values
+	 * @param count Count of values (must be greater than 0)
+	 * @return Index of the first largest value
+	 */
+	template <detail::numeric_type Type>
+	WOJ_NODISCARD constexpr size_t argmax(const Type* const data, const size_t count) noexcept
+	{
+		const Type value = maximum(data, count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (data[i] == value)
+			{
+				return i;
+			}
+		}
+		return 0;
+	}
+
+	template <detail::numeric_type Type, size_t Size> requires (Size > 0)
+	WOJ_NODISCARD constexpr size_t argmin(const stack::vector<Type, Size>& values) noexcept
+	{
+		return argmin(values.m_data, Size);
+	}
+
+	template <detail::numeric_type Type, size_t Size> requires (Size > 0)
+	WOJ_NODISCARD constexpr size_t argmax(const stack::vector<Type, Size>& values) noexcept
+	{
+		return argmax(values.m_data, Size);
+	}
+
+	template <detail::numeric_range Range>
+	WOJ_NODISCARD constexpr size_t argmin(const Range& values) noexcept
+	{
+		return argmin(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)));
+	}
+
+	template <detail::numeric_range Range>
+	WOJ_NODISCARD constexpr size_t argmax(const Range& values) noexcept
+	{
+		return argmax(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)));
+	}
+
+	// ----- Dot product and norm -----
+
+	/**
+	 * Computes the dot product of two arrays of count values with 4 independent SIMD accumulators for floating point
+	 * @param left Pointer to the first values
+	 * @param right Pointer to the second values
+	 * @param count Count of values
+	 * @return Sum of the products
+	 */
+	template <detail::numeric_type Type>
+	WOJ_NODISCARD constexpr sum_type_t<Type> dot(const Type* const left, const Type* const right, const size_t count) noexcept
+	{
+		size_t i = 0;
+		sum_type_t<Type> result{};
+
+		if constexpr (simd::has_pack_v<Type>)
+		{
+			if (!is_constant_evaluated())
+			{
+				using pack = simd::pack<Type>;
+				constexpr size_t width = pack::width;
+				pack first = pack::zero(), second = pack::zero(), third = pack::zero(), fourth = pack::zero();
+				for (; i + 4 * width <= count; i += 4 * width)
+				{
+					first = first + pack::load(left + i) * pack::load(right + i);
+					second = second + pack::load(left + i + width) * pack::load(right + i + width);
+					third = third + pack::load(left + i + 2 * width) * pack::load(right + i + 2 * width);
+					fourth = fourth + pack::load(left + i + 3 * width) * pack::load(right + i + 3 * width);
+				}
+				for (; i + width <= count; i += width)
+				{
+					first = first + pack::load(left + i) * pack::load(right + i);
+				}
+				result = reduce_add((first + second) + (third + fourth));
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			result += static_cast<sum_type_t<Type>>(left[i]) * static_cast<sum_type_t<Type>>(right[i]);
+		}
+		return result;
+	}
+
+	template <detail::numeric_type Type, size_t Size>
+	WOJ_NODISCARD constexpr sum_type_t<Type> dot(const stack::vector<Type, Size>& left, const stack::vector<Type, Size>& right) noexcept
+	{
+		if constexpr (Size <= detail::numeric_unroll_limit)
+		{
+			return [&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				return (sum_type_t<Type>{} + ... + (static_cast<sum_type_t<Type>>(left.m_data[Indices]) * static_cast<sum_type_t<Type>>(right.m_data[Indices])));
+			}(std::make_index_sequence<Size>{});
+		}
+		else
+		{
+			return dot(left.m_data, right.m_data, Size);
+		}
+	}
+
+	template <detail::numeric_range Left, detail::numeric_range Right> requires std::is_same_v<std::ranges::range_value_t<Left>, std::ranges::range_value_t<Right>>
+	WOJ_NODISCARD constexpr auto dot(const Left& left, const Right& right) noexcept
+	{
+		const size_t left_size = static_cast<size_t>(std::ranges::size(left));
+		const size_t right_size = static_cast<size_t>(std::ranges::size(right));
+		return dot(std::ranges::data(left), std::ranges::data(right), left_size < right_size ? left_size : right_size);
+	}
+
+	/**
+	 * Computes the Euclidean norm of count values
+	 * @param data Pointer to the values
+	 * @param count Count of values
+	 * @return Square root of the sum of squares
+	 */
+	template <detail::numeric_type Type>
+	WOJ_NODISCARD constexpr norm_type_t<Type> norm(const Type* const data, const size_t count) noexcept
+	{
+		return detail::numeric_sqrt(static_cast<norm_type_t<Type>>(dot(data, data, count)));
+	}
+
+	template <detail::numeric_type Type, size_t Size>
+	WOJ_NODISCARD constexpr norm_type_t<Type> norm(const stack::vector<Type, Size>& values) noexcept
+	{
+		return detail::numeric_sqrt(static_cast<norm_type_t<Type>>(dot(values, values)));
+	}
+
+	template <detail::numeric_range Range>
+	WOJ_NODISCARD constexpr auto norm(const Range& values) noexcept
+	{
+		return norm(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)));
+	}
+
+	// ----- Prefix sums -----
+
+	/**
+	 * Writes destination[i] = init + source[0] + ... + source[i], SSE2 in-register scans for float, double and 32-bit integers
+	 * @param source Pointer to the values
+	 * @param count Count of values
+	 * @param destination Pointer to storage for count sums (may be equal to source)
+	 * @param init Value added to every sum
+	 */
+	template <detail::numeric_type Type>
+	constexpr void inclusive_scan(const Type* const source, const size_t count, Type* const destination, const Type init = Type{}) noexcept
+	{
+		detail::scan<true>(source, count, destination, init);
+	}
+
+	/**
+	 * Writes destination[i] = init + source[0] + ... + source[i - 1]
+	 * @param source Pointer to the values
+	 * @param count Count of values
+	 * @param destination Pointer to storage for count sums (may be equal to source)
+	 * @param init Value of the first sum
+	 */
+	template <detail::numeric_type Type>
+	constexpr void exclusive_scan(const Type* const source, const size_t count, Type* const destination, const Type init = Type{}) noexcept
+	{
+		detail::scan<false>(source, count, destination, init);
+	}
+
+	template <detail::numeric_type Type, size_t Size>
+	WOJ_NODISCARD constexpr stack::vector<Type, Size> inclusive_scan(const stack::vector<Type, Size>& values, const Type init = Type{}) noexcept
+	{
+		stack::vector<Type, Size> result{ noinit_t{} };
+		detail::scan<true>(values.m_data, Size, result.m_data, init);
+		return result;
+	}
+
+	template <detail::numeric_type Type, size_t Size>
+	WOJ_NODISCARD constexpr stack::vector<Type, Size> exclusive_scan(const stack::vector<Type, Size>& values, const Type init = Type{}) noexcept
+	{
+		stack::vector<Type, Size> result{ noinit_t{} };
+		detail::scan<false>(values.m_data, Size, result.m_data, init);
+		return result;
+	}
+
+	/**
+	 * Scans a contiguous range in place
+	 */
+	template <detail::numeric_range Range>
+	constexpr void inclusive_scan(Range& values, const std::ranges::range_value_t<Range> init = {}) noexcept
+	{
+		detail::scan<true>(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)), std::ranges::data(values), init);
+	}
+
+	template <detail::numeric_range Range>
+	constexpr void exclusive_scan(Range& values, const std::ranges::range_value_t<Range> init = {}) noexcept
+	{
+		detail::scan<false>(std::ranges::data(values), static_cast<size_t>(std::ranges::size(values)), std::ranges::data(values), init);
+	}
+}
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "base.hpp"
+#include "sort.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_PARALLEL_HPP
+#define WOJ_PARALLEL_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Tuning of the parallel algorithms
+	 */
+	class parallel_options
+	{
+	public:
+		/**
+		 * Count of elements handed out at once, 0 picks about 8 chunks per thread
+		 */
+		size_t m_grain = 0;
+
+		/**
+		 * Ranges smaller than this run sequentially on the calling thread
+		 */
+		size_t m_sequential_threshold = 4096;
+
+		/**
+		 * Pool running the algorithm, nullptr uses default_thread_pool()
+		 */
+		thread_pool* m_pool = nullptr;
+	};
+
+	namespace detail
+	{
+		inline constexpr size_t parallel_chunks_per_thread = 8;
+
+		template <typename ElementType, size_t Size>
+		WOJ_NODISCARD constexpr std::span<ElementType, Size> parallel_range(stack::vector<ElementType, Size>& values) noexcept
+		{
+			return std::span<ElementType, Size>{ values.data() };
+		}
+
+		template <typename ElementType, size_t Size>
+		WOJ_NODISCARD constexpr std::span<const ElementType, Size> parallel_range(const stack::vector<ElementType, Size>& values) noexcept
+		{
+			return std::span<const ElementType, Size>{ values.data() };
+		}
+
+		template <std::ranges::random_access_range Range> requires std::ranges::sized_range<Range>
+		WOJ_NODISCARD constexpr Range& parallel_range(Range& range) noexcept
+		{
+			return range;
+		}
+
+		WOJ_NODISCARD inline thread_pool& parallel_pool(const parallel_options& options)
+		{
+			return options.m_pool != nullptr ? *options.m_pool : default_thread_pool();
+		}
+
+		WOJ_NODISCARD inline size_t parallel_grain(const size_t size, const thread_pool& pool, const parallel_options& options) noexcept
+		{
+			if (options.m_grain != 0)
+			{
+				return options.m_grain;
+			}
+
+			const size_t chunk_count = pool.thread_count() * parallel_chunks_per_thread;
+			return (std::max)(size_t{ 1 }, (size + chunk_count - 1) / chunk_count);
+		}
+
+		/**
+		 * Count of elements of the left run among the first count elements of the merge of two sorted runs (equivalent
+		 * elements of the left run come first, like with std::merge)
+		 */
+		template <typename Iterator, typename Compare>
+		WOJ_NODISCARD size_t merge_co_rank(const Iterator left, const size_t left_size, const Iterator right, const size_t right_size, const size_t count, Compare& compare)
+		{
+			size_t low = count > right_size ? count - right_size : 0;
+			size_t high = (std::min)(count, left_size);
+			while (low < high)
+			{
+				const size_t middle = low + (high - low) / 2;
+				if (compare(right[count - middle - 1], left[middle]))
+				{
+					high = middle;
+				}
+				else
+				{
+					low = middle + 1;
+				}
+			}
+			return low;
+		}
+
+		/**
+		 * Moves the runs of width sorted elements of source, merged pairwise, to destination; the output is handed out in
+		 * pieces of grain elements (width is a multiple of grain, so a piece never spans two pairs) whose inputs are found
+		 * with a co-rank search, so the last rounds (few long runs) use every thread too. The searches all run before
+		 * the first element is moved
+		 * @param splits Storage for the co-rank of every piece
+		 */
+		template <typename Source, typename Destination, typename Compare>
+		void parallel_merge_round(thread_pool& pool, const Source source, const Destination destination, const size_t size, const size_t width, const size_t grain, size_t* const splits, Compare& compare)
+		{
+			const size_t piece_count = (size + grain - 1) / grain;
+			pool.parallel_for(0, piece_count, parallel_grain(piece_count, pool, {}), [&](const size_t begin, const size_t end)
+			{
+				for (size_t piece = begin; piece < end; ++piece)
+				{
+					const size_t low = piece * grain / (2 * width) * (2 * width);
+					const size_t middle = (std::min)(low + width, size);
+					const size_t high = (std::min)(middle + width, size);
+					splits[piece] = merge_co_rank(source + low, middle - low, source + middle, high - middle, piece * grain - low, compare);
+				}
+			});
+
+			pool.parallel_for(0, size, grain, [&](const size_t begin, const size_t end)
+			{
+				const size_t low = begin / (2 * width) * (2 * width);
+				const size_t middle = (std::min)(low + width, size);
+				const size_t high = (std::min)(middle + width, size);
+				const size_t left_begin = splits[begin / grain];
+				const size_t left_end = end == high ? middle - low : splits[end / grain];
+				std::merge(std::make_move_iterator(source + (low + left_begin)), std::make_move_iterator(source + (low + left_end)),
+					std::make_move_iterator(source + (middle + (begin - low) - left_begin)), std::make_move_iterator(source + (middle + (end - low) - left_end)),
+					destination + begin, compare);
+			});
+		}
+	}
+
+	/**
+	 * Stack vectors and sized random access ranges (woj::vector, std::vector, spans, random access views...)
+	 */
+	template <typename Range>
+	concept parallel_range = requires(std::remove_reference_t<Range>& range)
+	{
+		{ detail::parallel_range(range) };
+	};
+
+	/**
+	 * Calls function on every element, in no particular order and from several threads
+	 * @param range Elements to visit
+	 * @param function Function called with a reference to each element
+	 * @param options Grain size, sequential threshold and pool
+	 */
+	template <parallel_range Range, typename Function>
+	void parallel_for_each(Range&& range, Function function, const parallel_options& options = {})
+	{
+		auto&& values = detail::parallel_range(range);
+		const auto first = std::ranges::begin(values);
+		const size_t size = static_cast<size_t>(std::ranges::size(values));
+
+		if (size < options.m_sequential_threshold)
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				function(first[i]);
+			}
+			return;
+		}
+
+		thread_pool& pool = detail::parallel_pool(options);
+		pool.parallel_for(0, size, detail::parallel_grain(size, pool, options), [&](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				function(first[i]);
+			}
+		});
+	}
+
+	/**
+	 * Stores function(input[i]) to output[i] for every element of input, from several threads
+	 * @param input Elements to transform
+	 * @param output Destination, at least as big as input
+	 * @param function Function called with a reference to each input element
+	 * @param options Grain size, sequential threshold and pool
+	 */
+	template <parallel_range Input, parallel_range Output, typename Function>
+	void parallel_transform(Input&& input, Output&& output, Function function, const parallel_options& options = {})
+	{
+		auto&& input_values = detail::parallel_range(input);
+		auto&& output_values = detail::parallel_range(output);
+		const auto input_first = std::ranges::begin(input_values);
+		const auto output_first = std::ranges::begin(output_values);
+		const size_t size = static_cast<size_t>(std::ranges::size(input_values));
+
+		if (static_cast<size_t>(std::ranges::size(output_values)) < size)
+		{
+			throw out_of_vector_range{ 202ull, "parallel.hpp", "woj::parallel_transform" };
+		}
+
+		if (size < options.m_sequential_threshold)
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				output_first[i] = function(input_first[i]);
+			}
+			return;
+		}
+
+		thread_pool& pool = detail::parallel_pool(options);
+		pool.parallel_for(0, size, detail::parallel_grain(size, pool, options), [&](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				output_first[i] = function(input_first[i]);
+			}
+		});
+	}
+
+	/**
+	 * Combines init and every element with operation, the result is deterministic for a given grain size
+	 * (chunks are reduced separately, then their results in order) but operation has to be associative
+	 * @param range Elements to combine
+	 * @param init Value the elements are combined with
+	 * @param operation Associative binary operation
+	 * @param options Grain size, sequential threshold and pool
+	 * @return init combined with every element
+	 */
+	template <parallel_range Range, typename Type, typename Operation = std::plus<>>
+	WOJ_NODISCARD Type parallel_reduce(Range&& range, Type init, Operation operation = Operation{}, const parallel_options& options = {})
+	{
+		auto&& values = detail::parallel_range(range);
+		const auto first = std::ranges::begin(values);
+		const size_t size = static_cast<size_t>(std::ranges::size(values));
+
+		if (size < options.m_sequential_threshold)
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				init = operation(std::move(init), first[i]);
+			}
+			return init;
+		}
+
+		thread_pool& pool = detail::parallel_pool(options);
+		const size_t grain = detail::parallel_grain(size, pool, options);
+		woj::vector<std::optional<Type>> partials((size + grain - 1) / grain);
+
+		pool.parallel_for(0, size, grain, [&](const size_t begin, const size_t end)
+		{
+			Type partial = static_cast<Type>(first[begin]);
+			for (size_t i = begin + 1; i < end; ++i)
+			{
+				partial = operation(std::move(partial), first[i]);
+			}
+			partials[begin / grain].emplace(std::move(partial));
+		});
+
+		for (std::optional<Type>& partial : partials)
+		{
+			init = operation(std::move(init), std::move(*partial));
+		}
+		return init;
+	}
+
+	/**
+	 * Sorts a range (not stable) from several threads: chunks are sorted with woj::sort, then merged pairwise in rounds
+	 * between the range and one scratch buffer allocated up front (filled by moving the range once unless the elements
+	 * are trivial), every merge being split between the threads
+	 * @param range Elements to sort
+	 * @param compare Strict weak ordering
+	 * @param options Grain size (length of the initially sorted chunks and of the merged pieces), sequential threshold and pool
+	 */
+	template <parallel_range Range, typename Compare = std::less<>>
+	void parallel_sort(Range&& range, Compare compare = Compare{}, const parallel_options& options = {})
+	{
+		auto&& values = detail::parallel_range(range);
+		const auto first = std::ranges::begin(values);
+		const size_t size = static_cast<size_t>(std::ranges::size(values));
+
+		if (size < options.m_sequential_threshold)
+		{
+			woj::sort(first, first + size, compare);
+			return;
+		}
+
+		thread_pool& pool = detail::parallel_pool(options);
+		const size_t grain = detail::parallel_grain(size, pool, options);
+
+		pool.parallel_for(0, size, grain, [&](const size_t begin, const size_t end)
+		{
+			woj::sort(first + begin, first + end, compare);
+		});
+		if (grain >= size)
+		{
+			return;
+		}
+
+		using value_type = std::iter_value_t<decltype(first)>;
+		woj::vector<size_t> splits((size + grain - 1) / grain);
+		bool in_scratch;
+		woj::vector<value_type> scratch;
+		if constexpr (std::is_trivially_default_constructible_v<value_type> && std::is_trivially_copyable_v<value_type>)
+		{
+			scratch.resize_uninitialized(size, noinit);
+			in_scratch = false;
+		}
+		else
+		{
+			scratch.reserve(size);
+			for (size_t i = 0; i < size; ++i)
+			{
+				scratch.emplace_back(std::move(first[i]));
+			}
+			in_scratch = true;
+		}
+
+		for (size_t width = grain; width < size; width *= 2)
+		{
+			if (in_scratch)
+			{
+				detail::parallel_merge_round(pool, scratch.data(), first, size, width, grain, splits.data(), compare);
+			}
+			else
+			{
+				detail::parallel_merge_round(pool, first, scratch.data(), size, width, grain, splits.data(), compare);
+			}
+			in_scratch = !in_scratch;
+		}
+
+		if (in_scratch)
+		{
+			pool.parallel_for(0, size, grain, [&](const size_t begin, const size_t end)
+			{
+				std::move(scratch.data() + begin, scratch.data() + end, first + begin);
+			});
+		}
+	}
+}
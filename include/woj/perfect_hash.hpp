@@ -0,0 +1,335 @@
+#pragma once
+
+#include "base.hpp"
+#include "hash.hpp"
+#include "string.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#ifndef WOJ_PERFECT_HASH_HPP
+#define WOJ_PERFECT_HASH_HPP
+#endif
+
+namespace woj
+{
+	class perfect_hash_failed final : public exception
+	{
+	public:
+		constexpr perfect_hash_failed() noexcept : exception{ static_cast<uint64_t>(-1), "Perfect hash construction failed (duplicate keys?)", nullptr, nullptr } {}
+
+		constexpr perfect_hash_failed(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Perfect hash construction failed (duplicate keys?)", file, function } {}
+	};
+
+	/**
+	 * Class representing a key/value pair passed to make_perfect_map (the key is referenced, not copied)
+	 * @tparam Elem Type of the key's elements
+	 * @tparam KeySize MemSize of the key
+	 * @tparam Value Type of the value
+	 */
+	template <typename Elem, size_t KeySize, typename Value>
+	class perfect_entry
+	{
+	public:
+		const stack::string<Elem, KeySize>& key;
+		Value value;
+	};
+
+	template <typename Elem, size_t KeySize, typename Value>
+	perfect_entry(const stack::string<Elem, KeySize>&, Value) -> perfect_entry<Elem, KeySize, Value>;
+
+	namespace detail
+	{
+		/**
+		 * Minimal perfect hash table built at compile-time with the CHD (compress, hash and displace) scheme.
+		 * One seeded 64-bit hash selects a bucket and two offsets f1, f2, the slot is (f1 + d0 * f2 + d1) % Count
+		 * where (d0, d1) is the bucket's displacement found during construction.
+		 * @tparam Elem Type of the keys' elements
+		 * @tparam KeySize MemSize of the stored keys
+		 * @tparam Count Count of keys (and slots)
+		 */
+		template <typename Elem, size_t KeySize, size_t Count>
+		class perfect_hash_table
+		{
+		public:
+			using size_type = size_t;
+
+			static_assert(Count > 0, "Perfect hash table needs at least one key");
+			static_assert(Count <= (std::numeric_limits<uint32_t>::max)(), "Too many keys");
+
+			static constexpr size_type bucket_count = (Count + 1) / 2;
+			static constexpr uint64_t max_seed_attempts = 64;
+
+			stack::string<Elem, KeySize> m_keys[Count];
+			uint32_t m_d0[bucket_count];
+			uint32_t m_d1[bucket_count];
+			uint64_t m_seed;
+
+			template <size_t... KeySizes>
+			consteval explicit perfect_hash_table(const stack::string<Elem, KeySizes>&... keys) : m_keys{}, m_d0{}, m_d1{}, m_seed{ 0 }
+			{
+				static_assert(sizeof...(KeySizes) == Count, "Count of keys does not match the table size");
+
+				size_type input_sizes[Count]{};
+				stack::string<Elem, KeySize> input[Count]{};
+				size_type i = 0;
+				((input_sizes[i] = keys.str_size(), input[i++] = keys), ...);
+
+				uint64_t hashes[Count]{};
+				size_type slots[Count]{};
+
+				for (uint64_t seed = 0; seed < max_seed_attempts; ++seed)
+				{
+					for (size_type k = 0; k < Count; ++k)
+					{
+						hashes[k] = hash_chars(input[k].data(), input_sizes[k], seed);
+					}
+
+					if (try_displace(hashes, slots))
+					{
+						m_seed = seed;
+						for (size_type k = 0; k < Count; ++k)
+						{
+							m_keys[slots[k]] = input[k];
+						}
+						return;
+					}
+				}
+
+				throw perfect_hash_failed{ 99ull, "perfect_hash.hpp", "woj::detail::perfect_hash_table<Elem, KeySize, Count>::perfect_hash_table" };
+			}
+
+			/**
+			 * Finds the slot of a key
+			 * @param key Buffer holding the key
+			 * @param count Count of characters in the key
+			 * @return Slot of the key or Count if the key is not in the table
+			 */
+			WOJ_NODISCARD constexpr size_type index_of(const Elem* const key, const size_type count) const noexcept
+			{
+				const uint64_t hash = hash_chars(key, count, m_seed);
+				const size_type slot = slot_of(hash, m_d0[bucket_of(hash)], m_d1[bucket_of(hash)]);
+				return m_keys[slot].equals(key, count) ? slot : Count;
+			}
+
+			template <size_t OtherKeySize>
+			WOJ_NODISCARD constexpr size_type index_of(const stack::string<Elem, OtherKeySize>& key) const noexcept
+			{
+				return index_of(key.data(), key.str_size());
+			}
+
+			template <size_t OtherKeySize>
+			WOJ_NODISCARD constexpr bool contains(const stack::string<Elem, OtherKeySize>& key) const noexcept
+			{
+				return index_of(key) != Count;
+			}
+
+			WOJ_NODISCARD constexpr bool contains(const Elem* const key, const size_type count) const noexcept
+			{
+				return index_of(key, count) != Count;
+			}
+
+			/**
+			 * @param index Slot index (must be < Count)
+			 * @return Key stored in the slot
+			 */
+			WOJ_NODISCARD constexpr const stack::string<Elem, KeySize>& key_at(const size_type index) const noexcept
+			{
+				return m_keys[index];
+			}
+
+			static WOJ_CONSTEVAL size_type size() noexcept
+			{
+				return Count;
+			}
+
+		private:
+			WOJ_NODISCARD static constexpr size_type bucket_of(const uint64_t hash) noexcept
+			{
+				return static_cast<size_type>((hash >> 32) % bucket_count);
+			}
+
+			WOJ_NODISCARD static constexpr size_type slot_of(const uint64_t hash, const uint64_t d0, const uint64_t d1) noexcept
+			{
+				const uint64_t f1 = static_cast<uint32_t>(hash) % Count;
+				const uint64_t f2 = static_cast<uint32_t>(hash >> 16) % Count;
+				return static_cast<size_type>((f1 + d0 * f2 + d1) % Count);
+			}
+
+			consteval bool try_displace(const uint64_t (&hashes)[Count], size_type (&slots)[Count]) noexcept
+			{
+				size_type bucket_sizes[bucket_count]{};
+				size_type order[bucket_count]{};
+				bool taken[Count]{};
+
+				for (size_type k = 0; k < Count; ++k)
+				{
+					++bucket_sizes[bucket_of(hashes[k])];
+				}
+
+				for (size_type b = 0; b < bucket_count; ++b)
+				{
+					order[b] = b;
+				}
+
+				// Largest buckets are placed first while most slots are still free
+				std::sort(order, order + bucket_count, [&](const size_type lhs, const size_type rhs)
+				{
+					return bucket_sizes[lhs] != bucket_sizes[rhs] ? bucket_sizes[lhs] > bucket_sizes[rhs] : lhs < rhs;
+				});
+
+				size_type members[Count]{};
+				size_type claimed[Count]{};
+
+				for (size_type o = 0; o < bucket_count && bucket_sizes[order[o]]; ++o)
+				{
+					const size_type bucket = order[o];
+					size_type member_count = 0;
+					bool placed = false;
+
+					for (size_type k = 0; k < Count; ++k)
+					{
+						if (bucket_of(hashes[k]) == bucket)
+						{
+							members[member_count++] = k;
+						}
+					}
+
+					for (uint64_t d0 = 0; d0 < Count && !placed; ++d0)
+					{
+						for (uint64_t d1 = 0; d1 < Count && !placed; ++d1)
+						{
+							size_type claimed_count = 0;
+							placed = true;
+
+							for (size_type m = 0; m < member_count; ++m)
+							{
+								const size_type slot = slot_of(hashes[members[m]], d0, d1);
+								if (taken[slot])
+								{
+									placed = false;
+									break;
+								}
+								taken[slot] = true;
+								claimed[claimed_count++] = slot;
+								slots[members[m]] = slot;
+							}
+
+							if (placed)
+							{
+								m_d0[bucket] = static_cast<uint32_t>(d0);
+								m_d1[bucket] = static_cast<uint32_t>(d1);
+							}
+							else
+							{
+								for (size_type c = 0; c < claimed_count; ++c)
+								{
+									taken[claimed[c]] = false;
+								}
+							}
+						}
+					}
+
+					if (!placed)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		};
+	}
+
+	/**
+	 * Class representing an immutable set of strings with a minimal perfect hash built at compile-time
+	 * @tparam Elem Type of the keys' elements
+	 * @tparam KeySize MemSize of the stored keys (longest key)
+	 * @tparam Count Count of keys
+	 */
+	template <typename Elem, size_t KeySize, size_t Count>
+	class perfect_set : public detail::perfect_hash_table<Elem, KeySize, Count>
+	{
+		using base = detail::perfect_hash_table<Elem, KeySize, Count>;
+
+	public:
+		template <size_t... KeySizes>
+		consteval explicit perfect_set(const stack::string<Elem, KeySizes>&... keys) : base{ keys... } {}
+	};
+
+	/**
+	 * Class representing an immutable string-keyed map with a minimal perfect hash built at compile-time,
+	 * lookup costs one hash and one key comparison
+	 * @tparam Elem Type of the keys' elements
+	 * @tparam KeySize MemSize of the stored keys (longest key)
+	 * @tparam Value Type of the values (must be default-constructible and assignable during constant evaluation)
+	 * @tparam Count Count of entries
+	 */
+	template <typename Elem, size_t KeySize, typename Value, size_t Count>
+	class perfect_map : public detail::perfect_hash_table<Elem, KeySize, Count>
+	{
+		using base = detail::perfect_hash_table<Elem, KeySize, Count>;
+
+	public:
+		using mapped_type = Value;
+
+		Value m_values[Count];
+
+		template <size_t... KeySizes>
+		consteval explicit perfect_map(const perfect_entry<Elem, KeySizes, Value>&... entries) : base{ entries.key... }, m_values{}
+		{
+			((m_values[this->index_of(entries.key)] = entries.value), ...);
+		}
+
+		/**
+		 * Finds the value of a key
+		 * @param key Key to find
+		 * @return Pointer to the value or nullptr if the key is not in the map
+		 */
+		template <size_t OtherKeySize>
+		WOJ_NODISCARD constexpr const Value* find(const stack::string<Elem, OtherKeySize>& key) const noexcept
+		{
+			const size_t index = this->index_of(key);
+			return index == Count ? nullptr : m_values + index;
+		}
+
+		WOJ_NODISCARD constexpr const Value* find(const Elem* const key, const size_t count) const noexcept
+		{
+			const size_t index = this->index_of(key, count);
+			return index == Count ? nullptr : m_values + index;
+		}
+
+		/**
+		 * @param index Slot index (must be < Count)
+		 * @return Value stored in the slot
+		 */
+		WOJ_NODISCARD constexpr const Value& value_at(const size_t index) const noexcept
+		{
+			return m_values[index];
+		}
+	};
+
+	/**
+	 * Builds a perfect_set from string literals at compile-time
+	 * e.g. constexpr auto methods = make_perfect_set(stack::string{ "GET" }, stack::string{ "POST" });
+	 * @param keys Keys of the set (must be unique)
+	 * @return Perfect set holding the keys
+	 */
+	template <typename Elem, size_t... KeySizes>
+	WOJ_NODISCARD consteval auto make_perfect_set(const stack::string<Elem, KeySizes>&... keys)
+	{
+		return perfect_set<Elem, (std::max)({ KeySizes... }), sizeof...(KeySizes)>{ keys... };
+	}
+
+	/**
+	 * Builds a perfect_map from string literals at compile-time
+	 * e.g. constexpr auto methods = make_perfect_map(perfect_entry{ stack::string{ "GET" }, 1 }, perfect_entry{ stack::string{ "POST" }, 2 });
+	 * @param entries Entries of the map (keys must be unique)
+	 * @return Perfect map holding the entries
+	 */
+	template <typename Elem, typename Value, size_t... KeySizes>
+	WOJ_NODISCARD consteval auto make_perfect_map(const perfect_entry<Elem, KeySizes, Value>&... entries)
+	{
+		return perfect_map<Elem, (std::max)({ KeySizes... }), Value, sizeof...(KeySizes)>{ entries... };
+	}
+}
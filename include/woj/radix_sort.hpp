@@ -0,0 +1,521 @@
+#pragma once
+
+#include "base.hpp"
+#include "parallel.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_RADIX_SORT_HPP
+#define WOJ_RADIX_SORT_HPP
+#endif
+
+namespace woj
+{
+	class radix_buffer_too_small final : public exception
+	{
+	public:
+		constexpr radix_buffer_too_small() noexcept : exception{ static_cast<uint64_t>(-1), "Radix sort buffer too small", nullptr, nullptr } {}
+
+		constexpr radix_buffer_too_small(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Radix sort buffer too small", file, function } {}
+	};
+
+	/**
+	 * Keys radix sort can order: integers (except bool) and IEEE 754 float and double
+	 */
+	template <typename Type>
+	concept radix_sortable = (std::integral<Type> && !std::same_as<std::remove_cv_t<Type>, bool>)
+		|| (std::floating_point<Type> && std::numeric_limits<Type>::is_iec559 && (sizeof(Type) == 4 || sizeof(Type) == 8));
+
+	namespace detail
+	{
+		inline constexpr size_t radix_digit_bits = 8;
+		inline constexpr size_t radix_bucket_count = size_t{ 1 } << radix_digit_bits;
+
+		/**
+		 * Ranges up to this size are sorted with a (stable) insertion sort, building the histograms would cost more
+		 */
+		inline constexpr size_t radix_insertion_sort_threshold = 64;
+
+		/**
+		 * Minimal count of elements in each chunk of a parallel radix sort
+		 */
+		inline constexpr size_t radix_parallel_grain = size_t{ 1 } << 16;
+
+		/**
+		 * Biggest scratch buffer (in bytes) a stack vector is sorted with without a heap allocation
+		 */
+		inline constexpr size_t radix_stack_buffer_limit = 16384;
+
+		template <typename Key>
+		using radix_bits_t = std::conditional_t<sizeof(Key) == 1, uint8_t,
+			std::conditional_t<sizeof(Key) == 2, uint16_t,
+			std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>>>;
+
+		template <typename Key>
+		using radix_histograms = std::array<std::array<size_t, radix_bucket_count>, sizeof(Key)>;
+
+		/**
+		 * Maps a key to an unsigned integer with the same ordering: signed integers get their sign bit flipped,
+		 * negative floating point numbers all their bits (reversing their order) and positive ones only the sign bit
+		 * (giving the IEEE 754 total order: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN)
+		 */
+		template <typename Key>
+		WOJ_NODISCARD constexpr radix_bits_t<Key> radix_encode(const Key key) noexcept
+		{
+			using bits_type = radix_bits_t<Key>;
+
+			constexpr size_t sign_shift = sizeof(Key) * CHAR_BIT - 1;
+			constexpr bits_type sign_bit = static_cast<bits_type>(bits_type{ 1 } << sign_shift);
+
+			const bits_type bits = std::bit_cast<bits_type>(key);
+			if constexpr (std::floating_point<Key>)
+			{
+				const bits_type mask = static_cast<bits_type>(static_cast<bits_type>(0 - static_cast<bits_type>(bits >> sign_shift)) | sign_bit);
+				return static_cast<bits_type>(bits ^ mask);
+			}
+			else if constexpr (std::signed_integral<Key>)
+			{
+				return static_cast<bits_type>(bits ^ sign_bit);
+			}
+			else
+			{
+				return bits;
+			}
+		}
+
+		template <typename Key>
+		WOJ_NODISCARD constexpr size_t radix_digit(const Key key, const size_t pass) noexcept
+		{
+			return static_cast<size_t>(radix_encode(key) >> (pass * radix_digit_bits)) & (radix_bucket_count - 1);
+		}
+
+		/**
+		 * Builds the histograms of every pass in a single read of the keys
+		 */
+		template <typename Key>
+		constexpr void radix_count(const Key* const keys, const size_t size, radix_histograms<Key>& histograms) noexcept
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				const radix_bits_t<Key> bits = radix_encode(keys[i]);
+				for (size_t pass = 0; pass < sizeof(Key); ++pass)
+				{
+					++histograms[pass][static_cast<size_t>(bits >> (pass * radix_digit_bits)) & (radix_bucket_count - 1)];
+				}
+			}
+		}
+
+		/**
+		 * Stable insertion sort by encoded keys, carrying the values along (Value is void for key-only sorts)
+		 */
+		template <typename Key, typename Value>
+		constexpr void radix_insertion_sort(Key* const keys, Value* const values, const size_t size)
+		{
+			for (size_t i = 1; i < size; ++i)
+			{
+				const Key key = keys[i];
+				const radix_bits_t<Key> bits = radix_encode(key);
+
+				size_t j = i;
+				if constexpr (std::is_void_v<Value>)
+				{
+					for (; j > 0 && bits < radix_encode(keys[j - 1]); --j)
+					{
+						keys[j] = keys[j - 1];
+					}
+				}
+				else
+				{
+					if (!(bits < radix_encode(keys[j - 1])))
+					{
+						continue;
+					}
+
+					Value value = std::move(values[i]);
+					for (; j > 0 && bits < radix_encode(keys[j - 1]); --j)
+					{
+						keys[j] = keys[j - 1];
+						values[j] = std::move(values[j - 1]);
+					}
+					values[j] = std::move(value);
+				}
+				keys[j] = key;
+			}
+		}
+
+		template <typename Key, typename Value>
+		constexpr void radix_scatter(const Key* const keys, Key* const key_destination, Value* const values, Value* const value_destination, const size_t size, const size_t pass, std::array<size_t, radix_bucket_count>& offsets)
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				const size_t position = offsets[radix_digit(keys[i], pass)]++;
+				key_destination[position] = keys[i];
+				if constexpr (!std::is_void_v<Value>)
+				{
+					value_destination[position] = std::move(values[i]);
+				}
+			}
+		}
+
+		/**
+		 * LSD radix sort over 8-bit digits, passes in which every key has the same digit are skipped;
+		 * the result ends up in keys (and values) whatever the number of passes performed
+		 */
+		template <typename Key, typename Value>
+		constexpr void radix_sort_passes(Key* const keys, Key* const key_buffer, Value* const values, Value* const value_buffer, const size_t size)
+		{
+			if (size <= radix_insertion_sort_threshold)
+			{
+				radix_insertion_sort(keys, values, size);
+				return;
+			}
+
+			// Counts do not depend on the order of the keys, so histograms of the input stay valid for every pass
+			radix_histograms<Key> histograms{};
+			radix_count(keys, size, histograms);
+
+			Key* key_source = keys;
+			Key* key_destination = key_buffer;
+			Value* value_source = values;
+			Value* value_destination = value_buffer;
+
+			for (size_t pass = 0; pass < sizeof(Key); ++pass)
+			{
+				const std::array<size_t, radix_bucket_count>& histogram = histograms[pass];
+				if (histogram[radix_digit(*key_source, pass)] == size)
+				{
+					continue;
+				}
+
+				std::array<size_t, radix_bucket_count> offsets;
+				size_t offset = 0;
+				for (size_t digit = 0; digit < radix_bucket_count; ++digit)
+				{
+					offsets[digit] = offset;
+					offset += histogram[digit];
+				}
+
+				radix_scatter(key_source, key_destination, value_source, value_destination, size, pass, offsets);
+				std::swap(key_source, key_destination);
+				std::swap(value_source, value_destination);
+			}
+
+			if (key_source != keys)
+			{
+				std::copy(key_source, key_source + size, keys);
+				if constexpr (!std::is_void_v<Value>)
+				{
+					std::move(value_source, value_source + size, values);
+				}
+			}
+		}
+
+		/**
+		 * Parallel LSD radix sort on a thread pool: the keys are split in chunks, every chunk is counted and scattered to
+		 * offsets following the previous chunks (which keeps the sort stable), each counting and scattering step being
+		 * a parallel loop over the chunks
+		 */
+		template <typename Key, typename Value>
+		void parallel_radix_sort_passes(Key* const keys, Key* const key_buffer, Value* const values, Value* const value_buffer, const size_t size, const parallel_options& options)
+		{
+			thread_pool& pool = parallel_pool(options);
+			const size_t grain = options.m_grain != 0 ? options.m_grain : (std::max)(radix_parallel_grain, (size + pool.thread_count() - 1) / pool.thread_count());
+			const size_t chunk_count = (size + grain - 1) / grain;
+
+			if (size < options.m_sequential_threshold || chunk_count <= 1)
+			{
+				radix_sort_passes(keys, key_buffer, values, value_buffer, size);
+				return;
+			}
+
+			woj::vector<radix_histograms<Key>> histograms(chunk_count);
+			pool.parallel_for(0, chunk_count, 1, [&](const size_t chunk, size_t)
+			{
+				const size_t begin = chunk * grain;
+				radix_count(keys + begin, (std::min)(grain, size - begin), histograms[chunk]);
+			});
+
+			radix_histograms<Key> totals{};
+			for (const radix_histograms<Key>& histogram : histograms)
+			{
+				for (size_t pass = 0; pass < sizeof(Key); ++pass)
+				{
+					for (size_t digit = 0; digit < radix_bucket_count; ++digit)
+					{
+						totals[pass][digit] += histogram[pass][digit];
+					}
+				}
+			}
+
+			Key* key_source = keys;
+			Key* key_destination = key_buffer;
+			Value* value_source = values;
+			Value* value_destination = value_buffer;
+			woj::vector<std::array<size_t, radix_bucket_count>> offsets(chunk_count);
+			bool first_pass = true;
+
+			for (size_t pass = 0; pass < sizeof(Key); ++pass)
+			{
+				if (totals[pass][radix_digit(*key_source, pass)] == size)
+				{
+					continue;
+				}
+
+				// After the first scatter the chunks hold different keys, their digits have to be counted again
+				if (!first_pass)
+				{
+					pool.parallel_for(0, chunk_count, 1, [&](const size_t chunk, size_t)
+					{
+						const size_t begin = chunk * grain;
+						const size_t end = (std::min)(begin + grain, size);
+						std::array<size_t, radix_bucket_count>& histogram = histograms[chunk][pass];
+						histogram.fill(0);
+						for (size_t i = begin; i < end; ++i)
+						{
+							++histogram[radix_digit(key_source[i], pass)];
+						}
+					});
+				}
+				first_pass = false;
+
+				size_t offset = 0;
+				for (size_t digit = 0; digit < radix_bucket_count; ++digit)
+				{
+					for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+					{
+						offsets[chunk][digit] = offset;
+						offset += histograms[chunk][pass][digit];
+					}
+				}
+
+				pool.parallel_for(0, chunk_count, 1, [&](const size_t chunk, size_t)
+				{
+					const size_t begin = chunk * grain;
+					Value* chunk_values = value_source;
+					if constexpr (!std::is_void_v<Value>)
+					{
+						chunk_values += begin;
+					}
+
+					radix_scatter(key_source + begin, key_destination, chunk_values, value_destination, (std::min)(grain, size - begin), pass, offsets[chunk]);
+				});
+
+				std::swap(key_source, key_destination);
+				std::swap(value_source, value_destination);
+			}
+
+			if (key_source != keys)
+			{
+				pool.parallel_for(0, chunk_count, 1, [&](const size_t chunk, size_t)
+				{
+					const size_t begin = chunk * grain;
+					const size_t end = (std::min)(begin + grain, size);
+					std::copy(key_source + begin, key_source + end, keys + begin);
+					if constexpr (!std::is_void_v<Value>)
+					{
+						std::move(value_source + begin, value_source + end, values + begin);
+					}
+				});
+			}
+		}
+
+		template <typename Type>
+		class is_stack_vector : public std::false_type {};
+
+		template <typename ElementType, size_t Size>
+		class is_stack_vector<stack::vector<ElementType, Size>> : public std::true_type {};
+
+		template <typename ElementType, size_t Size>
+		WOJ_NODISCARD constexpr std::span<ElementType> radix_span(stack::vector<ElementType, Size>& values) noexcept
+		{
+			return std::span<ElementType>{ values.data(), Size };
+		}
+
+		template <std::ranges::contiguous_range Range> requires std::ranges::sized_range<Range> && std::same_as<std::ranges::range_reference_t<Range>, std::ranges::range_value_t<Range>&>
+		WOJ_NODISCARD constexpr std::span<std::ranges::range_value_t<Range>> radix_span(Range& values) noexcept
+		{
+			return std::span<std::ranges::range_value_t<Range>>{ std::ranges::data(values), std::ranges::size(values) };
+		}
+
+		/**
+		 * Uninitialized (where possible) heap scratch storage for size elements
+		 */
+		template <typename Type>
+		WOJ_NODISCARD woj::vector<Type> radix_buffer(const size_t size)
+		{
+			if constexpr (std::is_trivially_default_constructible_v<Type>)
+			{
+				return woj::vector<Type>(size, noinit);
+			}
+			else
+			{
+				return woj::vector<Type>(size);
+			}
+		}
+	}
+
+	/**
+	 * Stack vectors and mutable contiguous ranges (woj::vector, std::vector, std::span, arrays...) of Type
+	 */
+	template <typename Storage>
+	concept radix_storage = requires(std::remove_reference_t<Storage>& storage)
+	{
+		{ detail::radix_span(storage) };
+	};
+
+	template <typename Storage>
+	using radix_storage_value_t = typename decltype(detail::radix_span(std::declval<std::remove_reference_t<Storage>&>()))::element_type;
+
+	/**
+	 * Sorts keys with an LSD radix sort (stable, linear time) using buffer as scratch space
+	 * @param keys Keys to sort (integers or IEEE 754 float/double, ordered like in radix_encode)
+	 * @param buffer Scratch space with room for at least as many keys
+	 */
+	template <radix_storage Keys, radix_storage Buffer> requires radix_sortable<radix_storage_value_t<Keys>> && std::same_as<radix_storage_value_t<Keys>, radix_storage_value_t<Buffer>>
+	constexpr void radix_sort(Keys&& keys, Buffer&& buffer)
+	{
+		using key_type = radix_storage_value_t<Keys>;
+
+		const std::span<key_type> key_span = detail::radix_span(keys);
+		const std::span<key_type> buffer_span = detail::radix_span(buffer);
+		if (buffer_span.size() < key_span.size())
+		{
+			throw radix_buffer_too_small{ 394ull, "radix_sort.hpp", "woj::radix_sort" };
+		}
+
+		detail::radix_sort_passes<key_type, void>(key_span.data(), buffer_span.data(), nullptr, nullptr, key_span.size());
+	}
+
+	/**
+	 * Sorts keys with an LSD radix sort (stable, linear time), small stack vectors use a scratch buffer on the stack,
+	 * everything else allocates one
+	 * @param keys Keys to sort (integers or IEEE 754 float/double, ordered like in radix_encode)
+	 */
+	template <radix_storage Keys> requires radix_sortable<radix_storage_value_t<Keys>>
+	void radix_sort(Keys&& keys)
+	{
+		using key_type = radix_storage_value_t<Keys>;
+		using storage_type = std::remove_cvref_t<Keys>;
+
+		if constexpr (detail::is_stack_vector<storage_type>::value && sizeof(storage_type) <= detail::radix_stack_buffer_limit)
+		{
+			storage_type buffer{ noinit };
+			woj::radix_sort(keys, buffer);
+		}
+		else
+		{
+			woj::vector<key_type> buffer = detail::radix_buffer<key_type>(detail::radix_span(keys).size());
+			woj::radix_sort(keys, buffer);
+		}
+	}
+
+	/**
+	 * Sorts keys with an LSD radix sort (stable, linear time), moving values along with their keys
+	 * @param keys Keys to sort (integers or IEEE 754 float/double, ordered like in radix_encode)
+	 * @param values Values to reorder, at least as many as keys
+	 * @param key_buffer Scratch space with room for at least as many keys
+	 * @param value_buffer Scratch space with room for at least as many values (default constructed)
+	 */
+	template <radix_storage Keys, radix_storage Values, radix_storage KeyBuffer, radix_storage ValueBuffer>
+		requires radix_sortable<radix_storage_value_t<Keys>> && std::same_as<radix_storage_value_t<Keys>, radix_storage_value_t<KeyBuffer>>
+			&& std::same_as<radix_storage_value_t<Values>, radix_storage_value_t<ValueBuffer>> && std::movable<radix_storage_value_t<Values>>
+	constexpr void radix_sort_by_key(Keys&& keys, Values&& values, KeyBuffer&& key_buffer, ValueBuffer&& value_buffer)
+	{
+		using key_type = radix_storage_value_t<Keys>;
+		using value_type = radix_storage_value_t<Values>;
+
+		const std::span<key_type> key_span = detail::radix_span(keys);
+		const std::span<value_type> value_span = detail::radix_span(values);
+		const std::span<key_type> key_buffer_span = detail::radix_span(key_buffer);
+		const std::span<value_type> value_buffer_span = detail::radix_span(value_buffer);
+		if (value_span.size() < key_span.size() || key_buffer_span.size() < key_span.size() || value_buffer_span.size() < key_span.size())
+		{
+			throw radix_buffer_too_small{ 444ull, "radix_sort.hpp", "woj::radix_sort_by_key" };
+		}
+
+		detail::radix_sort_passes(key_span.data(), key_buffer_span.data(), value_span.data(), value_buffer_span.data(), key_span.size());
+	}
+
+	/**
+	 * Sorts keys with an LSD radix sort (stable, linear time), moving values along with their keys, small stack vectors
+	 * use scratch buffers on the stack, everything else allocates them
+	 * @param keys Keys to sort (integers or IEEE 754 float/double, ordered like in radix_encode)
+	 * @param values Values to reorder, at least as many as keys
+	 */
+	template <radix_storage Keys, radix_storage Values>
+		requires radix_sortable<radix_storage_value_t<Keys>> && std::movable<radix_storage_value_t<Values>> && std::default_initializable<radix_storage_value_t<Values>>
+	void radix_sort_by_key(Keys&& keys, Values&& values)
+	{
+		using key_type = radix_storage_value_t<Keys>;
+		using value_type = radix_storage_value_t<Values>;
+		using key_storage_type = std::remove_cvref_t<Keys>;
+		using value_storage_type = std::remove_cvref_t<Values>;
+
+		if constexpr (detail::is_stack_vector<key_storage_type>::value && detail::is_stack_vector<value_storage_type>::value
+			&& sizeof(key_storage_type) + sizeof(value_storage_type) <= detail::radix_stack_buffer_limit)
+		{
+			key_storage_type key_buffer{ noinit };
+			value_storage_type value_buffer{ noinit };
+			woj::radix_sort_by_key(keys, values, key_buffer, value_buffer);
+		}
+		else
+		{
+			const size_t size = detail::radix_span(keys).size();
+			woj::vector<key_type> key_buffer = detail::radix_buffer<key_type>(size);
+			woj::vector<value_type> value_buffer = detail::radix_buffer<value_type>(size);
+			woj::radix_sort_by_key(keys, values, key_buffer, value_buffer);
+		}
+	}
+
+	/**
+	 * Sorts keys with an LSD radix sort spread over a thread pool (stable), falls back to the sequential sort when
+	 * there would be a single chunk (by default chunks hold at least 65536 keys)
+	 * @param keys Keys to sort (integers or IEEE 754 float/double, ordered like in radix_encode)
+	 * @param options Chunk size (0 gives one chunk per thread), sequential threshold and pool
+	 */
+	template <radix_storage Keys> requires radix_sortable<radix_storage_value_t<Keys>>
+	void parallel_radix_sort(Keys&& keys, const parallel_options& options = {})
+	{
+		using key_type = radix_storage_value_t<Keys>;
+
+		const std::span<key_type> key_span = detail::radix_span(keys);
+		woj::vector<key_type> buffer = detail::radix_buffer<key_type>(key_span.size());
+		detail::parallel_radix_sort_passes<key_type, void>(key_span.data(), buffer.data(), nullptr, nullptr, key_span.size(), options);
+	}
+
+	/**
+	 * Sorts keys with an LSD radix sort spread over a thread pool (stable), moving values along with their keys
+	 * @param keys Keys to sort (integers or IEEE 754 float/double, ordered like in radix_encode)
+	 * @param values Values to reorder, at least as many as keys
+	 * @param options Chunk size (0 gives one chunk per thread), sequential threshold and pool
+	 */
+	template <radix_storage Keys, radix_storage Values>
+		requires radix_sortable<radix_storage_value_t<Keys>> && std::movable<radix_storage_value_t<Values>> && std::default_initializable<radix_storage_value_t<Values>>
+	void parallel_radix_sort_by_key(Keys&& keys, Values&& values, const parallel_options& options = {})
+	{
+		using key_type = radix_storage_value_t<Keys>;
+		using value_type = radix_storage_value_t<Values>;
+
+		const std::span<key_type> key_span = detail::radix_span(keys);
+		const std::span<value_type> value_span = detail::radix_span(values);
+		if (value_span.size() < key_span.size())
+		{
+			throw radix_buffer_too_small{ 514ull, "radix_sort.hpp", "woj::parallel_radix_sort_by_key" };
+		}
+
+		woj::vector<key_type> key_buffer = detail::radix_buffer<key_type>(key_span.size());
+		woj::vector<value_type> value_buffer = detail::radix_buffer<value_type>(key_span.size());
+		detail::parallel_radix_sort_passes(key_span.data(), key_buffer.data(), value_span.data(), value_buffer.data(), key_span.size(), options);
+	}
+}
@@ -0,0 +1,1247 @@
+#pragma once
+
+#include "base.hpp"
+#include "string.hpp"
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef WOJ_REGEX_HPP
+#define WOJ_REGEX_HPP
+#endif
+
+namespace woj
+{
+	class regex_syntax_error final : public exception
+	{
+	public:
+		constexpr regex_syntax_error() noexcept : exception{ static_cast<uint64_t>(-1), "Invalid regular expression", nullptr, nullptr } {}
+
+		constexpr regex_syntax_error(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Invalid regular expression", file, function } {}
+	};
+
+	class regex_too_complex final : public exception
+	{
+	public:
+		constexpr regex_too_complex() noexcept : exception{ static_cast<uint64_t>(-1), "Regular expression needs too many DFA states", nullptr, nullptr } {}
+
+		constexpr regex_too_complex(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Regular expression needs too many DFA states", file, function } {}
+	};
+
+	/**
+	 * Class holding a regex pattern as a structural type so it can be passed as a template argument
+	 * @tparam Size Size of the literal (including the null terminator)
+	 */
+	template <size_t Size>
+	class regex_pattern
+	{
+	public:
+		char m_data[Size];
+
+		consteval regex_pattern(const char (&pattern)[Size]) noexcept : m_data{}
+		{
+			for (size_t i = 0; i < Size; ++i)
+			{
+				m_data[i] = pattern[i];
+			}
+		}
+
+		static consteval size_t size() noexcept
+		{
+			return Size - 1;
+		}
+	};
+
+	/**
+	 * Class representing the result of regex<...>::find
+	 */
+	class regex_match
+	{
+	public:
+		size_t m_position;
+		size_t m_length;
+
+		WOJ_NODISCARD constexpr explicit operator bool() const noexcept
+		{
+			return m_position != static_cast<size_t>(-1);
+		}
+
+		WOJ_NODISCARD constexpr size_t position() const noexcept
+		{
+			return m_position;
+		}
+
+		WOJ_NODISCARD constexpr size_t length() const noexcept
+		{
+			return m_length;
+		}
+	};
+
+	namespace detail
+	{
+		constexpr size_t regex_none = static_cast<size_t>(-1);
+		constexpr size_t regex_max_repeat = 1000;
+		constexpr size_t regex_max_states = 4096;
+		constexpr size_t regex_max_search_states = 512;
+
+		class regex_char_set
+		{
+		public:
+			uint64_t m_bits[4]{};
+
+			constexpr void insert(const uint8_t c) noexcept
+			{
+				m_bits[c >> 6] |= 1ull << (c & 63);
+			}
+
+			constexpr void insert(const uint8_t first, const uint8_t last) noexcept
+			{
+				for (unsigned c = first; c <= last; ++c)
+				{
+					insert(static_cast<uint8_t>(c));
+				}
+			}
+
+			constexpr void insert(const regex_char_set& other) noexcept
+			{
+				for (size_t i = 0; i < 4; ++i)
+				{
+					m_bits[i] |= other.m_bits[i];
+				}
+			}
+
+			constexpr void invert() noexcept
+			{
+				for (uint64_t& bits : m_bits)
+				{
+					bits = ~bits;
+				}
+			}
+
+			WOJ_NODISCARD constexpr bool contains(const uint8_t c) const noexcept
+			{
+				return m_bits[c >> 6] >> (c & 63) & 1;
+			}
+
+			WOJ_NODISCARD constexpr bool operator==(const regex_char_set& other) const noexcept = default;
+		};
+
+		enum class regex_node_kind : uint8_t
+		{
+			empty,
+			chars,
+			concat,
+			alternate,
+			repeat
+		};
+
+		class regex_node
+		{
+		public:
+			regex_node_kind m_kind;
+			regex_char_set m_chars;
+			size_t m_left;
+			size_t m_right;
+			size_t m_min;
+			size_t m_max; // regex_none if unbounded
+		};
+
+		/**
+		 * Recursive descent parser producing a syntax tree. Supported syntax: literals, '.', escapes (\d \w \s \D \W \S
+		 * \n \t \r \f \v \0 \xHH and escaped punctuation), classes ([a-z], [^...]), groups ((...) and (?:...)),
+		 * alternation, quantifiers (* + ? {n} {n,} {n,m}) and anchors '^' / '$' at the ends of the pattern.
+		 */
+		class regex_parser
+		{
+		public:
+			const char* m_pattern;
+			size_t m_size;
+			size_t m_position;
+			std::vector<regex_node> m_nodes;
+			bool m_anchored_begin;
+			bool m_anchored_end;
+
+			consteval regex_parser(const char* const pattern, const size_t size) : m_pattern{ pattern }, m_size{ size }, m_position{ 0 }, m_nodes{}, m_anchored_begin{ false }, m_anchored_end{ false }
+			{
+				if (m_size && m_pattern[0] == '^')
+				{
+					m_anchored_begin = true;
+					++m_position;
+				}
+
+				if (m_size > m_position && m_pattern[m_size - 1] == '$' && !escaped(m_size - 1))
+				{
+					m_anchored_end = true;
+					--m_size;
+				}
+			}
+
+			/**
+			 * Parses the whole pattern
+			 * @return Index of the root node
+			 */
+			consteval size_t parse()
+			{
+				const size_t root = parse_alternation();
+				if (m_position != m_size)
+				{
+					throw regex_syntax_error{ 190ull, "regex.hpp", "woj::detail::regex_parser::parse" };
+				}
+				return root;
+			}
+
+		private:
+			consteval bool escaped(size_t position) const noexcept
+			{
+				size_t backslashes = 0;
+				while (position > m_position && m_pattern[--position] == '\\')
+				{
+					++backslashes;
+				}
+				return backslashes % 2;
+			}
+
+			consteval size_t add(const regex_node_kind kind, const size_t left = regex_none, const size_t right = regex_none)
+			{
+				m_nodes.push_back(regex_node{ kind, {}, left, right, 0, 0 });
+				return m_nodes.size() - 1;
+			}
+
+			consteval size_t add_chars(const regex_char_set& chars)
+			{
+				const size_t node = add(regex_node_kind::chars);
+				m_nodes[node].m_chars = chars;
+				return node;
+			}
+
+			consteval size_t parse_alternation()
+			{
+				size_t left = parse_concatenation();
+				while (m_position < m_size && m_pattern[m_position] == '|')
+				{
+					++m_position;
+					const size_t right = parse_concatenation();
+					left = add(regex_node_kind::alternate, left, right);
+				}
+				return left;
+			}
+
+			consteval size_t parse_concatenation()
+			{
+				size_t result = regex_none;
+				while (m_position < m_size && m_pattern[m_position] != '|' && m_pattern[m_position] != ')')
+				{
+					const size_t next = parse_repetition();
+					result = result == regex_none ? next : add(regex_node_kind::concat, result, next);
+				}
+				return result == regex_none ? add(regex_node_kind::empty) : result;
+			}
+
+			consteval size_t parse_repetition()
+			{
+				size_t atom = parse_atom();
+				while (m_position < m_size)
+				{
+					size_t min = 0;
+					size_t max = regex_none;
+					const char c = m_pattern[m_position];
+
+					if (c == '*')
+					{
+						++m_position;
+					}
+					else if (c == '+')
+					{
+						min = 1;
+						++m_position;
+					}
+					else if (c == '?')
+					{
+						max = 1;
+						++m_position;
+					}
+					else if (c == '{')
+					{
+						++m_position;
+						min = parse_number();
+						max = min;
+						if (m_position < m_size && m_pattern[m_position] == ',')
+						{
+							++m_position;
+							max = m_position < m_size && m_pattern[m_position] == '}' ? regex_none : parse_number();
+						}
+						if (m_position >= m_size || m_pattern[m_position] != '}' || (max != regex_none && max < min))
+						{
+							throw regex_syntax_error{ 277ull, "regex.hpp", "woj::detail::regex_parser::parse_repetition" };
+						}
+						++m_position;
+					}
+					else
+					{
+						break;
+					}
+
+					atom = add(regex_node_kind::repeat, atom);
+					m_nodes[atom].m_min = min;
+					m_nodes[atom].m_max = max;
+				}
+				return atom;
+			}
+
+			consteval size_t parse_number()
+			{
+				size_t value = 0;
+				const size_t start = m_position;
+				while (m_position < m_size && m_pattern[m_position] >= '0' && m_pattern[m_position] <= '9')
+				{
+					value = value * 10 + static_cast<size_t>(m_pattern[m_position++] - '0');
+					if (value > regex_max_repeat)
+					{
+						throw regex_syntax_error{ 302ull, "regex.hpp", "woj::detail::regex_parser::parse_number" };
+					}
+				}
+				if (start == m_position)
+				{
+					throw regex_syntax_error{ 307ull, "regex.hpp", "woj::detail::regex_parser::parse_number" };
+				}
+				return value;
+			}
+
+			consteval size_t parse_atom()
+			{
+				const char c = m_pattern[m_position++];
+				regex_char_set chars{};
+
+				switch (c)
+				{
+				case '(':
+				{
+					if (m_position + 1 < m_size && m_pattern[m_position] == '?' && m_pattern[m_position + 1] == ':')
+					{
+						m_position += 2;
+					}
+					const size_t inner = parse_alternation();
+					if (m_position >= m_size || m_pattern[m_position] != ')')
+					{
+						throw regex_syntax_error{ 328ull, "regex.hpp", "woj::detail::regex_parser::parse_atom" };
+					}
+					++m_position;
+					return inner;
+				}
+				case '[':
+					return add_chars(parse_class());
+				case '.':
+					chars.invert();
+					chars.m_bits[0] &= ~(1ull << '\n');
+					return add_chars(chars);
+				case '\\':
+					return add_chars(parse_escape());
+				case '*':
+				case '+':
+				case '?':
+				case '{':
+				case ')':
+				case '^':
+				case '$':
+					throw regex_syntax_error{ 348ull, "regex.hpp", "woj::detail::regex_parser::parse_atom" };
+				default:
+					chars.insert(static_cast<uint8_t>(c));
+					return add_chars(chars);
+				}
+			}
+
+			consteval regex_char_set parse_class()
+			{
+				regex_char_set chars{};
+				const bool negated = m_position < m_size && m_pattern[m_position] == '^';
+				m_position += negated;
+
+				while (m_position < m_size && m_pattern[m_position] != ']')
+				{
+					const char c = m_pattern[m_position++];
+					if (c == '\\')
+					{
+						const regex_char_set escape = parse_escape();
+						// Single characters may start a range, shorthand classes may not
+						uint8_t single = 0;
+						size_t members = 0;
+						for (unsigned e = 0; e < 256; ++e)
+						{
+							if (escape.contains(static_cast<uint8_t>(e)))
+							{
+								single = static_cast<uint8_t>(e);
+								++members;
+							}
+						}
+						if (members == 1)
+						{
+							insert_class_item(chars, single);
+						}
+						else
+						{
+							chars.insert(escape);
+						}
+					}
+					else
+					{
+						insert_class_item(chars, static_cast<uint8_t>(c));
+					}
+				}
+
+				if (m_position >= m_size)
+				{
+					throw regex_syntax_error{ 395ull, "regex.hpp", "woj::detail::regex_parser::parse_class" };
+				}
+				++m_position;
+
+				if (negated)
+				{
+					chars.invert();
+				}
+				return chars;
+			}
+
+			consteval void insert_class_item(regex_char_set& chars, const uint8_t first)
+			{
+				if (m_position + 1 < m_size && m_pattern[m_position] == '-' && m_pattern[m_position + 1] != ']')
+				{
+					++m_position;
+					uint8_t last = static_cast<uint8_t>(m_pattern[m_position++]);
+					if (last == '\\')
+					{
+						const regex_char_set escape = parse_escape();
+						last = 0;
+						while (last < 255 && !escape.contains(last))
+						{
+							++last;
+						}
+					}
+					if (last < first)
+					{
+						throw regex_syntax_error{ 423ull, "regex.hpp", "woj::detail::regex_parser::insert_class_item" };
+					}
+					chars.insert(first, last);
+				}
+				else
+				{
+					chars.insert(first);
+				}
+			}
+
+			consteval regex_char_set parse_escape()
+			{
+				if (m_position >= m_size)
+				{
+					throw regex_syntax_error{ 437ull, "regex.hpp", "woj::detail::regex_parser::parse_escape" };
+				}
+
+				const char c = m_pattern[m_position++];
+				regex_char_set chars{};
+
+				switch (c)
+				{
+				case 'd':
+				case 'D':
+					chars.insert('0', '9');
+					break;
+				case 'w':
+				case 'W':
+					chars.insert('a', 'z');
+					chars.insert('A', 'Z');
+					chars.insert('0', '9');
+					chars.insert('_');
+					break;
+				case 's':
+				case 'S':
+					chars.insert(' ');
+					chars.insert('\t', '\r');
+					break;
+				case 'n':
+					chars.insert('\n');
+					break;
+				case 't':
+					chars.insert('\t');
+					break;
+				case 'r':
+					chars.insert('\r');
+					break;
+				case 'f':
+					chars.insert('\f');
+					break;
+				case 'v':
+					chars.insert('\v');
+					break;
+				case '0':
+					chars.insert(0);
+					break;
+				case 'x':
+				{
+					uint8_t value = 0;
+					for (size_t i = 0; i < 2; ++i, ++m_position)
+					{
+						const char digit = m_position < m_size ? m_pattern[m_position] : '\0';
+						if (digit >= '0' && digit <= '9')
+						{
+							value = static_cast<uint8_t>(value * 16 + (digit - '0'));
+						}
+						else if ((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f')
+						{
+							value = static_cast<uint8_t>(value * 16 + ((digit | 0x20) - 'a' + 10));
+						}
+						else
+						{
+							throw regex_syntax_error{ 495ull, "regex.hpp", "woj::detail::regex_parser::parse_escape" };
+						}
+					}
+					chars.insert(value);
+					break;
+				}
+				default:
+					if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+					{
+						throw regex_syntax_error{ 504ull, "regex.hpp", "woj::detail::regex_parser::parse_escape" };
+					}
+					chars.insert(static_cast<uint8_t>(c));
+				}
+
+				if (c == 'D' || c == 'W' || c == 'S')
+				{
+					chars.invert();
+				}
+				return chars;
+			}
+		};
+
+		/**
+		 * Thompson NFA state: a character transition when m_chars != regex_none, otherwise up to two epsilon transitions
+		 */
+		class regex_nfa_state
+		{
+		public:
+			size_t m_chars;
+			size_t m_out;
+			size_t m_alt;
+		};
+
+		/**
+		 * Compiles a pattern to a minimal DFA (Thompson NFA, subset construction over byte classes, Moore minimization).
+		 * State 0 is the dead state.
+		 */
+		class regex_compiler
+		{
+		public:
+			static constexpr size_t accept_state = 0;
+
+			std::vector<regex_char_set> m_sets;
+			std::vector<regex_nfa_state> m_nfa;
+			uint8_t m_class_of[256];
+			size_t m_class_count;
+			std::vector<size_t> m_next;
+			std::vector<uint8_t> m_accepting;
+			size_t m_state_count;
+			size_t m_start;
+			bool m_anchored_begin;
+			bool m_anchored_end;
+			bool m_complete;
+
+			/**
+			 * @param unanchored Whether to build the search automaton (may match from any position), which is
+			 * abandoned with m_complete = false instead of throwing if it needs more than regex_max_search_states states
+			 */
+			consteval regex_compiler(const char* const pattern, const size_t size, const bool unanchored) : m_sets{}, m_nfa{}, m_class_of{}, m_class_count{ 1 }, m_next{}, m_accepting{}, m_state_count{ 0 }, m_start{ 0 }, m_anchored_begin{ false }, m_anchored_end{ false }, m_complete{ true }
+			{
+				regex_parser parser{ pattern, size };
+				const size_t root = parser.parse();
+				m_anchored_begin = parser.m_anchored_begin;
+				m_anchored_end = parser.m_anchored_end;
+
+				m_nfa.push_back(regex_nfa_state{ regex_none, regex_none, regex_none });
+				const size_t nfa_start = build(parser.m_nodes, root, accept_state);
+
+				compute_classes();
+				build_dfa(nfa_start, unanchored && !m_anchored_begin, unanchored ? regex_max_search_states : regex_max_states);
+				if (m_complete)
+				{
+					minimize();
+				}
+			}
+
+		private:
+			consteval size_t add_state(const size_t chars, const size_t out, const size_t alt)
+			{
+				m_nfa.push_back(regex_nfa_state{ chars, out, alt });
+				return m_nfa.size() - 1;
+			}
+
+			/**
+			 * @return Index of the character set in m_sets (identical sets share an entry)
+			 */
+			consteval size_t intern(const regex_char_set& chars)
+			{
+				for (size_t i = 0; i < m_sets.size(); ++i)
+				{
+					if (m_sets[i] == chars)
+					{
+						return i;
+					}
+				}
+				m_sets.push_back(chars);
+				return m_sets.size() - 1;
+			}
+
+			/**
+			 * Builds the NFA of a node backwards
+			 * @param next State to continue with after the node matched
+			 * @return Entry state of the node
+			 */
+			consteval size_t build(const std::vector<regex_node>& nodes, const size_t node, const size_t next)
+			{
+				const regex_node& current = nodes[node];
+
+				switch (current.m_kind)
+				{
+				case regex_node_kind::empty:
+					return next;
+				case regex_node_kind::chars:
+					return add_state(intern(current.m_chars), next, regex_none);
+				case regex_node_kind::concat:
+					return build(nodes, current.m_left, build(nodes, current.m_right, next));
+				case regex_node_kind::alternate:
+				{
+					const size_t left = build(nodes, current.m_left, next);
+					const size_t right = build(nodes, current.m_right, next);
+					return add_state(regex_none, left, right);
+				}
+				default:
+				{
+					size_t entry = next;
+					if (current.m_max == regex_none)
+					{
+						const size_t loop = add_state(regex_none, regex_none, next);
+						const size_t body = build(nodes, current.m_left, loop);
+						m_nfa[loop].m_out = body;
+						entry = loop;
+					}
+					else
+					{
+						for (size_t i = current.m_min; i < current.m_max; ++i)
+						{
+							const size_t body = build(nodes, current.m_left, entry);
+							entry = add_state(regex_none, body, next);
+						}
+					}
+
+					for (size_t i = 0; i < current.m_min; ++i)
+					{
+						entry = build(nodes, current.m_left, entry);
+					}
+					return entry;
+				}
+				}
+			}
+
+			/**
+			 * Partitions bytes into classes that no character set distinguishes
+			 */
+			consteval void compute_classes()
+			{
+				for (const regex_char_set& set : m_sets)
+				{
+					size_t remap[512]{};
+					for (size_t i = 0; i < m_class_count * 2; ++i)
+					{
+						remap[i] = regex_none;
+					}
+
+					size_t count = 0;
+					for (unsigned c = 0; c < 256; ++c)
+					{
+						size_t& id = remap[m_class_of[c] * 2 + set.contains(static_cast<uint8_t>(c))];
+						if (id == regex_none)
+						{
+							id = count++;
+						}
+						m_class_of[c] = static_cast<uint8_t>(id);
+					}
+					m_class_count = count;
+				}
+			}
+
+			consteval void closure(std::vector<uint64_t>& states, const size_t offset, const size_t state, std::vector<size_t>& stack) const
+			{
+				stack.push_back(state);
+				while (!stack.empty())
+				{
+					const size_t current = stack.back();
+					stack.pop_back();
+
+					uint64_t& word = states[offset + current / 64];
+					if (word >> (current % 64) & 1)
+					{
+						continue;
+					}
+					word |= 1ull << (current % 64);
+
+					if (m_nfa[current].m_chars == regex_none)
+					{
+						if (m_nfa[current].m_out != regex_none)
+						{
+							stack.push_back(m_nfa[current].m_out);
+						}
+						if (m_nfa[current].m_alt != regex_none)
+						{
+							stack.push_back(m_nfa[current].m_alt);
+						}
+					}
+				}
+			}
+
+			consteval void build_dfa(const size_t nfa_start, const bool unanchored, const size_t max_states)
+			{
+				const size_t count = m_nfa.size();
+				const size_t words = (count + 63) / 64;
+				uint8_t representative[256]{};
+				for (unsigned c = 256; c-- > 0;)
+				{
+					representative[m_class_of[c]] = static_cast<uint8_t>(c);
+				}
+
+				// Only character states and the accept state identify a DFA state, epsilon states are dropped
+				std::vector<uint64_t> important(words, 0);
+				for (size_t nfa = 0; nfa < count; ++nfa)
+				{
+					if (nfa == accept_state || m_nfa[nfa].m_chars != regex_none)
+					{
+						important[nfa / 64] |= 1ull << (nfa % 64);
+					}
+				}
+
+				std::vector<uint64_t> closures(count * words, 0);
+				std::vector<size_t> stack{};
+				for (size_t nfa = 0; nfa < count; ++nfa)
+				{
+					closure(closures, nfa * words, nfa, stack);
+					for (size_t w = 0; w < words; ++w)
+					{
+						closures[nfa * words + w] &= important[w];
+					}
+				}
+
+				std::vector<uint64_t> sets(words, 0);
+				sets.insert(sets.end(), closures.begin() + static_cast<ptrdiff_t>(nfa_start * words), closures.begin() + static_cast<ptrdiff_t>((nfa_start + 1) * words));
+				std::vector<uint64_t> hashes{ hash_set(sets, 0, words), hash_set(sets, words, words) };
+				std::vector<uint64_t> moves(m_class_count * words, 0);
+
+				// Open addressing index of the DFA states by their NFA state set
+				std::vector<size_t> index{};
+				size_t mask = 0;
+
+				m_state_count = 2;
+				m_start = 1;
+				m_next.resize(m_class_count, 0);
+				m_accepting.push_back(0);
+
+				for (size_t state = 1; state < m_state_count; ++state)
+				{
+					for (size_t cls = 0; cls < m_class_count; ++cls)
+					{
+						for (size_t w = 0; w < words; ++w)
+						{
+							moves[cls * words + w] = unanchored ? closures[nfa_start * words + w] : 0;
+						}
+					}
+
+					for (size_t w = 0; w < words; ++w)
+					{
+						for (uint64_t bits = sets[state * words + w]; bits; bits &= bits - 1)
+						{
+							const regex_nfa_state& nfa = m_nfa[w * 64 + static_cast<size_t>(std::countr_zero(bits))];
+							if (nfa.m_chars == regex_none)
+							{
+								continue;
+							}
+
+							for (size_t cls = 0; cls < m_class_count; ++cls)
+							{
+								if (m_sets[nfa.m_chars].contains(representative[cls]))
+								{
+									for (size_t o = 0; o < words; ++o)
+									{
+										moves[cls * words + o] |= closures[nfa.m_out * words + o];
+									}
+								}
+							}
+						}
+					}
+
+					if (m_state_count * 2 + m_class_count * 2 > index.size())
+					{
+						index.assign(std::bit_ceil((m_state_count + m_class_count) * 4), regex_none);
+						mask = index.size() - 1;
+						for (size_t indexed = 0; indexed < m_state_count; ++indexed)
+						{
+							size_t slot = static_cast<size_t>(hashes[indexed]) & mask;
+							while (index[slot] != regex_none)
+							{
+								slot = (slot + 1) & mask;
+							}
+							index[slot] = indexed;
+						}
+					}
+
+					for (size_t cls = 0; cls < m_class_count; ++cls)
+					{
+						const uint64_t hash = hash_set(moves, cls * words, words);
+						size_t slot = static_cast<size_t>(hash) & mask;
+						while (index[slot] != regex_none && (hashes[index[slot]] != hash || !equal_words(sets, index[slot] * words, moves, cls * words, words)))
+						{
+							slot = (slot + 1) & mask;
+						}
+
+						size_t target = index[slot];
+						if (target == regex_none)
+						{
+							target = m_state_count;
+							index[slot] = target;
+							if (++m_state_count > max_states)
+							{
+								if (max_states == regex_max_search_states)
+								{
+									m_complete = false;
+									return;
+								}
+								throw regex_too_complex{ 815ull, "regex.hpp", "woj::detail::regex_compiler::build_dfa" };
+							}
+							sets.insert(sets.end(), moves.begin() + static_cast<ptrdiff_t>(cls * words), moves.begin() + static_cast<ptrdiff_t>((cls + 1) * words));
+							hashes.push_back(hash);
+						}
+						m_next.push_back(target);
+					}
+
+					m_accepting.push_back(sets[state * words] & 1);
+				}
+			}
+
+			WOJ_NODISCARD static consteval uint64_t hash_set(const std::vector<uint64_t>& sets, const size_t offset, const size_t words) noexcept
+			{
+				uint64_t hash = 0xCBF29CE484222325ull;
+				for (size_t i = 0; i < words; ++i)
+				{
+					hash = (hash ^ sets[offset + i]) * 0x100000001B3ull;
+					hash ^= hash >> 29;
+				}
+				return hash ^ hash >> 32;
+			}
+
+			WOJ_NODISCARD static consteval bool equal_words(const std::vector<uint64_t>& lhs, const size_t lhs_offset, const std::vector<uint64_t>& rhs, const size_t rhs_offset, const size_t words) noexcept
+			{
+				for (size_t i = 0; i < words; ++i)
+				{
+					if (lhs[lhs_offset + i] != rhs[rhs_offset + i])
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/**
+			 * Merges equivalent states with Hopcroft's partition refinement. Blocks are numbered in order of
+			 * their lowest state so the dead state stays at index 0.
+			 */
+			consteval void minimize()
+			{
+				const size_t count = m_state_count;
+				const size_t classes = m_class_count;
+
+				// Predecessors grouped by (class, target) in compressed rows
+				std::vector<size_t> predecessor_begin(classes * count + 1, 0);
+				std::vector<size_t> predecessors(classes * count, 0);
+				for (size_t state = 0; state < count; ++state)
+				{
+					for (size_t cls = 0; cls < classes; ++cls)
+					{
+						++predecessor_begin[cls * count + m_next[state * classes + cls] + 1];
+					}
+				}
+				for (size_t row = 0; row < classes * count; ++row)
+				{
+					predecessor_begin[row + 1] += predecessor_begin[row];
+				}
+				std::vector<size_t> cursor(predecessor_begin);
+				for (size_t state = 0; state < count; ++state)
+				{
+					for (size_t cls = 0; cls < classes; ++cls)
+					{
+						predecessors[cursor[cls * count + m_next[state * classes + cls]]++] = state;
+					}
+				}
+
+				// Elements are grouped by block, marked elements are moved to the front of their block
+				std::vector<size_t> elements(count, 0);
+				std::vector<size_t> location(count, 0);
+				std::vector<size_t> block_of(count, 0);
+				std::vector<size_t> first{};
+				std::vector<size_t> end{};
+				std::vector<size_t> marked{};
+
+				size_t position = 0;
+				for (uint8_t accepting = 0; accepting < 2; ++accepting)
+				{
+					const size_t start = position;
+					for (size_t state = 0; state < count; ++state)
+					{
+						if (m_accepting[state] == accepting)
+						{
+							elements[position] = state;
+							location[state] = position;
+							block_of[state] = first.size();
+							++position;
+						}
+					}
+					if (position != start)
+					{
+						first.push_back(start);
+						end.push_back(position);
+						marked.push_back(start);
+					}
+				}
+
+				std::vector<size_t> worklist{};
+				std::vector<uint8_t> pending(first.size() * classes, 1);
+				for (size_t item = 0; item < pending.size(); ++item)
+				{
+					worklist.push_back(item);
+				}
+
+				std::vector<size_t> splitter{};
+				std::vector<size_t> touched{};
+				while (!worklist.empty())
+				{
+					const size_t item = worklist.back();
+					worklist.pop_back();
+					pending[item] = 0;
+
+					const size_t cls = item % classes;
+					splitter.assign(elements.begin() + static_cast<ptrdiff_t>(first[item / classes]), elements.begin() + static_cast<ptrdiff_t>(end[item / classes]));
+
+					for (const size_t target : splitter)
+					{
+						for (size_t p = predecessor_begin[cls * count + target]; p < predecessor_begin[cls * count + target + 1]; ++p)
+						{
+							const size_t state = predecessors[p];
+							const size_t block = block_of[state];
+							if (location[state] < marked[block])
+							{
+								continue;
+							}
+							if (marked[block] == first[block])
+							{
+								touched.push_back(block);
+							}
+
+							const size_t other = elements[marked[block]];
+							elements[location[state]] = other;
+							location[other] = location[state];
+							elements[marked[block]] = state;
+							location[state] = marked[block]++;
+						}
+					}
+
+					for (const size_t block : touched)
+					{
+						if (marked[block] == end[block])
+						{
+							marked[block] = first[block];
+							continue;
+						}
+
+						// The marked part becomes a new block
+						const size_t created = first.size();
+						first.push_back(first[block]);
+						end.push_back(marked[block]);
+						marked.push_back(first[block]);
+						first[block] = marked[block];
+						pending.resize(first.size() * classes, 0);
+
+						for (size_t i = first[created]; i < end[created]; ++i)
+						{
+							block_of[elements[i]] = created;
+						}
+
+						const bool created_smaller = end[created] - first[created] <= end[block] - first[block];
+						for (size_t c = 0; c < classes; ++c)
+						{
+							const size_t added = pending[block * classes + c] || created_smaller ? created * classes + c : block * classes + c;
+							if (!pending[added])
+							{
+								pending[added] = 1;
+								worklist.push_back(added);
+							}
+						}
+					}
+					touched.clear();
+				}
+
+				std::vector<size_t> renumbered(first.size(), regex_none);
+				std::vector<size_t> block(count, 0);
+				size_t block_count = 0;
+				for (size_t state = 0; state < count; ++state)
+				{
+					size_t& id = renumbered[block_of[state]];
+					if (id == regex_none)
+					{
+						id = block_count++;
+					}
+					block[state] = id;
+				}
+
+				std::vector<size_t> next(block_count * m_class_count, 0);
+				std::vector<uint8_t> accepting(block_count, 0);
+				for (size_t state = 0; state < m_state_count; ++state)
+				{
+					for (size_t cls = 0; cls < m_class_count; ++cls)
+					{
+						next[block[state] * m_class_count + cls] = block[m_next[state * m_class_count + cls]];
+					}
+					accepting[block[state]] = m_accepting[state];
+				}
+
+				m_next = next;
+				m_accepting = accepting;
+				m_state_count = block_count;
+				m_start = block[m_start];
+			}
+		};
+
+		/**
+		 * Compiled DFA of a pattern, the transition table has one row of byte-class entries per state
+		 * @tparam States Count of states
+		 * @tparam Classes Count of byte classes
+		 */
+		template <size_t States, size_t Classes>
+		class regex_dfa
+		{
+		public:
+			using state_type = std::conditional_t<(States <= 256), uint8_t, uint16_t>;
+
+			uint8_t m_class_of[256];
+			state_type m_next[States * Classes];
+			bool m_accepting[States];
+			state_type m_start;
+			bool m_anchored_begin;
+			bool m_anchored_end;
+
+			consteval regex_dfa(const char* const pattern, const size_t size, const bool unanchored) : m_class_of{}, m_next{}, m_accepting{}, m_start{ 0 }, m_anchored_begin{ false }, m_anchored_end{ false }
+			{
+				const regex_compiler compiler{ pattern, size, unanchored };
+
+				for (size_t c = 0; c < 256; ++c)
+				{
+					m_class_of[c] = compiler.m_class_of[c];
+				}
+				for (size_t i = 0; i < States * Classes; ++i)
+				{
+					m_next[i] = static_cast<state_type>(compiler.m_next[i]);
+				}
+				for (size_t state = 0; state < States; ++state)
+				{
+					m_accepting[state] = compiler.m_accepting[state];
+				}
+				m_start = static_cast<state_type>(compiler.m_start);
+				m_anchored_begin = compiler.m_anchored_begin;
+				m_anchored_end = compiler.m_anchored_end;
+			}
+
+			WOJ_NODISCARD constexpr size_t next(const size_t state, const char c) const noexcept
+			{
+				return m_next[state * Classes + m_class_of[static_cast<uint8_t>(c)]];
+			}
+		};
+
+		class regex_dfa_size
+		{
+		public:
+			size_t m_states;
+			size_t m_classes;
+			bool m_complete;
+		};
+
+		template <regex_pattern Pattern, bool Unanchored>
+		inline constexpr regex_dfa_size regex_size = []() consteval
+		{
+			const regex_compiler compiler{ Pattern.m_data, Pattern.size(), Unanchored };
+			return regex_dfa_size{ compiler.m_state_count, compiler.m_class_count, compiler.m_complete };
+		}();
+
+		/**
+		 * Compiled automaton of a pattern (a variable template so the search automaton is only built when used)
+		 */
+		template <regex_pattern Pattern, bool Unanchored>
+		inline constexpr regex_dfa<regex_size<Pattern, Unanchored>.m_states, regex_size<Pattern, Unanchored>.m_classes> regex_automaton{ Pattern.m_data, Pattern.size(), Unanchored };
+	}
+
+	/**
+	 * Regular expression compiled to a minimal DFA at compile-time, matching never allocates or backtracks
+	 * and works in constant expressions, e.g. static_assert(regex<"[0-9]{4}-[0-9]{2}">::match("2024-05", 7));
+	 * Matches bytes; see detail::regex_parser for the supported syntax.
+	 * @tparam Pattern Pattern to compile
+	 */
+	template <regex_pattern Pattern>
+	class regex
+	{
+		static constexpr const auto& anchored = detail::regex_automaton<Pattern, false>;
+
+		template <bool Unanchored>
+		WOJ_NODISCARD static constexpr bool search_with(const char* const str, const size_t size) noexcept
+		{
+			const auto& automaton = detail::regex_automaton<Pattern, Unanchored>;
+			size_t state = automaton.m_start;
+			for (size_t i = 0; i < size; ++i)
+			{
+				if (automaton.m_accepting[state] && !automaton.m_anchored_end)
+				{
+					return true;
+				}
+				state = automaton.next(state, str[i]);
+				if (!state)
+				{
+					return false;
+				}
+			}
+			return automaton.m_accepting[state];
+		}
+
+		/**
+		 * Runs the anchored automaton from every start position, used when the search automaton would be too large
+		 */
+		WOJ_NODISCARD static constexpr bool search_each(const char* const str, const size_t size) noexcept
+		{
+			for (size_t start = 0; start <= size; ++start)
+			{
+				size_t state = anchored.m_start;
+				for (size_t i = start; state; ++i)
+				{
+					if (anchored.m_accepting[state] && (!anchored.m_anchored_end || i == size))
+					{
+						return true;
+					}
+					if (i == size)
+					{
+						break;
+					}
+					state = anchored.next(state, str[i]);
+				}
+			}
+			return false;
+		}
+
+	public:
+		/**
+		 * Checks whether the whole input matches the pattern (anchors are implied)
+		 * @param str Input buffer
+		 * @param size Count of characters in the input
+		 * @return True if the input matches
+		 */
+		WOJ_NODISCARD static constexpr bool match(const char* const str, const size_t size) noexcept
+		{
+			size_t state = anchored.m_start;
+			for (size_t i = 0; i < size; ++i)
+			{
+				state = anchored.next(state, str[i]);
+				if (!state)
+				{
+					return false;
+				}
+			}
+			return anchored.m_accepting[state];
+		}
+
+		template <size_t MemSize>
+		WOJ_NODISCARD static constexpr bool match(const stack::string<char, MemSize>& str) noexcept
+		{
+			return match(str.data(), str.str_size());
+		}
+
+		/**
+		 * Checks whether any part of the input matches the pattern (honours '^' and '$')
+		 * @param str Input buffer
+		 * @param size Count of characters in the input
+		 * @return True if a match was found
+		 */
+		WOJ_NODISCARD static constexpr bool search(const char* const str, const size_t size) noexcept
+		{
+			if (anchored.m_anchored_begin && anchored.m_anchored_end)
+			{
+				return match(str, size);
+			}
+
+			if constexpr (anchored.m_anchored_begin)
+			{
+				return search_with<false>(str, size);
+			}
+			else if constexpr (detail::regex_size<Pattern, true>.m_complete)
+			{
+				return search_with<true>(str, size);
+			}
+			else
+			{
+				return search_each(str, size);
+			}
+		}
+
+		template <size_t MemSize>
+		WOJ_NODISCARD static constexpr bool search(const stack::string<char, MemSize>& str) noexcept
+		{
+			return search(str.data(), str.str_size());
+		}
+
+		/**
+		 * Finds the leftmost-longest match (honours '^' and '$'), every candidate start runs until the DFA dies
+		 * so use search when only the presence of a match is needed
+		 * @param str Input buffer
+		 * @param size Count of characters in the input
+		 * @return Position and length of the match, evaluates to false if there is none
+		 */
+		WOJ_NODISCARD static constexpr regex_match find(const char* const str, const size_t size) noexcept
+		{
+			const size_t last_start = anchored.m_anchored_begin ? 0 : size;
+			for (size_t start = 0; start <= last_start; ++start)
+			{
+				size_t state = anchored.m_start;
+				size_t end = anchored.m_accepting[state] && (!anchored.m_anchored_end || start == size) ? start : detail::regex_none;
+
+				for (size_t i = start; i < size && state; ++i)
+				{
+					state = anchored.next(state, str[i]);
+					if (anchored.m_accepting[state] && (!anchored.m_anchored_end || i + 1 == size))
+					{
+						end = i + 1;
+					}
+				}
+
+				if (end != detail::regex_none)
+				{
+					return regex_match{ start, end - start };
+				}
+			}
+			return regex_match{ detail::regex_none, 0 };
+		}
+
+		template <size_t MemSize>
+		WOJ_NODISCARD static constexpr regex_match find(const stack::string<char, MemSize>& str) noexcept
+		{
+			return find(str.data(), str.str_size());
+		}
+
+		/**
+		 * @return Count of states of the anchored DFA (including the dead state)
+		 */
+		static WOJ_CONSTEVAL size_t state_count() noexcept
+		{
+			return sizeof(anchored.m_accepting);
+		}
+	};
+}
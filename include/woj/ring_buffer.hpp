@@ -0,0 +1,643 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_RING_BUFFER_HPP
+#define WOJ_RING_BUFFER_HPP
+#endif
+
+namespace woj
+{
+	namespace stack
+	{
+		/**
+		 * The content of a ring buffer as (at most) two contiguous spans, first holds the oldest elements
+		 */
+		template <typename ElementType>
+		struct ring_spans
+		{
+			std::span<ElementType> first;
+			std::span<ElementType> second;
+
+			WOJ_NODISCARD constexpr size_t size() const noexcept
+			{
+				return first.size() + second.size();
+			}
+		};
+
+		/**
+		 * Random access iterator over a ring buffer from the oldest to the newest element
+		 */
+		template <typename Buffer, bool Const>
+		class ring_iterator
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = typename Buffer::value_type;
+			using difference_type = ptrdiff_t;
+			using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+			using reference = std::conditional_t<Const, const value_type&, value_type&>;
+			using buffer_type = std::conditional_t<Const, const Buffer, Buffer>;
+
+			buffer_type* m_buffer;
+			size_t m_index;
+
+			constexpr ring_iterator() noexcept : m_buffer{ nullptr }, m_index{ 0 } {}
+
+			constexpr ring_iterator(buffer_type* const buffer, const size_t index) noexcept : m_buffer{ buffer }, m_index{ index } {}
+
+			constexpr operator ring_iterator<Buffer, true>() const noexcept requires (!Const)
+			{
+				return { m_buffer, m_index };
+			}
+
+			constexpr reference operator*() const noexcept
+			{
+				return (*m_buffer)[m_index];
+			}
+
+			constexpr pointer operator->() const noexcept
+			{
+				return &(*m_buffer)[m_index];
+			}
+
+			constexpr reference operator[](const difference_type offset) const noexcept
+			{
+				return (*m_buffer)[m_index + offset];
+			}
+
+			constexpr ring_iterator& operator++() noexcept
+			{
+				++m_index;
+				return *this;
+			}
+
+			constexpr ring_iterator operator++(int) noexcept
+			{
+				ring_iterator copy{ *this };
+				++m_index;
+				return copy;
+			}
+
+			constexpr ring_iterator& operator--() noexcept
+			{
+				--m_index;
+				return *this;
+			}
+
+			constexpr ring_iterator operator--(int) noexcept
+			{
+				ring_iterator copy{ *this };
+				--m_index;
+				return copy;
+			}
+
+			constexpr ring_iterator& operator+=(const difference_type offset) noexcept
+			{
+				m_index += offset;
+				return *this;
+			}
+
+			constexpr ring_iterator& operator-=(const difference_type offset) noexcept
+			{
+				m_index -= offset;
+				return *this;
+			}
+
+			constexpr ring_iterator operator+(const difference_type offset) const noexcept
+			{
+				return { m_buffer, m_index + offset };
+			}
+
+			friend constexpr ring_iterator operator+(const difference_type offset, const ring_iterator& iterator) noexcept
+			{
+				return iterator + offset;
+			}
+
+			constexpr ring_iterator operator-(const difference_type offset) const noexcept
+			{
+				return { m_buffer, m_index - offset };
+			}
+
+			constexpr difference_type operator-(const ring_iterator& other) const noexcept
+			{
+				return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+			}
+
+			constexpr bool operator==(const ring_iterator& other) const noexcept
+			{
+				return m_index == other.m_index;
+			}
+
+			constexpr auto operator<=>(const ring_iterator& other) const noexcept
+			{
+				return m_index <=> other.m_index;
+			}
+		};
+
+		/**
+		 * Class representing a fixed-capacity circular FIFO buffer, elements are stored in-place and constructed lazily,
+		 * indices wrap with a mask when Capacity is a power of two and with a single compare otherwise
+		 * @tparam ElementType Type of the elements
+		 * @tparam Capacity Maximum count of elements
+		 */
+		template <typename ElementType, size_t Capacity>
+		class ring_buffer
+		{
+		public:
+			using value_type = ElementType;
+			using size_type = size_t;
+			using difference_type = ptrdiff_t;
+			using reference = ElementType&;
+			using const_reference = const ElementType&;
+			using pointer = ElementType*;
+			using const_pointer = const ElementType*;
+			using iterator = ring_iterator<ring_buffer, false>;
+			using const_iterator = ring_iterator<ring_buffer, true>;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			/**
+			 * Smallest unsigned integer type able to hold Capacity
+			 */
+			using count_type = utils::auto_integer_t<0, Capacity>;
+
+			static_assert(Capacity > 0, "Capacity must be greater than 0");
+
+			static constexpr bool power_of_two = (Capacity & (Capacity - 1)) == 0;
+
+			union
+			{
+				alignas(ElementType) ElementType m_data[Capacity];
+			};
+			count_type m_head;
+			count_type m_size;
+
+			constexpr ring_buffer() noexcept : m_head{ 0 }, m_size{ 0 } {}
+
+			constexpr ring_buffer(const ring_buffer& other) requires std::is_trivially_copy_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr ring_buffer(const ring_buffer& other) noexcept(std::is_nothrow_copy_constructible_v<ElementType>) : m_head{ 0 }, m_size{ 0 }
+			{
+				for (const ElementType& element : other)
+				{
+					unchecked_emplace_back(element);
+				}
+			}
+
+			constexpr ring_buffer(ring_buffer&& other) requires std::is_trivially_move_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr ring_buffer(ring_buffer&& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>) : m_head{ 0 }, m_size{ 0 }
+			{
+				for (ElementType& element : other)
+				{
+					unchecked_emplace_back(std::move(element));
+				}
+			}
+
+			constexpr ~ring_buffer() requires std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr ~ring_buffer() noexcept
+			{
+				clear();
+			}
+
+			constexpr ring_buffer& operator=(const ring_buffer& other) requires std::is_trivially_copy_assignable_v<ElementType> && std::is_trivially_copy_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr ring_buffer& operator=(const ring_buffer& other)
+			{
+				if (this != &other)
+				{
+					clear();
+					for (const ElementType& element : other)
+					{
+						unchecked_emplace_back(element);
+					}
+				}
+				return *this;
+			}
+
+			constexpr ring_buffer& operator=(ring_buffer&& other) requires std::is_trivially_move_assignable_v<ElementType> && std::is_trivially_move_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr ring_buffer& operator=(ring_buffer&& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				if (this != &other)
+				{
+					clear();
+					for (ElementType& element : other)
+					{
+						unchecked_emplace_back(std::move(element));
+					}
+				}
+				return *this;
+			}
+
+			// ----- Element access -----
+
+			/**
+			 * @param index Logical index, 0 is the oldest element
+			 */
+			WOJ_NODISCARD constexpr reference operator[](const size_type index) noexcept
+			{
+				return m_data[wrap(m_head + index)];
+			}
+
+			WOJ_NODISCARD constexpr const_reference operator[](const size_type index) const noexcept
+			{
+				return m_data[wrap(m_head + index)];
+			}
+
+			WOJ_NODISCARD constexpr reference at(const size_type index)
+			{
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 263ull, "ring_buffer.hpp", "woj::stack::ring_buffer<ElementType, Capacity>::at" };
+				}
+				return (*this)[index];
+			}
+
+			WOJ_NODISCARD constexpr const_reference at(const size_type index) const
+			{
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 272ull, "ring_buffer.hpp", "woj::stack::ring_buffer<ElementType, Capacity>::at" };
+				}
+				return (*this)[index];
+			}
+
+			/**
+			 * @return The oldest element
+			 */
+			WOJ_NODISCARD constexpr reference front() noexcept
+			{
+				return m_data[m_head];
+			}
+
+			WOJ_NODISCARD constexpr const_reference front() const noexcept
+			{
+				return m_data[m_head];
+			}
+
+			/**
+			 * @return The newest element
+			 */
+			WOJ_NODISCARD constexpr reference back() noexcept
+			{
+				return (*this)[m_size - 1];
+			}
+
+			WOJ_NODISCARD constexpr const_reference back() const noexcept
+			{
+				return (*this)[m_size - 1];
+			}
+
+			/**
+			 * @return The elements from the oldest to the newest as two contiguous spans (second is empty unless the content wraps)
+			 */
+			WOJ_NODISCARD constexpr ring_spans<ElementType> spans() noexcept
+			{
+				const size_type first = contiguous(m_head, m_size);
+				return { { m_data + m_head, first }, { m_data, m_size - first } };
+			}
+
+			WOJ_NODISCARD constexpr ring_spans<const ElementType> spans() const noexcept
+			{
+				const size_type first = contiguous(m_head, m_size);
+				return { { m_data + m_head, first }, { m_data, m_size - first } };
+			}
+
+			// ----- Iterators -----
+
+			WOJ_NODISCARD constexpr iterator begin() noexcept
+			{
+				return { this, 0 };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+			{
+				return { this, 0 };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+			{
+				return { this, 0 };
+			}
+
+			WOJ_NODISCARD constexpr iterator end() noexcept
+			{
+				return { this, m_size };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator end() const noexcept
+			{
+				return { this, m_size };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+			{
+				return { this, m_size };
+			}
+
+			WOJ_NODISCARD constexpr reverse_iterator rbegin() noexcept
+			{
+				return reverse_iterator{ end() };
+			}
+
+			WOJ_NODISCARD constexpr const_reverse_iterator rbegin() const noexcept
+			{
+				return const_reverse_iterator{ end() };
+			}
+
+			WOJ_NODISCARD constexpr reverse_iterator rend() noexcept
+			{
+				return reverse_iterator{ begin() };
+			}
+
+			WOJ_NODISCARD constexpr const_reverse_iterator rend() const noexcept
+			{
+				return const_reverse_iterator{ begin() };
+			}
+
+			// ----- Capacity -----
+
+			WOJ_NODISCARD constexpr size_type size() const noexcept
+			{
+				return m_size;
+			}
+
+			WOJ_NODISCARD constexpr bool empty() const noexcept
+			{
+				return m_size == 0;
+			}
+
+			WOJ_NODISCARD constexpr bool full() const noexcept
+			{
+				return m_size == Capacity;
+			}
+
+			static WOJ_CONSTEVAL size_type capacity() noexcept
+			{
+				return Capacity;
+			}
+
+			// ----- Modifiers -----
+
+			/**
+			 * Appends an element, throws vector_capacity_exceeded when the buffer is full
+			 */
+			template <typename... Args>
+			constexpr reference emplace_back(Args&&... args)
+			{
+				if (full()) WOJ_UNLIKELY
+				{
+					throw vector_capacity_exceeded{ 402ull, "ring_buffer.hpp", "woj::stack::ring_buffer<ElementType, Capacity>::emplace_back" };
+				}
+				return unchecked_emplace_back(std::forward<Args>(args)...);
+			}
+
+			constexpr reference push_back(const ElementType& value)
+			{
+				return emplace_back(value);
+			}
+
+			constexpr reference push_back(ElementType&& value)
+			{
+				return emplace_back(std::move(value));
+			}
+
+			/**
+			 * Appends an element if there is room
+			 * @return Pointer to the new element or nullptr when the buffer is full
+			 */
+			template <typename... Args>
+			constexpr pointer try_emplace_back(Args&&... args)
+			{
+				return full() ? nullptr : &unchecked_emplace_back(std::forward<Args>(args)...);
+			}
+
+			constexpr pointer try_push_back(const ElementType& value)
+			{
+				return try_emplace_back(value);
+			}
+
+			constexpr pointer try_push_back(ElementType&& value)
+			{
+				return try_emplace_back(std::move(value));
+			}
+
+			/**
+			 * Appends an element, the buffer must not be full
+			 */
+			template <typename... Args>
+			constexpr reference unchecked_emplace_back(Args&&... args)
+			{
+				ElementType* const element = std::construct_at(m_data + wrap(m_head + m_size), std::forward<Args>(args)...);
+				++m_size;
+				return *element;
+			}
+
+			/**
+			 * Appends an element, replacing the oldest one when the buffer is full (sliding window)
+			 */
+			template <typename... Args>
+			constexpr reference emplace_overwrite(Args&&... args)
+			{
+				if (!full())
+				{
+					return unchecked_emplace_back(std::forward<Args>(args)...);
+				}
+
+				ElementType& element = m_data[m_head];
+				element = ElementType(std::forward<Args>(args)...);
+				m_head = static_cast<count_type>(wrap(m_head + 1));
+				return element;
+			}
+
+			constexpr reference push_overwrite(const ElementType& value)
+			{
+				return emplace_overwrite(value);
+			}
+
+			constexpr reference push_overwrite(ElementType&& value)
+			{
+				return emplace_overwrite(std::move(value));
+			}
+
+			/**
+			 * Appends as many values as fit, trivially copyable elements are copied with at most two memcpy calls
+			 * @param values Values to append
+			 * @param count Count of values
+			 * @return Count of values appended
+			 */
+			constexpr size_type push_back(const ElementType* const values, size_type count)
+			{
+				const size_type available = Capacity - m_size;
+				count = count < available ? count : available;
+				copy_in(wrap(m_head + m_size), values, count);
+				m_size = static_cast<count_type>(m_size + count);
+				return count;
+			}
+
+			/**
+			 * Appends all the values, the oldest elements are dropped to make room (only the last Capacity values are kept)
+			 * @param values Values to append
+			 * @param count Count of values
+			 */
+			constexpr void push_overwrite(const ElementType* values, size_type count)
+			{
+				if (count >= Capacity)
+				{
+					clear();
+					m_head = 0;
+					copy_in(0, values + (count - Capacity), Capacity);
+					m_size = static_cast<count_type>(Capacity);
+					return;
+				}
+
+				const size_type available = Capacity - m_size;
+				if (count > available)
+				{
+					pop_front(count - available);
+				}
+				push_back(values, count);
+			}
+
+			/**
+			 * Destroys the oldest element, the buffer must not be empty
+			 */
+			constexpr void pop_front() noexcept
+			{
+				std::destroy_at(m_data + m_head);
+				m_head = static_cast<count_type>(wrap(m_head + 1));
+				--m_size;
+			}
+
+			/**
+			 * Destroys the count oldest elements (used after consuming them through spans()), count must not exceed the size
+			 */
+			constexpr void pop_front(const size_type count) noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<ElementType>)
+				{
+					const size_type first = contiguous(m_head, count);
+					std::destroy_n(m_data + m_head, first);
+					std::destroy_n(m_data, count - first);
+				}
+				m_head = static_cast<count_type>(wrap(m_head + count));
+				m_size = static_cast<count_type>(m_size - count);
+			}
+
+			/**
+			 * Moves up to count of the oldest elements out of the buffer, trivially copyable elements are copied with at most two memcpy calls
+			 * @param destination Storage for count elements
+			 * @param count Count of elements to take
+			 * @return Count of elements taken
+			 */
+			constexpr size_type pop_front(ElementType* const destination, size_type count) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				count = count < m_size ? count : m_size;
+				const size_type first = contiguous(m_head, count);
+				move_out(m_data + m_head, first, destination);
+				move_out(m_data, count - first, destination + first);
+				pop_front(count);
+				return count;
+			}
+
+			/**
+			 * Destroys the newest element, the buffer must not be empty
+			 */
+			constexpr void pop_back() noexcept
+			{
+				--m_size;
+				std::destroy_at(m_data + wrap(m_head + m_size));
+			}
+
+			constexpr void clear() noexcept
+			{
+				pop_front(m_size);
+				m_head = 0;
+			}
+
+		private:
+			/**
+			 * Maps an index in [0, 2 * Capacity) to a slot
+			 */
+			WOJ_NODISCARD static constexpr size_type wrap(const size_type index) noexcept
+			{
+				if constexpr (power_of_two)
+				{
+					return index & (Capacity - 1);
+				}
+				else
+				{
+					return index >= Capacity ? index - Capacity : index;
+				}
+			}
+
+			/**
+			 * @return Count of the first count slots starting at start that are contiguous
+			 */
+			WOJ_NODISCARD static constexpr size_type contiguous(const size_type start, const size_type count) noexcept
+			{
+				return count < Capacity - start ? count : Capacity - start;
+			}
+
+			/**
+			 * Copy-constructs count values into the free slots starting at slot start
+			 */
+			constexpr void copy_in(const size_type start, const ElementType* const values, const size_type count)
+			{
+				const size_type first = contiguous(start, count);
+				woj::uninitialized_copy_n(values, first, m_data + start);
+				if constexpr (std::is_nothrow_copy_constructible_v<ElementType>)
+				{
+					woj::uninitialized_copy_n(values + first, count - first, m_data);
+				}
+				else
+				{
+					try
+					{
+						woj::uninitialized_copy_n(values + first, count - first, m_data);
+					}
+					catch (...)
+					{
+						std::destroy_n(m_data + start, first);
+						throw;
+					}
+				}
+			}
+
+			static constexpr void move_out(ElementType* const source, const size_type count, ElementType* const destination) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				if constexpr (std::is_trivially_copyable_v<ElementType>)
+				{
+					if (!is_constant_evaluated())
+					{
+						if (count)
+						{
+							std::memcpy(destination, source, count * sizeof(ElementType));
+						}
+						return;
+					}
+				}
+
+				for (size_type i = 0; i < count; ++i)
+				{
+					destination[i] = std::move(source[i]);
+				}
+			}
+		};
+	}
+
+	template <typename ElementType, size_t Capacity>
+	struct is_trivially_relocatable<stack::ring_buffer<ElementType, Capacity>> : is_trivially_relocatable<ElementType> {};
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "base.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef WOJ_SIMD_HPP
+#define WOJ_SIMD_HPP
+#endif
+
+// Instruction set detection (compile-time only, enable the sets with /arch or -m flags)
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#define WOJ_HAS_AVX512 1
+#endif
+
+#if defined(__AVX2__) || defined(WOJ_HAS_AVX512)
+#define WOJ_HAS_AVX2 1
+#endif
+
+#if defined(__SSSE3__) || defined(WOJ_HAS_AVX2)
+#define WOJ_HAS_SSSE3 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(WOJ_HAS_SSSE3)
+#define WOJ_HAS_SSE2 1
+#endif
+
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define WOJ_HAS_BMI2 1
+#endif
+
+#if defined(WOJ_HAS_SSE2) || defined(WOJ_HAS_BMI2)
+#include <immintrin.h>
+#endif
+
+namespace woj::simd
+{
+	/**
+	 * Class representing a set of matched lanes (one bit per lane), iterable from the lowest lane
+	 */
+	class bitmask
+	{
+	public:
+		uint64_t m_mask;
+
+		constexpr bitmask() noexcept : m_mask{ 0 } {}
+
+		explicit constexpr bitmask(const uint64_t mask) noexcept : m_mask{ mask } {}
+
+		/**
+		 * @return True if any lane matched
+		 */
+		explicit constexpr operator bool() const noexcept
+		{
+			return m_mask != 0;
+		}
+
+		/**
+		 * @return Index of the lowest matched lane (UB if none matched)
+		 */
+		WOJ_NODISCARD constexpr size_t lowest() const noexcept
+		{
+			return static_cast<size_t>(std::countr_zero(m_mask));
+		}
+
+		/**
+		 * Removes the lowest matched lane
+		 * @return Reference to self
+		 */
+		constexpr bitmask& remove_lowest() noexcept
+		{
+			m_mask &= m_mask - 1;
+			return *this;
+		}
+
+		/**
+		 * @return Count of matched lanes
+		 */
+		WOJ_NODISCARD constexpr size_t count() const noexcept
+		{
+			return static_cast<size_t>(std::popcount(m_mask));
+		}
+	};
+
+	/**
+	 * Finds the position of the n-th set bit of a word (PDEP when BMI2 is enabled)
+	 * @param word Word to search
+	 * @param n Index of the set bit among the set bits (0 is the lowest)
+	 * @return Position of the bit or 64 if the word has n set bits or fewer
+	 */
+	WOJ_NODISCARD constexpr size_t select_bit(uint64_t word, size_t n) noexcept
+	{
+		if (n >= 64)
+		{
+			return 64;
+		}
+
+		if (!is_constant_evaluated())
+		{
+#if defined(WOJ_HAS_BMI2) && (defined(_M_X64) || defined(__x86_64__))
+			return static_cast<size_t>(std::countr_zero(_pdep_u64(uint64_t{ 1 } << n, word)));
+#endif
+		}
+
+		// Narrows down to the byte holding the bit by counting the bits of the lower halves
+		size_t position = 0;
+		for (size_t width = 32; width >= 8; width /= 2)
+		{
+			const size_t lower = static_cast<size_t>(std::popcount(word & ((uint64_t{ 1 } << width) - 1)));
+			if (n >= lower)
+			{
+				n -= lower;
+				word >>= width;
+				position += width;
+			}
+		}
+		for (; n != 0 && word != 0; --n)
+		{
+			word &= word - 1;
+		}
+		return word == 0 ? 64 : position + static_cast<size_t>(std::countr_zero(word));
+	}
+
+	/**
+	 * Compares 16 bytes against a value
+	 * @param bytes Pointer to 16 bytes (must be 16-byte aligned)
+	 * @param value Value to compare against
+	 * @return Mask with bit i set if bytes[i] == value
+	 */
+	WOJ_NODISCARD constexpr bitmask match_bytes16(const int8_t* const bytes, const int8_t value) noexcept
+	{
+		if (!is_constant_evaluated())
+		{
+#if defined(WOJ_HAS_SSE2)
+			const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+			return bitmask{ static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value)))) };
+#endif
+		}
+
+		uint64_t mask{ 0 };
+		for (size_t i = 0; i < 16; ++i)
+		{
+			mask |= static_cast<uint64_t>(bytes[i] == value) << i;
+		}
+		return bitmask{ mask };
+	}
+
+	/**
+	 * Collects the sign bits of 16 bytes
+	 * @param bytes Pointer to 16 bytes (must be 16-byte aligned)
+	 * @return Mask with bit i set if bytes[i] < 0
+	 */
+	WOJ_NODISCARD constexpr bitmask sign_bytes16(const int8_t* const bytes) noexcept
+	{
+		if (!is_constant_evaluated())
+		{
+#if defined(WOJ_HAS_SSE2)
+			const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+			return bitmask{ static_cast<uint32_t>(_mm_movemask_epi8(group)) };
+#endif
+		}
+
+		uint64_t mask{ 0 };
+		for (size_t i = 0; i < 16; ++i)
+		{
+			mask |= static_cast<uint64_t>(bytes[i] < 0) << i;
+		}
+		return bitmask{ mask };
+	}
+
+	/**
+	 * Class representing a SIMD register of value_type lanes for the widest enabled instruction set, only specialized
+	 * for float and double (check with has_pack_v)
+	 * @tparam Type Lane type
+	 */
+	template <typename Type>
+	class pack;
+
+	template <typename Type>
+	inline constexpr bool has_pack_v = requires { pack<Type>::width; };
+
+#if defined(WOJ_HAS_AVX512)
+#define WOJ_SIMD_PACK_ISA(name) _mm512_##name
+#define WOJ_SIMD_PACK_FLOAT __m512
+#define WOJ_SIMD_PACK_DOUBLE __m512d
+#define WOJ_SIMD_PACK_BYTES 64
+#elif defined(WOJ_HAS_AVX2)
+#define WOJ_SIMD_PACK_ISA(name) _mm256_##name
+#define WOJ_SIMD_PACK_FLOAT __m256
+#define WOJ_SIMD_PACK_DOUBLE __m256d
+#define WOJ_SIMD_PACK_BYTES 32
+#elif defined(WOJ_HAS_SSE2)
+#define WOJ_SIMD_PACK_ISA(name) _mm_##name
+#define WOJ_SIMD_PACK_FLOAT __m128
+#define WOJ_SIMD_PACK_DOUBLE __m128d
+#define WOJ_SIMD_PACK_BYTES 16
+#endif
+
+#if defined(WOJ_SIMD_PACK_BYTES)
+#define WOJ_SIMD_DEFINE_PACK(type, register, suffix) \
+	template <> \
+	class pack<type> \
+	{ \
+	public: \
+		using value_type = type; \
+		using register_type = register; \
+		static constexpr size_t width = WOJ_SIMD_PACK_BYTES / sizeof(type); \
+		register_type m_value; \
+		WOJ_NODISCARD static pack load(const type* const source) noexcept { return { WOJ_SIMD_PACK_ISA(loadu_##suffix)(source) }; } \
+		WOJ_NODISCARD static pack broadcast(const type value) noexcept { return { WOJ_SIMD_PACK_ISA(set1_##suffix)(value) }; } \
+		WOJ_NODISCARD static pack zero() noexcept { return { WOJ_SIMD_PACK_ISA(setzero_##suffix)() }; } \
+		void store(type* const destination) const noexcept { WOJ_SIMD_PACK_ISA(storeu_##suffix)(destination, m_value); } \
+		WOJ_NODISCARD friend pack operator+(const pack left, const pack right) noexcept { return { WOJ_SIMD_PACK_ISA(add_##suffix)(left.m_value, right.m_value) }; } \
+		WOJ_NODISCARD friend pack operator-(const pack left, const pack right) noexcept { return { WOJ_SIMD_PACK_ISA(sub_##suffix)(left.m_value, right.m_value) }; } \
+		WOJ_NODISCARD friend pack operator*(const pack left, const pack right) noexcept { return { WOJ_SIMD_PACK_ISA(mul_##suffix)(left.m_value, right.m_value) }; } \
+		WOJ_NODISCARD friend pack operator/(const pack left, const pack right) noexcept { return { WOJ_SIMD_PACK_ISA(div_##suffix)(left.m_value, right.m_value) }; } \
+		WOJ_NODISCARD friend pack operator-(const pack value) noexcept { return { WOJ_SIMD_PACK_ISA(sub_##suffix)(WOJ_SIMD_PACK_ISA(setzero_##suffix)(), value.m_value) }; } \
+		WOJ_NODISCARD friend pack min(const pack left, const pack right) noexcept { return { WOJ_SIMD_PACK_ISA(min_##suffix)(left.m_value, right.m_value) }; } \
+		WOJ_NODISCARD friend pack max(const pack left, const pack right) noexcept { return { WOJ_SIMD_PACK_ISA(max_##suffix)(left.m_value, right.m_value) }; } \
+		WOJ_NODISCARD friend pack abs(const pack value) noexcept { return max(value, -value); } \
+		WOJ_NODISCARD friend type reduce_add(const pack value) noexcept { type lanes[width]; value.store(lanes); type result = lanes[0]; for (size_t i = 1; i < width; ++i) result += lanes[i]; return result; } \
+		WOJ_NODISCARD friend type reduce_min(const pack value) noexcept { type lanes[width]; value.store(lanes); type result = lanes[0]; for (size_t i = 1; i < width; ++i) result = lanes[i] < result ? lanes[i] : result; return result; } \
+		WOJ_NODISCARD friend type reduce_max(const pack value) noexcept { type lanes[width]; value.store(lanes); type result = lanes[0]; for (size_t i = 1; i < width; ++i) result = lanes[i] > result ? lanes[i] : result; return result; } \
+	};
+
+	WOJ_SIMD_DEFINE_PACK(float, WOJ_SIMD_PACK_FLOAT, ps)
+	WOJ_SIMD_DEFINE_PACK(double, WOJ_SIMD_PACK_DOUBLE, pd)
+
+#undef WOJ_SIMD_DEFINE_PACK
+#undef WOJ_SIMD_PACK_ISA
+#undef WOJ_SIMD_PACK_FLOAT
+#undef WOJ_SIMD_PACK_DOUBLE
+#undef WOJ_SIMD_PACK_BYTES
+#endif
+}
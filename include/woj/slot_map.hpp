@@ -0,0 +1,379 @@
+#pragma once
+
+#include "base.hpp"
+#include "inplace_vector.hpp"
+#include "vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_SLOT_MAP_HPP
+#define WOJ_SLOT_MAP_HPP
+#endif
+
+namespace woj
+{
+	class invalid_slot_handle final : public exception
+	{
+	public:
+		constexpr invalid_slot_handle() noexcept : exception{ static_cast<uint64_t>(-1), "Slot handle does not refer to a live element", nullptr, nullptr } {}
+
+		constexpr invalid_slot_handle(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Slot handle does not refer to a live element", file, function } {}
+	};
+
+	/**
+	 * Handle of a slot map element, a default-constructed handle never refers to an element
+	 */
+	class slot_handle
+	{
+	public:
+		uint32_t m_index = std::numeric_limits<uint32_t>::max();
+		uint32_t m_generation = 0;
+
+		WOJ_NODISCARD constexpr bool operator==(const slot_handle& other) const noexcept = default;
+	};
+
+	namespace detail
+	{
+		/**
+		 * Sparse entry of a slot map: the dense index of a live element, or the next free slot; the generation is odd
+		 * while the slot is live and is bumped when it is taken and when it is released
+		 */
+		class slot_map_slot
+		{
+		public:
+			uint32_t m_index;
+			uint32_t m_generation;
+		};
+	}
+
+	/**
+	 * Class representing a slot map: elements are stored densely (iterating is iterating a vector) and referred to by
+	 * generational handles that survive the removal of other elements, a sparse slot table maps handles to dense
+	 * indices and is checked in O(1); erasing moves the last element into the hole (swap and pop), so the order of
+	 * the elements is not stable. Generations wrap after 2^31 reuses of a slot
+	 * @tparam ElementType Type of the elements
+	 * @tparam ValueContainer Contiguous container of ElementType (woj::vector or stack::inplace_vector)
+	 * @tparam SlotContainer Contiguous container of detail::slot_map_slot with the same capacity
+	 * @tparam IndexContainer Contiguous container of uint32_t with the same capacity (slot of each dense element)
+	 */
+	template <typename ElementType, typename ValueContainer, typename SlotContainer, typename IndexContainer>
+	class basic_slot_map
+	{
+	public:
+		using value_type = ElementType;
+		using container_type = ValueContainer;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using reference = ElementType&;
+		using const_reference = const ElementType&;
+		using iterator = ElementType*;
+		using const_iterator = const ElementType*;
+		using handle_type = slot_handle;
+
+		static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+		ValueContainer m_values;
+		IndexContainer m_value_slots;
+		SlotContainer m_slots;
+		uint32_t m_free_head = npos;
+
+		constexpr basic_slot_map() = default;
+
+		// ----- Iterators -----
+
+		WOJ_NODISCARD constexpr iterator begin() noexcept
+		{
+			return m_values.data();
+		}
+
+		WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+		{
+			return m_values.data();
+		}
+
+		WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+		{
+			return m_values.data();
+		}
+
+		WOJ_NODISCARD constexpr iterator end() noexcept
+		{
+			return m_values.data() + m_values.size();
+		}
+
+		WOJ_NODISCARD constexpr const_iterator end() const noexcept
+		{
+			return m_values.data() + m_values.size();
+		}
+
+		WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		// ----- Element access -----
+
+		/**
+		 * @return Pointer to the element or nullptr if the handle is stale
+		 */
+		WOJ_NODISCARD constexpr ElementType* get(const slot_handle handle) noexcept
+		{
+			return contains(handle) ? m_values.data() + m_slots.data()[handle.m_index].m_index : nullptr;
+		}
+
+		WOJ_NODISCARD constexpr const ElementType* get(const slot_handle handle) const noexcept
+		{
+			return contains(handle) ? m_values.data() + m_slots.data()[handle.m_index].m_index : nullptr;
+		}
+
+		/**
+		 * Accesses the element of a handle, the handle must be live
+		 */
+		constexpr ElementType& operator[](const slot_handle handle) noexcept
+#ifndef NDEBUG
+		(false)
+#endif
+		{
+#ifndef NDEBUG
+			if (!contains(handle))
+			{
+				throw invalid_slot_handle{ 143ull, "slot_map.hpp", "woj::basic_slot_map<ElementType, ValueContainer, SlotContainer, IndexContainer>::operator[]" };
+			}
+#endif
+
+			return m_values.data()[m_slots.data()[handle.m_index].m_index];
+		}
+
+		constexpr const ElementType& operator[](const slot_handle handle) const noexcept
+#ifndef NDEBUG
+		(false)
+#endif
+		{
+#ifndef NDEBUG
+			if (!contains(handle))
+			{
+				throw invalid_slot_handle{ 158ull, "slot_map.hpp", "woj::basic_slot_map<ElementType, ValueContainer, SlotContainer, IndexContainer>::operator[]" };
+			}
+#endif
+
+			return m_values.data()[m_slots.data()[handle.m_index].m_index];
+		}
+
+		/**
+		 * @throws invalid_slot_handle if the handle is stale
+		 */
+		constexpr ElementType& at(const slot_handle handle)
+		{
+			if (!contains(handle))
+			{
+				throw invalid_slot_handle{ 172ull, "slot_map.hpp", "woj::basic_slot_map<ElementType, ValueContainer, SlotContainer, IndexContainer>::at" };
+			}
+			return m_values.data()[m_slots.data()[handle.m_index].m_index];
+		}
+
+		constexpr const ElementType& at(const slot_handle handle) const
+		{
+			if (!contains(handle))
+			{
+				throw invalid_slot_handle{ 181ull, "slot_map.hpp", "woj::basic_slot_map<ElementType, ValueContainer, SlotContainer, IndexContainer>::at" };
+			}
+			return m_values.data()[m_slots.data()[handle.m_index].m_index];
+		}
+
+		/**
+		 * @return True if the handle refers to a live element
+		 */
+		WOJ_NODISCARD constexpr bool contains(const slot_handle handle) const noexcept
+		{
+			return handle.m_index < m_slots.size() && m_slots.data()[handle.m_index].m_generation == handle.m_generation && (handle.m_generation & 1) != 0;
+		}
+
+		/**
+		 * @return Handle of the element at an iterator
+		 */
+		WOJ_NODISCARD constexpr slot_handle handle_of(const const_iterator pos) const noexcept
+		{
+			const uint32_t slot = m_value_slots.data()[pos - begin()];
+			return { slot, m_slots.data()[slot].m_generation };
+		}
+
+		/**
+		 * @return The elements, densely stored in no particular order
+		 */
+		WOJ_NODISCARD constexpr const ValueContainer& values() const noexcept
+		{
+			return m_values;
+		}
+
+		WOJ_NODISCARD constexpr ElementType* data() noexcept
+		{
+			return m_values.data();
+		}
+
+		WOJ_NODISCARD constexpr const ElementType* data() const noexcept
+		{
+			return m_values.data();
+		}
+
+		// ----- Capacity -----
+
+		WOJ_NODISCARD constexpr size_type size() const noexcept
+		{
+			return m_values.size();
+		}
+
+		WOJ_NODISCARD constexpr bool empty() const noexcept
+		{
+			return m_values.size() == 0;
+		}
+
+		/**
+		 * Reserves storage for count elements (no-op for fixed-capacity containers)
+		 */
+		constexpr void reserve(const size_type count)
+		{
+			if constexpr (requires { m_values.reserve(count); })
+			{
+				m_values.reserve(count);
+				m_value_slots.reserve(count);
+				m_slots.reserve(count);
+			}
+		}
+
+		// ----- Modifiers -----
+
+		/**
+		 * Constructs an element at the end of the dense storage
+		 * @param args Arguments to construct the element with
+		 * @return Handle of the new element
+		 * @throws vector_capacity_exceeded if a fixed-capacity slot map is full
+		 */
+		template <typename... Args>
+		constexpr slot_handle emplace(Args&&... args)
+		{
+			// Every step leaves the map consistent if the next one throws
+			if (m_free_head == npos)
+			{
+				m_slots.emplace_back(detail::slot_map_slot{ npos, 0 });
+				m_free_head = static_cast<uint32_t>(m_slots.size() - 1);
+			}
+			const uint32_t slot = m_free_head;
+			m_value_slots.emplace_back(slot);
+			if constexpr (std::is_nothrow_constructible_v<ElementType, Args...>)
+			{
+				m_values.emplace_back(std::forward<Args>(args)...);
+			}
+			else
+			{
+				try
+				{
+					m_values.emplace_back(std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					m_value_slots.pop_back();
+					throw;
+				}
+			}
+
+			detail::slot_map_slot& entry = m_slots.data()[slot];
+			m_free_head = entry.m_index;
+			entry.m_index = static_cast<uint32_t>(m_values.size() - 1);
+			++entry.m_generation;
+			return { slot, entry.m_generation };
+		}
+
+		constexpr slot_handle insert(const ElementType& value)
+		{
+			return emplace(value);
+		}
+
+		constexpr slot_handle insert(ElementType&& value)
+		{
+			return emplace(std::move(value));
+		}
+
+		/**
+		 * Erases an element, the last element takes its place in the dense storage
+		 * @param handle Handle of the element
+		 * @return True if the handle was live
+		 */
+		constexpr bool erase(const slot_handle handle) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+		{
+			if (!contains(handle))
+			{
+				return false;
+			}
+			erase_dense(m_slots.data()[handle.m_index].m_index);
+			return true;
+		}
+
+		/**
+		 * Erases the element at an iterator
+		 * @return Iterator to the element moved into its place (end() if it was the last one), erasing while iterating
+		 * visits every element once
+		 */
+		constexpr iterator erase(const const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+		{
+			const size_type index = static_cast<size_type>(pos - begin());
+			erase_dense(static_cast<uint32_t>(index));
+			return begin() + index;
+		}
+
+		/**
+		 * Erases all elements, every handle becomes stale (the slots are kept for reuse)
+		 */
+		constexpr void clear() noexcept
+		{
+			for (size_type i = 0; i < m_values.size(); ++i)
+			{
+				release_slot(m_value_slots.data()[i]);
+			}
+			m_values.clear();
+			m_value_slots.clear();
+		}
+
+	private:
+		constexpr void release_slot(const uint32_t slot) noexcept
+		{
+			detail::slot_map_slot& entry = m_slots.data()[slot];
+			++entry.m_generation;
+			entry.m_index = m_free_head;
+			m_free_head = slot;
+		}
+
+		constexpr void erase_dense(const uint32_t index) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+		{
+			const uint32_t slot = m_value_slots.data()[index];
+			const uint32_t last = static_cast<uint32_t>(m_values.size() - 1);
+			if (index != last)
+			{
+				m_values.data()[index] = std::move(m_values.data()[last]);
+				const uint32_t moved = m_value_slots.data()[last];
+				m_value_slots.data()[index] = moved;
+				m_slots.data()[moved].m_index = index;
+			}
+			m_values.pop_back();
+			m_value_slots.pop_back();
+			release_slot(slot);
+		}
+	};
+
+	/**
+	 * Growable slot map
+	 */
+	template <typename ElementType>
+	using slot_map = basic_slot_map<ElementType, vector<ElementType>, vector<detail::slot_map_slot>, vector<uint32_t>>;
+
+	namespace stack
+	{
+		/**
+		 * Fixed-capacity, allocation-free slot map
+		 */
+		template <typename ElementType, size_t Capacity>
+		using slot_map = basic_slot_map<ElementType, inplace_vector<ElementType, Capacity>, inplace_vector<detail::slot_map_slot, Capacity>, inplace_vector<uint32_t, Capacity>>;
+	}
+}
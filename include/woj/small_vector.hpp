@@ -0,0 +1,206 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_SMALL_VECTOR_HPP
+#define WOJ_SMALL_VECTOR_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Class representing a growable vector storing up to InlineCapacity elements in-place (like stack::vector) and spilling
+	 * to memory obtained from an allocator beyond that, moves of a spilled vector only steal the pointer
+	 * @tparam ElementType Type of the elements
+	 * @tparam InlineCapacity Count of elements stored without allocating
+	 * @tparam Allocator Allocator providing the spilled storage (see allocator_type), reallocate() is used for trivially relocatable elements when available
+	 * @tparam GrowthFactor std::ratio the capacity is multiplied by when the vector runs out of room
+	 */
+	template <typename ElementType, size_t InlineCapacity, typename Allocator = default_allocator, typename GrowthFactor = std::ratio<3, 2>>
+	class small_vector : public detail::growable_vector_base<small_vector<ElementType, InlineCapacity, Allocator, GrowthFactor>, ElementType, Allocator, GrowthFactor, InlineCapacity>
+	{
+		using base = detail::growable_vector_base<small_vector<ElementType, InlineCapacity, Allocator, GrowthFactor>, ElementType, Allocator, GrowthFactor, InlineCapacity>;
+		friend base;
+
+	public:
+		using typename base::size_type;
+
+		static_assert(InlineCapacity > 0, "Inline capacity must be greater than 0");
+
+		union
+		{
+			alignas(ElementType) ElementType m_inline[InlineCapacity];
+		};
+
+		constexpr small_vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) : base{ m_inline, InlineCapacity } {}
+
+		explicit constexpr small_vector(const none_t) noexcept(std::is_nothrow_default_constructible_v<Allocator>) : small_vector{} {}
+
+		explicit constexpr small_vector(const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>) : base{ m_inline, InlineCapacity, allocator } {}
+
+		/**
+		 * Constructs count value-initialized elements
+		 */
+		explicit constexpr small_vector(const size_type count, const Allocator& allocator = Allocator{}) : small_vector{ allocator }
+		{
+			base::resize(count);
+		}
+
+		constexpr small_vector(const size_type count, const ElementType& value, const Allocator& allocator = Allocator{}) : small_vector{ allocator }
+		{
+			base::resize(count, value);
+		}
+
+		/**
+		 * Constructs count elements without initializing them (see resize_uninitialized)
+		 */
+		constexpr small_vector(const size_type count, const noinit_t noinit, const Allocator& allocator = Allocator{}) requires std::is_trivially_default_constructible_v<ElementType> : small_vector{ allocator }
+		{
+			base::resize_uninitialized(count, noinit);
+		}
+
+		template <size_t OtherSize>
+		explicit constexpr small_vector(const ElementType (&other)[OtherSize], const Allocator& allocator = Allocator{}) : small_vector{ allocator }
+		{
+			base::copy_construct(other, OtherSize);
+		}
+
+		constexpr small_vector(const std::initializer_list<ElementType> values, const Allocator& allocator = Allocator{}) : small_vector{ allocator }
+		{
+			base::copy_construct(values.begin(), values.size());
+		}
+
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr small_vector(const InputIterator first, const InputIterator last, const Allocator& allocator = Allocator{}) : small_vector{ allocator }
+		{
+			base::assign(first, last);
+		}
+
+		template <size_t OtherSize>
+		explicit constexpr small_vector(const stack::vector<ElementType, OtherSize>& other, const Allocator& allocator = Allocator{}) : small_vector{ allocator }
+		{
+			base::copy_construct(other.m_data, OtherSize);
+		}
+
+		constexpr small_vector(const small_vector& other) : small_vector{ other.m_allocator }
+		{
+			base::copy_construct(other.m_data, other.m_size);
+		}
+
+		/**
+		 * Steals the storage of a spilled vector, inline elements are relocated one by one
+		 */
+		constexpr small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>) : base{ m_inline, 0, InlineCapacity, std::move(other.m_allocator) }
+		{
+			take(other);
+		}
+
+		constexpr ~small_vector() noexcept
+		{
+			base::release();
+		}
+
+		constexpr small_vector& operator=(const small_vector& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			base::assign(other.m_data, other.m_data + other.m_size);
+			return *this;
+		}
+
+		constexpr small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			base::release();
+			this->m_allocator = std::move(other.m_allocator);
+			take(other);
+			return *this;
+		}
+
+		constexpr small_vector& operator=(const std::initializer_list<ElementType> values)
+		{
+			base::assign(values.begin(), values.end());
+			return *this;
+		}
+
+		/**
+		 * Checks whether the elements are stored in-place
+		 */
+		WOJ_NODISCARD constexpr bool is_inline() const noexcept
+		{
+			return this->m_data == m_inline;
+		}
+
+		static WOJ_CONSTEVAL size_type inline_capacity() noexcept
+		{
+			return InlineCapacity;
+		}
+
+		constexpr void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+		{
+			if (this == &other)
+			{
+				return;
+			}
+
+			if (!is_inline() && !other.is_inline())
+			{
+				using std::swap;
+				swap(this->m_data, other.m_data);
+				swap(this->m_size, other.m_size);
+				swap(this->m_capacity, other.m_capacity);
+				swap(this->m_allocator, other.m_allocator);
+				return;
+			}
+
+			small_vector temporary{ std::move(other) };
+			other = std::move(*this);
+			*this = std::move(temporary);
+		}
+
+		// ----- Comparison -----
+
+		template <size_t OtherInlineCapacity, typename OtherAllocator, typename OtherGrowthFactor>
+		WOJ_NODISCARD constexpr bool operator==(const small_vector<ElementType, OtherInlineCapacity, OtherAllocator, OtherGrowthFactor>& other) const noexcept
+		{
+			return this->m_size == other.m_size && std::equal(this->m_data, this->m_data + this->m_size, other.m_data);
+		}
+
+	private:
+		/**
+		 * Takes over the elements of other, this vector must be empty and in-place
+		 */
+		constexpr void take(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+		{
+			if (other.is_inline())
+			{
+				woj::uninitialized_relocate_n(other.m_inline, other.m_size, m_inline);
+				this->m_size = other.m_size;
+			}
+			else
+			{
+				this->m_data = other.m_data;
+				this->m_size = other.m_size;
+				this->m_capacity = other.m_capacity;
+				other.m_data = other.m_inline;
+				other.m_capacity = InlineCapacity;
+			}
+			other.m_size = 0;
+		}
+	};
+}
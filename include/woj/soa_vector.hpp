@@ -0,0 +1,886 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_SOA_VECTOR_HPP
+#define WOJ_SOA_VECTOR_HPP
+#endif
+
+namespace woj
+{
+	namespace detail
+	{
+		/**
+		 * Columns start on a cache line (and full AVX-512 register) boundary
+		 */
+		inline constexpr size_t soa_column_alignment = 64;
+
+		template <typename Type>
+		inline constexpr size_t soa_alignment_of = alignof(Type) > soa_column_alignment ? alignof(Type) : soa_column_alignment;
+
+		/**
+		 * Moving a column of this type to a new allocation can throw (it is neither trivially relocatable nor nothrow move constructible)
+		 */
+		template <typename Type>
+		inline constexpr bool soa_move_may_throw = !is_trivially_relocatable_v<Type> && !std::is_nothrow_move_constructible_v<Type>;
+
+		/**
+		 * Copies count rows of a column into uninitialized storage, or moves them if the type cannot be copied, the
+		 * sources stay alive
+		 */
+		template <typename Type>
+		constexpr void soa_uninitialized_move_if_noexcept(Type* const source, const size_t count, Type* const destination)
+		{
+			if constexpr (std::is_copy_constructible_v<Type>)
+			{
+				woj::uninitialized_copy_n(source, count, destination);
+			}
+			else
+			{
+				woj::uninitialized_move_n(source, count, destination);
+			}
+		}
+
+		/**
+		 * Random access iterator over the rows of a structure-of-arrays container, dereferencing yields a tuple of references
+		 */
+		template <typename Container, bool Const>
+		class soa_iterator
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using iterator_concept = std::random_access_iterator_tag;
+			using value_type = typename Container::value_type;
+			using difference_type = ptrdiff_t;
+			using reference = std::conditional_t<Const, typename Container::const_reference, typename Container::reference>;
+			using container_type = std::conditional_t<Const, const Container, Container>;
+
+			container_type* m_container;
+			size_t m_index;
+
+			constexpr soa_iterator() noexcept : m_container{ nullptr }, m_index{ 0 } {}
+
+			constexpr soa_iterator(container_type* const container, const size_t index) noexcept : m_container{ container }, m_index{ index } {}
+
+			constexpr operator soa_iterator<Container, true>() const noexcept requires (!Const)
+			{
+				return { m_container, m_index };
+			}
+
+			constexpr reference operator*() const noexcept
+			{
+				return (*m_container)[m_index];
+			}
+
+			constexpr reference operator[](const difference_type offset) const noexcept
+			{
+				return (*m_container)[m_index + offset];
+			}
+
+			constexpr soa_iterator& operator++() noexcept
+			{
+				++m_index;
+				return *this;
+			}
+
+			constexpr soa_iterator operator++(int) noexcept
+			{
+				soa_iterator copy{ *this };
+				++m_index;
+				return copy;
+			}
+
+			constexpr soa_iterator& operator--() noexcept
+			{
+				--m_index;
+				return *this;
+			}
+
+			constexpr soa_iterator operator--(int) noexcept
+			{
+				soa_iterator copy{ *this };
+				--m_index;
+				return copy;
+			}
+
+			constexpr soa_iterator& operator+=(const difference_type offset) noexcept
+			{
+				m_index += offset;
+				return *this;
+			}
+
+			constexpr soa_iterator& operator-=(const difference_type offset) noexcept
+			{
+				m_index -= offset;
+				return *this;
+			}
+
+			constexpr soa_iterator operator+(const difference_type offset) const noexcept
+			{
+				return { m_container, m_index + offset };
+			}
+
+			friend constexpr soa_iterator operator+(const difference_type offset, const soa_iterator& iterator) noexcept
+			{
+				return iterator + offset;
+			}
+
+			constexpr soa_iterator operator-(const difference_type offset) const noexcept
+			{
+				return { m_container, m_index - offset };
+			}
+
+			constexpr difference_type operator-(const soa_iterator& other) const noexcept
+			{
+				return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+			}
+
+			constexpr bool operator==(const soa_iterator& other) const noexcept
+			{
+				return m_index == other.m_index;
+			}
+
+			constexpr auto operator<=>(const soa_iterator& other) const noexcept
+			{
+				return m_index <=> other.m_index;
+			}
+		};
+
+		/**
+		 * Row and column operations shared by the fixed-capacity and the growable structure-of-arrays containers
+		 * @tparam Derived Container type, must provide column_data<Index>(), full(), reserve_for(count),
+		 * grow_emplace_back(args...) and m_size
+		 * @tparam Types Column types
+		 */
+		template <typename Derived, typename... Types>
+		class soa_base
+		{
+		public:
+			using value_type = std::tuple<Types...>;
+			using reference = std::tuple<Types&...>;
+			using const_reference = std::tuple<const Types&...>;
+			using size_type = size_t;
+			using difference_type = ptrdiff_t;
+			using iterator = soa_iterator<Derived, false>;
+			using const_iterator = soa_iterator<Derived, true>;
+
+			template <size_t Index>
+			using column_type = std::tuple_element_t<Index, value_type>;
+
+			static constexpr size_t column_count = sizeof...(Types);
+
+			static_assert(column_count > 0, "A structure of arrays needs at least one column");
+
+			// ----- Element access -----
+
+			/**
+			 * @return Row as a tuple of references into the columns
+			 */
+			WOJ_NODISCARD constexpr reference operator[](const size_type index) noexcept
+			{
+				return row(index, std::index_sequence_for<Types...>{});
+			}
+
+			WOJ_NODISCARD constexpr const_reference operator[](const size_type index) const noexcept
+			{
+				return row(index, std::index_sequence_for<Types...>{});
+			}
+
+			/**
+			 * Accesses a row with bounds checking in every build
+			 */
+			WOJ_NODISCARD constexpr reference at(const size_type index)
+			{
+				if (index >= self().m_size)
+				{
+					throw out_of_vector_range{ 207ull, "soa_vector.hpp", "woj::detail::soa_base<Derived, Types...>::at" };
+				}
+				return (*this)[index];
+			}
+
+			WOJ_NODISCARD constexpr const_reference at(const size_type index) const
+			{
+				if (index >= self().m_size)
+				{
+					throw out_of_vector_range{ 216ull, "soa_vector.hpp", "woj::detail::soa_base<Derived, Types...>::at" };
+				}
+				return (*this)[index];
+			}
+
+			/**
+			 * @return Reference to one field of a row
+			 */
+			template <size_t Index>
+			WOJ_NODISCARD constexpr column_type<Index>& get(const size_type index) noexcept
+			{
+				return self().template column_data<Index>()[index];
+			}
+
+			template <size_t Index>
+			WOJ_NODISCARD constexpr const column_type<Index>& get(const size_type index) const noexcept
+			{
+				return self().template column_data<Index>()[index];
+			}
+
+			WOJ_NODISCARD constexpr reference front() noexcept
+			{
+				return (*this)[0];
+			}
+
+			WOJ_NODISCARD constexpr const_reference front() const noexcept
+			{
+				return (*this)[0];
+			}
+
+			WOJ_NODISCARD constexpr reference back() noexcept
+			{
+				return (*this)[self().m_size - 1];
+			}
+
+			WOJ_NODISCARD constexpr const_reference back() const noexcept
+			{
+				return (*this)[self().m_size - 1];
+			}
+
+			/**
+			 * @return Contiguous view of one column (aligned to soa_column_alignment), for SIMD processing
+			 */
+			template <size_t Index>
+			WOJ_NODISCARD constexpr std::span<column_type<Index>> column() noexcept
+			{
+				return { self().template column_data<Index>(), self().m_size };
+			}
+
+			template <size_t Index>
+			WOJ_NODISCARD constexpr std::span<const column_type<Index>> column() const noexcept
+			{
+				return { self().template column_data<Index>(), self().m_size };
+			}
+
+			// ----- Iterators -----
+
+			WOJ_NODISCARD constexpr iterator begin() noexcept
+			{
+				return { &self(), 0 };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+			{
+				return { &self(), 0 };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+			{
+				return { &self(), 0 };
+			}
+
+			WOJ_NODISCARD constexpr iterator end() noexcept
+			{
+				return { &self(), self().m_size };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator end() const noexcept
+			{
+				return { &self(), self().m_size };
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+			{
+				return { &self(), self().m_size };
+			}
+
+			// ----- Capacity -----
+
+			WOJ_NODISCARD constexpr size_type size() const noexcept
+			{
+				return self().m_size;
+			}
+
+			WOJ_NODISCARD constexpr bool empty() const noexcept
+			{
+				return self().m_size == 0;
+			}
+
+			/**
+			 * Resizes the container, new rows are value-initialized
+			 */
+			constexpr void resize(const size_type count)
+			{
+				if (count > self().m_size)
+				{
+					self().reserve_for(count);
+					while (self().m_size < count)
+					{
+						emplace_back(Types{}...);
+					}
+				}
+				else
+				{
+					destroy_from(count);
+				}
+			}
+
+			// ----- Modifiers -----
+
+			/**
+			 * Appends a row, one argument per column
+			 * @return Reference to the new row
+			 */
+			template <typename... Args> requires (sizeof...(Args) == sizeof...(Types))
+			constexpr reference emplace_back(Args&&... args)
+			{
+				Derived& container = self();
+				if (container.full()) WOJ_UNLIKELY
+				{
+					return container.grow_emplace_back(std::forward<Args>(args)...);
+				}
+				construct_row(columns(std::index_sequence_for<Types...>{}), container.m_size, std::index_sequence_for<Types...>{}, std::forward<Args>(args)...);
+				return (*this)[container.m_size++];
+			}
+
+			constexpr reference push_back(const value_type& value)
+			{
+				return std::apply([this](const Types&... fields) -> reference { return emplace_back(fields...); }, value);
+			}
+
+			constexpr reference push_back(value_type&& value)
+			{
+				return std::apply([this](Types&... fields) -> reference { return emplace_back(std::move(fields)...); }, value);
+			}
+
+			/**
+			 * Destroys the last row, the container must not be empty
+			 */
+			constexpr void pop_back() noexcept
+			{
+				destroy_from(self().m_size - 1);
+			}
+
+			/**
+			 * Removes a row, later rows are shifted up
+			 */
+			constexpr void erase(const size_type index) noexcept((std::is_nothrow_move_assignable_v<Types> && ...))
+			{
+				Derived& container = self();
+				[&]<size_t... Indices>(std::index_sequence<Indices...>)
+				{
+					((std::move(container.template column_data<Indices>() + index + 1, container.template column_data<Indices>() + container.m_size, container.template column_data<Indices>() + index)), ...);
+				}(std::index_sequence_for<Types...>{});
+				destroy_from(container.m_size - 1);
+			}
+
+			/**
+			 * Removes a row by moving the last row into its place (does not keep the order)
+			 */
+			constexpr void swap_erase(const size_type index) noexcept((std::is_nothrow_move_assignable_v<Types> && ...))
+			{
+				Derived& container = self();
+				const size_type last = container.m_size - 1;
+				if (index != last)
+				{
+					[&]<size_t... Indices>(std::index_sequence<Indices...>)
+					{
+						((container.template column_data<Indices>()[index] = std::move(container.template column_data<Indices>()[last])), ...);
+					}(std::index_sequence_for<Types...>{});
+				}
+				destroy_from(last);
+			}
+
+			constexpr void clear() noexcept
+			{
+				destroy_from(0);
+			}
+
+		protected:
+			WOJ_NODISCARD constexpr Derived& self() noexcept
+			{
+				return static_cast<Derived&>(*this);
+			}
+
+			WOJ_NODISCARD constexpr const Derived& self() const noexcept
+			{
+				return static_cast<const Derived&>(*this);
+			}
+
+			template <size_t... Indices>
+			WOJ_NODISCARD constexpr reference row(const size_type index, std::index_sequence<Indices...>) noexcept
+			{
+				return reference{ self().template column_data<Indices>()[index]... };
+			}
+
+			template <size_t... Indices>
+			WOJ_NODISCARD constexpr const_reference row(const size_type index, std::index_sequence<Indices...>) const noexcept
+			{
+				return const_reference{ self().template column_data<Indices>()[index]... };
+			}
+
+			template <size_t... Indices>
+			WOJ_NODISCARD constexpr std::tuple<Types*...> columns(std::index_sequence<Indices...>) noexcept
+			{
+				return { self().template column_data<Indices>()... };
+			}
+
+			/**
+			 * Constructs a row in columns, a throw destroys the fields constructed so far
+			 */
+			template <size_t... Indices, typename... Args>
+			static constexpr void construct_row(const std::tuple<Types*...>& columns, const size_type index, std::index_sequence<Indices...>, Args&&... args)
+			{
+				if constexpr ((std::is_nothrow_constructible_v<Types, Args&&> && ...))
+				{
+					(std::construct_at(std::get<Indices>(columns) + index, std::forward<Args>(args)), ...);
+				}
+				else
+				{
+					size_t constructed = 0;
+					try
+					{
+						((std::construct_at(std::get<Indices>(columns) + index, std::forward<Args>(args)), ++constructed), ...);
+					}
+					catch (...)
+					{
+						((Indices < constructed ? std::destroy_at(std::get<Indices>(columns) + index) : void()), ...);
+						throw;
+					}
+				}
+			}
+
+			/**
+			 * Copies the rows of another container, this container must be empty with room for them
+			 */
+			template <typename Other>
+			constexpr void copy_rows(const Other& other)
+			{
+				for (size_type i = 0; i < other.m_size; ++i)
+				{
+					std::apply([this](const Types&... fields) { emplace_back(fields...); }, other[i]);
+				}
+			}
+
+			/**
+			 * Destroys the rows from index on and shrinks the size to index (no-op if index >= size)
+			 */
+			constexpr void destroy_from(const size_type index) noexcept
+			{
+				Derived& container = self();
+				if (index < container.m_size)
+				{
+					[&]<size_t... Indices>(std::index_sequence<Indices...>)
+					{
+						(std::destroy(container.template column_data<Indices>() + index, container.template column_data<Indices>() + container.m_size), ...);
+					}(std::index_sequence_for<Types...>{});
+					container.m_size = index;
+				}
+			}
+		};
+
+		template <typename Type, size_t Capacity>
+		class soa_column
+		{
+		public:
+			union
+			{
+				alignas(soa_alignment_of<Type>) Type m_data[Capacity];
+			};
+
+			constexpr soa_column() noexcept {}
+
+			constexpr soa_column(const soa_column&) noexcept {}
+
+			constexpr ~soa_column() requires std::is_trivially_destructible_v<Type> = default;
+
+			constexpr ~soa_column() noexcept {}
+		};
+	}
+
+	namespace stack
+	{
+		/**
+		 * Class representing a fixed-capacity structure of arrays: every column type is stored in its own aligned array
+		 * in-place, rows are accessed as tuples of references and columns as spans
+		 * @tparam Capacity Maximum count of rows
+		 * @tparam Types Column types
+		 */
+		template <size_t Capacity, typename... Types>
+		class soa_vector : public detail::soa_base<soa_vector<Capacity, Types...>, Types...>
+		{
+			using base = detail::soa_base<soa_vector<Capacity, Types...>, Types...>;
+			friend base;
+
+		public:
+			std::tuple<detail::soa_column<Types, Capacity>...> m_columns;
+			size_t m_size;
+
+			constexpr soa_vector() noexcept : m_columns{}, m_size{ 0 } {}
+
+			constexpr soa_vector(const soa_vector& other) : m_columns{}, m_size{ 0 }
+			{
+				base::copy_rows(other);
+			}
+
+			constexpr soa_vector(soa_vector&& other) noexcept((std::is_nothrow_move_constructible_v<Types> && ...)) : m_columns{}, m_size{ 0 }
+			{
+				for (size_t i = 0; i < other.m_size; ++i)
+				{
+					std::apply([this](Types&... fields) { base::emplace_back(std::move(fields)...); }, other[i]);
+				}
+			}
+
+			constexpr ~soa_vector() noexcept
+			{
+				base::clear();
+			}
+
+			constexpr soa_vector& operator=(const soa_vector& other)
+			{
+				if (this != &other)
+				{
+					base::clear();
+					base::copy_rows(other);
+				}
+				return *this;
+			}
+
+			constexpr soa_vector& operator=(soa_vector&& other) noexcept((std::is_nothrow_move_constructible_v<Types> && ...))
+			{
+				if (this != &other)
+				{
+					base::clear();
+					for (size_t i = 0; i < other.m_size; ++i)
+					{
+						std::apply([this](Types&... fields) { base::emplace_back(std::move(fields)...); }, other[i]);
+					}
+				}
+				return *this;
+			}
+
+			static WOJ_CONSTEVAL size_t capacity() noexcept
+			{
+				return Capacity;
+			}
+
+			WOJ_NODISCARD constexpr bool full() const noexcept
+			{
+				return m_size == Capacity;
+			}
+
+			template <size_t Index>
+			WOJ_NODISCARD constexpr auto* column_data() noexcept
+			{
+				return std::get<Index>(m_columns).m_data;
+			}
+
+			template <size_t Index>
+			WOJ_NODISCARD constexpr const auto* column_data() const noexcept
+			{
+				return std::get<Index>(m_columns).m_data;
+			}
+
+		private:
+			template <typename... Args>
+			WOJ_NORETURN constexpr typename base::reference grow_emplace_back(Args&&...) const
+			{
+				throw vector_capacity_exceeded{ 594ull, "soa_vector.hpp", "woj::stack::soa_vector<Capacity, Types...>::grow_emplace_back" };
+			}
+
+			constexpr void reserve_for(const size_t count) const
+			{
+				if (count > Capacity) WOJ_UNLIKELY
+				{
+					throw vector_capacity_exceeded{ 601ull, "soa_vector.hpp", "woj::stack::soa_vector<Capacity, Types...>::reserve_for" };
+				}
+			}
+		};
+	}
+
+	/**
+	 * Class representing a growable structure of arrays: every column type is stored in its own aligned array, all columns
+	 * share one allocation, rows are accessed as tuples of references and columns as spans
+	 * @tparam Allocator Allocator providing the storage (see allocator_type)
+	 * @tparam Types Column types
+	 */
+	template <typename Allocator, typename... Types>
+	class basic_soa_vector : public detail::soa_base<basic_soa_vector<Allocator, Types...>, Types...>
+	{
+		using base = detail::soa_base<basic_soa_vector<Allocator, Types...>, Types...>;
+		friend base;
+
+	public:
+		static_assert(woj::allocator_type<Allocator>, "Allocator must provide allocate(size, alignment) and noexcept deallocate(ptr, size, alignment)");
+
+		static constexpr size_t alignment = (std::max)({ detail::soa_alignment_of<Types>... });
+
+		std::tuple<Types*...> m_columns;
+		size_t m_size;
+		size_t m_capacity;
+		WOJ_NO_UNIQUE_ADDRESS Allocator m_allocator;
+
+		constexpr basic_soa_vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) : m_columns{}, m_size{ 0 }, m_capacity{ 0 }, m_allocator{} {}
+
+		explicit constexpr basic_soa_vector(const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>) : m_columns{}, m_size{ 0 }, m_capacity{ 0 }, m_allocator{ allocator } {}
+
+		constexpr basic_soa_vector(const basic_soa_vector& other) : basic_soa_vector{ other.m_allocator }
+		{
+			reserve(other.m_size);
+			base::copy_rows(other);
+		}
+
+		constexpr basic_soa_vector(basic_soa_vector&& other) noexcept : m_columns{ other.m_columns }, m_size{ other.m_size }, m_capacity{ other.m_capacity }, m_allocator{ std::move(other.m_allocator) }
+		{
+			other.m_columns = {};
+			other.m_size = 0;
+			other.m_capacity = 0;
+		}
+
+		constexpr ~basic_soa_vector() noexcept
+		{
+			release();
+		}
+
+		constexpr basic_soa_vector& operator=(const basic_soa_vector& other)
+		{
+			if (this != &other)
+			{
+				base::clear();
+				reserve(other.m_size);
+				base::copy_rows(other);
+			}
+			return *this;
+		}
+
+		constexpr basic_soa_vector& operator=(basic_soa_vector&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release();
+				m_columns = other.m_columns;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				m_allocator = std::move(other.m_allocator);
+				other.m_columns = {};
+				other.m_size = 0;
+				other.m_capacity = 0;
+			}
+			return *this;
+		}
+
+		WOJ_NODISCARD constexpr size_t capacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		/**
+		 * Makes room for at least count rows without further allocations
+		 */
+		constexpr void reserve(const size_t count)
+		{
+			if (count > m_capacity)
+			{
+				reallocate(count);
+			}
+		}
+
+		constexpr void shrink_to_fit()
+		{
+			if (m_size == 0)
+			{
+				release();
+			}
+			else if (m_capacity > m_size)
+			{
+				reallocate(m_size);
+			}
+		}
+
+		template <size_t Index>
+		WOJ_NODISCARD constexpr auto* column_data() noexcept
+		{
+			return std::get<Index>(m_columns);
+		}
+
+		template <size_t Index>
+		WOJ_NODISCARD constexpr const auto* column_data() const noexcept
+		{
+			return std::get<Index>(m_columns);
+		}
+
+	private:
+		/**
+		 * Byte offset of every column in an allocation of capacity rows (each rounded up to the alignment of its own
+		 * column), the last entry is the total size
+		 */
+		WOJ_NODISCARD static constexpr std::array<size_t, sizeof...(Types) + 1> layout(const size_t capacity) noexcept
+		{
+			std::array<size_t, sizeof...(Types) + 1> offsets{};
+			size_t offset = 0;
+			size_t index = 0;
+			((offset = (offset + detail::soa_alignment_of<Types> - 1) / detail::soa_alignment_of<Types> * detail::soa_alignment_of<Types>, offsets[index++] = offset, offset += capacity * sizeof(Types)), ...);
+			offsets[index] = offset;
+			return offsets;
+		}
+
+		WOJ_NODISCARD constexpr bool full() const noexcept
+		{
+			return m_size == m_capacity;
+		}
+
+		WOJ_NODISCARD constexpr size_t grown_capacity(const size_t count) const noexcept
+		{
+			const size_t grown = m_capacity + m_capacity / 2;
+			return grown < count ? (count < 8 ? 8 : count) : grown;
+		}
+
+		constexpr void reserve_for(const size_t count)
+		{
+			if (count > m_capacity)
+			{
+				reallocate(grown_capacity(count));
+			}
+		}
+
+		/**
+		 * Appends a row to a full container, the row is constructed in the new allocation before the old rows are moved
+		 * so arguments referring to them stay valid
+		 */
+		template <typename... Args>
+		constexpr typename base::reference grow_emplace_back(Args&&... args)
+		{
+			const size_t capacity = grown_capacity(m_size + 1);
+			const std::tuple<Types*...> columns = allocate_columns(capacity);
+			try
+			{
+				base::construct_row(columns, m_size, std::index_sequence_for<Types...>{}, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				deallocate(columns, capacity);
+				throw;
+			}
+
+			move_rows(columns, capacity, 1);
+			return (*this)[m_size++];
+		}
+
+		/**
+		 * Moves the rows to an allocation of exactly capacity rows (capacity must be at least the size); if a row throws
+		 * while moving, the new allocation is freed and the container is left as it was
+		 */
+		constexpr void reallocate(const size_t capacity)
+		{
+			move_rows(allocate_columns(capacity), capacity, 0);
+		}
+
+		/**
+		 * Moves the rows into new columns and adopts them
+		 * @param columns Columns allocated for capacity rows
+		 * @param capacity Capacity of the new columns
+		 * @param new_rows Count of rows already constructed after the current size in the new columns (destroyed with
+		 * them if moving throws)
+		 */
+		constexpr void move_rows(const std::tuple<Types*...>& columns, const size_t capacity, const size_t new_rows)
+		{
+			// Columns that may throw are copied (moved if they cannot be copied) first while the old rows stay in place,
+			// nothing has been relocated yet if one of them throws
+			[&]<size_t... Indices>(std::index_sequence<Indices...>)
+			{
+				size_t moved = 0;
+				try
+				{
+					((detail::soa_move_may_throw<Types> ? detail::soa_uninitialized_move_if_noexcept(std::get<Indices>(m_columns), m_size, std::get<Indices>(columns)) : void(), ++moved), ...);
+				}
+				catch (...)
+				{
+					((Indices < moved && detail::soa_move_may_throw<Types> ? void(std::destroy_n(std::get<Indices>(columns), m_size)) : void()), ...);
+					(std::destroy_n(std::get<Indices>(columns) + m_size, new_rows), ...);
+					deallocate(columns, capacity);
+					throw;
+				}
+
+				((detail::soa_move_may_throw<Types> ? void(std::destroy_n(std::get<Indices>(m_columns), m_size)) : woj::uninitialized_relocate_n(std::get<Indices>(m_columns), m_size, std::get<Indices>(columns))), ...);
+			}(std::index_sequence_for<Types...>{});
+
+			deallocate(m_columns, m_capacity);
+			m_columns = columns;
+			m_capacity = capacity;
+		}
+
+		/**
+		 * Allocates uninitialized columns for capacity rows
+		 */
+		WOJ_NODISCARD constexpr std::tuple<Types*...> allocate_columns(const size_t capacity)
+		{
+			std::tuple<Types*...> columns;
+			if (is_constant_evaluated())
+			{
+				[&]<size_t... Indices>(std::index_sequence<Indices...>)
+				{
+					size_t allocated = 0;
+					try
+					{
+						((std::get<Indices>(columns) = std::allocator<Types>{}.allocate(capacity), ++allocated), ...);
+					}
+					catch (...)
+					{
+						((Indices < allocated ? std::allocator<Types>{}.deallocate(std::get<Indices>(columns), capacity) : void()), ...);
+						throw;
+					}
+				}(std::index_sequence_for<Types...>{});
+			}
+			else
+			{
+				const std::array<size_t, sizeof...(Types) + 1> offsets = layout(capacity);
+				std::byte* const block = static_cast<std::byte*>(m_allocator.allocate(offsets.back(), alignment));
+				[&]<size_t... Indices>(std::index_sequence<Indices...>)
+				{
+					((std::get<Indices>(columns) = reinterpret_cast<Types*>(block + offsets[Indices])), ...);
+				}(std::index_sequence_for<Types...>{});
+			}
+			return columns;
+		}
+
+		/**
+		 * Frees columns allocated for capacity rows (their rows must already be destroyed or relocated)
+		 */
+		constexpr void deallocate(const std::tuple<Types*...>& columns, const size_t capacity) noexcept
+		{
+			if (capacity == 0)
+			{
+				return;
+			}
+
+			if (is_constant_evaluated())
+			{
+				[&]<size_t... Indices>(std::index_sequence<Indices...>)
+				{
+					(std::allocator<Types>{}.deallocate(std::get<Indices>(columns), capacity), ...);
+				}(std::index_sequence_for<Types...>{});
+			}
+			else
+			{
+				m_allocator.deallocate(std::get<0>(columns), layout(capacity).back(), alignment);
+			}
+		}
+
+		constexpr void release() noexcept
+		{
+			base::clear();
+			deallocate(m_columns, m_capacity);
+			m_columns = {};
+			m_capacity = 0;
+		}
+	};
+
+	template <typename... Types>
+	using soa_vector = basic_soa_vector<default_allocator, Types...>;
+}
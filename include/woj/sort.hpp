@@ -0,0 +1,623 @@
+#pragma once
+
+#include "base.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_SORT_HPP
+#define WOJ_SORT_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Largest compile-time size sorted with a sorting network instead of pattern-defeating quicksort
+	 */
+	inline constexpr size_t sorting_network_limit = 32;
+
+	namespace detail
+	{
+		/**
+		 * Partitions smaller than this are finished with insertion sort
+		 */
+		inline constexpr ptrdiff_t insertion_sort_threshold = 24;
+
+		/**
+		 * Partitions bigger than this pick their pivot with Tukey's ninther instead of a median of 3
+		 */
+		inline constexpr ptrdiff_t ninther_threshold = 128;
+
+		/**
+		 * Partial insertion sort gives up after moving elements this many positions in total
+		 */
+		inline constexpr ptrdiff_t partial_insertion_sort_limit = 8;
+
+		class sorting_comparator
+		{
+		public:
+			uint8_t m_low;
+			uint8_t m_high;
+		};
+
+		/**
+		 * Largest size with a tabulated best known sorting network
+		 */
+		inline constexpr size_t best_sorting_network_limit = 16;
+
+		/**
+		 * Best known (fewest comparators) sorting networks for 2 to 16 elements, proven optimal up to 12 elements;
+		 * 14 and 15 elements are the 16 element network without the comparators of the unused top inputs
+		 */
+		inline constexpr sorting_comparator best_sorting_networks[] =
+		{
+			// 2 elements: 1 comparator in 1 layer
+			{ 0, 1 },
+			// 3 elements: 3 comparators in 3 layers
+			{ 0, 2 },
+			{ 0, 1 },
+			{ 1, 2 },
+			// 4 elements: 5 comparators in 3 layers
+			{ 0, 2 }, { 1, 3 },
+			{ 0, 1 }, { 2, 3 },
+			{ 1, 2 },
+			// 5 elements: 9 comparators in 5 layers
+			{ 0, 3 }, { 1, 4 },
+			{ 0, 2 }, { 1, 3 },
+			{ 0, 1 }, { 2, 4 },
+			{ 1, 2 }, { 3, 4 },
+			{ 2, 3 },
+			// 6 elements: 12 comparators in 5 layers
+			{ 0, 5 }, { 1, 3 }, { 2, 4 },
+			{ 1, 2 }, { 3, 4 },
+			{ 0, 3 }, { 2, 5 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 },
+			{ 1, 2 }, { 3, 4 },
+			// 7 elements: 16 comparators in 6 layers
+			{ 0, 6 }, { 2, 3 }, { 4, 5 },
+			{ 0, 2 }, { 1, 4 }, { 3, 6 },
+			{ 0, 1 }, { 2, 5 }, { 3, 4 },
+			{ 1, 2 }, { 4, 6 },
+			{ 2, 3 }, { 4, 5 },
+			{ 1, 2 }, { 3, 4 }, { 5, 6 },
+			// 8 elements: 19 comparators in 6 layers
+			{ 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+			{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+			{ 2, 4 }, { 3, 5 },
+			{ 1, 4 }, { 3, 6 },
+			{ 1, 2 }, { 3, 4 }, { 5, 6 },
+			// 9 elements: 25 comparators in 7 layers
+			{ 0, 3 }, { 1, 7 }, { 2, 5 }, { 4, 8 },
+			{ 0, 7 }, { 2, 4 }, { 3, 8 }, { 5, 6 },
+			{ 0, 2 }, { 1, 3 }, { 4, 5 }, { 7, 8 },
+			{ 1, 4 }, { 3, 6 }, { 5, 7 },
+			{ 0, 1 }, { 2, 4 }, { 3, 5 }, { 6, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 },
+			{ 1, 2 }, { 3, 4 }, { 5, 6 },
+			// 10 elements: 29 comparators in 8 layers
+			{ 0, 8 }, { 1, 9 }, { 2, 7 }, { 3, 5 }, { 4, 6 },
+			{ 0, 2 }, { 1, 4 }, { 5, 8 }, { 7, 9 },
+			{ 0, 3 }, { 2, 4 }, { 5, 7 }, { 6, 9 },
+			{ 0, 1 }, { 3, 6 }, { 8, 9 },
+			{ 1, 5 }, { 2, 3 }, { 4, 8 }, { 6, 7 },
+			{ 1, 2 }, { 3, 5 }, { 4, 6 }, { 7, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 },
+			{ 3, 4 }, { 5, 6 },
+			// 11 elements: 35 comparators in 8 layers
+			{ 0, 9 }, { 1, 6 }, { 2, 4 }, { 3, 7 }, { 5, 8 },
+			{ 0, 1 }, { 3, 5 }, { 4, 10 }, { 6, 9 }, { 7, 8 },
+			{ 1, 3 }, { 2, 5 }, { 4, 7 }, { 8, 10 },
+			{ 0, 4 }, { 1, 2 }, { 3, 7 }, { 5, 9 }, { 6, 8 },
+			{ 0, 1 }, { 2, 6 }, { 4, 5 }, { 7, 8 }, { 9, 10 },
+			{ 2, 4 }, { 3, 6 }, { 5, 7 }, { 8, 9 },
+			{ 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 },
+			// 12 elements: 39 comparators in 9 layers
+			{ 0, 8 }, { 1, 7 }, { 2, 6 }, { 3, 11 }, { 4, 10 }, { 5, 9 },
+			{ 0, 1 }, { 2, 5 }, { 3, 4 }, { 6, 9 }, { 7, 8 }, { 10, 11 },
+			{ 0, 2 }, { 1, 6 }, { 5, 10 }, { 9, 11 },
+			{ 0, 3 }, { 1, 2 }, { 4, 6 }, { 5, 7 }, { 8, 11 }, { 9, 10 },
+			{ 1, 4 }, { 3, 5 }, { 6, 8 }, { 7, 10 },
+			{ 1, 3 }, { 2, 5 }, { 6, 9 }, { 8, 10 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 },
+			{ 4, 6 }, { 5, 7 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 },
+			// 13 elements: 45 comparators in 10 layers
+			{ 0, 12 }, { 1, 10 }, { 2, 9 }, { 3, 7 }, { 5, 11 }, { 6, 8 },
+			{ 1, 6 }, { 2, 3 }, { 4, 11 }, { 7, 9 }, { 8, 10 },
+			{ 0, 4 }, { 1, 2 }, { 3, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+			{ 4, 6 }, { 5, 9 }, { 8, 11 }, { 10, 12 },
+			{ 0, 5 }, { 3, 8 }, { 4, 7 }, { 6, 11 }, { 9, 10 },
+			{ 0, 1 }, { 2, 5 }, { 6, 9 }, { 7, 8 }, { 10, 11 },
+			{ 1, 3 }, { 2, 4 }, { 5, 6 }, { 9, 10 },
+			{ 1, 2 }, { 3, 4 }, { 5, 7 }, { 6, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 },
+			{ 3, 4 }, { 5, 6 },
+			// 14 elements: 51 comparators in 10 layers
+			{ 0, 13 }, { 1, 12 }, { 4, 8 }, { 5, 6 }, { 7, 11 }, { 9, 10 },
+			{ 0, 5 }, { 1, 7 }, { 2, 9 }, { 3, 4 }, { 6, 13 }, { 11, 12 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 8 }, { 7, 9 }, { 10, 11 }, { 12, 13 },
+			{ 0, 2 }, { 1, 3 }, { 4, 10 }, { 5, 11 }, { 6, 7 }, { 8, 9 },
+			{ 1, 2 }, { 3, 12 }, { 4, 6 }, { 5, 7 }, { 8, 10 }, { 9, 11 },
+			{ 1, 4 }, { 2, 6 }, { 5, 8 }, { 7, 10 }, { 9, 13 },
+			{ 2, 4 }, { 3, 6 }, { 9, 12 }, { 11, 13 },
+			{ 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+			{ 6, 7 }, { 8, 9 },
+			// 15 elements: 56 comparators in 10 layers
+			{ 0, 13 }, { 1, 12 }, { 3, 14 }, { 4, 8 }, { 5, 6 }, { 7, 11 }, { 9, 10 },
+			{ 0, 5 }, { 1, 7 }, { 2, 9 }, { 3, 4 }, { 6, 13 }, { 8, 14 }, { 11, 12 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 8 }, { 7, 9 }, { 10, 11 }, { 12, 13 },
+			{ 0, 2 }, { 1, 3 }, { 4, 10 }, { 5, 11 }, { 6, 7 }, { 8, 9 }, { 12, 14 },
+			{ 1, 2 }, { 3, 12 }, { 4, 6 }, { 5, 7 }, { 8, 10 }, { 9, 11 }, { 13, 14 },
+			{ 1, 4 }, { 2, 6 }, { 5, 8 }, { 7, 10 }, { 9, 13 }, { 11, 14 },
+			{ 2, 4 }, { 3, 6 }, { 9, 12 }, { 11, 13 },
+			{ 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+			{ 6, 7 }, { 8, 9 },
+			// 16 elements: 60 comparators in 10 layers
+			{ 0, 13 }, { 1, 12 }, { 2, 15 }, { 3, 14 }, { 4, 8 }, { 5, 6 }, { 7, 11 }, { 9, 10 },
+			{ 0, 5 }, { 1, 7 }, { 2, 9 }, { 3, 4 }, { 6, 13 }, { 8, 14 }, { 10, 15 }, { 11, 12 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 8 }, { 7, 9 }, { 10, 11 }, { 12, 13 }, { 14, 15 },
+			{ 0, 2 }, { 1, 3 }, { 4, 10 }, { 5, 11 }, { 6, 7 }, { 8, 9 }, { 12, 14 }, { 13, 15 },
+			{ 1, 2 }, { 3, 12 }, { 4, 6 }, { 5, 7 }, { 8, 10 }, { 9, 11 }, { 13, 14 },
+			{ 1, 4 }, { 2, 6 }, { 5, 8 }, { 7, 10 }, { 9, 13 }, { 11, 14 },
+			{ 2, 4 }, { 3, 6 }, { 9, 12 }, { 11, 13 },
+			{ 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+			{ 6, 7 }, { 8, 9 }
+		};
+
+		/**
+		 * The network for n elements is best_sorting_networks[best_sorting_network_offsets[n], best_sorting_network_offsets[n + 1])
+		 */
+		inline constexpr uint16_t best_sorting_network_offsets[best_sorting_network_limit + 2] = { 0, 0, 0, 1, 4, 9, 18, 30, 46, 65, 90, 119, 154, 193, 238, 289, 345, 405 };
+
+		/**
+		 * Visits the comparators of a sorting network for size elements: the best known network up to 16 elements,
+		 * Batcher's odd-even merge sort network above, which is not optimal (191 comparators for 32 elements where
+		 * 185 are known to suffice)
+		 */
+		template <typename Function>
+		constexpr void visit_sorting_network(const size_t size, Function&& function)
+		{
+			if (size <= best_sorting_network_limit)
+			{
+				for (size_t i = best_sorting_network_offsets[size]; i < best_sorting_network_offsets[size + 1]; ++i)
+				{
+					function(size_t{ best_sorting_networks[i].m_low }, size_t{ best_sorting_networks[i].m_high });
+				}
+				return;
+			}
+
+			for (size_t p = 1; p < size; p *= 2)
+			{
+				for (size_t k = p; k > 0; k /= 2)
+				{
+					for (size_t j = k % p; j + k < size; j += 2 * k)
+					{
+						for (size_t i = 0; i < k && i + j + k < size; ++i)
+						{
+							if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+							{
+								function(i + j, i + j + k);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		template <size_t Size>
+		WOJ_NODISCARD WOJ_CONSTEVAL size_t sorting_network_size()
+		{
+			size_t count = 0;
+			visit_sorting_network(Size, [&count](size_t, size_t) { ++count; });
+			return count;
+		}
+
+		template <size_t Size>
+		WOJ_NODISCARD WOJ_CONSTEVAL std::array<sorting_comparator, sorting_network_size<Size>()> make_sorting_network()
+		{
+			std::array<sorting_comparator, sorting_network_size<Size>()> network{};
+			size_t index = 0;
+			visit_sorting_network(Size, [&](const size_t low, const size_t high)
+			{
+				network[index++] = { static_cast<uint8_t>(low), static_cast<uint8_t>(high) };
+			});
+			return network;
+		}
+
+		template <size_t Size>
+		inline constexpr auto sorting_network = make_sorting_network<Size>();
+
+		template <typename Compare, typename Type>
+		inline constexpr bool is_natural_less = std::is_arithmetic_v<Type> && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Type>>);
+
+		/**
+		 * Orders two elements without a branch: arithmetic types become min/max instructions, small trivially
+		 * copyable types conditional moves, other types fall back to a conditional swap
+		 */
+		template <typename Type, typename Compare>
+		WOJ_ALWAYS_INLINE constexpr void compare_exchange(Type& low, Type& high, Compare& compare)
+		{
+			if constexpr (is_natural_less<Compare, Type>)
+			{
+				const Type minimum = high < low ? high : low;
+				const Type maximum = high < low ? low : high;
+				low = minimum;
+				high = maximum;
+			}
+			else if constexpr (std::is_trivially_copyable_v<Type> && sizeof(Type) <= 2 * sizeof(void*))
+			{
+				const bool swap = compare(high, low);
+				const Type minimum = swap ? high : low;
+				const Type maximum = swap ? low : high;
+				low = minimum;
+				high = maximum;
+			}
+			else
+			{
+				if (compare(high, low))
+				{
+					std::ranges::swap(low, high);
+				}
+			}
+		}
+
+		template <size_t Size, typename Type, typename Compare, size_t... Indices>
+		WOJ_ALWAYS_INLINE constexpr void apply_sorting_network(Type* const data, Compare& compare, std::index_sequence<Indices...>)
+		{
+			(compare_exchange(data[sorting_network<Size>[Indices].m_low], data[sorting_network<Size>[Indices].m_high], compare), ...);
+		}
+
+		template <typename Iterator, typename Compare>
+		constexpr void sort3(const Iterator first, const Iterator second, const Iterator third, Compare& compare)
+		{
+			if (compare(*second, *first))
+			{
+				std::iter_swap(first, second);
+			}
+			if (compare(*third, *second))
+			{
+				std::iter_swap(second, third);
+				if (compare(*second, *first))
+				{
+					std::iter_swap(first, second);
+				}
+			}
+		}
+
+		template <typename Iterator, typename Compare>
+		constexpr void insertion_sort(const Iterator first, const Iterator last, Compare& compare)
+		{
+			using value_type = std::iter_value_t<Iterator>;
+
+			if (first == last)
+			{
+				return;
+			}
+
+			for (Iterator current = first + 1; current != last; ++current)
+			{
+				Iterator sift = current;
+				Iterator previous = current - 1;
+				if (compare(*sift, *previous))
+				{
+					value_type value = std::move(*sift);
+					do
+					{
+						*sift-- = std::move(*previous);
+					}
+					while (sift != first && compare(value, *--previous));
+					*sift = std::move(value);
+				}
+			}
+		}
+
+		/**
+		 * Insertion sort relying on the element before first being ordered before every element of the range
+		 */
+		template <typename Iterator, typename Compare>
+		constexpr void unguarded_insertion_sort(const Iterator first, const Iterator last, Compare& compare)
+		{
+			using value_type = std::iter_value_t<Iterator>;
+
+			if (first == last)
+			{
+				return;
+			}
+
+			for (Iterator current = first + 1; current != last; ++current)
+			{
+				Iterator sift = current;
+				Iterator previous = current - 1;
+				if (compare(*sift, *previous))
+				{
+					value_type value = std::move(*sift);
+					do
+					{
+						*sift-- = std::move(*previous);
+					}
+					while (compare(value, *--previous));
+					*sift = std::move(value);
+				}
+			}
+		}
+
+		/**
+		 * Insertion sort that gives up once the range turns out not to be nearly sorted
+		 * @return Whether the range is sorted
+		 */
+		template <typename Iterator, typename Compare>
+		constexpr bool partial_insertion_sort(const Iterator first, const Iterator last, Compare& compare)
+		{
+			using value_type = std::iter_value_t<Iterator>;
+
+			if (first == last)
+			{
+				return true;
+			}
+
+			ptrdiff_t moves = 0;
+			for (Iterator current = first + 1; current != last; ++current)
+			{
+				Iterator sift = current;
+				Iterator previous = current - 1;
+				if (compare(*sift, *previous))
+				{
+					value_type value = std::move(*sift);
+					do
+					{
+						*sift-- = std::move(*previous);
+					}
+					while (sift != first && compare(value, *--previous));
+					*sift = std::move(value);
+
+					moves += current - sift;
+					if (moves > partial_insertion_sort_limit)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * Partitions around the pivot at first, elements equal to the pivot go to the right
+		 * @return Position of the pivot and whether the range was already partitioned
+		 */
+		template <typename Iterator, typename Compare>
+		constexpr std::pair<Iterator, bool> partition_right(const Iterator begin, const Iterator end, Compare& compare)
+		{
+			using value_type = std::iter_value_t<Iterator>;
+
+			value_type pivot = std::move(*begin);
+			Iterator first = begin;
+			Iterator last = end;
+
+			while (compare(*++first, pivot));
+
+			if (first - 1 == begin)
+			{
+				while (first < last && !compare(*--last, pivot));
+			}
+			else
+			{
+				while (!compare(*--last, pivot));
+			}
+
+			const bool already_partitioned = first >= last;
+			while (first < last)
+			{
+				std::iter_swap(first, last);
+				while (compare(*++first, pivot));
+				while (!compare(*--last, pivot));
+			}
+
+			const Iterator pivot_position = first - 1;
+			*begin = std::move(*pivot_position);
+			*pivot_position = std::move(pivot);
+			return { pivot_position, already_partitioned };
+		}
+
+		/**
+		 * Partitions around the pivot at first, elements equal to the pivot go to the left (used when the pivot
+		 * equals the element before the range, all those elements are then in their final place)
+		 * @return Position of the pivot
+		 */
+		template <typename Iterator, typename Compare>
+		constexpr Iterator partition_left(const Iterator begin, const Iterator end, Compare& compare)
+		{
+			using value_type = std::iter_value_t<Iterator>;
+
+			value_type pivot = std::move(*begin);
+			Iterator first = begin;
+			Iterator last = end;
+
+			while (compare(pivot, *--last));
+
+			if (last + 1 == end)
+			{
+				while (first < last && !compare(pivot, *++first));
+			}
+			else
+			{
+				while (!compare(pivot, *++first));
+			}
+
+			while (first < last)
+			{
+				std::iter_swap(first, last);
+				while (compare(pivot, *--last));
+				while (!compare(pivot, *++first));
+			}
+
+			*begin = std::move(*last);
+			*last = std::move(pivot);
+			return last;
+		}
+
+		/**
+		 * Pattern-defeating quicksort: introsort that detects already partitioned ranges, handles runs of equal
+		 * elements in linear time and breaks up patterns causing unbalanced partitions before falling back to heapsort
+		 * @param bad_allowed Count of highly unbalanced partitions tolerated before switching to heapsort
+		 * @param leftmost Whether the range is the leftmost one (otherwise the element before it is a lower bound)
+		 */
+		template <typename Iterator, typename Compare>
+		constexpr void pdqsort_loop(Iterator begin, const Iterator end, Compare& compare, int bad_allowed, bool leftmost)
+		{
+			for (;;)
+			{
+				const ptrdiff_t size = end - begin;
+				if (size < insertion_sort_threshold)
+				{
+					if (leftmost)
+					{
+						insertion_sort(begin, end, compare);
+					}
+					else
+					{
+						unguarded_insertion_sort(begin, end, compare);
+					}
+					return;
+				}
+
+				// Moves the pivot to begin
+				const ptrdiff_t half = size / 2;
+				if (size > ninther_threshold)
+				{
+					sort3(begin, begin + half, end - 1, compare);
+					sort3(begin + 1, begin + (half - 1), end - 2, compare);
+					sort3(begin + 2, begin + (half + 1), end - 3, compare);
+					sort3(begin + (half - 1), begin + half, begin + (half + 1), compare);
+					std::iter_swap(begin, begin + half);
+				}
+				else
+				{
+					sort3(begin + half, begin, end - 1, compare);
+				}
+
+				if (!leftmost && !compare(*(begin - 1), *begin))
+				{
+					begin = partition_left(begin, end, compare) + 1;
+					continue;
+				}
+
+				const auto [pivot_position, already_partitioned] = partition_right(begin, end, compare);
+				const ptrdiff_t left_size = pivot_position - begin;
+				const ptrdiff_t right_size = end - (pivot_position + 1);
+
+				if (left_size < size / 8 || right_size < size / 8)
+				{
+					if (--bad_allowed == 0)
+					{
+						std::make_heap(begin, end, compare);
+						std::sort_heap(begin, end, compare);
+						return;
+					}
+
+					if (left_size >= insertion_sort_threshold)
+					{
+						std::iter_swap(begin, begin + left_size / 4);
+						std::iter_swap(pivot_position - 1, pivot_position - left_size / 4);
+						if (left_size > ninther_threshold)
+						{
+							std::iter_swap(begin + 1, begin + (left_size / 4 + 1));
+							std::iter_swap(begin + 2, begin + (left_size / 4 + 2));
+							std::iter_swap(pivot_position - 2, pivot_position - (left_size / 4 + 1));
+							std::iter_swap(pivot_position - 3, pivot_position - (left_size / 4 + 2));
+						}
+					}
+
+					if (right_size >= insertion_sort_threshold)
+					{
+						std::iter_swap(pivot_position + 1, pivot_position + (1 + right_size / 4));
+						std::iter_swap(end - 1, end - right_size / 4);
+						if (right_size > ninther_threshold)
+						{
+							std::iter_swap(pivot_position + 2, pivot_position + (2 + right_size / 4));
+							std::iter_swap(pivot_position + 3, pivot_position + (3 + right_size / 4));
+							std::iter_swap(end - 2, end - (1 + right_size / 4));
+							std::iter_swap(end - 3, end - (2 + right_size / 4));
+						}
+					}
+				}
+				else if (already_partitioned && partial_insertion_sort(begin, pivot_position, compare) && partial_insertion_sort(pivot_position + 1, end, compare))
+				{
+					return;
+				}
+
+				pdqsort_loop(begin, pivot_position, compare, bad_allowed, leftmost);
+				begin = pivot_position + 1;
+				leftmost = false;
+			}
+		}
+	}
+
+	/**
+	 * Sorts Size elements with a fully unrolled sorting network (branchless compare-exchanges)
+	 * @tparam Size Count of elements (at most 256)
+	 * @param data Elements to sort
+	 * @param compare Strict weak ordering
+	 */
+	template <size_t Size, typename Type, typename Compare = std::less<>>
+	constexpr void sort_network(Type* const data, Compare compare = Compare{})
+	{
+		static_assert(Size <= 256, "Sorting networks are limited to 256 elements");
+
+		detail::apply_sorting_network<Size>(data, compare, std::make_index_sequence<detail::sorting_network<Size>.size()>{});
+	}
+
+	/**
+	 * Sorts a range with pattern-defeating quicksort (not stable), usable during constant evaluation
+	 * @param first First element
+	 * @param last Past the last element
+	 * @param compare Strict weak ordering
+	 */
+	template <std::random_access_iterator Iterator, typename Compare = std::less<>>
+	constexpr void sort(const Iterator first, const Iterator last, Compare compare = Compare{})
+	{
+		const ptrdiff_t size = last - first;
+		if (size < 2)
+		{
+			return;
+		}
+
+		detail::pdqsort_loop(first, last, compare, std::bit_width(static_cast<size_t>(size)), true);
+	}
+
+	template <std::ranges::random_access_range Range, typename Compare = std::less<>> requires std::ranges::common_range<Range>
+	constexpr void sort(Range&& range, Compare compare = Compare{})
+	{
+		woj::sort(std::ranges::begin(range), std::ranges::end(range), compare);
+	}
+
+	/**
+	 * Sorts a stack vector, sizes up to sorting_network_limit use a sorting network, bigger ones pattern-defeating quicksort
+	 * @param values Vector to sort
+	 * @param compare Strict weak ordering
+	 */
+	template <typename ElementType, size_t Size, typename Compare = std::less<>>
+	constexpr void sort(stack::vector<ElementType, Size>& values, Compare compare = Compare{})
+	{
+		if constexpr (Size <= sorting_network_limit)
+		{
+			woj::sort_network<Size>(values.data(), compare);
+		}
+		else
+		{
+			woj::sort(values.data() + 0, values.data() + Size, compare);
+		}
+	}
+}
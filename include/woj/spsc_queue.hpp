@@ -0,0 +1,290 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifndef WOJ_SPSC_QUEUE_HPP
+#define WOJ_SPSC_QUEUE_HPP
+#endif
+
+namespace woj
+{
+	namespace stack
+	{
+		/**
+		 * Class representing a bounded lock-free single-producer/single-consumer FIFO queue, elements are stored in-place
+		 * and constructed lazily, the producer and the consumer each own a cache line with their index and a cached copy
+		 * of the other side's index, so the shared indices are only read when the cached copy says the queue is full/empty
+		 * @tparam ElementType Type of the elements
+		 * @tparam Capacity Maximum count of elements (a power of two turns the index wrapping into a mask)
+		 */
+		template <typename ElementType, size_t Capacity>
+		class spsc_queue
+		{
+		public:
+			using value_type = ElementType;
+			using size_type = size_t;
+
+			static_assert(Capacity > 0, "Capacity must be greater than 0");
+
+			// Producer side
+			alignas(cache_line_size) std::atomic<size_type> m_tail;
+			size_type m_head_cache;
+
+			// Consumer side
+			alignas(cache_line_size) std::atomic<size_type> m_head;
+			size_type m_tail_cache;
+
+			union
+			{
+				alignas(cache_line_size) ElementType m_data[Capacity];
+			};
+
+			spsc_queue() noexcept : m_tail{ 0 }, m_head_cache{ 0 }, m_head{ 0 }, m_tail_cache{ 0 } {}
+
+			/**
+			 * Constructs the queue holding the given values
+			 */
+			template <typename... Values>
+			explicit spsc_queue(in_place_t, Values&&... values) : spsc_queue{}
+			{
+				static_assert(sizeof...(Values) <= Capacity, "Too many values for the queue");
+
+				size_type tail = 0;
+				(std::construct_at(m_data + tail++, std::forward<Values>(values)), ...);
+				m_tail.store(tail, std::memory_order_relaxed);
+			}
+
+			spsc_queue(const spsc_queue&) = delete;
+
+			spsc_queue(spsc_queue&&) = delete;
+
+			~spsc_queue() noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<ElementType>)
+				{
+					const size_type tail = m_tail.load(std::memory_order_relaxed);
+					for (size_type head = m_head.load(std::memory_order_relaxed); head != tail; ++head)
+					{
+						std::destroy_at(m_data + head % Capacity);
+					}
+				}
+			}
+
+			spsc_queue& operator=(const spsc_queue&) = delete;
+
+			spsc_queue& operator=(spsc_queue&&) = delete;
+
+			// ----- Producer -----
+
+			/**
+			 * Constructs an element at the back of the queue in-place
+			 * @return Whether there was room for it
+			 */
+			template <typename... Args>
+			bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<ElementType, Args&&...>)
+			{
+				const size_type tail = m_tail.load(std::memory_order_relaxed);
+				if (tail - m_head_cache == Capacity)
+				{
+					m_head_cache = m_head.load(std::memory_order_acquire);
+					if (tail - m_head_cache == Capacity)
+					{
+						return false;
+					}
+				}
+
+				std::construct_at(m_data + tail % Capacity, std::forward<Args>(args)...);
+				m_tail.store(tail + 1, std::memory_order_release);
+				return true;
+			}
+
+			template <typename... Args>
+			bool try_push(in_place_t, Args&&... args) noexcept(std::is_nothrow_constructible_v<ElementType, Args&&...>)
+			{
+				return try_emplace(std::forward<Args>(args)...);
+			}
+
+			bool try_push(const ElementType& value) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				return try_emplace(value);
+			}
+
+			bool try_push(ElementType&& value) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				return try_emplace(std::move(value));
+			}
+
+			/**
+			 * Enqueues as many values as fit and publishes them at once, trivially copyable elements are copied with at most two memcpy calls
+			 * @param values Values to enqueue
+			 * @param count Count of values
+			 * @return Count of values enqueued
+			 */
+			size_type try_push(const ElementType* const values, size_type count) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				const size_type tail = m_tail.load(std::memory_order_relaxed);
+				if (Capacity - (tail - m_head_cache) < count)
+				{
+					m_head_cache = m_head.load(std::memory_order_acquire);
+				}
+
+				const size_type available = Capacity - (tail - m_head_cache);
+				count = count < available ? count : available;
+				if (count == 0)
+				{
+					return 0;
+				}
+
+				const size_type start = tail % Capacity;
+				const size_type first = count < Capacity - start ? count : Capacity - start;
+				woj::uninitialized_copy_n(values, first, m_data + start);
+				if constexpr (std::is_nothrow_copy_constructible_v<ElementType>)
+				{
+					woj::uninitialized_copy_n(values + first, count - first, m_data);
+				}
+				else
+				{
+					try
+					{
+						woj::uninitialized_copy_n(values + first, count - first, m_data);
+					}
+					catch (...)
+					{
+						std::destroy_n(m_data + start, first);
+						throw;
+					}
+				}
+
+				m_tail.store(tail + count, std::memory_order_release);
+				return count;
+			}
+
+			// ----- Consumer -----
+
+			/**
+			 * @return Pointer to the oldest element (valid until it is popped) or nullptr when the queue is empty
+			 */
+			WOJ_NODISCARD ElementType* front() noexcept
+			{
+				const size_type head = m_head.load(std::memory_order_relaxed);
+				if (head == m_tail_cache)
+				{
+					m_tail_cache = m_tail.load(std::memory_order_acquire);
+					if (head == m_tail_cache)
+					{
+						return nullptr;
+					}
+				}
+				return m_data + head % Capacity;
+			}
+
+			/**
+			 * Destroys the oldest element, front() must have returned it
+			 */
+			void pop() noexcept
+			{
+				const size_type head = m_head.load(std::memory_order_relaxed);
+				std::destroy_at(m_data + head % Capacity);
+				m_head.store(head + 1, std::memory_order_release);
+			}
+
+			/**
+			 * Moves the oldest element out of the queue
+			 * @return Whether there was an element
+			 */
+			bool try_pop(ElementType& value) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				ElementType* const element = front();
+				if (!element)
+				{
+					return false;
+				}
+
+				value = std::move(*element);
+				pop();
+				return true;
+			}
+
+			/**
+			 * Moves up to count of the oldest elements out of the queue and releases their slots at once,
+			 * trivially copyable elements are copied with at most two memcpy calls
+			 * @param destination Storage for count elements
+			 * @param count Count of elements to take
+			 * @return Count of elements taken
+			 */
+			size_type try_pop(ElementType* const destination, size_type count) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				const size_type head = m_head.load(std::memory_order_relaxed);
+				if (m_tail_cache - head < count)
+				{
+					m_tail_cache = m_tail.load(std::memory_order_acquire);
+				}
+
+				const size_type available = m_tail_cache - head;
+				count = count < available ? count : available;
+				if (count == 0)
+				{
+					return 0;
+				}
+
+				const size_type start = head % Capacity;
+				const size_type first = count < Capacity - start ? count : Capacity - start;
+				move_out(m_data + start, first, destination);
+				move_out(m_data, count - first, destination + first);
+				m_head.store(head + count, std::memory_order_release);
+				return count;
+			}
+
+			// ----- Observers -----
+
+			/**
+			 * @return Count of elements, exact only when called from the producer or the consumer while the other side is idle
+			 */
+			WOJ_NODISCARD size_type size() const noexcept
+			{
+				const size_type head = m_head.load(std::memory_order_acquire);
+				return m_tail.load(std::memory_order_acquire) - head;
+			}
+
+			WOJ_NODISCARD bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			static WOJ_CONSTEVAL size_type capacity() noexcept
+			{
+				return Capacity;
+			}
+
+		private:
+			/**
+			 * Moves count elements to destination and destroys them
+			 */
+			static void move_out(ElementType* const source, const size_type count, ElementType* const destination) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				if constexpr (std::is_trivially_copyable_v<ElementType>)
+				{
+					if (count)
+					{
+						std::memcpy(destination, source, count * sizeof(ElementType));
+					}
+				}
+				else
+				{
+					for (size_type i = 0; i < count; ++i)
+					{
+						destination[i] = std::move(source[i]);
+						std::destroy_at(source + i);
+					}
+				}
+			}
+		};
+	}
+}
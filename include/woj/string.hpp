@@ -1,28 +1,24 @@
 #pragma once
 
-#ifndef WOJ_STRING_HPP
-#define WOJ_STRING_HPP
+#include "base.hpp"
+#include <algorithm>
 #include <cassert>
-
-#include "string.hpp"
-#endif
-
-#ifndef WOJ_DEFS_HPP
-#include "woj/base.hpp"
-#endif
-
-#include <type_traits>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <cwchar>
-#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #if defined(WOJ_HAS_CXX20)
 #include <concepts>
 #endif
 
+#ifndef WOJ_STRING_HPP
+#define WOJ_STRING_HPP
+#endif
+
 namespace woj
 {
 	#if defined(WOJ_HAS_CXX20)
@@ -65,460 +61,10 @@ namespace woj
 			using reference = Elem&;
 			using const_reference = const Elem&;
 
-			class const_reverse_iterator;
-			class reverse_reverse_iterator;
-			class const_reverse_reverse_iterator;
-
-			class reverse_iterator
-			{
-			public:
-				pointer p_elem;
-
-				constexpr reverse_iterator() noexcept : p_elem(nullptr) {}
-
-				constexpr reverse_iterator(const noinit_t) noexcept {}
-
-				explicit constexpr reverse_iterator(const pointer p_elem) noexcept : p_elem(p_elem) {}
-
-				constexpr reverse_iterator(const reverse_iterator& other) noexcept : p_elem(other.p_elem) {}
-
-				constexpr reverse_iterator(reverse_iterator&& other) noexcept : p_elem(other.p_elem)
-				{
-					other.p_elem = nullptr;
-				}
-
-				WOJ_CONSTEXPR20 ~reverse_iterator() noexcept = default;
-
-				explicit constexpr operator const_reverse_iterator() const noexcept
-				{
-					return const_reverse_iterator(p_elem);
-				}
-
-				explicit constexpr operator reverse_reverse_iterator() const noexcept
-				{
-					return reverse_reverse_iterator(p_elem);
-				}
-
-				explicit constexpr operator const_reverse_reverse_iterator() const noexcept
-				{
-					return const_reverse_reverse_iterator(p_elem);
-				}
-
-				constexpr reverse_iterator& operator=(const reverse_iterator& other) noexcept = default;
-
-				constexpr reverse_iterator& operator=(reverse_iterator&& other) noexcept
-				{
-					p_elem = other.p_elem;
-					other.p_elem = nullptr;
-					return *this;
-				}
-
-				constexpr reference operator*() const noexcept
-				{
-					return *p_elem;
-				}
-
-				constexpr pointer operator->() const noexcept
-				{
-					return p_elem;
-				}
-
-				constexpr reverse_iterator& operator++() noexcept
-				{
-					++p_elem;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator++(int) noexcept
-				{
-					reverse_iterator temp(*this);
-					++p_elem;
-					return temp;
-				}
-
-				constexpr reverse_iterator& operator--() noexcept
-				{
-					--p_elem;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator--(int) noexcept
-				{
-					reverse_iterator temp(*this);
-					--p_elem;
-					return temp;
-				}
-
-				constexpr reverse_iterator& operator+=(const difference_type value) noexcept
-				{
-					p_elem += value;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator+(const difference_type value) const noexcept
-				{
-					reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr reverse_iterator& operator-=(const difference_type value) noexcept
-				{
-					p_elem -= value;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator-(const difference_type value) const noexcept
-				{
-					reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr reverse_iterator& operator-(const reverse_iterator other) const noexcept
-				{
-					return p_elem - other.p_elem;
-				}
-
-				constexpr const reverse_iterator& as_const() const noexcept
-				{
-					return *this;
-				}
-
-				constexpr const_reverse_iterator constified() const noexcept
-				{
-					return const_reverse_iterator(p_elem);
-				}
-
-				constexpr reverse_reverse_iterator reversed() const noexcept
-				{
-					return reverse_reverse_iterator(p_elem);
-				}
-
-				constexpr const_reverse_reverse_iterator creversed() const noexcept
-				{
-					return const_reverse_reverse_iterator(p_elem);
-				}
-			};
-
-			class const_reverse_iterator
-			{
-				const_pointer p_elem;
-
-				constexpr const_reverse_iterator() noexcept : p_elem(nullptr) {}
-
-				constexpr const_reverse_iterator(const noinit_t) noexcept {}
-
-				explicit constexpr const_reverse_iterator(const const_pointer p_elem) noexcept : p_elem(p_elem) {}
-
-				constexpr const_reverse_iterator(const const_reverse_iterator& other) noexcept : p_elem(other.p_elem) {}
-
-				constexpr const_reverse_iterator(const_reverse_iterator&& other) noexcept : p_elem(other.p_elem)
-				{
-					other.p_elem = nullptr;
-				}
-
-				WOJ_CONSTEXPR20 ~const_reverse_iterator() noexcept = default;
-
-				constexpr const_reverse_iterator& operator=(const const_reverse_iterator& other) noexcept = default;
-
-				constexpr const_reverse_iterator& operator=(const_reverse_iterator&& other) noexcept
-				{
-					p_elem = other.p_elem;
-					other.p_elem = nullptr;
-					return *this;
-				}
-
-				constexpr reference operator*() const noexcept
-				{
-					return *p_elem;
-				}
-
-				constexpr pointer operator->() const noexcept
-				{
-					return p_elem;
-				}
-
-				constexpr const_reverse_iterator& operator++() noexcept
-				{
-					++p_elem;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator++(int) noexcept
-				{
-					const_reverse_iterator temp(*this);
-					++p_elem;
-					return temp;
-				}
-
-				constexpr const_reverse_iterator& operator--() noexcept
-				{
-					--p_elem;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator--(int) noexcept
-				{
-					const_reverse_iterator temp(*this);
-					--p_elem;
-					return temp;
-				}
-
-				constexpr const_reverse_iterator& operator+=(const difference_type value) noexcept
-				{
-					p_elem += value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator+(const difference_type value) const noexcept
-				{
-					const_reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator& operator-=(const difference_type value) noexcept
-				{
-					p_elem -= value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator-(const difference_type value) const noexcept
-				{
-					const_reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator& operator-(const const_reverse_iterator other) const noexcept
-				{
-					return p_elem - other.p_elem;
-				}
-
-				constexpr const const_reverse_iterator& as_const() const noexcept
-				{
-					return *this;
-				}
-			};
-
-			class reverse_iterator
-			{
-			public:
-				pointer p_elem;
-
-				constexpr reverse_iterator() noexcept : p_elem(nullptr) {}
-
-				constexpr reverse_iterator(const noinit_t) noexcept {}
-
-				explicit constexpr reverse_iterator(const pointer p_elem) noexcept : p_elem(p_elem) {}
-
-				constexpr reverse_iterator(const reverse_iterator& other) noexcept : p_elem(other.p_elem) {}
-
-				constexpr reverse_iterator(reverse_iterator&& other) noexcept : p_elem(other.p_elem)
-				{
-					other.p_elem = nullptr;
-				}
-
-				WOJ_CONSTEXPR20 ~reverse_iterator() noexcept = default;
-
-				constexpr reverse_iterator& operator=(const reverse_iterator& other) noexcept = default;
-
-				constexpr reverse_iterator& operator=(reverse_iterator&& other) noexcept
-				{
-					p_elem = other.p_elem;
-					other.p_elem = nullptr;
-					return *this;
-				}
-
-				constexpr reference operator*() const noexcept
-				{
-					return *p_elem;
-				}
-
-				constexpr pointer operator->() const noexcept
-				{
-					return p_elem;
-				}
-
-				constexpr reverse_iterator& operator++() noexcept
-				{
-					++p_elem;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator++(int) noexcept
-				{
-					reverse_iterator temp(*this);
-					++p_elem;
-					return temp;
-				}
-
-				constexpr reverse_iterator& operator--() noexcept
-				{
-					--p_elem;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator--(int) noexcept
-				{
-					reverse_iterator temp(*this);
-					--p_elem;
-					return temp;
-				}
-
-				constexpr reverse_iterator& operator+=(const difference_type value) noexcept
-				{
-					p_elem += value;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator+(const difference_type value) const noexcept
-				{
-					reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr reverse_iterator& operator-=(const difference_type value) noexcept
-				{
-					p_elem -= value;
-					return *this;
-				}
-
-				constexpr reverse_iterator operator-(const difference_type value) const noexcept
-				{
-					reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr reverse_iterator& operator-(const reverse_iterator other) const noexcept
-				{
-					return p_elem - other.p_elem;
-				}
-
-				constexpr const reverse_iterator& as_const() const noexcept
-				{
-					return *this;
-				}
-
-				constexpr const_reverse_iterator constified() const noexcept
-				{
-					return const_reverse_iterator(p_elem);
-				}
-
-				constexpr reverse_reverse_iterator reversed() const noexcept
-				{
-					return reverse_reverse_iterator(p_elem);
-				}
-
-				constexpr const_reverse_reverse_iterator creversed() const noexcept
-				{
-					return const_reverse_reverse_iterator(p_elem);
-				}
-			};
-
-			class const_reverse_iterator
-			{
-				const_pointer p_elem;
-
-				constexpr const_reverse_iterator() noexcept : p_elem(nullptr) {}
-
-				constexpr const_reverse_iterator(const noinit_t) noexcept {}
-
-				explicit constexpr const_reverse_iterator(const const_pointer p_elem) noexcept : p_elem(p_elem) {}
-
-				constexpr const_reverse_iterator(const const_reverse_iterator& other) noexcept : p_elem(other.p_elem) {}
-
-				constexpr const_reverse_iterator(const_reverse_iterator&& other) noexcept : p_elem(other.p_elem)
-				{
-					other.p_elem = nullptr;
-				}
-
-				WOJ_CONSTEXPR20 ~const_reverse_iterator() noexcept = default;
-
-				constexpr const_reverse_iterator& operator=(const const_reverse_iterator& other) noexcept = default;
-
-				constexpr const_reverse_iterator& operator=(const_reverse_iterator&& other) noexcept
-				{
-					p_elem = other.p_elem;
-					other.p_elem = nullptr;
-					return *this;
-				}
-
-				constexpr reference operator*() const noexcept
-				{
-					return *p_elem;
-				}
-
-				constexpr pointer operator->() const noexcept
-				{
-					return p_elem;
-				}
-
-				constexpr const_reverse_iterator& operator++() noexcept
-				{
-					++p_elem;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator++(int) noexcept
-				{
-					const_reverse_iterator temp(*this);
-					++p_elem;
-					return temp;
-				}
-
-				constexpr const_reverse_iterator& operator--() noexcept
-				{
-					--p_elem;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator--(int) noexcept
-				{
-					const_reverse_iterator temp(*this);
-					--p_elem;
-					return temp;
-				}
-
-				constexpr const_reverse_iterator& operator+=(const difference_type value) noexcept
-				{
-					p_elem += value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator+(const difference_type value) const noexcept
-				{
-					const_reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator& operator-=(const difference_type value) noexcept
-				{
-					p_elem -= value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator operator-(const difference_type value) const noexcept
-				{
-					const_reverse_iterator temp(*this);
-					temp += value;
-					return *this;
-				}
-
-				constexpr const_reverse_iterator& operator-(const const_reverse_iterator other) const noexcept
-				{
-					return p_elem - other.p_elem;
-				}
-
-				constexpr const const_reverse_iterator& as_const() const noexcept
-				{
-					return *this;
-				}
-			};
+			using iterator = Elem*;
+			using const_iterator = const Elem*;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
 			alignas(Elem) Elem m_data[MemSize];
 
@@ -531,22 +77,22 @@ namespace woj
 			 * @return Output stream reference
 			 */
 			template <typename IStrElem, typename IStrTraits = std::char_traits<IStrElem>>
-			constexpr friend std::ostream& operator<<(std::basic_ostream<IStrElem, IStrTraits>& ostr, const string& str)
+			friend std::basic_ostream<IStrElem, IStrTraits>& operator<<(std::basic_ostream<IStrElem, IStrTraits>& ostr, const string& str)
 			{
 				using ostr_type = std::basic_ostream<IStrElem, IStrTraits>;
 				typename ostr_type::iostate state{ ostr_type::goodbit };
 
-				std::string s;
-				std::cout << s;
-
 				if (typename ostr_type::sentry{ ostr }) WOJ_LIKELY
 				{
-					size_type pad = (ostr.width() <= 0) ? 0 : static_cast<size_type>(ostr.width());
-					ostr.rdbuf()->sputn(str.c_str(), str.str_size());
+					const std::streamsize size = static_cast<std::streamsize>(str.str_size());
+					if (ostr.rdbuf()->sputn(str.c_str(), size) != size) WOJ_UNLIKELY
+						state |= ostr_type::badbit;
 				}
 				else
 					state |= ostr_type::badbit;
 
+				ostr.setstate(state);
+
 				return ostr;
 			}
 
@@ -559,7 +105,7 @@ namespace woj
 			 * @return Input stream reference
 			 */
 			template <typename IStrElem, typename IStrTraits = std::char_traits<IStrElem>>
-			constexpr friend std::istream& operator>>(std::basic_istream<IStrElem, IStrTraits>& istr, string& str)
+			friend std::basic_istream<IStrElem, IStrTraits>& operator>>(std::basic_istream<IStrElem, IStrTraits>& istr, string& str)
 			{
 				using istr_type = std::basic_istream<IStrElem, IStrTraits>;
 				using ctype = std::ctype<IStrElem>;
@@ -572,9 +118,10 @@ namespace woj
 					typename IStrTraits::int_type chr = istr.rdbuf()->sgetc();
 					bool changed{ false };
 
+					const size_type limit = istr.width() > 0 ? (std::min)(MemSize, static_cast<size_type>(istr.width())) : MemSize;
 					size_type i = 0;
 
-					for (; i < (istr.width() > 0 ? (std::min)(str.max_size(), istr.width()) : str.max_size()); ++i, chr = istr.rdbuf()->snextc()) WOJ_LIKELY
+					for (; i < limit; ++i, chr = istr.rdbuf()->snextc()) WOJ_LIKELY
 					{
 						if (IStrTraits::eq_int_type(chr, IStrTraits::eof())) WOJ_UNLIKELY
 						{
@@ -593,7 +140,11 @@ namespace woj
 						}
 					}
 
-					str[i] = 0;
+					if (i < MemSize)
+					{
+						str[i] = 0;
+					}
+					istr.width(0);
 
 					if (!changed) WOJ_UNLIKELY
 						state |= istr_type::failbit;
@@ -621,7 +172,7 @@ namespace woj
 			 * @param other Buffer to copy from
 			 */
 			template <size_type OtherMemSize>
-			constexpr string(const Elem(&other)[OtherMemSize]) noexcept
+			constexpr string(const Elem(&other)[OtherMemSize]) noexcept : m_data{}
 			{
 				copy(other);
 			}
@@ -633,7 +184,7 @@ namespace woj
 			 * @param count Count of characters to copy
 			 */
 			template <size_type OtherMemSize>
-			constexpr string(const Elem(&other)[OtherMemSize], const size_type count) noexcept
+			constexpr string(const Elem(&other)[OtherMemSize], const size_type count) noexcept : m_data{}
 			{
 				copy(other, count);
 			}
@@ -692,12 +243,17 @@ namespace woj
 				copy(other, count);
 			}
 
-
 			/**
 			 * Copy constructor from another string
+			 * @tparam OtherElem Type of the other string's elements
+			 * @tparam OtherMemSize MemSize of the other string
 			 * @param other String to copy from
 			 */
+#if defined(WOJ_HAS_CXX20)
 			template <char_type OtherElem, size_type OtherMemSize>
+#else
+			template <typename OtherElem, size_type OtherMemSize>
+#endif
 			constexpr string(const string<OtherElem, OtherMemSize>& other) noexcept : m_data{}
 			{
 				copy(other);
@@ -710,7 +266,10 @@ namespace woj
 			 * @param other String to copy from
 			 * @param count Count of characters to copy
 			 */
+#if defined(WOJ_HAS_CXX20)
 			template <char_type OtherElem, size_type OtherMemSize>
+#else
+			template <typename OtherElem, size_type OtherMemSize>
 #endif
 			constexpr string(const string<OtherElem, OtherMemSize>& other, const size_type count) noexcept : m_data{}
 			{
@@ -748,10 +307,10 @@ namespace woj
 			 * @param other Buffer to copy from
 			 * @return Reference to self
 			 */
-		template <typename ElemPtr = const Elem* const>
-		requires std::is_pointer<ElemPtr>::value &&
-				 std::is_same<std::remove_const_t<std::remove_pointer_t<std::remove_const_t<std::remove_pointer_t<ElemPtr>>>>, Elem>::value &&
-				 (!std::is_array<ElemPtr>::value)
+			template <typename ElemPtr = const Elem* const>
+			requires std::is_pointer<ElemPtr>::value &&
+					 std::is_same<std::remove_const_t<std::remove_pointer_t<std::remove_const_t<ElemPtr>>>, Elem>::value &&
+					 (!std::is_array<ElemPtr>::value)
 #else
 			/**
 			 * Assign from pointer buffer operator
@@ -761,7 +320,7 @@ namespace woj
 			 */
 			template <typename ElemPtr = const Elem* const, typename = std::enable_if_t<
 				std::is_pointer<ElemPtr>::value &&
-				std::is_same<std::remove_const_t<std::remove_pointer_t<std::remove_const_t<std::remove_pointer_t<ElemPtr>>>>, Elem>::value &&
+				std::is_same<std::remove_const_t<std::remove_pointer_t<std::remove_const_t<ElemPtr>>>, Elem>::value &&
 				!std::is_array<ElemPtr>::value>>
 #endif
 				constexpr string& operator=(ElemPtr other) noexcept
@@ -776,10 +335,13 @@ namespace woj
 			 */
 			constexpr string& operator=(const string& other) noexcept
 			{
-				return copy(other);
+				if (this != &other)
+				{
+					copy(other);
+				}
+				return *this;
 			}
 
-
 #if defined(WOJ_HAS_CXX20)
 			/**
 			 * Assign from another string of different params operator
@@ -832,77 +394,79 @@ namespace woj
 			// ----- Iteration functions -----
 
 			/**
-			 * Begin reverse_iterator
 			 * @return Iterator to the beginning of the string
 			 */
-			WOJ_NODISCARD constexpr reverse_iterator begin() noexcept
+			WOJ_NODISCARD constexpr iterator begin() noexcept
 			{
 				return m_data;
 			}
 
 			/**
-			 * Const begin reverse_iterator
-			 * @return Const reverse_iterator to the beginning of the string
+			 * @return Const iterator to the beginning of the string
 			 */
-			WOJ_NODISCARD constexpr const_reverse_iterator begin() const noexcept
+			WOJ_NODISCARD constexpr const_iterator begin() const noexcept
 			{
 				return m_data;
 			}
 
 			/**
-			 * Const begin reverse_iterator
-			 * @return Const reverse_iterator to the beginning of the string
+			 * @return Const iterator to the beginning of the string
 			 */
-			WOJ_NODISCARD constexpr const_reverse_iterator cbegin() const noexcept
+			WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
 			{
 				return begin();
 			}
 
 			/**
-			 * End reverse_iterator
-			 * @return Iterator to the end of the string (after the null terminator)
+			 * @return Iterator to the end of the memory buffer (MemSize elements, not the null terminator)
 			 */
-			WOJ_NODISCARD constexpr reverse_iterator end() noexcept
+			WOJ_NODISCARD constexpr iterator end() noexcept
 			{
 				return m_data + MemSize;
 			}
 
-			WOJ_NODISCARD constexpr const_reverse_iterator end() const noexcept
+			/**
+			 * @return Const iterator to the end of the memory buffer (MemSize elements, not the null terminator)
+			 */
+			WOJ_NODISCARD constexpr const_iterator end() const noexcept
 			{
 				return m_data + MemSize;
 			}
 
-			WOJ_NODISCARD constexpr const_reverse_iterator cend() const noexcept
+			/**
+			 * @return Const iterator to the end of the memory buffer (MemSize elements, not the null terminator)
+			 */
+			WOJ_NODISCARD constexpr const_iterator cend() const noexcept
 			{
 				return end();
 			}
 
-			WOJ_NODISCARD constexpr reverse_reverse_iterator rbegin() noexcept
+			WOJ_NODISCARD constexpr reverse_iterator rbegin() noexcept
 			{
-				return m_data + MemSize - 1;
+				return reverse_iterator{ end() };
 			}
 
-			WOJ_NODISCARD constexpr const_reverse_reverse_iterator rbegin() const noexcept
+			WOJ_NODISCARD constexpr const_reverse_iterator rbegin() const noexcept
 			{
-				return m_data + MemSize - 1;
+				return const_reverse_iterator{ end() };
 			}
 
-			WOJ_NODISCARD constexpr const_reverse_reverse_iterator crbegin() const noexcept
+			WOJ_NODISCARD constexpr const_reverse_iterator crbegin() const noexcept
 			{
 				return rbegin();
 			}
 
-			WOJ_NODISCARD constexpr reverse_reverse_iterator rend() noexcept
+			WOJ_NODISCARD constexpr reverse_iterator rend() noexcept
 			{
-				return m_data - 1;
+				return reverse_iterator{ begin() };
 			}
 
-			WOJ_NODISCARD constexpr const_reverse_reverse_iterator rend() const noexcept
+			WOJ_NODISCARD constexpr const_reverse_iterator rend() const noexcept
 			{
-				return m_data - 1;
+				return const_reverse_iterator{ begin() };
 			}
 
-			WOJ_NODISCARD constexpr const_reverse_reverse_iterator crend() const noexcept
+			WOJ_NODISCARD constexpr const_reverse_iterator crend() const noexcept
 			{
 				return rend();
 			}
@@ -910,58 +474,58 @@ namespace woj
 			// ----- Copy functions from buffers -----
 
 			/**
-			 * Copy from array buffer
-			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
-			 * @tparam OtherMemSize Size of the buffer to copy from
+			 * Copy count characters from a buffer, null-terminates if the string has space left
 			 * @param other Buffer to copy from
+			 * @param count Count of characters to copy (clamped to MemSize)
+			 * @param buffer_overlaps Whether the buffer overlaps with internal buffer
 			 * @return Reference to self
 			 */
-			template <bool BufferOverlaps = false, size_type OtherMemSize>
-			constexpr string& copy(const Elem(&other)[OtherMemSize]) noexcept
+			constexpr string& copy_chars(const Elem* const other, const size_type count, const bool buffer_overlaps) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
+				const size_type size = (std::min)(count, MemSize);
 
 				if (is_constant_evaluated())
 				{
-					constexpr bool buffer_smaller = OtherMemSize < MemSize;
-					constexpr size_type size = (buffer_smaller ? OtherMemSize : MemSize) * sizeof(Elem);
-
-
 					for (size_type i = 0; i < size; ++i)
 					{
 						m_data[i] = other[i];
 					}
-
-					if constexpr  (buffer_smaller)
-					{
-						m_data[OtherMemSize] = 0;
-					}
 				}
-				else
+				else if (size)
 				{
-					constexpr bool buffer_smaller = OtherMemSize < MemSize;
-					constexpr size_type byte_size = (buffer_smaller ? OtherMemSize : MemSize) * sizeof(Elem);
+					WOJ_ASSERT_ASSUME(other != nullptr);
 
-
-					if constexpr  (BufferOverlaps)
+					if (buffer_overlaps) WOJ_UNLIKELY
 					{
-						std::memmove(m_data, other, byte_size);
+						std::memmove(m_data, other, size * sizeof(Elem));
 					}
 					else
 					{
-						std::memcpy(m_data, other, byte_size);
+						std::memcpy(m_data, other, size * sizeof(Elem));
 					}
+				}
 
-
-					if constexpr  (buffer_smaller)
-					{
-						m_data[OtherMemSize] = 0;
-					}
+				if (size < MemSize)
+				{
+					m_data[size] = 0;
 				}
 
 				return *this;
 			}
 
+			/**
+			 * Copy from array buffer
+			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
+			 * @tparam OtherMemSize Size of the buffer to copy from
+			 * @param other Buffer to copy from
+			 * @return Reference to self
+			 */
+			template <bool BufferOverlaps = false, size_type OtherMemSize>
+			constexpr string& copy(const Elem(&other)[OtherMemSize]) noexcept
+			{
+				return copy_chars(other, OtherMemSize, BufferOverlaps);
+			}
+
 			/**
 			 * Copy from array buffer
 			 * @tparam OtherMemSize Size of the buffer to copy from
@@ -972,216 +536,48 @@ namespace woj
 			template <size_type OtherMemSize>
 			constexpr string& copy(const Elem(&other)[OtherMemSize], const bool buffer_overlaps) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				if (is_constant_evaluated())
-				{
-					constexpr bool buffer_smaller = OtherMemSize < MemSize;
-					constexpr size_type size = (buffer_smaller ? OtherMemSize : MemSize) * sizeof(Elem);
-
-
-					for (size_type i = 0; i < size; ++i)
-					{
-						m_data[i] = other[i];
-					}
-
-					if constexpr  (buffer_smaller)
-					{
-						m_data[OtherMemSize] = 0;
-					}
-				}
-				else
-				{
-					constexpr bool buffer_smaller = OtherMemSize < MemSize;
-					constexpr size_type byte_size = (buffer_smaller ? OtherMemSize : MemSize) * sizeof(Elem);
-
-
-					if (buffer_overlaps) WOJ_LIKELY
-					{
-						std::memmove(m_data, other, byte_size);
-					}
-					else WOJ_UNLIKELY
-					{
-						std::memcpy(m_data, other, byte_size);
-					}
-
-
-					if constexpr  (buffer_smaller)
-					{
-						m_data[OtherMemSize] = 0;
-					}
-				}
-
-				return *this;
+				return copy_chars(other, OtherMemSize, buffer_overlaps);
 			}
 
 			/**
 			 * Copy from array buffer with count of characters
 			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
-			 * @tparam OtherMemSize Size of the buffer to copy from
-			 * Copy from array m_data with count of characters
-			 * @tparam BufferOverlaps Whether the m_data overlaps with the string's m_data
 			 * @tparam Count Count of characters to copy
-			 * @tparam OtherMemSize Size of the m_data to copy from
+			 * @tparam OtherMemSize Size of the buffer to copy from
 			 * @param other Buffer to copy from
-			 * @param count Count of characters to copy
 			 * @return Reference to self
 			 */
 			template <bool BufferOverlaps, size_type Count, size_type OtherMemSize>
 			constexpr string& copy(const Elem(&other)[OtherMemSize]) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				if (is_constant_evaluated())
-				{
-					constexpr bool buffer_smaller = Count < MemSize;
-					constexpr size_type size = (buffer_smaller ? Count : MemSize) * sizeof(Elem);
-
-					
-					for (size_type i = 0; i < size; ++i)
-					{
-						m_data[i] = other[i];
-					}
-
-					if constexpr  (buffer_smaller)
-					{
-						m_data[Count] = 0;
-					}
-				}
-				else
-				{
-					constexpr bool buffer_smaller = Count < MemSize;
-					constexpr size_type byte_size = (buffer_smaller ? Count : MemSize) * sizeof(Elem);
-
-
-					if constexpr  (BufferOverlaps)
-					{
-						std::memmove(m_data, other, byte_size);
-					}
-					else WOJ_UNLIKELY
-					{
-						std::memcpy(m_data, other, byte_size);
-					}
-
-
-					if constexpr  (buffer_smaller)
-					{
-						m_data[Count] = 0;
-					}
-				}
-
-				return *this;
+				return copy_chars(other, (std::min)(Count, OtherMemSize), BufferOverlaps);
 			}
 
 			/**
-			 * Copy from array m_data with count of characters
-			 * @tparam OtherMemSize Size of the m_data to copy from
+			 * Copy from array buffer with count of characters
+			 * @tparam OtherMemSize Size of the buffer to copy from
 			 * @param other Buffer to copy from
 			 * @param count Count of characters to copy
 			 * @return Reference to self
 			 */
 			template <size_type OtherMemSize>
-			WOJ_CONSTEXPR20 string& copy(const Elem(&other)[OtherMemSize], const size_type count) noexcept
+			constexpr string& copy(const Elem(&other)[OtherMemSize], const size_type count) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-				//[[assume(other != nullptr)]]
-
-				if (is_constant_evaluated())
-				{
-					constexpr bool buffer_smaller = OtherMemSize < MemSize;
-					constexpr size_type size = (buffer_smaller ? OtherMemSize : MemSize) * sizeof(Elem);
-
-
-					for (size_type i = 0; i < size; ++i)
-					{
-						m_data[i] = other[i];
-					}
-
-					if constexpr (buffer_smaller)
-					{
-						m_data[OtherMemSize] = 0;
-					}
-				}
-				else
-				{
-					if (count < MemSize) WOJ_LIKELY
-					{
-						const size_type byte_size = count * sizeof(Elem);
-						std::memcpy(m_data, other, byte_size);
-
-						m_data[count - 1] = 0;
-					}
-					else WOJ_UNLIKELY
-					{
-						constexpr size_type byte_size = MemSize * sizeof(Elem);
-						std::memcpy(m_data, other, byte_size);
-					}
-				}
-
-				return *this;
+				return copy_chars(other, (std::min)(count, OtherMemSize), false);
 			}
 
 			/**
-			 * Copy from array m_data with count of characters
-			 * @tparam OtherMemSize Size of the m_data to copy from
+			 * Copy from array buffer with count of characters
+			 * @tparam OtherMemSize Size of the buffer to copy from
 			 * @param other Buffer to copy from
-			 * @param buffer_overlaps Whether the m_data overlaps with the string's m_data
-			 * @param count Count of characters to copy
 			 * @param buffer_overlaps Whether the buffer overlaps with internal buffer
+			 * @param count Count of characters to copy
 			 * @return Reference to self
 			 */
 			template <size_type OtherMemSize>
-			WOJ_CONSTEXPR20 string& copy(const Elem(&other)[OtherMemSize], const bool buffer_overlaps, const size_type count) noexcept
+			constexpr string& copy(const Elem(&other)[OtherMemSize], const bool buffer_overlaps, const size_type count) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				if (is_constant_evaluated())
-				{
-					const bool buffer_smaller = count < MemSize;
-					const size_type size = (buffer_smaller ? count : MemSize) * sizeof(Elem);
-
-
-					for (size_type i = 0; i < size; ++i)
-					{
-						m_data[i] = other[i];
-					}
-
-					if (buffer_smaller)
-					{
-						m_data[count] = 0;
-					}
-				}
-				else
-				{
-					if (count < MemSize) WOJ_LIKELY
-					{
-						const size_type byte_size = count * sizeof(Elem);
-						if constexpr  (buffer_overlaps)
-						{
-							std::memmove(m_data, other, byte_size);
-						}
-						else
-						{
-							std::memcpy(m_data, other, byte_size);
-						}
-
-						m_data[count - 1] = 0;
-					}
-					else WOJ_UNLIKELY
-					{
-						constexpr size_type byte_size = MemSize * sizeof(Elem);
-						if constexpr  (buffer_overlaps)
-						{
-							std::memmove(m_data, other, byte_size);
-						}
-						else
-						{
-							std::memcpy(m_data, other, byte_size);
-						}	
-					}
-				}
-
-				return *this;
+				return copy_chars(other, (std::min)(count, OtherMemSize), buffer_overlaps);
 			}
 
 #if defined(WOJ_HAS_CXX20)
@@ -1189,13 +585,10 @@ namespace woj
 			 * Copy from pointer buffer until null terminator is found or maximum size is reached (MemSize)
 			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
 			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
-			 * Copy from pointer m_data until null terminator is found or maximum size is reached (MemSize)
-			 * @tparam BufferOverlaps Whether the m_data overlaps with the string's m_data (unused, kept for compatibility)
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
 			 * @param other Buffer to copy from
 			 * @return Reference to self
 			 */
-			template <bool BufferOverlaps, typename ElemPtr = const Elem* const>
+			template <bool BufferOverlaps = false, typename ElemPtr = const Elem* const>
 				requires std::is_pointer<ElemPtr>::value &&
 						 std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
 						 (!std::is_array<ElemPtr>::value)
@@ -1208,137 +601,73 @@ namespace woj
 			 * @return Reference to self
 			 */
 			template <bool BufferOverlaps = false, typename ElemPtr = const Elem* const, typename = std::enable_if_t<
-			/**
-			 * Copy from pointer m_data until null terminator is found or maximum size is reached (MemSize)
-			 * @tparam BufferOverlaps Whether the m_data overlaps with the string's m_data (unused, kept for compatibility)
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
-			 * @param other Buffer to copy from
-			 * @return Reference to self
-			 */
-			template <bool BufferOverlaps, typename ElemPtr = const Elem* const, typename = std::enable_if_t<
 				std::is_pointer<ElemPtr>::value &&
-				std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value), void>>
-#endif
-				constexpr string& copy(ElemPtr other) noexcept
-			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				size_type i = 0;
-
-				while (i < MemSize - 1 && !(m_data[i] = other[i++])) WOJ_LIKELY {}
-
-				if (i < MemSize - 1) WOJ_LIKELY
-				{
-					m_data[i] = 0;
-				}
-
-				return *this;
+				std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
+				!std::is_array<ElemPtr>::value>>
+#endif
+				constexpr string& copy(ElemPtr other) noexcept
+			{
+				return copy_chars(other, terminated_size(other), BufferOverlaps);
 			}
 
 #if defined(WOJ_HAS_CXX20)
 			/**
-			 * Copy from pointer m_data until null terminator is found or maximum size is reached (MemSize)
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
+			 * Copy from pointer buffer until null terminator is found or maximum size is reached (MemSize)
+			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
-			 * @param buffer_overlaps Whether the m_data overlaps with the string's m_data
+			 * @param buffer_overlaps Whether the buffer overlaps with internal buffer
 			 * @return Reference to self
 			 */
 			template <typename ElemPtr = const Elem* const>
 				requires std::is_pointer<ElemPtr>::value &&
-			std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)
+						 std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
+						 (!std::is_array<ElemPtr>::value)
 #else
 			/**
-			 * Copy from pointer m_data until null terminator is found or maximum size is reached (MemSize)
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
+			 * Copy from pointer buffer until null terminator is found or maximum size is reached (MemSize)
+			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
-			 * @param buffer_overlaps Whether the m_data overlaps with the string's m_data
+			 * @param buffer_overlaps Whether the buffer overlaps with internal buffer
 			 * @return Reference to self
 			 */
-			template < typename ElemPtr = const Elem* const, typename = std::enable_if_t<
-				std::is_pointer<ElemPtr>::value&&
+			template <typename ElemPtr = const Elem* const, typename = std::enable_if_t<
+				std::is_pointer<ElemPtr>::value &&
 				std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)>>
+				!std::is_array<ElemPtr>::value>>
 #endif
 				constexpr string& copy(ElemPtr other, const bool buffer_overlaps) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				size_type i = 0;
-
-				while (i < MemSize - 1 && !(m_data[i] = other[i++])) WOJ_LIKELY;
-
-				if (i < MemSize - 1) WOJ_LIKELY
-				{
-					m_data[i] = 0;
-				}
-
-				return *this;
+				return copy_chars(other, terminated_size(other), buffer_overlaps);
 			}
 
 #if defined(WOJ_HAS_CXX20)
 			/**
-			 * Copy from pointer m_data count of characters
+			 * Copy from pointer buffer count of characters
 			 * @tparam Count Count of characters to copy
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
+			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
 			 * @return Reference to self
 			 */
 			template <size_type Count, typename ElemPtr = const Elem* const>
-				requires std::is_pointer<ElemPtr>::value&&
-			std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)
+				requires std::is_pointer<ElemPtr>::value &&
+						 std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
+						 (!std::is_array<ElemPtr>::value)
 #else
 			/**
-			 * Copy from pointer m_data count of characters
+			 * Copy from pointer buffer count of characters
 			 * @tparam Count Count of characters to copy
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
+			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
 			 * @return Reference to self
 			 */
-			template <size_type Count, typename ElemPtr, typename = std::enable_if_t<
-				std::is_pointer<ElemPtr>::value&&
+			template <size_type Count, typename ElemPtr = const Elem* const, typename = std::enable_if_t<
+				std::is_pointer<ElemPtr>::value &&
 				std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)>>
+				!std::is_array<ElemPtr>::value>>
 #endif
 				constexpr string& copy(ElemPtr other) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				if (is_constant_evaluated())
-				{
-					constexpr bool buffer_smaller = Count < MemSize;
-					constexpr size_type size = (buffer_smaller ? Count : MemSize) * sizeof(Elem);
-
-
-					for (size_type i = 0; i < size; ++i)
-					{
-						m_data[i] = other[i];
-					}
-
-					if constexpr  (buffer_smaller)
-					{
-						m_data[Count] = 0;
-					}
-				}
-				else
-				{
-					if constexpr (Count < MemSize)
-					{
-						constexpr size_type byte_size = Count * sizeof(Elem);
-						std::memcpy(m_data, other, byte_size);
-
-						m_data[Count] = 0;
-					}
-					else
-					{
-						constexpr size_type byte_size = MemSize * sizeof(Elem);
-						std::memcpy(m_data, other, byte_size);
-					}
-				}
-
-				return *this;
+				return copy_chars(other, Count, false);
 			}
 
 #if defined(WOJ_HAS_CXX20)
@@ -1346,10 +675,8 @@ namespace woj
 			 * Copy from pointer buffer count of characters
 			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
 			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
-			 * Copy from pointer m_data count of characters
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
 			 * @param other Buffer to copy from
-			 * @param count MemSize of the m_data to copy from
+			 * @param count Count of characters to copy
 			 * @return Reference to self
 			 */
 			template <bool BufferOverlaps = false, typename ElemPtr = const Elem* const>
@@ -1362,76 +689,25 @@ namespace woj
 			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
 			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
-			 * @param count MemSize of the buffer to copy from
+			 * @param count Count of characters to copy
 			 * @return Reference to self
 			 */
-			template <bool BufferOverlaps = false,<typename ElemPtr = const Elem* const, typename = std::enable_if_t<
-				std::is_pointer<ElemPtr>::value&&
+			template <bool BufferOverlaps = false, typename ElemPtr = const Elem* const, typename = std::enable_if_t<
+				std::is_pointer<ElemPtr>::value &&
 				std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)>>
+				!std::is_array<ElemPtr>::value>>
 #endif
 				constexpr string& copy(ElemPtr other, const size_type count) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				if (is_constant_evaluated())
-				{
-					if (count < MemSize) WOJ_LIKELY
-					{
-						for (size_type i = 0; i < count; ++i) WOJ_LIKELY
-						{
-							m_data[i] = other[i];
-						}
-
-						m_data[count - 1] = 0;
-					}
-					else WOJ_UNLIKELY
-					{
-						for (size_type i = 0; i < MemSize; ++i) WOJ_LIKELY
-						{
-							m_data[i] = other[i];
-						}
-					}
-				}
-				else
-				{
-					if (count < MemSize) WOJ_LIKELY
-					{
-						if constexpr  (BufferOverlaps)
-						{
-							std::memmove(m_data, other, count * sizeof(Elem));
-						}
-						else
-						{
-							std::memcpy(m_data, other, count * sizeof(Elem));
-						}
-
-						m_data[count] = 0;
-					}
-					else WOJ_UNLIKELY
-					{
-						if constexpr  (BufferOverlaps)
-						{
-							std::memmove(m_data, other, MemSize * sizeof(Elem));
-						}
-						else
-						{
-							std::memcpy(m_data, other, MemSize * sizeof(Elem));
-						}
-					}
-				}
-
-				return *this;
+				return copy_chars(other, count, BufferOverlaps);
 			}
 
 #if defined(WOJ_HAS_CXX20)
 			/**
-			 * Copy from pointer m_data count of characters
-			 * @tparam BufferOverlaps Whether the m_data overlaps with the string's m_data
-			 * @tparam Count Count of characters to copy
+			 * Copy from pointer buffer count of characters
 			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
+			 * @tparam Count Count of characters to copy
 			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
 			 * @param other Buffer to copy from
 			 * @return Reference to self
 			 */
@@ -1442,176 +718,126 @@ namespace woj
 #else
 			/**
 			 * Copy from pointer buffer count of characters
-			 * @tparam Count Count of characters to copy
 			 * @tparam BufferOverlaps Whether the buffer overlaps with internal buffer
-			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
-			 * @param other Buffer to copy from
-			 * @return Reference to self
-			 */
-			template <size_type Count, bool BufferOverlaps = false, typename ElemPtr = const Elem* const, typename = std::enable_if_t<
-			/**
-			 * Copy from pointer m_data count of characters
-			 * @tparam BufferOverlaps Whether the m_data overlaps with the string's m_data
 			 * @tparam Count Count of characters to copy
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
+			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
 			 * @return Reference to self
 			 */
-			template <size_type Count, typename ElemPtr, typename = std::enable_if_t<
+			template <bool BufferOverlaps, size_type Count, typename ElemPtr = const Elem* const, typename = std::enable_if_t<
 				std::is_pointer<ElemPtr>::value &&
 				std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)>>
+				!std::is_array<ElemPtr>::value>>
 #endif
 				constexpr string& copy(ElemPtr other) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				if (is_constant_evaluated())
-				{
-					constexpr bool buffer_smaller = Count < MemSize;
-					constexpr size_type size = (buffer_smaller ? Count : MemSize) * sizeof(Elem);
-
-
-					for (size_type i = 0; i < size; ++i)
-					{
-						m_data[i] = other[i];
-					}
-
-					if constexpr (buffer_smaller)
-					{
-						m_data[Count] = 0;
-					}
-				}
-				else
-				{
-					constexpr bool buffer_smaller = Count < MemSize;
-					constexpr size_type byte_size = (buffer_smaller ? Count : MemSize) * sizeof(Elem);
-
-
-					if constexpr (BufferOverlaps)
-					{
-						std::memmove(m_data, other, byte_size);
-					}
-					else
-					{
-						std::memcpy(m_data, other, byte_size);
-					}
-
-
-					if constexpr (buffer_smaller)
-					{
-						m_data[Count] = 0;
-					}
-				}
-				return *this;
+				return copy_chars(other, Count, BufferOverlaps);
 			}
 
 #if defined(WOJ_HAS_CXX20)
 			/**
-			 * Copy from pointer m_data count of characters
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
+			 * Copy from pointer buffer count of characters
+			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
-			 * @param buffer_overlaps Whether the m_data overlaps with the string's m_data
+			 * @param buffer_overlaps Whether the buffer overlaps with internal buffer
 			 * @param count Count of characters to copy
 			 * @return Reference to self
 			 */
 			template <typename ElemPtr = const Elem* const>
-				requires std::is_pointer<ElemPtr>::value&&
-			std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)
+				requires std::is_pointer<ElemPtr>::value &&
+						 std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
+						 (!std::is_array<ElemPtr>::value)
 #else
 			/**
-			 * Copy from pointer m_data count of characters
-			 * @tparam ElemPtr Type of the pointer m_data (Default: const Elem* const)
+			 * Copy from pointer buffer count of characters
+			 * @tparam ElemPtr Type of the pointer buffer (Default: const Elem* const)
 			 * @param other Buffer to copy from
-			 * @param buffer_overlaps Whether the m_data overlaps with the string's m_data
+			 * @param buffer_overlaps Whether the buffer overlaps with internal buffer
 			 * @param count Count of characters to copy
 			 * @return Reference to self
 			 */
-			template <size_type Count, typename ElemPtr, typename = std::enable_if_t<
-				std::is_pointer<ElemPtr>::value&&
+			template <typename ElemPtr = const Elem* const, typename = std::enable_if_t<
+				std::is_pointer<ElemPtr>::value &&
 				std::is_same<typename std::remove_const<typename std::remove_pointer<typename std::remove_const<ElemPtr>::type>::type>::type, Elem>::value &&
-				(!std::is_array<ElemPtr>::value)>>
+				!std::is_array<ElemPtr>::value>>
 #endif
 				constexpr string& copy(ElemPtr other, const bool buffer_overlaps, const size_type count) noexcept
 			{
-				WOJ_ASSERT_ASSUME(other != nullptr);
-
-				if (is_constant_evaluated())
-				{
-					const bool buffer_smaller = count < MemSize;
-					const size_type size = (buffer_smaller ? count : MemSize) * sizeof(Elem);
-
-
-					for (size_type i = 0; i < size; ++i)
-					{
-						m_data[i] = other[i];
-					}
-
-					if constexpr (buffer_smaller)
-					{
-						m_data[count] = 0;
-					}
-				}
-				else
-				{
-					if (count < MemSize) WOJ_LIKELY
-					{
-						const size_type byte_size = count * sizeof(Elem);
-						if constexpr (buffer_overlaps)
-						{
-							std::memmove(m_data, other, byte_size);
-						}
-						else
-						{
-							std::memcpy(m_data, other, byte_size);
-						}
-
-						m_data[count - 1] = 0;
-					}
-					else WOJ_UNLIKELY
-					{
-						constexpr size_type byte_size = MemSize * sizeof(Elem);
-						if constexpr (buffer_overlaps)
-						{
-							std::memmove(m_data, other, byte_size);
-						}
-						else
-						{
-							std::memcpy(m_data, other, byte_size);
-						}
-					}
-				}
-
-				return *this;
+				return copy_chars(other, count, buffer_overlaps);
 			}
 
+			/**
+			 * Copy from another string (until its null terminator)
+			 * @tparam OtherElem Type of the other string's elements
+			 * @tparam OtherMemSize MemSize of the other string
+			 * @param other String to copy from
+			 * @return Reference to self
+			 */
 #if defined(WOJ_HAS_CXX20)
 			template <char_type OtherElem, size_type OtherMemSize>
 #else
 			template <typename OtherElem, size_type OtherMemSize>
 #endif
-			constexpr string& copy(const string<OtherElem, OtherMemSize>& other)
+			constexpr string& copy(const string<OtherElem, OtherMemSize>& other) noexcept
 			{
-				WOJ_ASSERT_ASSUME(this != &other);
-
-				copy(other.data());
-
-				return *this;
+				return copy(other, other.str_size());
 			}
 
+			/**
+			 * Copy count characters from another string (stops at its null terminator)
+			 * @tparam OtherElem Type of the other string's elements
+			 * @tparam OtherMemSize MemSize of the other string
+			 * @param other String to copy from
+			 * @param count Count of characters to copy
+			 * @return Reference to self
+			 */
 #if defined(WOJ_HAS_CXX20)
 			template <char_type OtherElem, size_type OtherMemSize>
 #else
 			template <typename OtherElem, size_type OtherMemSize>
 #endif
-			constexpr string& copy(const string<OtherElem, OtherMemSize>& other, const size_type count)
+			constexpr string& copy(const string<OtherElem, OtherMemSize>& other, size_type count) noexcept
 			{
-				WOJ_ASSERT_ASSUME(this != &other);
+				count = (std::min)(count, other.str_size());
 
-				copy(other.data(), count);
+				if constexpr (std::is_same<OtherElem, Elem>::value)
+				{
+					WOJ_ASSERT_ASSUME(static_cast<const void*>(this) != static_cast<const void*>(&other));
 
-				return *this;
+					return copy_chars(other.data(), count, false);
+				}
+				else
+				{
+					count = (std::min)(count, MemSize);
+
+					for (size_type i = 0; i < count; ++i)
+					{
+						m_data[i] = static_cast<Elem>(other.m_data[i]);
+					}
+
+					if (count < MemSize)
+					{
+						m_data[count] = 0;
+					}
+
+					return *this;
+				}
+			}
+
+			/**
+			 * @param other Null-terminated buffer
+			 * @return Count of characters before the null terminator, at most MemSize
+			 */
+			WOJ_NODISCARD static constexpr size_type terminated_size(const Elem* const other) noexcept
+			{
+				size_type size = 0;
+
+				while (size < MemSize && other[size]) WOJ_LIKELY
+				{
+					++size;
+				}
+
+				return size;
 			}
 
 			/**
@@ -1677,12 +903,12 @@ namespace woj
 			 */
 			constexpr string& swap(const size_type index1, const size_type index2) noexcept
 			{
-				WOJ_ASSERT_ASSUME(index1 >= 0 && index1 < MemSize);
-				WOJ_ASSERT_ASSUME(index2 >= 0 && index2 < MemSize);
+				WOJ_ASSERT_ASSUME(index1 < MemSize);
+				WOJ_ASSERT_ASSUME(index2 < MemSize);
 
-				m_data[index1] ^= m_data[index2];
-				m_data[index2] ^= m_data[index1];
-				m_data[index1] ^= m_data[index2];
+				const Elem temp = m_data[index1];
+				m_data[index1] = m_data[index2];
+				m_data[index2] = temp;
 				return *this;
 			}
 
@@ -1697,14 +923,83 @@ namespace woj
 
 				for (size_type i = 0; i < MemSize; ++i)
 				{
-					m_data[i] ^= other.m_data[i];
-					other.m_data[i] ^= m_data[i];
-					m_data[i] ^= other.m_data[i];
+					const Elem temp = m_data[i];
+					m_data[i] = other.m_data[i];
+					other.m_data[i] = temp;
 				}
 
 				return *this;
 			}
 
+			// ----- Comparison functions -----
+
+			/**
+			 * Checks whether the string holds the same characters (until null terminator) as a buffer
+			 * @param other Buffer to compare with
+			 * @param count Count of characters in the buffer
+			 * @return True if both hold the same characters
+			 */
+			WOJ_NODISCARD constexpr bool equals(const Elem* const other, const size_type count) const noexcept
+			{
+				if (str_size() != count)
+				{
+					return false;
+				}
+
+				if (is_constant_evaluated())
+				{
+					for (size_type i = 0; i < count; ++i)
+					{
+						if (m_data[i] != other[i])
+						{
+							return false;
+						}
+					}
+					return true;
+				}
+
+				// memcmp is vectorised by every mainstream C runtime
+				return !std::memcmp(m_data, other, count * sizeof(Elem));
+			}
+
+			/**
+			 * Checks whether the string holds the same characters (until null terminator) as another string
+			 * @tparam OtherMemSize MemSize of the other string
+			 * @param other String to compare with
+			 * @return True if both hold the same characters
+			 */
+			template <size_type OtherMemSize>
+			WOJ_NODISCARD constexpr bool equals(const string<Elem, OtherMemSize>& other) const noexcept
+			{
+				return equals(other.data(), other.str_size());
+			}
+
+			/**
+			 * Equality operator (compares characters until null terminator)
+			 * @tparam OtherMemSize MemSize of the other string
+			 * @param lhs String to compare
+			 * @param rhs String to compare with
+			 * @return True if both hold the same characters
+			 */
+			template <size_type OtherMemSize>
+			WOJ_NODISCARD friend constexpr bool operator==(const string& lhs, const string<Elem, OtherMemSize>& rhs) noexcept
+			{
+				return lhs.equals(rhs);
+			}
+
+			/**
+			 * Inequality operator (compares characters until null terminator)
+			 * @tparam OtherMemSize MemSize of the other string
+			 * @param lhs String to compare
+			 * @param rhs String to compare with
+			 * @return True if the strings hold different characters
+			 */
+			template <size_type OtherMemSize>
+			WOJ_NODISCARD friend constexpr bool operator!=(const string& lhs, const string<Elem, OtherMemSize>& rhs) noexcept
+			{
+				return !lhs.equals(rhs);
+			}
+
 			/**
 			 * Returns a reference to self as const, useful for const-correctness e.g. when iterating
 			 * @return Reference to self as const
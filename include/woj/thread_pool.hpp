@@ -0,0 +1,742 @@
+#pragma once
+
+#include "base.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#ifndef WOJ_THREAD_POOL_HPP
+#define WOJ_THREAD_POOL_HPP
+#endif
+
+namespace woj
+{
+	/**
+	 * Tasks spawned on a thread_pool and waited for together with thread_pool::sync, which has to be called before the
+	 * group is destroyed
+	 */
+	class task_group
+	{
+	public:
+		std::atomic<size_t> m_pending;
+		std::atomic<bool> m_failed;
+		std::exception_ptr m_exception;
+
+		task_group() noexcept : m_pending{ 0 }, m_failed{ false }, m_exception{} {}
+
+		task_group(const task_group&) = delete;
+
+		task_group& operator=(const task_group&) = delete;
+
+		/**
+		 * Keeps the first exception, tasks of a failed group that did not start yet are skipped
+		 */
+		void fail(std::exception_ptr exception) noexcept
+		{
+			if (!m_failed.exchange(true, std::memory_order_acq_rel))
+			{
+				m_exception = std::move(exception);
+			}
+		}
+	};
+
+	namespace detail
+	{
+		class task_arena;
+
+		/**
+		 * Header of a spawned task, the closure is stored right after it
+		 */
+		class alignas(std::max_align_t) task
+		{
+		public:
+			void (*m_invoke)(task& self, bool run);
+			task_group* m_group;
+			task_arena* m_arena;
+			size_t m_size;
+		};
+
+		/**
+		 * Bump allocator for the tasks spawned by one worker: allocation only moves an offset forward and the whole arena
+		 * is rewound once every task allocated from it is done (tasks may finish on other threads, hence the atomic count)
+		 */
+		class task_arena
+		{
+		public:
+			static constexpr size_t block_size = 65536;
+
+			woj::vector<void*> m_blocks;
+			size_t m_block;
+			size_t m_offset;
+			alignas(cache_line_size) std::atomic<size_t> m_live;
+
+			task_arena() noexcept : m_blocks{}, m_block{ 0 }, m_offset{ 0 }, m_live{ 0 } {}
+
+			task_arena(const task_arena&) = delete;
+
+			task_arena& operator=(const task_arena&) = delete;
+
+			~task_arena()
+			{
+				for (void* const block : m_blocks)
+				{
+					default_allocator::deallocate(block, block_size, alignof(task));
+				}
+			}
+
+			/**
+			 * @return Storage for size bytes, nullptr if size does not fit in a block
+			 */
+			WOJ_NODISCARD void* allocate(size_t size)
+			{
+				size = (size + alignof(task) - 1) & ~(alignof(task) - 1);
+				if (size > block_size)
+				{
+					return nullptr;
+				}
+
+				if (m_live.load(std::memory_order_acquire) == 0)
+				{
+					m_block = 0;
+					m_offset = 0;
+				}
+
+				if (m_offset + size > block_size)
+				{
+					++m_block;
+					m_offset = 0;
+				}
+
+				if (m_block == m_blocks.size())
+				{
+					m_blocks.push_back(default_allocator::allocate(block_size, alignof(task)));
+				}
+
+				void* const memory = static_cast<std::byte*>(m_blocks[m_block]) + m_offset;
+				m_offset += size;
+				m_live.fetch_add(1, std::memory_order_relaxed);
+				return memory;
+			}
+
+			void release() noexcept
+			{
+				m_live.fetch_sub(1, std::memory_order_release);
+			}
+		};
+
+		/**
+		 * Chase-Lev work-stealing deque: the owning worker pushes and pops at the bottom, other threads steal from the top
+		 */
+		class task_deque
+		{
+		public:
+			static constexpr int64_t capacity = 4096;
+
+			alignas(cache_line_size) std::atomic<int64_t> m_top;
+			alignas(cache_line_size) std::atomic<int64_t> m_bottom;
+			alignas(cache_line_size) std::array<std::atomic<task*>, capacity> m_tasks;
+
+			task_deque() noexcept : m_top{ 0 }, m_bottom{ 0 }, m_tasks{} {}
+
+			/**
+			 * Owner only
+			 * @return Whether there was room for the task
+			 */
+			WOJ_NODISCARD bool push(task* const pushed) noexcept
+			{
+				const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+				const int64_t top = m_top.load(std::memory_order_acquire);
+				if (bottom - top >= capacity)
+				{
+					return false;
+				}
+
+				m_tasks[static_cast<size_t>(bottom & (capacity - 1))].store(pushed, std::memory_order_release);
+				m_bottom.store(bottom + 1, std::memory_order_release);
+				return true;
+			}
+
+			/**
+			 * Owner only, takes the most recently pushed task
+			 */
+			WOJ_NODISCARD task* pop() noexcept
+			{
+				const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+				m_bottom.store(bottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t top = m_top.load(std::memory_order_relaxed);
+
+				if (top > bottom)
+				{
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				task* popped = m_tasks[static_cast<size_t>(bottom & (capacity - 1))].load(std::memory_order_relaxed);
+				if (top == bottom)
+				{
+					// Last task, a thief may be taking it at the same time
+					if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					{
+						popped = nullptr;
+					}
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+				return popped;
+			}
+
+			/**
+			 * Any thread, takes the oldest task
+			 */
+			WOJ_NODISCARD task* steal() noexcept
+			{
+				int64_t top = m_top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+				if (top >= bottom)
+				{
+					return nullptr;
+				}
+
+				task* const stolen = m_tasks[static_cast<size_t>(top & (capacity - 1))].load(std::memory_order_acquire);
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					return nullptr;
+				}
+				return stolen;
+			}
+		};
+
+		class worker
+		{
+		public:
+			const void* m_pool;
+			size_t m_index;
+			uint64_t m_random;
+			task_arena m_arena;
+			task_deque m_deque;
+
+			worker(const void* const pool, const size_t index) noexcept : m_pool{ pool }, m_index{ index }, m_random{ 0x9E3779B97F4A7C15ull * (index + 1) }, m_arena{}, m_deque{} {}
+		};
+
+		WOJ_NODISCARD inline worker*& current_worker() noexcept
+		{
+			static thread_local worker* current = nullptr;
+			return current;
+		}
+
+		WOJ_NODISCARD inline uint64_t next_random(uint64_t& state) noexcept
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+
+		/**
+		 * Restricts the calling thread to one hardware thread (no-op on platforms without affinity support)
+		 */
+		inline void pin_current_thread(const size_t core) noexcept
+		{
+			const unsigned int hardware_threads = std::thread::hardware_concurrency();
+			if (hardware_threads == 0)
+			{
+				return;
+			}
+
+#if defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(core % hardware_threads, &set);
+			pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+			SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << (core % hardware_threads % (sizeof(DWORD_PTR) * CHAR_BIT)));
+#else
+			static_cast<void>(core);
+#endif
+		}
+	}
+
+	/**
+	 * Work-stealing scheduler: every worker owns a Chase-Lev deque it pushes spawned tasks to and pops them from,
+	 * idle workers steal the oldest tasks of random victims, threads outside the pool spawn through a global injection
+	 * queue and help executing tasks while they wait in sync; workers with nothing to do park on a futex
+	 */
+	class thread_pool
+	{
+	public:
+		/**
+		 * Attempts to find a task before a worker, or a thread waiting in sync, parks
+		 */
+		static constexpr size_t search_attempts = 64;
+
+		woj::vector<std::unique_ptr<detail::worker>> m_workers;
+		woj::vector<std::thread> m_threads;
+		std::mutex m_injection_mutex;
+		std::deque<detail::task*> m_injected;
+		std::atomic<size_t> m_injected_size;
+		alignas(cache_line_size) std::atomic<uint32_t> m_epoch;
+		std::atomic<uint32_t> m_sleeping;
+		std::atomic<bool> m_stopping;
+		alignas(cache_line_size) std::atomic<uint32_t> m_sync_epoch;
+		std::atomic<uint32_t> m_sync_sleeping;
+
+		/**
+		 * @param thread_count Count of threads running tasks including the one waiting in sync, 0 uses the hardware concurrency
+		 * @param pin_threads Whether to restrict every worker to its own hardware thread (the first one is left to the caller)
+		 */
+		explicit thread_pool(size_t thread_count = 0, const bool pin_threads = false) : m_injected_size{ 0 }, m_epoch{ 0 }, m_sleeping{ 0 }, m_stopping{ false }, m_sync_epoch{ 0 }, m_sync_sleeping{ 0 }
+		{
+			if (thread_count == 0)
+			{
+				thread_count = (std::max)(1u, std::thread::hardware_concurrency());
+			}
+
+			m_workers.reserve(thread_count - 1);
+			for (size_t i = 0; i + 1 < thread_count; ++i)
+			{
+				m_workers.push_back(std::make_unique<detail::worker>(this, i));
+			}
+
+			try
+			{
+				m_threads.reserve(m_workers.size());
+				for (const std::unique_ptr<detail::worker>& owned : m_workers)
+				{
+					m_threads.emplace_back([this, &worker = *owned, pin_threads] { worker_loop(worker, pin_threads); });
+				}
+			}
+			catch (...)
+			{
+				stop();
+				throw;
+			}
+		}
+
+		thread_pool(const thread_pool&) = delete;
+
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		~thread_pool()
+		{
+			stop();
+		}
+
+		WOJ_NODISCARD size_t thread_count() const noexcept
+		{
+			return m_workers.size() + 1;
+		}
+
+		/**
+		 * Schedules function() to run on the pool as part of group, workers allocate the task from their bump arena,
+		 * other threads from the heap (without workers the task runs immediately)
+		 * @param group Group sync waits on
+		 * @param function Function to call, copied or moved into the task
+		 */
+		template <typename Function>
+		void spawn(task_group& group, Function&& function)
+		{
+			using closure_type = std::decay_t<Function>;
+			static_assert(alignof(closure_type) <= alignof(detail::task), "Over-aligned tasks are not supported");
+
+			constexpr size_t size = sizeof(detail::task) + sizeof(closure_type);
+
+			detail::worker* const worker = local_worker();
+			void* memory = worker != nullptr ? worker->m_arena.allocate(size) : nullptr;
+			detail::task_arena* const arena = memory != nullptr ? &worker->m_arena : nullptr;
+			if (memory == nullptr)
+			{
+				memory = default_allocator::allocate(size, alignof(detail::task));
+			}
+
+			detail::task* const spawned = static_cast<detail::task*>(memory);
+			try
+			{
+				::new (static_cast<void*>(spawned + 1)) closure_type(std::forward<Function>(function));
+			}
+			catch (...)
+			{
+				free_task(memory, arena, size);
+				throw;
+			}
+			::new (memory) detail::task{ &invoke_task<closure_type>, &group, arena, size };
+			group.m_pending.fetch_add(1, std::memory_order_relaxed);
+
+			if (worker != nullptr)
+			{
+				if (!worker->m_deque.push(spawned))
+				{
+					execute(*spawned);
+					return;
+				}
+			}
+			else if (m_workers.empty())
+			{
+				execute(*spawned);
+				return;
+			}
+			else
+			{
+				try
+				{
+					std::lock_guard lock{ m_injection_mutex };
+					m_injected.push_back(spawned);
+					m_injected_size.fetch_add(1, std::memory_order_relaxed);
+				}
+				catch (...)
+				{
+					execute(*spawned);
+					return;
+				}
+			}
+			notify_work();
+		}
+
+		/**
+		 * Waits for every task of group, executing tasks of the pool in the meantime (parking when there are none), then
+		 * rethrows the first exception thrown by a task of the group
+		 * @param group Group to wait for
+		 */
+		void sync(task_group& group)
+		{
+			detail::worker* const worker = local_worker();
+			size_t attempt = 0;
+			while (group.m_pending.load(std::memory_order_acquire) != 0)
+			{
+				detail::task* found = find_task(worker);
+				if (found == nullptr && ++attempt < search_attempts)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				if (found == nullptr)
+				{
+					// Parks on its own word, woken by the completion of a group or by new tasks no parked worker can take
+					const uint32_t epoch = m_sync_epoch.load(std::memory_order_acquire);
+					m_sync_sleeping.fetch_add(1, std::memory_order_seq_cst);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+
+					if (group.m_pending.load(std::memory_order_acquire) != 0)
+					{
+						found = find_task(worker);
+						if (found == nullptr)
+						{
+							m_sync_epoch.wait(epoch, std::memory_order_acquire);
+						}
+					}
+					m_sync_sleeping.fetch_sub(1, std::memory_order_relaxed);
+				}
+
+				attempt = 0;
+				if (found != nullptr)
+				{
+					execute(*found);
+				}
+			}
+
+			if (group.m_failed.load(std::memory_order_acquire))
+			{
+				std::exception_ptr exception = std::exchange(group.m_exception, nullptr);
+				group.m_failed.store(false, std::memory_order_relaxed);
+				std::rethrow_exception(std::move(exception));
+			}
+		}
+
+		/**
+		 * Calls function(chunk_begin, chunk_end) for consecutive chunks of grain indices covering [begin, end), spread over
+		 * the pool by recursively splitting the range in halves; returns once every chunk is done, rethrowing the first
+		 * exception thrown by function
+		 * @param begin First index
+		 * @param end Past the last index
+		 * @param grain Count of indices per chunk (at least 1)
+		 * @param function Function called with the bounds of each chunk
+		 */
+		template <typename Function>
+		void parallel_for(const size_t begin, const size_t end, size_t grain, Function&& function)
+		{
+			if (begin >= end)
+			{
+				return;
+			}
+
+			grain = (std::max)(grain, size_t{ 1 });
+			if (end - begin <= grain || m_workers.empty())
+			{
+				for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += grain)
+				{
+					function(chunk_begin, end - chunk_begin > grain ? chunk_begin + grain : end);
+				}
+				return;
+			}
+
+			task_group group;
+			try
+			{
+				parallel_for_split(group, begin, end, grain, function);
+			}
+			catch (...)
+			{
+				group.fail(std::current_exception());
+			}
+			sync(group);
+		}
+
+	private:
+		template <typename Closure>
+		static void invoke_task(detail::task& self, const bool run)
+		{
+			class destroy_guard
+			{
+			public:
+				Closure* m_closure;
+
+				~destroy_guard()
+				{
+					m_closure->~Closure();
+				}
+			};
+
+			const destroy_guard guard{ std::launder(reinterpret_cast<Closure*>(&self + 1)) };
+			if (run)
+			{
+				(*guard.m_closure)();
+			}
+		}
+
+		static void free_task(void* const memory, detail::task_arena* const arena, const size_t size) noexcept
+		{
+			if (arena != nullptr)
+			{
+				arena->release();
+			}
+			else
+			{
+				default_allocator::deallocate(memory, size, alignof(detail::task));
+			}
+		}
+
+		void execute(detail::task& executed) noexcept
+		{
+			task_group& group = *executed.m_group;
+			try
+			{
+				executed.m_invoke(executed, !group.m_failed.load(std::memory_order_relaxed));
+			}
+			catch (...)
+			{
+				group.fail(std::current_exception());
+			}
+
+			free_task(&executed, executed.m_arena, executed.m_size);
+			if (group.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				// The group may be gone once its count is 0, a thread parked in sync is woken through the pool
+				notify_parked();
+			}
+		}
+
+		template <typename Function>
+		void parallel_for_split(task_group& group, const size_t begin, size_t end, const size_t grain, Function& function)
+		{
+			// The upper half is spawned until a single chunk is left for this thread, chunk bounds stay multiples of grain from begin
+			while (end - begin > grain)
+			{
+				const size_t chunk_count = (end - begin + grain - 1) / grain;
+				const size_t middle = begin + chunk_count / 2 * grain;
+				spawn(group, [this, &group, middle, end, grain, &function]
+				{
+					parallel_for_split(group, middle, end, grain, function);
+				});
+				end = middle;
+			}
+			function(begin, end);
+		}
+
+		WOJ_NODISCARD detail::worker* local_worker() const noexcept
+		{
+			detail::worker* const worker = detail::current_worker();
+			return worker != nullptr && worker->m_pool == this ? worker : nullptr;
+		}
+
+		/**
+		 * Looks for a task in the own deque (newest first), then the injection queue, then steals from the other workers
+		 */
+		WOJ_NODISCARD detail::task* find_task(detail::worker* const worker)
+		{
+			if (worker != nullptr)
+			{
+				if (detail::task* const popped = worker->m_deque.pop())
+				{
+					return popped;
+				}
+			}
+
+			if (m_injected_size.load(std::memory_order_relaxed) != 0)
+			{
+				// Like with the deques, threads outside the pool take their newest tasks back while workers take the oldest,
+				// so a thread waiting in sync does not start ever bigger tasks on top of its stack
+				std::lock_guard lock{ m_injection_mutex };
+				if (!m_injected.empty())
+				{
+					detail::task* injected;
+					if (worker != nullptr)
+					{
+						injected = m_injected.front();
+						m_injected.pop_front();
+					}
+					else
+					{
+						injected = m_injected.back();
+						m_injected.pop_back();
+					}
+					m_injected_size.fetch_sub(1, std::memory_order_relaxed);
+					return injected;
+				}
+			}
+
+			const size_t worker_count = m_workers.size();
+			if (worker_count == 0)
+			{
+				return nullptr;
+			}
+
+			thread_local uint64_t external_random = 0x2545F4914F6CDD1Dull;
+			const size_t first = static_cast<size_t>(detail::next_random(worker != nullptr ? worker->m_random : external_random) % worker_count);
+			for (size_t i = 0; i < worker_count; ++i)
+			{
+				detail::worker& victim = *m_workers[(first + i) % worker_count];
+				if (&victim != worker)
+				{
+					if (detail::task* const stolen = victim.m_deque.steal())
+					{
+						return stolen;
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		void notify_work() noexcept
+		{
+			// Pairs with the fences in worker_loop and sync: either the parking thread sees the new task or this sees the thread
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_sleeping.load(std::memory_order_relaxed) != 0)
+			{
+				// Only workers park on this word, the woken one takes the task or parks again after searching for it
+				m_epoch.fetch_add(1, std::memory_order_release);
+				m_epoch.notify_one();
+			}
+			else if (m_sync_sleeping.load(std::memory_order_relaxed) != 0)
+			{
+				// Every worker is busy (or there are none), the threads waiting in sync help
+				notify_sync();
+			}
+		}
+
+		void notify_parked() noexcept
+		{
+			// Pairs with the fence in sync: either the parking thread sees the completed group or this sees the thread
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_sync_sleeping.load(std::memory_order_relaxed) != 0)
+			{
+				notify_sync();
+			}
+		}
+
+		void notify_sync() noexcept
+		{
+			m_sync_epoch.fetch_add(1, std::memory_order_release);
+			m_sync_epoch.notify_all();
+		}
+
+		void worker_loop(detail::worker& worker, const bool pin_thread)
+		{
+			detail::current_worker() = &worker;
+			if (pin_thread)
+			{
+				detail::pin_current_thread(worker.m_index + 1);
+			}
+
+			for (;;)
+			{
+				detail::task* found = nullptr;
+				for (size_t attempt = 0; attempt < search_attempts && found == nullptr; ++attempt)
+				{
+					found = find_task(&worker);
+					if (found == nullptr && attempt + 1 < search_attempts)
+					{
+						std::this_thread::yield();
+					}
+				}
+
+				if (found == nullptr)
+				{
+					const uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+					m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+
+					if (m_stopping.load(std::memory_order_acquire))
+					{
+						m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+						return;
+					}
+
+					found = find_task(&worker);
+					if (found == nullptr)
+					{
+						m_epoch.wait(epoch, std::memory_order_acquire);
+					}
+					m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+				}
+
+				if (found != nullptr)
+				{
+					execute(*found);
+				}
+			}
+		}
+
+		void stop() noexcept
+		{
+			m_stopping.store(true, std::memory_order_release);
+			m_epoch.fetch_add(1, std::memory_order_release);
+			m_epoch.notify_all();
+
+			for (std::thread& thread : m_threads)
+			{
+				thread.join();
+			}
+			m_threads.clear();
+		}
+	};
+
+	/**
+	 * Pool owned by the library, created on first use with one thread per hardware thread
+	 */
+	WOJ_NODISCARD inline thread_pool& default_thread_pool()
+	{
+		static thread_pool pool{};
+		return pool;
+	}
+}
@@ -5,9 +5,10 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <cstring>
+#include <cwchar>
 
 #include "base.hpp"
-#include "defs.hpp"
 
 namespace woj
 {
@@ -1,8 +1,15 @@
 #pragma once
 
 #include "base.hpp"
+#include "memory.hpp"
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ratio>
 
 #ifndef WOJ_VECTOR_HPP
 #define WOJ_VECTOR_HPP
@@ -18,6 +25,24 @@ namespace woj
 		constexpr out_of_vector_range(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Out of vector range", file, function } {}
 	};
 
+	class vector_capacity_exceeded final : public exception
+	{
+	public:
+		constexpr vector_capacity_exceeded() noexcept : exception{ static_cast<uint64_t>(-1), "Vector capacity exceeded", nullptr, nullptr } {}
+
+		constexpr vector_capacity_exceeded(const size_t line, const char* const file, const char* const function) noexcept : exception{ line, "Vector capacity exceeded", file, function } {}
+	};
+
+	namespace detail
+	{
+		/**
+		 * Lazy element-wise expression (see vector_expression.hpp) producing Size values of ElementType
+		 */
+		template <typename Expression, typename ElementType, size_t Size>
+		concept vector_expression_of = Expression::is_vector_expression && std::is_same_v<typename Expression::value_type, ElementType> && Expression::size() == Size
+			&& requires(const Expression& expression, ElementType* const destination) { expression.evaluate(destination); };
+	}
+
 	namespace stack
 	{
 		template <typename ElementType, size_t Size>
@@ -609,106 +634,117 @@ namespace woj
 				alignas(ElementType) ElementType m_data[Size];
 			};
 
-			constexpr vector() noexcept : m_data{} {}
+			constexpr vector() noexcept(std::is_nothrow_default_constructible_v<ElementType>) : m_data{} {}
 
-			explicit constexpr vector(const none_t) noexcept : m_data{} {}
+			explicit constexpr vector(const none_t) noexcept(std::is_nothrow_default_constructible_v<ElementType>) : m_data{} {}
 
-			explicit constexpr vector(const noinit_t noinit) noexcept
+			/**
+			 * Leaves trivial elements uninitialized, other element types are still value-initialized
+			 */
+			explicit constexpr vector(const noinit_t) noexcept(std::is_nothrow_default_constructible_v<ElementType>)
 			{
-				if (is_constant_evaluated())
+				if (!std::is_trivially_default_constructible_v<ElementType> || is_constant_evaluated())
 				{
-					m_data = {};
+					woj::uninitialized_value_construct_n(m_data, Size);
 				}
 			}
 			
-			explicit constexpr vector(const ElementType& value) noexcept
+			explicit constexpr vector(const ElementType& value) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
 			{
-				if (is_constant_evaluated())
-				{
-					std::fill_n(m_data, Size, value);
-				}
 				if constexpr (std::is_same_v<ElementType, unsigned char> || std::is_same_v<ElementType, char> || std::is_same_v<ElementType, wchar_t> || std::is_same_v<ElementType, char8_t>)
 				{
-					memset(m_data, value, Size * sizeof(ElementType));
-				}
-				else
-				{
-					std::fill_n(m_data, Size, value);
+					if (!is_constant_evaluated())
+					{
+						memset(m_data, value, Size * sizeof(ElementType));
+						return;
+					}
 				}
+				woj::uninitialized_fill_n(m_data, Size, value);
 			}
 
-			explicit constexpr vector(const ElementType (&other)[Size]) noexcept
+			explicit constexpr vector(const ElementType (&other)[Size]) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
 			{
-				if (is_constant_evaluated())
-				{
-					std::copy_n(other, Size, m_data);
-				}
-				else
-				{
-					memcpy(m_data, other, Size * sizeof(ElementType));
-				}
+				woj::uninitialized_copy_n(other, Size, m_data);
 			}
 
+			/**
+			 * Copies the first min(Size, OtherSize) elements, the rest is left like with noinit
+			 */
 			template <size_t OtherSize> requires (OtherSize != Size)
-			explicit constexpr vector(const ElementType(&other)[OtherSize]) noexcept
+			explicit constexpr vector(const ElementType(&other)[OtherSize]) noexcept(std::is_nothrow_copy_constructible_v<ElementType> && std::is_nothrow_default_constructible_v<ElementType>)
 			{
-				constexpr size_t min_size = Size < OtherSize ? Size : OtherSize;
-				if (is_constant_evaluated())
-				{
-					std::copy_n(other, min_size, m_data);
-				}
-				else
-				{
-					memcpy(m_data, other, min_size * sizeof(ElementType));
-				}
+				construct_from(other, Size < OtherSize ? Size : OtherSize);
 			}
 
-			constexpr vector(const std::initializer_list<ElementType>& other) noexcept
+			constexpr vector(const std::initializer_list<ElementType>& other) noexcept(std::is_nothrow_copy_constructible_v<ElementType> && std::is_nothrow_default_constructible_v<ElementType>)
 			{
-				const size_t min_size = Size < other.size() ? Size : other.size();
-				if (is_constant_evaluated())
-				{
-					std::copy_n(other.begin(), min_size, m_data);
-				}
-				else
-				{
-					memcpy(m_data, other.begin(), min_size);
-				}
+				construct_from(other.begin(), Size < other.size() ? Size : other.size());
 			}
 
 			template <typename... OthersValueTypes>
 			explicit constexpr vector(in_place_t, OthersValueTypes&&... other_values) noexcept : m_data{ std::forward<OthersValueTypes>(other_values)...} {}
 
-			constexpr vector(const vector& other) noexcept
+			/**
+			 * Evaluates a lazy element-wise expression in a single pass
+			 */
+			template <typename Expression> requires detail::vector_expression_of<Expression, ElementType, Size>
+			constexpr vector(const Expression& expression) noexcept : vector{ noinit_t{} }
 			{
-				if (is_constant_evaluated())
-				{
-					std::copy_n(other.m_data, Size, m_data);
-				}
-				else
-				{
-					memcpy(m_data, other.m_data, Size * sizeof(ElementType));
-				}
+				expression.evaluate(m_data);
 			}
 
-			~vector() noexcept = default;
+			constexpr vector(const vector& other) requires std::is_trivially_copy_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
 
-			constexpr vector& operator=(const vector& other) noexcept
+			constexpr vector(const vector& other) noexcept(std::is_nothrow_copy_constructible_v<ElementType>)
+			{
+				woj::uninitialized_copy_n(other.m_data, Size, m_data);
+			}
+
+			constexpr vector(vector&& other) requires std::is_trivially_move_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr vector(vector&& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+			{
+				woj::uninitialized_move_n(other.m_data, Size, m_data);
+			}
+
+			constexpr ~vector() requires std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr ~vector() noexcept
+			{
+				std::destroy_n(m_data, Size);
+			}
+
+			constexpr vector& operator=(const vector& other) requires std::is_trivially_copy_assignable_v<ElementType> && std::is_trivially_copy_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr vector& operator=(const vector& other) noexcept(std::is_nothrow_copy_assignable_v<ElementType>)
 			{
-#ifndef NDEBUG
 				if (this == &other)
 				{
 					return *this;
 				}
-#endif
-				if (is_constant_evaluated())
-				{
-					std::copy_n(other.m_data, Size, m_data);
-				}
-				else
+				std::copy_n(other.m_data, Size, m_data);
+				return *this;
+			}
+
+			constexpr vector& operator=(vector&& other) requires std::is_trivially_move_assignable_v<ElementType> && std::is_trivially_move_constructible_v<ElementType> && std::is_trivially_destructible_v<ElementType> = default;
+
+			constexpr vector& operator=(vector&& other) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				if (this == &other)
 				{
-					memcpy(m_data, other.m_data, Size * sizeof(ElementType));
+					return *this;
 				}
+				std::move(other.m_data, other.m_data + Size, m_data);
+				return *this;
+			}
+
+			/**
+			 * Evaluates a lazy element-wise expression in a single pass, the expression may refer to this vector
+			 */
+			template <typename Expression> requires detail::vector_expression_of<Expression, ElementType, Size>
+			constexpr vector& operator=(const Expression& expression) noexcept
+			{
+				expression.evaluate(m_data);
 				return *this;
 			}
 
@@ -725,7 +761,7 @@ namespace woj
 #ifndef NDEBUG
 				if (index >= Size)
 				{
-					throw out_of_vector_range{ 449ull, "vector.hpp", "woj::stack::vector<ElementType, Size>::operator[]" };
+					throw out_of_vector_range{ 764ull, "vector.hpp", "woj::stack::vector<ElementType, Size>::operator[]" };
 				}
 #endif
 
@@ -756,6 +792,31 @@ namespace woj
 			{
 				return Size;
 			}
+
+		private:
+			constexpr void construct_from(const ElementType* const source, const size_t count) noexcept(std::is_nothrow_copy_constructible_v<ElementType> && std::is_nothrow_default_constructible_v<ElementType>)
+			{
+				woj::uninitialized_copy_n(source, count, m_data);
+				if (!std::is_trivially_default_constructible_v<ElementType> || is_constant_evaluated())
+				{
+					if constexpr (std::is_nothrow_default_constructible_v<ElementType>)
+					{
+						woj::uninitialized_value_construct_n(m_data + count, Size - count);
+					}
+					else
+					{
+						try
+						{
+							woj::uninitialized_value_construct_n(m_data + count, Size - count);
+						}
+						catch (...)
+						{
+							std::destroy_n(m_data, count);
+							throw;
+						}
+					}
+				}
+			}
 		};
 
 		template <typename ElementType>
@@ -795,7 +856,7 @@ namespace woj
 			constexpr ElementType operator[](const size_t) const noexcept
 			{
 #ifndef NDEBUG
-				throw out_of_vector_range{ 512ull, "vector.hpp", "woj::stack::vector<ElementType, 0ull>::operator[]" };
+				throw out_of_vector_range{ 859ull, "vector.hpp", "woj::stack::vector<ElementType, 0ull>::operator[]" };
 #else
 				return ElementType{};
 #endif
@@ -807,7 +868,7 @@ namespace woj
 			static WOJ_CONSTEVAL const ElementType(& data() noexcept)[1]
 			{
 #ifndef NDEBUG
-				throw out_of_vector_range{ 524ull, "vector.hpp", "woj::stack::vector<ElementType, 0ull>::data" };
+				throw out_of_vector_range{ 871ull, "vector.hpp", "woj::stack::vector<ElementType, 0ull>::data" };
 #else
 				char c = 0;
 				return reinterpret_cast<const ElementType(&)[1]>(c);
@@ -839,4 +900,957 @@ namespace woj
 		template <typename... OthersValueTypes>
 		vector(const in_place_t, OthersValueTypes&&...) -> vector<std::common_type_t<std::remove_cvref_t<OthersValueTypes>...>, sizeof...(OthersValueTypes)>;
 	}
+
+	namespace detail
+	{
+		/**
+		 * Storage management shared by the growable vectors, the elements are stored in memory obtained from an allocator
+		 * or in the inline storage of Derived while they fit in it
+		 * @tparam Derived Vector type, provides ElementType m_inline[InlineCapacity] when InlineCapacity is not 0
+		 * @tparam ElementType Type of the elements
+		 * @tparam Allocator Allocator providing the storage (see allocator_type), reallocate() is used for trivially relocatable elements when available
+		 * @tparam GrowthFactor std::ratio the capacity is multiplied by when the vector runs out of room
+		 * @tparam InlineCapacity Count of elements stored without allocating
+		 */
+		template <typename Derived, typename ElementType, typename Allocator, typename GrowthFactor, size_t InlineCapacity>
+		class growable_vector_base
+		{
+		public:
+			using value_type = ElementType;
+			using allocator_type = Allocator;
+			using size_type = size_t;
+			using difference_type = ptrdiff_t;
+			using reference = ElementType&;
+			using const_reference = const ElementType&;
+			using pointer = ElementType*;
+			using const_pointer = const ElementType*;
+			using iterator = ElementType*;
+			using const_iterator = const ElementType*;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			static_assert(woj::allocator_type<Allocator>, "Allocator must provide allocate(size, alignment) and noexcept deallocate(ptr, size, alignment)");
+			static_assert(std::ratio_greater_v<GrowthFactor, std::ratio<1>>, "Growth factor must be greater than 1");
+
+			/**
+			 * Capacity of the first allocation made by a growing vector without inline storage (one cache line worth of
+			 * elements), vectors with inline storage grow geometrically from the inline capacity
+			 */
+			static constexpr size_type initial_capacity = InlineCapacity != 0 ? InlineCapacity : (sizeof(ElementType) < 64 ? 64 / sizeof(ElementType) : 1);
+
+			/**
+			 * Points either to the allocated storage or to the inline storage (nullptr without one)
+			 */
+			ElementType* m_data;
+			size_type m_size;
+			size_type m_capacity;
+			WOJ_NO_UNIQUE_ADDRESS Allocator m_allocator;
+
+			explicit constexpr operator bool() const noexcept
+			{
+				return m_size != 0;
+			}
+
+			// ----- Element access -----
+
+			constexpr const ElementType& operator[](const size_type index) const noexcept
+	#ifndef NDEBUG
+			(false)
+	#endif
+			{
+	#ifndef NDEBUG
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 964ull, "vector.hpp", "woj::detail::growable_vector_base<Derived, ElementType, Allocator, GrowthFactor, InlineCapacity>::operator[]" };
+				}
+	#endif
+
+				return m_data[index];
+			}
+
+			constexpr ElementType& operator[](const size_type index) noexcept
+	#ifndef NDEBUG
+			(false)
+	#endif
+			{
+	#ifndef NDEBUG
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 979ull, "vector.hpp", "woj::detail::growable_vector_base<Derived, ElementType, Allocator, GrowthFactor, InlineCapacity>::operator[]" };
+				}
+	#endif
+
+				return m_data[index];
+			}
+
+			/**
+			 * Accesses an element with bounds checking in every build
+			 */
+			constexpr const ElementType& at(const size_type index) const
+			{
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 993ull, "vector.hpp", "woj::detail::growable_vector_base<Derived, ElementType, Allocator, GrowthFactor, InlineCapacity>::at" };
+				}
+				return m_data[index];
+			}
+
+			constexpr ElementType& at(const size_type index)
+			{
+				if (index >= m_size)
+				{
+					throw out_of_vector_range{ 1002ull, "vector.hpp", "woj::detail::growable_vector_base<Derived, ElementType, Allocator, GrowthFactor, InlineCapacity>::at" };
+				}
+				return m_data[index];
+			}
+
+			WOJ_NODISCARD constexpr const ElementType& front() const noexcept
+			{
+				return m_data[0];
+			}
+
+			WOJ_NODISCARD constexpr ElementType& front() noexcept
+			{
+				return m_data[0];
+			}
+
+			WOJ_NODISCARD constexpr const ElementType& back() const noexcept
+			{
+				return m_data[m_size - 1];
+			}
+
+			WOJ_NODISCARD constexpr ElementType& back() noexcept
+			{
+				return m_data[m_size - 1];
+			}
+
+			WOJ_NODISCARD constexpr const ElementType* data() const noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr ElementType* data() noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr const Allocator& get_allocator() const noexcept
+			{
+				return m_allocator;
+			}
+
+			// ----- Iterators -----
+
+			WOJ_NODISCARD constexpr iterator begin() noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator begin() const noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cbegin() const noexcept
+			{
+				return m_data;
+			}
+
+			WOJ_NODISCARD constexpr iterator end() noexcept
+			{
+				return m_data + m_size;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator end() const noexcept
+			{
+				return m_data + m_size;
+			}
+
+			WOJ_NODISCARD constexpr const_iterator cend() const noexcept
+			{
+				return m_data + m_size;
+			}
+
+			WOJ_NODISCARD constexpr reverse_iterator rbegin() noexcept
+			{
+				return reverse_iterator{ end() };
+			}
+
+			WOJ_NODISCARD constexpr const_reverse_iterator rbegin() const noexcept
+			{
+				return const_reverse_iterator{ end() };
+			}
+
+			WOJ_NODISCARD constexpr reverse_iterator rend() noexcept
+			{
+				return reverse_iterator{ begin() };
+			}
+
+			WOJ_NODISCARD constexpr const_reverse_iterator rend() const noexcept
+			{
+				return const_reverse_iterator{ begin() };
+			}
+
+			// ----- Capacity -----
+
+			WOJ_NODISCARD constexpr size_type size() const noexcept
+			{
+				return m_size;
+			}
+
+			WOJ_NODISCARD constexpr bool empty() const noexcept
+			{
+				return m_size == 0;
+			}
+
+			WOJ_NODISCARD constexpr size_type capacity() const noexcept
+			{
+				return m_capacity;
+			}
+
+			static constexpr size_type max_size() noexcept
+			{
+				return static_cast<size_type>(std::numeric_limits<ptrdiff_t>::max()) / sizeof(ElementType);
+			}
+
+			/**
+			 * Makes room for at least count elements without further allocations
+			 * @param count Requested capacity
+			 */
+			constexpr void reserve(const size_type count)
+			{
+				if (count > m_capacity)
+				{
+					check_capacity(count, 1124ull, "woj::detail::growable_vector_base<Derived, ElementType, Allocator, GrowthFactor, InlineCapacity>::reserve");
+					reallocate(count);
+				}
+			}
+
+			/**
+			 * Shrinks the capacity to the size, moving the elements back to the inline storage when they fit (an empty
+			 * vector without inline storage frees its storage)
+			 */
+			constexpr void shrink_to_fit()
+			{
+				if (allocated() && m_capacity > m_size)
+				{
+					reallocate(m_size);
+				}
+			}
+
+			/**
+			 * Resizes the vector, new elements are value-initialized
+			 * @param count New size
+			 */
+			constexpr void resize(const size_type count)
+			{
+				if (count > m_size)
+				{
+					reserve(count);
+					woj::uninitialized_value_construct_n(m_data + m_size, count - m_size);
+					m_size = count;
+				}
+				else
+				{
+					destroy_from(count);
+				}
+			}
+
+			constexpr void resize(const size_type count, const ElementType& value)
+			{
+				if (count > m_size)
+				{
+					if (count > m_capacity)
+					{
+						// value may live in the current storage
+						const ElementType copy(value);
+						reserve(count);
+						woj::uninitialized_fill_n(m_data + m_size, count - m_size, copy);
+					}
+					else
+					{
+						woj::uninitialized_fill_n(m_data + m_size, count - m_size, value);
+					}
+					m_size = count;
+				}
+				else
+				{
+					destroy_from(count);
+				}
+			}
+
+			/**
+			 * Resizes the vector leaving new elements uninitialized, for buffers that are about to be overwritten anyway
+			 * @param count New size
+			 */
+			constexpr void resize_uninitialized(const size_type count, const noinit_t) requires std::is_trivially_default_constructible_v<ElementType>
+			{
+				if (count > m_size)
+				{
+					reserve(count);
+					if (is_constant_evaluated())
+					{
+						woj::uninitialized_value_construct_n(m_data + m_size, count - m_size);
+					}
+					m_size = count;
+				}
+				else
+				{
+					destroy_from(count);
+				}
+			}
+
+			// ----- Modifiers -----
+
+			/**
+			 * Constructs an element at the end
+			 * @param args Arguments to construct the element with
+			 * @return Reference to the new element
+			 */
+			template <typename... Args>
+			constexpr ElementType& emplace_back(Args&&... args)
+			{
+				if (m_size == m_capacity) WOJ_UNLIKELY
+				{
+					return grow_emplace_back(std::forward<Args>(args)...);
+				}
+
+				ElementType* const element = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+				++m_size;
+				return *element;
+			}
+
+			constexpr ElementType& push_back(const ElementType& value)
+			{
+				return emplace_back(value);
+			}
+
+			constexpr ElementType& push_back(ElementType&& value)
+			{
+				return emplace_back(std::move(value));
+			}
+
+			/**
+			 * Destroys the last element, the vector must not be empty
+			 */
+			constexpr void pop_back() noexcept
+			{
+				WOJ_ASSUME(m_size > 0);
+
+				--m_size;
+				std::destroy_at(m_data + m_size);
+			}
+
+			/**
+			 * Constructs an element before pos, later elements are shifted right
+			 * @param pos Position to insert at
+			 * @param args Arguments to construct the element with
+			 * @return Iterator to the new element
+			 */
+			template <typename... Args>
+			constexpr iterator emplace(const const_iterator pos, Args&&... args)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				if (index == m_size)
+				{
+					return &emplace_back(std::forward<Args>(args)...);
+				}
+
+				// Constructed first so arguments referring to elements of this vector stay valid
+				ElementType value(std::forward<Args>(args)...);
+				reserve_for(m_size + 1);
+				if (open_gap(index, 1))
+				{
+					m_data[index] = std::move(value);
+				}
+				else
+				{
+					std::construct_at(m_data + index, std::move(value));
+				}
+				return m_data + index;
+			}
+
+			constexpr iterator insert(const const_iterator pos, const ElementType& value)
+			{
+				return emplace(pos, value);
+			}
+
+			constexpr iterator insert(const const_iterator pos, ElementType&& value)
+			{
+				return emplace(pos, std::move(value));
+			}
+
+			/**
+			 * Inserts count copies of value before pos
+			 * @return Iterator to the first inserted element
+			 */
+			constexpr iterator insert(const const_iterator pos, const size_type count, const ElementType& value)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				if (count == 0)
+				{
+					return m_data + index;
+				}
+
+				const ElementType copy(value);
+				reserve_for(m_size + count);
+				const size_type moved = open_gap(index, count);
+				for (size_type i = 0; i < count; ++i)
+				{
+					if (i < moved)
+					{
+						m_data[index + i] = copy;
+					}
+					else
+					{
+						std::construct_at(m_data + index + i, copy);
+					}
+				}
+				return m_data + index;
+			}
+
+			/**
+			 * Inserts the elements of [first, last) before pos
+			 * @return Iterator to the first inserted element
+			 */
+			template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+			constexpr iterator insert(const const_iterator pos, InputIterator first, const InputIterator last)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				const size_type old_size = m_size;
+
+				if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>)
+				{
+					reserve_for(m_size + static_cast<size_type>(std::distance(first, last)));
+				}
+				for (; first != last; ++first)
+				{
+					emplace_back(*first);
+				}
+
+				std::rotate(m_data + index, m_data + old_size, m_data + m_size);
+				return m_data + index;
+			}
+
+			constexpr iterator insert(const const_iterator pos, const std::initializer_list<ElementType> values)
+			{
+				return insert(pos, values.begin(), values.end());
+			}
+
+			/**
+			 * Appends the elements of [first, last)
+			 */
+			template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+			constexpr void append(InputIterator first, const InputIterator last)
+			{
+				insert(end(), first, last);
+			}
+
+			/**
+			 * Removes the element at pos, later elements are shifted left
+			 * @return Iterator to the element following the removed one
+			 */
+			constexpr iterator erase(const const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				return erase(pos, pos + 1);
+			}
+
+			/**
+			 * Removes the elements of [first, last)
+			 * @return Iterator to the element following the removed ones
+			 */
+			constexpr iterator erase(const const_iterator first, const const_iterator last) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				const size_type index = static_cast<size_type>(first - m_data);
+				const size_type count = static_cast<size_type>(last - first);
+
+				if (count)
+				{
+					if constexpr (is_trivially_relocatable_v<ElementType>)
+					{
+						if (!is_constant_evaluated())
+						{
+							std::destroy_n(m_data + index, count);
+							woj::uninitialized_relocate_n(m_data + index + count, m_size - index - count, m_data + index);
+							m_size -= count;
+							return m_data + index;
+						}
+					}
+
+					std::move(m_data + index + count, m_data + m_size, m_data + index);
+					destroy_from(m_size - count);
+				}
+				return m_data + index;
+			}
+
+			/**
+			 * Removes the element at pos by moving the last element into its place (does not keep the order)
+			 * @return Iterator to the element now at pos
+			 */
+			constexpr iterator swap_erase(const const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+			{
+				const size_type index = static_cast<size_type>(pos - m_data);
+				if (index != m_size - 1u)
+				{
+					m_data[index] = std::move(m_data[m_size - 1]);
+				}
+				pop_back();
+				return m_data + index;
+			}
+
+			template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+			constexpr void assign(InputIterator first, const InputIterator last)
+			{
+				if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>)
+				{
+					const size_type count = static_cast<size_type>(std::distance(first, last));
+					if (count > m_capacity)
+					{
+						// Nothing worth keeping, start from a fresh allocation of the exact size
+						clear();
+						reallocate(count);
+					}
+				}
+
+				size_type i = 0;
+				for (; first != last && i < m_size; ++first, ++i)
+				{
+					m_data[i] = *first;
+				}
+				destroy_from(i);
+				for (; first != last; ++first)
+				{
+					emplace_back(*first);
+				}
+			}
+
+			constexpr void assign(const size_type count, const ElementType& value)
+			{
+				if (count > m_capacity)
+				{
+					const ElementType copy(value);
+					clear();
+					reallocate(count);
+					resize(count, copy);
+					return;
+				}
+
+				const size_type common = m_size < count ? m_size : count;
+				for (size_type i = 0; i < common; ++i)
+				{
+					m_data[i] = value;
+				}
+				resize(count, value);
+			}
+
+			constexpr void clear() noexcept
+			{
+				destroy_from(0);
+			}
+
+		protected:
+			constexpr growable_vector_base(ElementType* const data, const size_type capacity) noexcept(std::is_nothrow_default_constructible_v<Allocator>) : m_data{ data }, m_size{ 0 }, m_capacity{ capacity }, m_allocator{} {}
+
+			constexpr growable_vector_base(ElementType* const data, const size_type capacity, const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>) : m_data{ data }, m_size{ 0 }, m_capacity{ capacity }, m_allocator{ allocator } {}
+
+			constexpr growable_vector_base(ElementType* const data, const size_type size, const size_type capacity, Allocator&& allocator) noexcept : m_data{ data }, m_size{ size }, m_capacity{ capacity }, m_allocator{ std::move(allocator) } {}
+
+			/**
+			 * @return Inline storage of Derived, nullptr without one
+			 */
+			WOJ_NODISCARD constexpr ElementType* inline_data() noexcept
+			{
+				if constexpr (InlineCapacity == 0)
+				{
+					return nullptr;
+				}
+				else
+				{
+					return static_cast<Derived&>(*this).m_inline;
+				}
+			}
+
+			/**
+			 * Checks whether the elements are stored in memory obtained from the allocator
+			 */
+			WOJ_NODISCARD constexpr bool allocated() const noexcept
+			{
+				if constexpr (InlineCapacity == 0)
+				{
+					return m_data != nullptr;
+				}
+				else
+				{
+					return m_data != static_cast<const Derived&>(*this).m_inline;
+				}
+			}
+
+			constexpr void check_capacity(const size_type count, const size_t line, const char* const function) const
+			{
+				if (count > max_size()) WOJ_UNLIKELY
+				{
+					throw vector_capacity_exceeded{ line, "vector.hpp", function };
+				}
+			}
+
+			/**
+			 * Capacity to grow to so that at least required elements fit
+			 */
+			WOJ_NODISCARD constexpr size_type grown_capacity(const size_type required) const
+			{
+				check_capacity(required, 1501ull, "woj::detail::growable_vector_base<Derived, ElementType, Allocator, GrowthFactor, InlineCapacity>::grown_capacity");
+
+				size_type capacity = initial_capacity;
+				if (m_capacity >= initial_capacity)
+				{
+					capacity = m_capacity <= max_size() / GrowthFactor::num ? m_capacity * GrowthFactor::num / GrowthFactor::den : max_size();
+				}
+				return capacity < required ? required : capacity;
+			}
+
+			/**
+			 * Makes room for required elements growing geometrically
+			 */
+			constexpr void reserve_for(const size_type required)
+			{
+				if (required > m_capacity)
+				{
+					reallocate(grown_capacity(required));
+				}
+			}
+
+			WOJ_NODISCARD constexpr ElementType* allocate(const size_type count)
+			{
+				if (is_constant_evaluated())
+				{
+					return std::allocator<ElementType>{}.allocate(count);
+				}
+				return static_cast<ElementType*>(m_allocator.allocate(count * sizeof(ElementType), alignof(ElementType)));
+			}
+
+			constexpr void deallocate(ElementType* const ptr, const size_type count) noexcept
+			{
+				if (is_constant_evaluated())
+				{
+					std::allocator<ElementType>{}.deallocate(ptr, count);
+					return;
+				}
+				m_allocator.deallocate(ptr, count * sizeof(ElementType), alignof(ElementType));
+			}
+
+			/**
+			 * Moves the elements to a storage of exactly capacity elements (capacity must be at least the size), allocated
+			 * elements move back to the inline storage when the capacity fits it (without inline storage a capacity of 0
+			 * frees the allocated storage)
+			 */
+			constexpr void reallocate(const size_type capacity)
+			{
+				if (capacity <= InlineCapacity)
+				{
+					if (allocated())
+					{
+						ElementType* const data = m_data;
+						if constexpr (InlineCapacity != 0)
+						{
+							woj::uninitialized_relocate_n(data, m_size, inline_data());
+						}
+						deallocate(data, m_capacity);
+						m_data = inline_data();
+						m_capacity = InlineCapacity;
+					}
+					return;
+				}
+
+				if constexpr (is_trivially_relocatable_v<ElementType> && reallocating_allocator_type<Allocator>)
+				{
+					if (!is_constant_evaluated() && allocated())
+					{
+						m_data = static_cast<ElementType*>(m_allocator.reallocate(m_data, m_capacity * sizeof(ElementType), capacity * sizeof(ElementType), alignof(ElementType)));
+						m_capacity = capacity;
+						return;
+					}
+				}
+
+				ElementType* const data = allocate(capacity);
+				if constexpr (is_trivially_relocatable_v<ElementType> || std::is_nothrow_move_constructible_v<ElementType>)
+				{
+					woj::uninitialized_relocate_n(m_data, m_size, data);
+				}
+				else
+				{
+					try
+					{
+						woj::uninitialized_relocate_n(m_data, m_size, data);
+					}
+					catch (...)
+					{
+						deallocate(data, capacity);
+						throw;
+					}
+				}
+				if (allocated())
+				{
+					deallocate(m_data, m_capacity);
+				}
+				m_data = data;
+				m_capacity = capacity;
+			}
+
+			template <typename... Args>
+			constexpr ElementType& grow_emplace_back(Args&&... args)
+			{
+				const size_type capacity = grown_capacity(m_size + 1);
+
+				if constexpr (is_trivially_relocatable_v<ElementType> && reallocating_allocator_type<Allocator>)
+				{
+					if (!is_constant_evaluated() && allocated())
+					{
+						// Constructed first so arguments referring to elements of this vector stay valid
+						ElementType value(std::forward<Args>(args)...);
+						reallocate(capacity);
+						ElementType* const element = std::construct_at(m_data + m_size, std::move(value));
+						++m_size;
+						return *element;
+					}
+				}
+
+				// The new element is constructed before the old ones are relocated so arguments referring to them stay valid
+				ElementType* const data = allocate(capacity);
+				ElementType* element = nullptr;
+				try
+				{
+					element = std::construct_at(data + m_size, std::forward<Args>(args)...);
+					woj::uninitialized_relocate_n(m_data, m_size, data);
+				}
+				catch (...)
+				{
+					if (element)
+					{
+						std::destroy_at(element);
+					}
+					deallocate(data, capacity);
+					throw;
+				}
+				if (allocated())
+				{
+					deallocate(m_data, m_capacity);
+				}
+				m_data = data;
+				m_capacity = capacity;
+				++m_size;
+				return *element;
+			}
+
+			constexpr void copy_construct(const ElementType* const source, const size_type count)
+			{
+				if (count)
+				{
+					reserve(count);
+					woj::uninitialized_copy_n(source, count, m_data);
+					m_size = count;
+				}
+			}
+
+			/**
+			 * Destroys the elements and frees the allocated storage
+			 */
+			constexpr void release() noexcept
+			{
+				clear();
+				if (allocated())
+				{
+					deallocate(m_data, m_capacity);
+					m_data = inline_data();
+					m_capacity = InlineCapacity;
+				}
+			}
+
+			/**
+			 * Destroys the elements from index on and shrinks the size to index (no-op if index >= size)
+			 */
+			constexpr void destroy_from(const size_type index) noexcept
+			{
+				if (index < m_size)
+				{
+					std::destroy(m_data + index, m_data + m_size);
+					m_size = index;
+				}
+			}
+
+			/**
+			 * Shifts [index, size) right by count (capacity must suffice), the first min(count, size - index) slots of the gap
+			 * stay constructed (moved-from) and the rest is raw storage, trivially relocatable elements leave the whole gap raw
+			 * @return Count of gap slots holding moved-from elements
+			 */
+			constexpr size_type open_gap(const size_type index, const size_type count)
+			{
+				const size_type tail = m_size - index;
+
+				if constexpr (is_trivially_relocatable_v<ElementType>)
+				{
+					if (!is_constant_evaluated())
+					{
+						woj::uninitialized_relocate_n(m_data + index, tail, m_data + index + count);
+						m_size += count;
+						return 0;
+					}
+				}
+
+				// Elements moved past the old end are constructed, the rest is move-assigned backwards
+				const size_type old_size = m_size;
+				const size_type constructed_from = tail > count ? old_size - count : index;
+				for (size_type i = constructed_from; i < old_size; ++i)
+				{
+					std::construct_at(m_data + i + count, std::move(m_data[i]));
+				}
+				std::move_backward(m_data + index, m_data + constructed_from, m_data + constructed_from + count);
+				m_size = old_size + count;
+				return tail < count ? tail : count;
+			}
+		};
+	}
+
+	/**
+	 * Class representing a growable vector storing its elements in memory obtained from an allocator
+	 * @tparam ElementType Type of the elements
+	 * @tparam Allocator Allocator providing the storage (see allocator_type), reallocate() is used for trivially relocatable elements when available
+	 * @tparam GrowthFactor std::ratio the capacity is multiplied by when the vector runs out of room
+	 */
+	template <typename ElementType, typename Allocator = default_allocator, typename GrowthFactor = std::ratio<3, 2>>
+	class vector : public detail::growable_vector_base<vector<ElementType, Allocator, GrowthFactor>, ElementType, Allocator, GrowthFactor, 0>
+	{
+		using base = detail::growable_vector_base<vector<ElementType, Allocator, GrowthFactor>, ElementType, Allocator, GrowthFactor, 0>;
+		friend base;
+
+	public:
+		using typename base::size_type;
+
+		constexpr vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) : base{ nullptr, 0 } {}
+
+		explicit constexpr vector(const none_t) noexcept(std::is_nothrow_default_constructible_v<Allocator>) : vector{} {}
+
+		explicit constexpr vector(const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>) : base{ nullptr, 0, allocator } {}
+
+		/**
+		 * Constructs count value-initialized elements
+		 */
+		explicit constexpr vector(const size_type count, const Allocator& allocator = Allocator{}) : vector{ allocator }
+		{
+			base::resize(count);
+		}
+
+		constexpr vector(const size_type count, const ElementType& value, const Allocator& allocator = Allocator{}) : vector{ allocator }
+		{
+			base::resize(count, value);
+		}
+
+		/**
+		 * Constructs count elements without initializing them (see resize_uninitialized)
+		 */
+		constexpr vector(const size_type count, const noinit_t noinit, const Allocator& allocator = Allocator{}) requires std::is_trivially_default_constructible_v<ElementType> : vector{ allocator }
+		{
+			base::resize_uninitialized(count, noinit);
+		}
+
+		template <size_t OtherSize>
+		explicit constexpr vector(const ElementType (&other)[OtherSize], const Allocator& allocator = Allocator{}) : vector{ allocator }
+		{
+			base::copy_construct(other, OtherSize);
+		}
+
+		constexpr vector(const std::initializer_list<ElementType> values, const Allocator& allocator = Allocator{}) : vector{ allocator }
+		{
+			base::copy_construct(values.begin(), values.size());
+		}
+
+		template <typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+		constexpr vector(const InputIterator first, const InputIterator last, const Allocator& allocator = Allocator{}) : vector{ allocator }
+		{
+			base::assign(first, last);
+		}
+
+		template <size_t OtherSize>
+		explicit constexpr vector(const stack::vector<ElementType, OtherSize>& other, const Allocator& allocator = Allocator{}) : vector{ allocator }
+		{
+			base::copy_construct(other.m_data, OtherSize);
+		}
+
+		constexpr vector(const vector& other) : vector{ other.m_allocator }
+		{
+			base::copy_construct(other.m_data, other.m_size);
+		}
+
+		constexpr vector(vector&& other) noexcept : base{ other.m_data, other.m_size, other.m_capacity, std::move(other.m_allocator) }
+		{
+			other.m_data = nullptr;
+			other.m_size = 0;
+			other.m_capacity = 0;
+		}
+
+		constexpr ~vector() noexcept
+		{
+			base::release();
+		}
+
+		constexpr vector& operator=(const vector& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			base::assign(other.m_data, other.m_data + other.m_size);
+			return *this;
+		}
+
+		constexpr vector& operator=(vector&& other) noexcept
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			base::release();
+			this->m_data = other.m_data;
+			this->m_size = other.m_size;
+			this->m_capacity = other.m_capacity;
+			this->m_allocator = std::move(other.m_allocator);
+			other.m_data = nullptr;
+			other.m_size = 0;
+			other.m_capacity = 0;
+			return *this;
+		}
+
+		constexpr vector& operator=(const std::initializer_list<ElementType> values)
+		{
+			base::assign(values.begin(), values.end());
+			return *this;
+		}
+
+		constexpr void swap(vector& other) noexcept(std::is_nothrow_swappable_v<Allocator>)
+		{
+			using std::swap;
+			swap(this->m_data, other.m_data);
+			swap(this->m_size, other.m_size);
+			swap(this->m_capacity, other.m_capacity);
+			swap(this->m_allocator, other.m_allocator);
+		}
+
+		// ----- Comparison -----
+
+		template <typename OtherAllocator, typename OtherGrowthFactor>
+		WOJ_NODISCARD constexpr bool operator==(const vector<ElementType, OtherAllocator, OtherGrowthFactor>& other) const noexcept
+		{
+			return this->m_size == other.m_size && std::equal(this->m_data, this->m_data + this->m_size, other.m_data);
+		}
+	};
+
+	template <typename ElementType, size_t Size>
+	vector(const ElementType(&)[Size]) -> vector<ElementType>;
+
+	template <typename ElementType, size_t Size>
+	struct is_trivially_relocatable<stack::vector<ElementType, Size>> : is_trivially_relocatable<ElementType> {};
+
+	template <typename ElementType, typename Allocator, typename GrowthFactor>
+	struct is_trivially_relocatable<vector<ElementType, Allocator, GrowthFactor>> : is_trivially_relocatable<Allocator> {};
 }
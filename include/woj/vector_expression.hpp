@@ -0,0 +1,419 @@
+#pragma once
+
+#include "base.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+#include <cstddef>
+#include <type_traits>
+
+#ifndef WOJ_VECTOR_EXPRESSION_HPP
+#define WOJ_VECTOR_EXPRESSION_HPP
+#endif
+
+namespace woj
+{
+	namespace stack
+	{
+		/**
+		 * Base of lazy element-wise expressions over stack::vector, nothing is computed until the expression is assigned
+		 * to a vector, then the whole tree is evaluated in one loop (SIMD packs for float/double, scalars in constant evaluation)
+		 * @tparam Derived Expression type, must provide operator[](index) and for float/double load(index) returning a simd::pack
+		 * @tparam ElementType Type of the produced values
+		 * @tparam Size Count of the produced values
+		 */
+		template <typename Derived, typename ElementType, size_t Size>
+		class vector_expression
+		{
+		public:
+			using value_type = ElementType;
+
+			static constexpr bool is_vector_expression = true;
+
+			static WOJ_CONSTEVAL size_t size() noexcept
+			{
+				return Size;
+			}
+
+			/**
+			 * Writes the values of the expression to destination (may alias the operands element for element)
+			 * @param destination Storage for Size values
+			 */
+			constexpr void evaluate(ElementType* const destination) const noexcept
+			{
+				// Copied so the operand pointers stay in registers instead of being reloaded after every store
+				const Derived self = static_cast<const Derived&>(*this);
+				size_t i = 0;
+
+				if constexpr (simd::has_pack_v<ElementType>)
+				{
+					if (!is_constant_evaluated())
+					{
+						constexpr size_t width = simd::pack<ElementType>::width;
+						for (; i + 2 * width <= Size; i += 2 * width)
+						{
+							const simd::pack<ElementType> first = self.load(i);
+							const simd::pack<ElementType> second = self.load(i + width);
+							first.store(destination + i);
+							second.store(destination + i + width);
+						}
+						if (i + width <= Size)
+						{
+							self.load(i).store(destination + i);
+							i += width;
+						}
+					}
+				}
+
+				for (; i < Size; ++i)
+				{
+					destination[i] = self[i];
+				}
+			}
+		};
+
+		template <typename ElementType, size_t Size>
+		class vector_operand final : public vector_expression<vector_operand<ElementType, Size>, ElementType, Size>
+		{
+		public:
+			const ElementType* m_data;
+
+			explicit constexpr vector_operand(const vector<ElementType, Size>& source) noexcept : m_data{ source.m_data } {}
+
+			WOJ_NODISCARD constexpr ElementType operator[](const size_t index) const noexcept
+			{
+				return m_data[index];
+			}
+
+			WOJ_NODISCARD simd::pack<ElementType> load(const size_t index) const noexcept requires simd::has_pack_v<ElementType>
+			{
+				return simd::pack<ElementType>::load(m_data + index);
+			}
+		};
+
+		template <typename ElementType, size_t Size>
+		class scalar_operand final : public vector_expression<scalar_operand<ElementType, Size>, ElementType, Size>
+		{
+		public:
+			ElementType m_value;
+
+			explicit constexpr scalar_operand(const ElementType value) noexcept : m_value{ value } {}
+
+			WOJ_NODISCARD constexpr ElementType operator[](const size_t) const noexcept
+			{
+				return m_value;
+			}
+
+			WOJ_NODISCARD simd::pack<ElementType> load(const size_t) const noexcept requires simd::has_pack_v<ElementType>
+			{
+				return simd::pack<ElementType>::broadcast(m_value);
+			}
+		};
+
+		template <typename Operation, typename Operand>
+		class unary_vector_expression final : public vector_expression<unary_vector_expression<Operation, Operand>, typename Operand::value_type, Operand::size()>
+		{
+		public:
+			using value_type = typename Operand::value_type;
+
+			Operand m_operand;
+
+			explicit constexpr unary_vector_expression(const Operand& operand) noexcept : m_operand{ operand } {}
+
+			WOJ_NODISCARD constexpr value_type operator[](const size_t index) const noexcept
+			{
+				return Operation::apply(m_operand[index]);
+			}
+
+			WOJ_NODISCARD simd::pack<value_type> load(const size_t index) const noexcept requires simd::has_pack_v<value_type>
+			{
+				return Operation::apply(m_operand.load(index));
+			}
+		};
+
+		template <typename Operation, typename Left, typename Right>
+		class binary_vector_expression final : public vector_expression<binary_vector_expression<Operation, Left, Right>, typename Left::value_type, Left::size()>
+		{
+		public:
+			using value_type = typename Left::value_type;
+
+			Left m_left;
+			Right m_right;
+
+			constexpr binary_vector_expression(const Left& left, const Right& right) noexcept : m_left{ left }, m_right{ right } {}
+
+			WOJ_NODISCARD constexpr value_type operator[](const size_t index) const noexcept
+			{
+				return Operation::apply(m_left[index], m_right[index]);
+			}
+
+			WOJ_NODISCARD simd::pack<value_type> load(const size_t index) const noexcept requires simd::has_pack_v<value_type>
+			{
+				return Operation::apply(m_left.load(index), m_right.load(index));
+			}
+		};
+	}
+
+	namespace detail
+	{
+		template <typename Type>
+		struct vector_math_traits
+		{
+			static constexpr bool is_operand = false;
+		};
+
+		template <typename ElementType, size_t Size> requires std::is_arithmetic_v<ElementType> && (!std::is_same_v<ElementType, bool>)
+		struct vector_math_traits<stack::vector<ElementType, Size>>
+		{
+			static constexpr bool is_operand = true;
+			using value_type = ElementType;
+			static constexpr size_t size = Size;
+			using operand_type = stack::vector_operand<ElementType, Size>;
+		};
+
+		template <typename Expression> requires Expression::is_vector_expression
+		struct vector_math_traits<Expression>
+		{
+			static constexpr bool is_operand = true;
+			using value_type = typename Expression::value_type;
+			static constexpr size_t size = Expression::size();
+			using operand_type = Expression;
+		};
+
+		template <typename Type>
+		concept vector_math_operand = vector_math_traits<std::remove_cvref_t<Type>>::is_operand;
+
+		template <typename Type>
+		concept vector_math_scalar = std::is_arithmetic_v<std::remove_cvref_t<Type>>;
+
+		/**
+		 * Two vector operands of the same element type and size, or a vector operand and a scalar
+		 */
+		template <typename Left, typename Right>
+		concept vector_math_operands = (vector_math_operand<Left> && vector_math_operand<Right>
+			&& std::is_same_v<typename vector_math_traits<std::remove_cvref_t<Left>>::value_type, typename vector_math_traits<std::remove_cvref_t<Right>>::value_type>
+			&& vector_math_traits<std::remove_cvref_t<Left>>::size == vector_math_traits<std::remove_cvref_t<Right>>::size)
+			|| (vector_math_operand<Left> && vector_math_scalar<Right>)
+			|| (vector_math_scalar<Left> && vector_math_operand<Right>);
+
+		template <typename Type, typename Other>
+		constexpr auto to_vector_operand(const Type& value) noexcept
+		{
+			if constexpr (vector_math_operand<Type>)
+			{
+				return typename vector_math_traits<Type>::operand_type{ value };
+			}
+			else
+			{
+				using traits = vector_math_traits<Other>;
+				return stack::scalar_operand<typename traits::value_type, traits::size>{ static_cast<typename traits::value_type>(value) };
+			}
+		}
+
+		template <typename Operation, typename Left, typename Right>
+		constexpr auto make_binary_vector_expression(const Left& left, const Right& right) noexcept
+		{
+			auto left_operand = to_vector_operand<Left, Right>(left);
+			auto right_operand = to_vector_operand<Right, Left>(right);
+			return stack::binary_vector_expression<Operation, decltype(left_operand), decltype(right_operand)>{ left_operand, right_operand };
+		}
+
+		// Operations are applied both to scalars and to simd::pack values
+
+		struct vector_plus
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value left, const Value right) noexcept
+			{
+				return static_cast<Value>(left + right);
+			}
+		};
+
+		struct vector_minus
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value left, const Value right) noexcept
+			{
+				return static_cast<Value>(left - right);
+			}
+		};
+
+		struct vector_multiplies
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value left, const Value right) noexcept
+			{
+				return static_cast<Value>(left * right);
+			}
+		};
+
+		struct vector_divides
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value left, const Value right) noexcept
+			{
+				return static_cast<Value>(left / right);
+			}
+		};
+
+		// min/max follow the SSE semantics (the second operand wins on NaN) so scalar tails match the SIMD body
+
+		struct vector_min
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value left, const Value right) noexcept
+			{
+				if constexpr (std::is_arithmetic_v<Value>)
+				{
+					return left < right ? left : right;
+				}
+				else
+				{
+					return min(left, right);
+				}
+			}
+		};
+
+		struct vector_max
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value left, const Value right) noexcept
+			{
+				if constexpr (std::is_arithmetic_v<Value>)
+				{
+					return left > right ? left : right;
+				}
+				else
+				{
+					return max(left, right);
+				}
+			}
+		};
+
+		struct vector_negate
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value value) noexcept
+			{
+				return static_cast<Value>(-value);
+			}
+		};
+
+		struct vector_abs
+		{
+			template <typename Value>
+			static constexpr Value apply(const Value value) noexcept
+			{
+				if constexpr (std::is_arithmetic_v<Value>)
+				{
+					return value < Value{} ? static_cast<Value>(-value) : value;
+				}
+				else
+				{
+					return abs(value);
+				}
+			}
+		};
+	}
+
+	namespace stack
+	{
+		template <typename Left, typename Right> requires detail::vector_math_operands<Left, Right>
+		WOJ_NODISCARD constexpr auto operator+(const Left& left, const Right& right) noexcept
+		{
+			return detail::make_binary_vector_expression<detail::vector_plus>(left, right);
+		}
+
+		template <typename Left, typename Right> requires detail::vector_math_operands<Left, Right>
+		WOJ_NODISCARD constexpr auto operator-(const Left& left, const Right& right) noexcept
+		{
+			return detail::make_binary_vector_expression<detail::vector_minus>(left, right);
+		}
+
+		template <typename Left, typename Right> requires detail::vector_math_operands<Left, Right>
+		WOJ_NODISCARD constexpr auto operator*(const Left& left, const Right& right) noexcept
+		{
+			return detail::make_binary_vector_expression<detail::vector_multiplies>(left, right);
+		}
+
+		template <typename Left, typename Right> requires detail::vector_math_operands<Left, Right>
+		WOJ_NODISCARD constexpr auto operator/(const Left& left, const Right& right) noexcept
+		{
+			return detail::make_binary_vector_expression<detail::vector_divides>(left, right);
+		}
+
+		template <detail::vector_math_operand Operand>
+		WOJ_NODISCARD constexpr auto operator-(const Operand& operand) noexcept
+		{
+			using operand_type = typename detail::vector_math_traits<Operand>::operand_type;
+			return unary_vector_expression<detail::vector_negate, operand_type>{ operand_type{ operand } };
+		}
+
+		/**
+		 * Element-wise minimum, either operand may be a scalar
+		 */
+		template <typename Left, typename Right> requires detail::vector_math_operands<Left, Right>
+		WOJ_NODISCARD constexpr auto min(const Left& left, const Right& right) noexcept
+		{
+			return detail::make_binary_vector_expression<detail::vector_min>(left, right);
+		}
+
+		/**
+		 * Element-wise maximum, either operand may be a scalar
+		 */
+		template <typename Left, typename Right> requires detail::vector_math_operands<Left, Right>
+		WOJ_NODISCARD constexpr auto max(const Left& left, const Right& right) noexcept
+		{
+			return detail::make_binary_vector_expression<detail::vector_max>(left, right);
+		}
+
+		/**
+		 * Element-wise clamp to [low, high], the bounds may be scalars or vectors
+		 */
+		template <detail::vector_math_operand Operand, typename Low, typename High> requires detail::vector_math_operands<Operand, Low> && detail::vector_math_operands<Operand, High>
+		WOJ_NODISCARD constexpr auto clamp(const Operand& operand, const Low& low, const High& high) noexcept
+		{
+			return min(max(operand, low), high);
+		}
+
+		template <detail::vector_math_operand Operand>
+		WOJ_NODISCARD constexpr auto abs(const Operand& operand) noexcept
+		{
+			using operand_type = typename detail::vector_math_traits<Operand>::operand_type;
+			return unary_vector_expression<detail::vector_abs, operand_type>{ operand_type{ operand } };
+		}
+
+		/**
+		 * Materializes an expression into a new vector
+		 */
+		template <detail::vector_math_operand Operand>
+		WOJ_NODISCARD constexpr auto evaluate(const Operand& operand) noexcept
+		{
+			using traits = detail::vector_math_traits<Operand>;
+			return vector<typename traits::value_type, traits::size>{ typename traits::operand_type{ operand } };
+		}
+
+		template <typename ElementType, size_t Size, typename Right> requires detail::vector_math_operands<vector<ElementType, Size>, Right>
+		constexpr vector<ElementType, Size>& operator+=(vector<ElementType, Size>& left, const Right& right) noexcept
+		{
+			return left = left + right;
+		}
+
+		template <typename ElementType, size_t Size, typename Right> requires detail::vector_math_operands<vector<ElementType, Size>, Right>
+		constexpr vector<ElementType, Size>& operator-=(vector<ElementType, Size>& left, const Right& right) noexcept
+		{
+			return left = left - right;
+		}
+
+		template <typename ElementType, size_t Size, typename Right> requires detail::vector_math_operands<vector<ElementType, Size>, Right>
+		constexpr vector<ElementType, Size>& operator*=(vector<ElementType, Size>& left, const Right& right) noexcept
+		{
+			return left = left * right;
+		}
+
+		template <typename ElementType, size_t Size, typename Right> requires detail::vector_math_operands<vector<ElementType, Size>, Right>
+		constexpr vector<ElementType, Size>& operator/=(vector<ElementType, Size>& left, const Right& right) noexcept
+		{
+			return left = left / right;
+		}
+	}
+}